@@ -7,7 +7,11 @@
          (single) systematic parameter (supported by the ReWeight package).
          It outputs a ROOT file containing a tree with an entry for every
          input event. Each such tree entry contains a TArrayF of all computed
-         weights and a TArrayF of all used tweak dial values.
+         weights and a TArrayF of all used tweak dial values, as well as
+         summaries of the weights over the dial values (weights_min,
+         weights_max, weights_mean, weights_rms and weights_fnonpos, the
+         fraction of dial values with weight <= 0), for outlier checks
+         without reading the weight arrays.
 
 \syntax  grwght1scan \
            -f input_event_file
@@ -18,7 +22,19 @@
           [--max-tweak maximum_tweak_value]
           [-p neutrino_codes]
           [-o output_weights_file]
+          [--select cut_expression]
+          [--rejected skip|unity]
+          [--preflight n_events]
           [--seed random_number_seed]
+          [--table-cache file]
+          [--startup-timing json_file]
+          [--trace json_file]
+          [--trace-sample n]
+          [--weight-storage type]
+          [--log-weight-range lnw_min,lnw_max]
+          [--compression algorithm[:level]]
+          [--basket-size bytes]
+          [--auto-flush n_entries]
           [--message-thresholds xml_file]
           [--event-record-print-level level]
 
@@ -26,7 +42,14 @@
          [] is an optional argument.
 
          -f
-            Specifies a GHEP input file.
+            Specifies an input file with a GHEP event tree or, if it has
+            none, a flat `gst' summary tree (as written by gntpc -f gst).
+            Reading a gst tree is faster, but the flat format lacks the
+            information some systematics need (eg the hadronization record
+            or the hadron positions in the nucleus); those are rejected
+            at startup. Systematics whose weight calculators handle compact
+            event views (eg the hadron fate ones) are reweighted from
+            events decoded straight from the gst branches.
          -n
             Specifies an event range.
             Examples:
@@ -58,8 +81,81 @@
             Specifies the filename of the output weight file.
             This is an optional argument.
             By default filename is weights_<name_of_systematic_param>.root.
+         --select
+            A cut expression selecting the events to reweight, evaluated on
+            cheap event summary quantities before any weight calculator runs.
+            Quantities: probe, cc, nc, em, qel, res, dis, coh, mec, dfr, charm,
+            Ev, Q2, W, x, y, target, A, Z, hitnuc, fsl, Elep and the final
+            state multiplicities np, nn, npip, npim, npi0, nKp, nKm, nK0,
+            ngamma. Operators: abs(), ! - * / + - < <= > >= == != && ||.
+            Example: --select "cc && abs(probe)==14 && Ev<10 && A==12"
+            By default all events are reweighted.
+         --rejected
+            What to write for events failing the --select expression:
+            `unity' (default) writes an entry with all weights set to 1,
+            `skip' writes no entry at all (the `eventnum' branch then
+            identifies the reweighted events).
+         --preflight
+            Before reweighting, compares the differential cross sections
+            stored with the events against those of each cross section
+            weight calculator's default model, for (selected) events spread
+            over the event range: up to 20 events for each calculator and
+            process (scattering & interaction type, target). Calculators
+            use the stored values (fast) for the processes where all agree,
+            and recompute them for the others; the decisions are reported
+            in the log. 0 disables the check, in which case the stored
+            values are always used and only checked for the first events.
+            Ignored for gst input. Default: 1000
          --seed
             Random number seed.
+            The output file contains a GReWeightIOShardManifest object named
+            `shard_manifest' recording the input file identity, the event
+            range, a hash of the configuration and the seed, so that outputs
+            of jobs processing different event ranges can be validated and
+            merged with grwghtmerge.
+         --table-cache
+            A ROOT file caching the tables weight calculators derive at
+            startup or on first use (resonance branching ratios vs W,
+            nucleon momentum distributions, pdf normalizations). Tables
+            found in the file are loaded instead of rebuilt; new ones are
+            added to it at the end of the job. The file is keyed by the
+            GENIE version and tune, and is rebuilt if they do not match.
+            By default no cache is used.
+         --startup-timing
+            Times the startup phases (message thresholds, tune, input file,
+            each weight calculator's construction, first reconfiguration
+            and first weight calculation, ...) and reports the wall time
+            and resident memory change of each, as a table in the log and
+            as JSON in the specified file, once the first event is done.
+         --trace
+            Records timed spans (weight calculation, each calculator's
+            weight calculation & reconfiguration, cross section
+            evaluations & integrals, event reading) for a sample of events
+            and writes them as Chrome trace JSON in the specified file, to
+            be viewed with chrome://tracing or ui.perfetto.dev. The slowest
+            traced events are listed in the log.
+         --trace-sample
+            Traces every n-th event (by event number). Default: 100
+         --weight-storage
+            How weights are stored: double, float (default), log16 (16-bit
+            fixed-point ln(w), stored in a `weights_q' branch) or float16
+            (half-precision w-1, stored in a `weights_q' branch).
+            The output file contains a GReWeightIOWeightCodec object named
+            `weight_codec' which decodes the stored values and documents
+            their precision bound (1.2E-4 relative error for log16 with the
+            default ln(w) range, 2^-11 |w-1| for float16).
+         --log-weight-range
+            The ln(w) range covered by log16 storage. Default: -8,8.
+            Weights outside the range are clipped at its edges.
+         --compression
+            Output compression: zlib, lzma, lz4 or zstd, optionally followed
+            by :level (eg `lz4:4'). Default: the ROOT default.
+         --basket-size
+            Basket size (in bytes) for the weights tree branches.
+            Default: large enough to hold one cluster of entries.
+         --auto-flush
+            Number of entries per cluster, which should match the chunks in
+            which the weights are read back. Default: ~16 MB of weights.
          --message-thresholds
             Allows users to customize the message stream thresholds.
             The thresholds are specified using an XML file.
@@ -79,6 +175,7 @@
 //____________________________________________________________________________
 
 #include <string>
+#include <vector>
 #include <sstream>
 #include <cassert>
 
@@ -107,6 +204,16 @@
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSyst.h"
 #include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightEventView.h"
+#include "RwFramework/GReWeightSelection.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+#include "RwFramework/GReWeightTracer.h"
+#include "RwIO/GReWeightIOWeightCodec.h"
+#include "RwIO/GReWeightIOWeightStats.h"
+#include "RwIO/GReWeightIOUtils.h"
+#include "RwIO/GReWeightIOShardManifest.h"
+#include "RwIO/GReWeightIOGstReader.h"
 #include "RwCalculators/GReWeightNuXSecNCEL.h"
 #include "RwCalculators/GReWeightNuXSecCCQE.h"
 #include "RwCalculators/GReWeightNuXSecCCRES.h"
@@ -126,6 +233,7 @@
 #include "RwCalculators/GReWeightINukeParams.h"
 #include "RwCalculators/GReWeightNuXSecNC.h"
 #include "RwCalculators/GReWeightXSecEmpiricalMEC.h"
+#include "RwCalculators/GReWeightPreflight.h"
 
 
 using std::string;
@@ -137,6 +245,9 @@ using namespace genie::rew;
 void GetCommandLineArgs (int argc, char ** argv);
 void PrintSyntax        (void);
 void GetEventRange      (Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast);
+string ConfigurationString(void);
+void Preflight          (GReWeightPreflight & preflight, GReWeight & rw, TTree * tree,
+                         NtpMCEventRecord * mcrec, const vector<bool> & selected, Long64_t nfirst);
 
 string      gOptInpFilename; ///< name for input file (contains input event tree)
 string      gOptOutFilename; ///< name for output file (contains the output weight tree)
@@ -148,41 +259,86 @@ double      gOptMinTwk;      ///< Minimum value of tweaked dial
 double      gOptMaxTwk;      ///< Maximum value of tweaked dial
 PDGCodeList gOptNu(false);   ///< neutrinos to consider
 long int    gOptRanSeed;     ///< random number seed
+GReWeightIOWeightCodec gOptWghtCodec(GReWeightIOWeightCodec::kStoreFloat); ///< weight storage
+string      gOptCompression; ///< output compression spec (algorithm[:level])
+int         gOptBasketSize;  ///< basket size for the weights tree branches
+Long64_t    gOptAutoFlush;   ///< # of entries per cluster in the weights tree
+GReWeightSelection gOptSelection; ///< events to reweight
+bool        gOptSkipRejected; ///< write no entry for events failing the selection?
+int         gOptPreflight;   ///< # of events for the stored cross section preflight (0: none)
+string      gOptTableCache;  ///< table cache file, if any
+string      gOptStartupTiming; ///< startup timing JSON file, if timing
+string      gOptTrace;       ///< trace JSON file, if tracing
+long        gOptTraceSample; ///< trace every n-th event
 
 //___________________________________________________________________
 int main(int argc, char ** argv)
 {
   GetCommandLineArgs (argc, argv);
 
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  if(gOptStartupTiming.size() > 0) timer->Enable();
+
+  GReWeightTracer * tracer = GReWeightTracer::Instance();
+  tracer->SetSampling(gOptTraceSample);
+  if(gOptTrace.size() > 0) tracer->Enable();
+
   utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  timer->Lap("message thresholds");
   utils::app_init::RandGen(gOptRanSeed);
   GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
+  timer->Lap("random number generator");
 
   if ( ! RunOpt::Instance()->Tune() ) {
     LOG("greweight", pFATAL) << " No TuneId in RunOption";
     exit(-1);
   }
   RunOpt::Instance()->BuildTune();
+  timer->Lap("build tune");
 
 
-  // Get the input event sample
+  // Get the input event sample: a GHEP tree or, failing that, a gst tree
   TTree *           tree = 0;
   NtpMCTreeHeader * thdr = 0;
+  GReWeightIOGstReader * gst = 0;
   TFile file(gOptInpFilename.c_str(),"READ");
   tree = dynamic_cast <TTree *>           ( file.Get("gtree")  );
   thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
-  LOG("grwght1scan", pNOTICE) << "Input tree header: " << *thdr;
+  if(!tree) {
+    tree = dynamic_cast <TTree *> ( file.Get("gst") );
+    if(GReWeightIOGstReader::IsGstTree(tree)) gst = new GReWeightIOGstReader(tree);
+    else tree = 0;
+  }
+  if(gst && !gst->IsValid()) {
+    LOG("grwght1scan", pFATAL)
+      << "Can't read the gst tree of input file " << file.GetName() << ": " << gst->Error();
+    gAbortingInErr = true;
+    exit(1);
+  }
   if(!tree){
     LOG("grwght1scan", pFATAL)
-      << "Can't find a GHEP tree in input file: "<< file.GetName();
+      << "Can't find a GHEP or gst tree in input file: "<< file.GetName();
     gAbortingInErr = true;
     PrintSyntax();
     exit(1);
   }
+  if(thdr) {
+    LOG("grwght1scan", pNOTICE) << "Input tree header: " << *thdr;
+  }
   NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
+  if(!gst) tree->SetBranchAddress("gmcrec", &mcrec);
+
+  // Make sure the systematic can be reweighted from a gst tree
+  string why;
+  if(gst && !gst->CanReweight(gOptSyst, why)) {
+    LOG("grwght1scan", pFATAL)
+      << GSyst::AsString(gOptSyst) << " can not be reweighted from a gst tree: " << why;
+    gAbortingInErr = true;
+    exit(1);
+  }
 
   Long64_t nev_in_file = tree->GetEntries();
+  timer->Lap("open input");
 
   // The tweaking dial takes N values between [-1,1]
 
@@ -198,6 +354,17 @@ int main(int argc, char ** argv)
 
   Long64_t nev = (nlast - nfirst + 1);
 
+  // Describe this job, so that outputs of jobs processing different
+  // event ranges can be validated & merged
+  GReWeightIOShardManifest manifest;
+  manifest.SetApp        ("grwght1scan");
+  manifest.SetInput      (&file, nev_in_file);
+  manifest.SetEventRange (nfirst, nlast);
+  manifest.SetConfig     (ConfigurationString());
+  manifest.SetSeed       (gOptRanSeed);
+  manifest.AddTree       (GSyst::AsString(gOptSyst));
+  manifest.SetSparse     (gOptSelection.IsSet() && gOptSkipRejected);
+
   //
   // Summarize
   //
@@ -206,21 +373,52 @@ int main(int argc, char ** argv)
     << "\n"
     << "\n** grwght1scan: Will start processing events promptly."
     << "\nHere is a summary of inputs: "
-    << "\n - Input event file: " << gOptInpFilename
+    << "\n - Input event file: " << gOptInpFilename << (gst ? " (gst tree)" : "")
     << "\n - Processing: " << nev << " events in the range [" << nfirst << ", " << nlast << "]"
     << "\n - Systematic parameter to tweak: " << GSyst::AsString(gOptSyst)
     << "\n - Number of tweak dial values in [" << gOptMinTwk << ", " << gOptMaxTwk << "] : " << gOptInpNTwk
     << "\n - Neutrino species to reweight : " << gOptNu
     << "\n - Output weights to be saved in : " << gOptOutFilename
+    << "\n - Weight storage : " << gOptWghtCodec.AsString()
     << "\n - Specified random number seed : " << gOptRanSeed
+    << "\n - Event selection : " << (gOptSelection.IsSet() ? gOptSelection.Expression() : "none")
     << "\n\n";
 
+  // Apply the event selection up-front, so that rejected events are
+  // neither read nor reweighted at each tweak dial value
+  vector<bool> selected(nev, true);
+  Long64_t nsel = nev;
+  if(gOptSelection.IsSet()) {
+    nsel = 0;
+    for (int iev = nfirst; iev <= nlast; iev++) {
+      EventRecord * evp = 0;
+      if(gst) evp = gst->ReadEvent(iev);
+      else {
+        tree->GetEntry(iev);
+        evp = mcrec->event;
+      }
+      selected[iev - nfirst] = (evp != 0 && gOptSelection.Select(*evp));
+      if(selected[iev - nfirst]) nsel++;
+      if(mcrec) mcrec->Clear();
+    }
+    LOG("grwght1scan", pNOTICE)
+      << "Selected " << nsel << " of " << nev << " events ("
+      << (100.*nsel)/nev << "%) for reweighting";
+  }
+
+  timer->Lap("event selection");
 
   // Declare the weights and twkdial arrays
   const int n_events = (const int) nev;
   float weights  [n_events][n_points];
   float twkdials [n_events][n_points];
 
+  // Load the derived calculator tables from the cache, if one is used
+  if(gOptTableCache.size() > 0) {
+    GReWeightTableCache::Instance()->Open(gOptTableCache);
+  }
+  timer->Lap("table cache");
+
   // Create a GReWeight object and add to it a set of weight calculators
 
   GReWeight rw;
@@ -296,6 +494,17 @@ int main(int argc, char ** argv)
      rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12uShape);
   }
 
+  timer->Lap("systematics & calculator modes");
+
+  // Decide where the stored differential cross sections can be used
+  GReWeightPreflight preflight;
+  if(gOptPreflight > 0 && !gst) {
+    Preflight(preflight, rw, tree, mcrec, selected, nfirst);
+    timer->Lap("preflight");
+  }
+
+  GReWeightEventView view;
+
   // Twk dial loop
   for (int ith_dial = 0; ith_dial < n_points; ith_dial++) {
 
@@ -314,25 +523,51 @@ int main(int argc, char ** argv)
               LOG("grwght1scan", pNOTICE)
                  << "***** Currently at event number: "<< iev;
           }
+          GReWeightTracer::BeginEvent(iev);
 
-          // Get next event
-          tree->GetEntry(iev);
-          EventRecord & event = *(mcrec->event);
-          LOG("grwght1scan", pINFO) << "Event: " << iev << "\n" << event;
+          // Events failing the selection get unit weights
+          if(!selected[iev - nfirst]) {
+             weights  [iev - nfirst][ith_dial] = 1.;
+             twkdials [iev - nfirst][ith_dial] = twk_dial;
+             continue;
+          }
 
           // Reset arrays
           int idx = iev - nfirst;
           weights  [idx][ith_dial] = -99999.0;
           twkdials [idx][ith_dial] = twk_dial;
 
-          // Reweight this event?
-          int nupdg = event.Probe()->Pdg();
-          bool do_reweight = gOptNu.ExistsInPDGCodeList(nupdg);
-
-          // Calculate weight
           double wght=1.;
-          if ( do_reweight ) {
-             wght = rw.CalcWeight(event);
+
+          if(gst && rw.HandlesEventView()) {
+             // Calculators that can, reweight events decoded straight
+             // from the gst branches, with no event record built
+             if(!gst->ReadEventView(iev, view)) continue;
+             int nupdg = view.Pdg(view.ProbePosition());
+             if(gOptNu.ExistsInPDGCodeList(nupdg)) {
+                wght = rw.CalcWeight(view);
+             }
+          } else {
+             // Get next event
+             EventRecord * evp = 0;
+             if(gst) evp = gst->ReadEvent(iev);
+             else {
+               GReWeightTraceSpan span("GetEntry", "io");
+               tree->GetEntry(iev);
+               evp = mcrec->event;
+             }
+             if(!evp) continue;
+             EventRecord & event = *evp;
+             LOG("grwght1scan", pINFO) << "Event: " << iev << "\n" << event;
+
+             // Reweight this event?
+             int nupdg = event.Probe()->Pdg();
+             bool do_reweight = gOptNu.ExistsInPDGCodeList(nupdg);
+
+             // Calculate weight
+             if ( do_reweight ) {
+                wght = rw.CalcWeight(event);
+             }
           }
 
           // Print/store
@@ -340,13 +575,30 @@ int main(int argc, char ** argv)
               << "Overall weight = " << wght;
           weights[idx][ith_dial] = wght;
 
+          // Startup is over once the first event is done
+          if(timer->IsEnabled()) {
+             timer->Lap("rest of first event");
+             timer->Report(gOptStartupTiming);
+             timer->Disable();
+          }
+
           // Clean-up
-          mcrec->Clear();
+          if(mcrec) mcrec->Clear();
 
       } // evt loop
+      GReWeightTracer::EndEvent();
   } // twk_dial loop
 
+  if(tracer->IsEnabled()) {
+    tracer->Disable();
+    tracer->Report(gOptTrace);
+  }
+
+  // Store any derived calculator tables built in this job
+  GReWeightTableCache::Instance()->Save();
+
   // Close event file
+  delete gst;
   file.Close();
 
   //
@@ -356,30 +608,49 @@ int main(int argc, char ** argv)
   // Make an output tree for saving the weights. As only considering
   // varying a single systematic use this for name of tree.
   TFile * wght_file = new TFile(gOptOutFilename.c_str(), "RECREATE");
+  if(gOptCompression.size() > 0) {
+    if(!utils::rew::SetCompression(wght_file, gOptCompression)) {
+      LOG("grwght1scan", pFATAL) << "Can't set the output compression: " << gOptCompression;
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
   TTree * wght_tree = new TTree(GSyst::AsString(gOptSyst).c_str(),
                                 "GENIE weights tree");
   int branch_eventnum = 0;
-  TArrayF * branch_weight_array   = new TArrayF(n_points);
   TArrayF * branch_twkdials_array = new TArrayF(n_points);
   wght_tree->Branch("eventnum", &branch_eventnum);
-  wght_tree->Branch("weights",  &branch_weight_array);
+  GReWeightIOWeightBranch * branch_weights =
+     new GReWeightIOWeightBranch(wght_tree, "weights", n_points, gOptWghtCodec);
   wght_tree->Branch("twkdials", &branch_twkdials_array);
+  GReWeightIOWeightStats wght_stats(wght_tree, "weights");
+  vector<double> row_weights(n_points);
+
+  utils::rew::TuneWeightTree(wght_tree,
+     sizeof(int) + 5*sizeof(float) + n_points*(gOptWghtCodec.BytesPerWeight() + sizeof(float)),
+     gOptBasketSize, gOptAutoFlush);
 
   for(int iev = nfirst; iev <= nlast; iev++) {
     int idx = iev - nfirst;
+    if(!selected[idx] && gOptSkipRejected) continue;
     branch_eventnum = iev;
     for(int ith_dial = 0; ith_dial < n_points; ith_dial++){
         LOG("grwght1scan", pDEBUG)
           << "Filling tree with wght = " << weights[idx][ith_dial]
           << ", twk dial = "<< twkdials[idx][ith_dial];
-       branch_weight_array   -> AddAt (weights [idx][ith_dial], ith_dial);
+       branch_weights        -> Set   (ith_dial, weights [idx][ith_dial]);
        branch_twkdials_array -> AddAt (twkdials[idx][ith_dial], ith_dial);
+       row_weights[ith_dial] = weights[idx][ith_dial];
     } // twk_dial loop
+    wght_stats.Set(&row_weights[0], n_points);
     wght_tree->Fill();
   }
 
   wght_file->cd();
   wght_tree->Write();
+  gOptWghtCodec.Write("weight_codec");
+  manifest.Write("shard_manifest");
+  delete branch_weights;
   delete wght_tree;
   wght_tree = 0;
   wght_file->Close();
@@ -551,6 +822,153 @@ void GetCommandLineArgs(int argc, char ** argv)
      gOptMaxTwk = -5;
   }
 
+  // stored cross section preflight
+  gOptPreflight = 1000;
+  if( parser.OptionExists("preflight") ) {
+    gOptPreflight = parser.ArgAsInt("preflight");
+  }
+  if(gOptPreflight < 0) {
+    LOG("grwght1scan", pFATAL) << "--preflight can not be negative";
+    PrintSyntax();
+    exit(1);
+  }
+
+  // table cache
+  gOptTableCache = "";
+  if( parser.OptionExists("table-cache") ) {
+    gOptTableCache = parser.ArgAsString("table-cache");
+  }
+
+  // startup timing
+  gOptStartupTiming = "";
+  if( parser.OptionExists("startup-timing") ) {
+    gOptStartupTiming = parser.ArgAsString("startup-timing");
+  }
+
+  // tracing
+  gOptTrace = "";
+  if( parser.OptionExists("trace") ) {
+    gOptTrace = parser.ArgAsString("trace");
+  }
+  gOptTraceSample = 100;
+  if( parser.OptionExists("trace-sample") ) {
+    gOptTraceSample = parser.ArgAsLong("trace-sample");
+  }
+
+  // weight storage
+  if( parser.OptionExists("weight-storage") ) {
+    LOG("grwght1scan", pINFO) << "Reading weight storage type";
+    string storage_name = parser.ArgAsString("weight-storage");
+    GReWeightIOWeightCodec::WeightStorage_t storage;
+    if(!GReWeightIOWeightCodec::FromString(storage_name, storage)) {
+      LOG("grwght1scan", pFATAL) << "Unknown weight storage type: " << storage_name;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec = GReWeightIOWeightCodec(storage);
+  }
+  if( parser.OptionExists("log-weight-range") ) {
+    vector<double> range = parser.ArgAsDoubleTokens("log-weight-range",",");
+    if(gOptWghtCodec.Storage() != GReWeightIOWeightCodec::kStoreLog16 ||
+       range.size() != 2 || range[1] <= range[0]) {
+      LOG("grwght1scan", pFATAL)
+        << "--log-weight-range needs --weight-storage log16 and lnw_min < lnw_max";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec.SetLogRange(range[0], range[1]);
+  }
+
+  // output compression & layout
+  gOptCompression = "";
+  if( parser.OptionExists("compression") ) {
+    gOptCompression = parser.ArgAsString("compression");
+    int settings = 0;
+    if(!utils::rew::CompressionSettings(gOptCompression, settings)) {
+      LOG("grwght1scan", pFATAL) << "Invalid --compression: " << gOptCompression;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  gOptBasketSize = 0;
+  if( parser.OptionExists("basket-size") ) {
+    gOptBasketSize = parser.ArgAsInt("basket-size");
+  }
+  gOptAutoFlush = 0;
+  if( parser.OptionExists("auto-flush") ) {
+    gOptAutoFlush = parser.ArgAsLong("auto-flush");
+  }
+
+  // event selection
+  if( parser.OptionExists("select") ) {
+    LOG("grwght1scan", pINFO) << "Reading event selection";
+    string error;
+    if(!gOptSelection.Compile(parser.ArgAsString("select"), error)) {
+      LOG("grwght1scan", pFATAL) << "Invalid --select expression: " << error;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  gOptSkipRejected = false;
+  if( parser.OptionExists("rejected") ) {
+    string rejected = parser.ArgAsString("rejected");
+    if(rejected != "skip" && rejected != "unity") {
+      LOG("grwght1scan", pFATAL) << "--rejected must be skip or unity, not: " << rejected;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptSkipRejected = (rejected == "skip");
+  }
+
+}
+//_________________________________________________________________________________
+string ConfigurationString(void)
+{
+// Canonical description of everything that determines the weights,
+// apart from the input events and the event range
+//
+  ostringstream cfg;
+  cfg.precision(17);
+  cfg << "app: grwght1scan\n"
+      << "syst: " << GSyst::AsString(gOptSyst) << "\n"
+      << "n_points: " << gOptInpNTwk << "\n"
+      << "range: " << gOptMinTwk << ", " << gOptMaxTwk << "\n"
+      << "tune: " << RunOpt::Instance()->Tune()->Name() << "\n"
+      << "neutrinos:";
+  for(unsigned int i = 0; i < gOptNu.size(); i++) cfg << " " << gOptNu[i];
+  cfg << "\n"
+      << "storage: " << gOptWghtCodec.AsString() << "\n"
+      << "select: " << gOptSelection.Expression() << "\n"
+      << "rejected: " << (gOptSkipRejected ? "skip" : "unity") << "\n";
+  return cfg.str();
+}
+//_________________________________________________________________________________
+void Preflight(
+   GReWeightPreflight & preflight, GReWeight & rw, TTree * tree,
+   NtpMCEventRecord * mcrec, const vector<bool> & selected, Long64_t nfirst)
+{
+  //
+  // Checks the stored differential cross sections of up to gOptPreflight
+  // selected events, evenly spread over the event range, and sets the
+  // per-process choice of stored or recomputed values of the calculators
+  //
+  vector<Long64_t> entries;
+  for(unsigned int i = 0; i < selected.size(); i++) {
+    if(selected[i]) entries.push_back(nfirst + i);
+  }
+  unsigned int step = TMath::Max(1, int(entries.size() / gOptPreflight));
+  for(unsigned int i = 0; i < entries.size(); i += step) {
+    tree->GetEntry(entries[i]);
+    if(mcrec->event) preflight.Check(rw, *mcrec->event);
+    mcrec->Clear();
+  }
+  preflight.Apply(rw);
+  preflight.Print();
 }
 //_________________________________________________________________________________
 void GetEventRange(Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast)
@@ -596,7 +1014,19 @@ void PrintSyntax(void)
      << "    [--max-tweak maximum_tweak_value] \n"
      << "    [-p neutrino_codes]      \n"
      << "    [-o output_weights_file] \n"
+     << "    [--select cut_expression] \n"
+     << "    [--rejected skip|unity]  \n"
+     << "    [--preflight n_events]   \n"
      << "    [--seed random_number_seed] \n"
+     << "    [--table-cache file]     \n"
+     << "    [--startup-timing json_file] \n"
+     << "    [--trace json_file]      \n"
+     << "    [--trace-sample n]       \n"
+     << "    [--weight-storage type]  \n"
+     << "    [--log-weight-range lnw_min,lnw_max] \n"
+     << "    [--compression algorithm[:level]] \n"
+     << "    [--basket-size bytes]    \n"
+     << "    [--auto-flush n_entries] \n"
      << "    [--message-thresholds xml_file]\n"
      << "    [--event-record-print-level level]\n\n\n"
      << " See the GENIE Physics and User manual for more details";
@@ -0,0 +1,687 @@
+//____________________________________________________________________________
+/*!
+
+\program grwghtbinresp
+
+\brief   Generates, for template fits, the response functions of the
+         expected counts of a set of analysis bins to the specified
+         systematic params (see GReWeightIOBinResponse), instead of event
+         weights, so that fits scale with the number of bins rather than
+         the number of events.
+         The events are binned in variables of their summary (see grwghtnp
+         --histograms). In a single pass over the input, each chunk of
+         events is reweighted for every knot of every dial (the other dials
+         at their nominal values) and, for each pair of dials declared
+         correlated, for every point of their knot grid, and the weighted
+         counts of all bins are accumulated. Per bin, the counts at the
+         knots are then interpolated by a cubic spline in each dial and,
+         for correlated pairs, by a bilinear correction over the knot grid.
+
+         The output file contains:
+         - a GReWeightIOBinResponse `bin_response', with the response
+           functions and a fast evaluator,
+         - the binned counts of all universes (see grwghtnp --histograms)
+           and a TNamed `universes' describing them.
+
+\syntax  grwghtbinresp \
+           -f input_event_file
+           -s systematic1[,systematic2[,...]]
+           --bins binning
+          [-n n1[,n2]]
+          [-o output_file]
+          [--knots k1,k2[,...]]
+          [--dial-knots syst:k1,k2[,...][;...]]
+          [--cross syst1*syst2[,...]]
+          [--select expression]
+          [--chunk-size n_events]
+          [--seed random_number_seed]
+          [--table-cache file]
+          [--message-thresholds xml_file]
+
+         where
+         [] is an optional argument.
+
+         -f
+            Specifies an input file with a GHEP event tree or, if it has
+            none, a flat `gst' summary tree (as written by gntpc -f gst).
+         -s
+            Specifies the systematic params (dials) of the response.
+         --bins
+            Analysis bins, as `[name=]expression:nbins,min,max' specs
+            separated by `;' (see grwghtnp --histograms). Every bin of every
+            variable, under/overflow included, gets a response function.
+         -n
+            Specifies an event range (see grwght1scan).
+            By default all events are processed.
+         -o
+            Output file name. Default: binresp.root
+         --knots
+            Tweak dial values at which the counts are computed, for all
+            dials. At least 2, in increasing order. Default: -2,-1,0,1,2
+         --dial-knots
+            Knots of specific dials, overriding --knots, eg
+            --dial-knots "MaCCQE:-2,-1,0,1,2,3;MaCCRES:-1,0,1"
+         --cross
+            Pairs of dials, separated by commas, whose joint response is
+            not the product of their separate responses (eg two dials of
+            the same weight calculator), eg --cross "MaCCRES*MvCCRES".
+            Each pair costs a universe per point of its knot grid.
+         --select
+            Only events passing the selection (see grwghtnp --select) are
+            binned.
+         --chunk-size
+            Number of events held in memory at a time. Default: 1000
+         --seed
+            Random number seed.
+         --table-cache
+            Cache file for the tables weight calculators derive at startup.
+            See grwght1scan.
+         --message-thresholds
+            Allows users to customize the message stream thresholds.
+            The thresholds are specified using an XML file.
+            See $GENIE/config/Messenger.xml for the XML schema.
+
+\author  The GENIE Collaboration
+
+\created Oct 18, 2026
+
+\cpright Copyright (c) 2003-2018, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <cassert>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TNamed.h>
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Ntuple/NtpMCTreeHeader.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/StringUtils.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GSystSet.h"
+#include "RwFramework/GSyst.h"
+#include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightEventSummary.h"
+#include "RwFramework/GReWeightSelection.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwIO/GReWeightIOEventBuffer.h"
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwIO/GReWeightIOUniverseHists.h"
+#include "RwIO/GReWeightIOBinResponse.h"
+#include "RwCalculators/GReWeightHandle.h"
+
+using std::string;
+using std::vector;
+using std::ostringstream;
+
+using namespace genie;
+using namespace genie::rew;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+void GetEventRange      (Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast);
+int  SystIndex          (const string & name);
+
+string                   gOptInpFilename;  ///< name for input file (contains input event tree)
+string                   gOptOutFilename;  ///< name for output file
+Long64_t                 gOptNEvt1;        ///< range of events to process (1st input, if any)
+Long64_t                 gOptNEvt2;        ///< range of events to process (2nd input, if any)
+vector<GSyst_t>          gOptVSyst;        ///< dials of the response
+vector< vector<double> > gOptKnots;        ///< knots of each dial
+vector< std::pair<int,int> > gOptCross;    ///< correlated pairs of dials (indices in gOptVSyst)
+string                   gOptBins;         ///< analysis binning
+GReWeightSelection       gOptSelection;    ///< event selection, if any
+int                      gOptChunkSize;    ///< # of events held in memory at a time
+long int                 gOptRanSeed;      ///< random number seed
+string                   gOptTableCache;   ///< table cache file, if any
+
+//___________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  utils::app_init::RandGen(gOptRanSeed);
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("grwghtbinresp", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+
+  // Get the input event sample
+  TFile file(gOptInpFilename.c_str(),"READ");
+  TTree *           tree = dynamic_cast <TTree *>           ( file.Get("gtree")  );
+  NtpMCTreeHeader * thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
+  if(!tree) {
+    tree = dynamic_cast <TTree *> ( file.Get("gst") );
+    if(!GReWeightIOGstReader::IsGstTree(tree)) tree = 0;
+  }
+  if(!tree){
+    LOG("grwghtbinresp", pFATAL)
+      << "Can't find a GHEP or gst tree in input file: "<< file.GetName();
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  if(thdr) {
+    LOG("grwghtbinresp", pNOTICE) << "Input tree header: " << *thdr;
+  }
+
+  Long64_t nev_in_file = tree->GetEntries();
+  Long64_t nfirst = 0;
+  Long64_t nlast  = 0;
+  GetEventRange(nev_in_file, nfirst, nlast);
+  Long64_t nev = (nlast - nfirst + 1);
+
+  //
+  // Universes: one per knot of each dial (the nominal counts stand for
+  // knots at 0) and one per point of the knot grid of each correlated
+  // pair (the single dial universes stand for points with a knot at 0)
+  //
+  const int n_params = gOptVSyst.size();
+  vector< vector<double> > universes;
+  vector<string>           universe_names;
+  vector< vector<int> >    dial_universe (n_params);       // [dial][knot], -1: nominal
+  vector< vector<int> >    cross_universe(gOptCross.size()); // [pair][knot1 * nknots2 + knot2], -1: see above
+  for(int ip = 0; ip < n_params; ip++) {
+    for(unsigned int ik = 0; ik < gOptKnots[ip].size(); ik++) {
+      double knot = gOptKnots[ip][ik];
+      if(knot == 0.) {
+        dial_universe[ip].push_back(-1);
+        continue;
+      }
+      vector<double> twk(n_params, 0.);
+      twk[ip] = knot;
+      ostringstream name;
+      name << GSyst::AsString(gOptVSyst[ip]) << "=" << knot;
+      dial_universe[ip].push_back(universes.size());
+      universes.push_back(twk);
+      universe_names.push_back(name.str());
+    }
+  }
+  for(unsigned int ic = 0; ic < gOptCross.size(); ic++) {
+    int p1 = gOptCross[ic].first;
+    int p2 = gOptCross[ic].second;
+    for(unsigned int ik1 = 0; ik1 < gOptKnots[p1].size(); ik1++) {
+      for(unsigned int ik2 = 0; ik2 < gOptKnots[p2].size(); ik2++) {
+        double k1 = gOptKnots[p1][ik1];
+        double k2 = gOptKnots[p2][ik2];
+        if(k1 == 0. || k2 == 0.) {
+          cross_universe[ic].push_back(-1);
+          continue;
+        }
+        vector<double> twk(n_params, 0.);
+        twk[p1] = k1;
+        twk[p2] = k2;
+        ostringstream name;
+        name << GSyst::AsString(gOptVSyst[p1]) << "=" << k1 << " "
+             << GSyst::AsString(gOptVSyst[p2]) << "=" << k2;
+        cross_universe[ic].push_back(universes.size());
+        universes.push_back(twk);
+        universe_names.push_back(name.str());
+      }
+    }
+  }
+  const int n_univ = TMath::Max((int)universes.size(), 1);
+
+  string error;
+  GReWeightIOUniverseHists hists(n_univ);
+  hists.AddVariables(gOptBins, error); // already validated
+  const int nvars = hists.NVariables();
+  const int nbins = hists.NBins();
+
+  LOG("grwghtbinresp", pNOTICE)
+    << "\n"
+    << "\n** grwghtbinresp: Will start processing events promptly."
+    << "\nHere is a summary of inputs: "
+    << "\n - Input event file: " << gOptInpFilename
+    << "\n - Processing: " << nev << " events in the range [" << nfirst << ", " << nlast << "]"
+    << "\n - Dials: " << n_params << ", correlated pairs: " << gOptCross.size()
+    << "\n - Universes: " << universes.size()
+    << "\n - Bins: " << nbins << " (" << hists.Specification() << ")"
+    << "\n - Selection: " << (gOptSelection.IsSet() ? gOptSelection.Expression() : "none")
+    << "\n - Output file: " << gOptOutFilename
+    << "\n\n";
+
+  // Load the derived calculator tables from the cache, if one is used
+  if(gOptTableCache.size() > 0) {
+    GReWeightTableCache::Instance()->Open(gOptTableCache);
+  }
+
+  GReWeight rw;
+  GReWeightHandle::AdoptWeightCalcs(gOptVSyst, rw);
+  GSystSet & syst = rw.Systematics();
+  for(int ip = 0; ip < n_params; ip++) {
+    syst.Init(gOptVSyst[ip]);
+  }
+
+  //
+  // Bin all events for all universes, one chunk of events at a time
+  //
+
+  GReWeightIOEventBuffer * buffer = new GReWeightIOEventBuffer(tree, gOptChunkSize);
+  if(buffer->GstReader()) {
+    bool ok = true;
+    for(int ip = 0; ip < n_params; ip++) {
+      string why;
+      if(buffer->GstReader()->CanReweight(gOptVSyst[ip], why)) continue;
+      LOG("grwghtbinresp", pFATAL)
+        << GSyst::AsString(gOptVSyst[ip]) << " can not be reweighted from a gst tree: " << why;
+      ok = false;
+    }
+    if(!ok) {
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  GReWeightEventSummary summary;
+  vector<int>          bins;     // [event * nvars + variable], of the selected events
+  vector<unsigned int> selected; // buffer index of the selected events
+  Long64_t nselected = 0;
+  for(Long64_t ichunk = nfirst; ichunk <= nlast; ichunk += buffer->Capacity()) {
+
+    unsigned int nbuf = buffer->Fill(ichunk, nlast);
+    if(nbuf == 0) continue;
+
+    LOG("grwghtbinresp", pNOTICE)
+       << "***** Currently at event number: "<< ichunk;
+
+    selected.clear();
+    bins.clear();
+    for(unsigned int iev = 0; iev < nbuf; iev++) {
+      summary.Fill(buffer->Event(iev));
+      if(gOptSelection.IsSet() && !gOptSelection.Select(summary)) continue;
+      size_t first = bins.size();
+      bins.resize(first + nvars);
+      hists.FindBins(summary, &bins[first]);
+      hists.FillNominal(0, &bins[first]);
+      selected.push_back(iev);
+    }
+    nselected += selected.size();
+    if(selected.size() == 0) continue;
+
+    for(unsigned int iu = 0; iu < universes.size(); iu++) {
+      for(int ip = 0; ip < n_params; ip++) {
+        syst.Set(gOptVSyst[ip], universes[iu][ip]);
+      }
+      rw.Reconfigure();
+      for(unsigned int is = 0; is < selected.size(); is++) {
+        double wght = rw.CalcWeight(buffer->Event(selected[is]));
+        hists.Fill(0, iu, &bins[is * nvars], wght);
+      }
+    } // universes
+  } // chunks
+  delete buffer;
+  hists.Merge();
+
+  LOG("grwghtbinresp", pNOTICE)
+    << nselected << " of " << nev << " events binned";
+
+  //
+  // Response functions: per bin, the count ratios to nominal at the knots
+  //
+
+  GReWeightIOBinResponse response;
+  response.SetBinning(hists.Specification(), nbins);
+  for(int ip = 0; ip < n_params; ip++) {
+    response.AddDial(GSyst::AsString(gOptVSyst[ip]), gOptKnots[ip]);
+  }
+  for(unsigned int ic = 0; ic < gOptCross.size(); ic++) {
+    response.AddCross(gOptCross[ic].first, gOptCross[ic].second);
+  }
+
+  int nempty = 0;
+  vector<double> ratios;
+  for(int ib = 0; ib < nbins; ib++) {
+    double nominal = hists.Nominal(ib);
+    response.SetNominal(ib, nominal);
+    if(nominal <= 0.) {
+      nempty++;
+      continue; // flat response
+    }
+    for(int ip = 0; ip < n_params; ip++) {
+      const vector<int> & iu = dial_universe[ip];
+      ratios.assign(iu.size(), 1.);
+      for(unsigned int ik = 0; ik < iu.size(); ik++) {
+        if(iu[ik] >= 0) ratios[ik] = hists.SumW(iu[ik], ib) / nominal;
+      }
+      response.SetDialResponse(ip, ib, &ratios[0]);
+    }
+    for(unsigned int ic = 0; ic < gOptCross.size(); ic++) {
+      int p1  = gOptCross[ic].first;
+      int p2  = gOptCross[ic].second;
+      int nk2 = gOptKnots[p2].size();
+      const vector<int> & iu = cross_universe[ic];
+      ratios.assign(iu.size(), 1.);
+      for(unsigned int ik = 0; ik < iu.size(); ik++) {
+        int u = iu[ik];
+        if(u < 0) {
+          // a knot at 0: the other dial's own universe, if any
+          int u1 = dial_universe[p1][ik / nk2];
+          int u2 = dial_universe[p2][ik % nk2];
+          u = (u1 >= 0) ? u1 : u2;
+        }
+        if(u >= 0) ratios[ik] = hists.SumW(u, ib) / nominal;
+      }
+      response.SetCrossResponse(ic, ib, &ratios[0]);
+    }
+  }
+  if(nempty > 0) {
+    LOG("grwghtbinresp", pWARN)
+      << nempty << " of " << nbins << " bins are empty: their response is flat";
+  }
+
+  //
+  // Write the response functions & the binned counts
+  //
+
+  TFile out(gOptOutFilename.c_str(), "RECREATE");
+  if(out.IsZombie()) {
+    LOG("grwghtbinresp", pFATAL) << "Can't create output file: " << gOptOutFilename;
+    gAbortingInErr = true;
+    exit(1);
+  }
+  out.cd();
+  response.Write("bin_response");
+  hists.Write(&out);
+  ostringstream universe_list;
+  for(unsigned int iu = 0; iu < universes.size(); iu++) {
+    universe_list << iu << ": " << universe_names[iu] << "\n";
+  }
+  TNamed universes_named("universes", universe_list.str().c_str());
+  universes_named.Write();
+  out.Close();
+
+  // Store any derived calculator tables built in this job
+  GReWeightTableCache::Instance()->Save();
+
+  // Close event file
+  file.Close();
+
+  LOG("grwghtbinresp", pNOTICE)
+    << "Bin response functions saved in " << gOptOutFilename;
+  LOG("grwghtbinresp", pNOTICE)  << "Done!";
+
+  return 0;
+}
+//___________________________________________________________________
+int SystIndex(const string & name)
+{
+  GSyst_t s = GSyst::FromString(utils::str::TrimSpaces(name));
+  for(unsigned int ip = 0; ip < gOptVSyst.size(); ip++) {
+    if(gOptVSyst[ip] == s) return ip;
+  }
+  return -1;
+}
+//___________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("grwghtbinresp", pINFO) << "*** Parsing command line arguments";
+
+  // Common run options. Set defaults and read.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  // get GENIE event sample
+  if(parser.OptionExists('f')) {
+    LOG("grwghtbinresp", pINFO) << "Reading event sample filename";
+    gOptInpFilename = parser.ArgAsString('f');
+  } else {
+    LOG("grwghtbinresp", pFATAL)
+        << "Unspecified input filename - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // output file
+  if(parser.OptionExists('o')) {
+    gOptOutFilename = parser.ArgAsString('o');
+  } else {
+    gOptOutFilename = "binresp.root";
+  }
+
+  // range of event numbers to process
+  if ( parser.OptionExists('n') ) {
+    //
+    LOG("grwghtbinresp", pINFO) << "Reading number of events to analyze";
+    string nev =  parser.ArgAsString('n');
+    if (nev.find(",") != string::npos) {
+      vector<long> vecn = parser.ArgAsLongTokens('n',",");
+      if(vecn.size()!=2) {
+         LOG("grwghtbinresp", pFATAL) << "Invalid syntax";
+         gAbortingInErr = true;
+         PrintSyntax();
+         exit(1);
+      }
+      // User specified a comma-separated set of values n1,n2.
+      // Use [n1,n2] as the event range to process.
+      gOptNEvt1 = vecn[0];
+      gOptNEvt2 = vecn[1];
+    } else {
+      // User specified a single number n.
+      // Use [0,n] as the event range to process.
+      gOptNEvt1 = -1;
+      gOptNEvt2 = parser.ArgAsLong('n');
+    }
+  } else {
+    LOG("grwghtbinresp", pINFO)
+      << "Unspecified number of events to analyze - Use all";
+    gOptNEvt1 = -1;
+    gOptNEvt2 = -1;
+  }
+
+  // systematic params
+  if( parser.OptionExists('s') ) {
+    LOG("grwghtbinresp", pINFO) << "Reading systematic params";
+    vector<string> names = utils::str::Split(parser.ArgAsString('s'), ",");
+    for(unsigned int i = 0; i < names.size(); i++) {
+      GSyst_t s = GSyst::FromString(utils::str::TrimSpaces(names[i]));
+      if(s == kNullSystematic) {
+        LOG("grwghtbinresp", pFATAL) << "Unknown systematic param: " << names[i];
+        gAbortingInErr = true;
+        PrintSyntax();
+        exit(1);
+      }
+      gOptVSyst.push_back(s);
+    }
+  } else {
+    LOG("grwghtbinresp", pFATAL)
+        << "Unspecified systematic params - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // analysis bins
+  if( parser.OptionExists("bins") ) {
+    gOptBins = parser.ArgAsString("bins");
+    string error;
+    GReWeightIOUniverseHists hists(1);
+    if(!hists.AddVariables(gOptBins, error)) {
+      LOG("grwghtbinresp", pFATAL) << "Invalid --bins: " << error;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  } else {
+    LOG("grwghtbinresp", pFATAL)
+        << "Unspecified analysis bins - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // knots
+  vector<double> knots;
+  if( parser.OptionExists("knots") ) {
+    knots = parser.ArgAsDoubleTokens("knots",",");
+  } else {
+    double def[] = { -2., -1., 0., 1., 2. };
+    knots.assign(def, def + 5);
+  }
+  gOptKnots.assign(gOptVSyst.size(), knots);
+  if( parser.OptionExists("dial-knots") ) {
+    vector<string> specs = utils::str::Split(parser.ArgAsString("dial-knots"), ";");
+    for(unsigned int i = 0; i < specs.size(); i++) {
+      if(utils::str::TrimSpaces(specs[i]).size() == 0) continue;
+      size_t colon = specs[i].find(':');
+      int ip = (colon == string::npos) ? -1 : SystIndex(specs[i].substr(0, colon));
+      if(ip < 0) {
+        LOG("grwghtbinresp", pFATAL)
+          << "Invalid --dial-knots entry (not syst:k1,k2,... with syst given by -s): " << specs[i];
+        gAbortingInErr = true;
+        PrintSyntax();
+        exit(1);
+      }
+      vector<string> values = utils::str::Split(specs[i].substr(colon+1), ",");
+      gOptKnots[ip].clear();
+      for(unsigned int k = 0; k < values.size(); k++) {
+        gOptKnots[ip].push_back(atof(values[k].c_str()));
+      }
+    }
+  }
+  for(unsigned int ip = 0; ip < gOptKnots.size(); ip++) {
+    bool ok = (gOptKnots[ip].size() >= 2);
+    for(unsigned int k = 1; ok && k < gOptKnots[ip].size(); k++) {
+      ok = (gOptKnots[ip][k] > gOptKnots[ip][k-1]);
+    }
+    if(!ok) {
+      LOG("grwghtbinresp", pFATAL)
+        << "The knots of " << GSyst::AsString(gOptVSyst[ip])
+        << " must be at least 2, in increasing order";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+
+  // correlated pairs
+  gOptCross.clear();
+  if( parser.OptionExists("cross") ) {
+    vector<string> pairs = utils::str::Split(parser.ArgAsString("cross"), ",");
+    for(unsigned int i = 0; i < pairs.size(); i++) {
+      size_t star = pairs[i].find('*');
+      int p1 = (star == string::npos) ? -1 : SystIndex(pairs[i].substr(0, star));
+      int p2 = (star == string::npos) ? -1 : SystIndex(pairs[i].substr(star+1));
+      if(p1 < 0 || p2 < 0 || p1 == p2) {
+        LOG("grwghtbinresp", pFATAL)
+          << "Invalid --cross entry (not syst1*syst2 with two systs given by -s): " << pairs[i];
+        gAbortingInErr = true;
+        PrintSyntax();
+        exit(1);
+      }
+      gOptCross.push_back(std::make_pair(p1, p2));
+    }
+  }
+
+  // event selection
+  if( parser.OptionExists("select") ) {
+    string error;
+    if(!gOptSelection.Compile(parser.ArgAsString("select"), error)) {
+      LOG("grwghtbinresp", pFATAL) << "Invalid --select: " << error;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+
+  // chunk size
+  if( parser.OptionExists("chunk-size") ) {
+    LOG("grwghtbinresp", pINFO) << "Reading chunk size";
+    gOptChunkSize = parser.ArgAsInt("chunk-size");
+    if(gOptChunkSize < 1) {
+      LOG("grwghtbinresp", pFATAL) << "Chunk size must be positive - Exiting";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  } else {
+    gOptChunkSize = 1000;
+  }
+
+  // random number seed
+  if( parser.OptionExists("seed") ) {
+    LOG("grwghtbinresp", pINFO) << "Reading random number seed";
+    gOptRanSeed = parser.ArgAsLong("seed");
+  } else {
+    LOG("grwghtbinresp", pINFO) << "Unspecified random number seed - Using default";
+    gOptRanSeed = -1;
+  }
+
+  // table cache
+  gOptTableCache = "";
+  if( parser.OptionExists("table-cache") ) {
+    gOptTableCache = parser.ArgAsString("table-cache");
+  }
+}
+//_________________________________________________________________________________
+void GetEventRange(Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast)
+{
+  nfirst = 0;
+  nlast  = 0;
+
+  if(gOptNEvt1>=0 && gOptNEvt2>=0) {
+    // Input was `-n N1,N2'.
+    // Process events [N1,N2].
+    // Note: Incuding N1 and N2.
+    nfirst = gOptNEvt1;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2>=0) {
+    // Input was `-n N'.
+    // Process first N events [0,N).
+    // Note: Event N is not included.
+    nfirst = 0;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2-1);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2<0) {
+    // No input. Process all events.
+    nfirst = 0;
+    nlast  = nev_in_file-1;
+  }
+
+  assert(nfirst <= nlast && nfirst >= 0 && nlast <= nev_in_file-1);
+}
+//_________________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("grwghtbinresp", pFATAL)
+     << "\n\n"
+     << "grwghtbinresp                \n"
+     << "     -f input_event_file     \n"
+     << "     -s syst1[,syst2[,...]]  \n"
+     << "     --bins binning          \n"
+     << "    [-n n1[,n2]]             \n"
+     << "    [-o output_file]         \n"
+     << "    [--knots k1,k2[,...]]    \n"
+     << "    [--dial-knots syst:k1,k2[,...][;...]] \n"
+     << "    [--cross syst1*syst2[,...]] \n"
+     << "    [--select expression]    \n"
+     << "    [--chunk-size n_events]  \n"
+     << "    [--seed random_number_seed] \n"
+     << "    [--table-cache file]     \n"
+     << "    [--message-thresholds xml_file]\n\n\n"
+     << " See the GENIE Physics and User manual for more details";
+}
+//_________________________________________________________________________________
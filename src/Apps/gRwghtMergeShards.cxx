@@ -0,0 +1,327 @@
+//____________________________________________________________________________
+/*!
+
+\program grwghtmerge
+
+\brief   Merges the weight files written by several grwght1scan, grwghtnp or
+         grwghtmulti jobs that processed different event ranges of the same
+         input event file (`shards') into a single weight file.
+         Each shard must contain the GReWeightIOShardManifest object written
+         by these apps. The manifests are used to check that all shards were
+         produced from the same input file, with identical configurations
+         and random number seeds, and that the event ranges they cover do
+         not overlap and leave no gaps.
+         Shards with no weight trees (the histogram outputs of grwghtnp
+         --histograms) are rejected: sum them with hadd instead.
+         The weight trees are concatenated in event order using fast cloning:
+         the compressed baskets are copied as they are, without being
+         decompressed and recompressed. The output file uses the compression
+         settings of the first shard.
+
+\syntax  grwghtmerge \
+           -f shard_file[,shard_file,...]
+           -o output_file
+          [--allow-partial]
+          [--message-thresholds xml_file]
+
+         where
+         [] is an optional argument.
+
+         -f
+            Specifies a comma separated list of shard files, in any order.
+         -o
+            Specifies the merged output file.
+         --allow-partial
+            Allow the shards to cover only part of the input event file and
+            to leave gaps between them. By default, the shards must cover
+            the full input event file. Overlapping shards are always an error.
+            If the merged shards are not contiguous, the output file carries
+            no shard manifest and can not be merged any further.
+         --message-thresholds
+            Allows users to customize the message stream thresholds.
+            The thresholds are specified using an XML file.
+            See $GENIE/config/Messenger.xml for the XML schema.
+
+\author  The GENIE Collaboration
+
+\created Oct 18, 2026
+
+\cpright Copyright (c) 2003-2018, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include <TFile.h>
+#include <TTree.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOShardManifest.h"
+#include "RwIO/GReWeightIOWeightCodec.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+// A shard file and its manifest
+struct Shard {
+  TFile *                    File;
+  GReWeightIOShardManifest * Manifest;
+};
+
+bool OrderByFirstEvent  (const Shard & a, const Shard & b);
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+vector<string> gOptInpFilenames; ///< shard files
+string         gOptOutFilename;  ///< merged output file
+bool           gOptAllowPartial; ///< allow incomplete coverage of the input event file
+
+//_________________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  //
+  // Open shards and read their manifests
+  //
+
+  vector<Shard> shards;
+  for(unsigned int i = 0; i < gOptInpFilenames.size(); i++) {
+    Shard shard;
+    shard.File = new TFile(gOptInpFilenames[i].c_str(), "READ");
+    if(!shard.File || shard.File->IsZombie()) {
+      LOG("grwghtmerge", pFATAL) << "Can't open shard file: " << gOptInpFilenames[i];
+      gAbortingInErr = true;
+      exit(1);
+    }
+    shard.Manifest = dynamic_cast<GReWeightIOShardManifest *> (
+                        shard.File->Get("shard_manifest"));
+    if(!shard.Manifest) {
+      LOG("grwghtmerge", pFATAL)
+        << "No shard manifest in file: " << gOptInpFilenames[i]
+        << " - It was not written by a shard-aware reweighting app";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    if(shard.Manifest->TreeNames().size() == 0) {
+      LOG("grwghtmerge", pFATAL)
+        << "No weight trees in shard file: " << gOptInpFilenames[i]
+        << " - Histogram outputs (grwghtnp --histograms) are summed with hadd";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    LOG("grwghtmerge", pNOTICE)
+      << "Shard: " << gOptInpFilenames[i] << *shard.Manifest;
+    shards.push_back(shard);
+  }
+
+  //
+  // Check that the shards can be merged
+  //
+
+  const GReWeightIOShardManifest & ref = *shards[0].Manifest;
+  for(unsigned int i = 1; i < shards.size(); i++) {
+    string why;
+    if(!ref.Compatible(*shards[i].Manifest, why)) {
+      LOG("grwghtmerge", pFATAL)
+        << "Shards " << shards[0].File->GetName() << " and "
+        << shards[i].File->GetName() << " can not be merged: " << why;
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  std::sort(shards.begin(), shards.end(), OrderByFirstEvent);
+
+  bool contiguous = true;
+  for(unsigned int i = 1; i < shards.size(); i++) {
+    const GReWeightIOShardManifest & prev = *shards[i-1].Manifest;
+    const GReWeightIOShardManifest & curr = *shards[i  ].Manifest;
+    if(curr.FirstEvent() <= prev.LastEvent()) {
+      LOG("grwghtmerge", pFATAL)
+        << "Overlapping shards: " << shards[i-1].File->GetName()
+        << " [" << prev.FirstEvent() << ", " << prev.LastEvent() << "] and "
+        << shards[i].File->GetName()
+        << " [" << curr.FirstEvent() << ", " << curr.LastEvent() << "]";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    if(curr.FirstEvent() != prev.LastEvent() + 1) {
+      LOG("grwghtmerge", pWARN)
+        << "Events [" << prev.LastEvent() + 1 << ", " << curr.FirstEvent() - 1
+        << "] are not covered by any shard";
+      contiguous = false;
+    }
+  }
+  Long64_t first = shards.front().Manifest->FirstEvent();
+  Long64_t last  = shards.back ().Manifest->LastEvent();
+  bool complete = contiguous && first == 0 && last == ref.InputEntries() - 1;
+  if(!complete) {
+    LOG("grwghtmerge", pWARN)
+      << "Shards span events [" << first << ", " << last << "] of the "
+      << ref.InputEntries() << " events in the input file";
+    if(!gOptAllowPartial) {
+      LOG("grwghtmerge", pFATAL)
+        << "Incomplete coverage of the input event file - Use --allow-partial to merge anyway";
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  // Each tree must hold an entry per event in the shard range (or,
+  // for sparse trees, per selected event in the shard range)
+  for(unsigned int i = 0; i < shards.size(); i++) {
+    const GReWeightIOShardManifest & m = *shards[i].Manifest;
+    for(unsigned int it = 0; it < m.TreeNames().size(); it++) {
+      TTree * tree = dynamic_cast<TTree *> (shards[i].File->Get(m.TreeNames()[it].c_str()));
+      bool size_ok = tree && (m.Sparse() ?
+         tree->GetEntries() <= m.NEvents() : tree->GetEntries() == m.NEvents());
+      if(!size_ok) {
+        LOG("grwghtmerge", pFATAL)
+          << "Tree " << m.TreeNames()[it] << " in " << shards[i].File->GetName()
+          << " is missing or does not match the shard event range";
+        gAbortingInErr = true;
+        exit(1);
+      }
+    }
+  }
+
+  //
+  // Merge the weight trees, in event order, copying baskets as they are
+  //
+
+  TFile out_file(gOptOutFilename.c_str(), "RECREATE");
+  out_file.SetCompressionSettings(shards[0].File->GetCompressionSettings());
+
+  for(unsigned int it = 0; it < ref.TreeNames().size(); it++) {
+    const char * name = ref.TreeNames()[it].c_str();
+    out_file.cd();
+    TTree * ref_tree = dynamic_cast<TTree *> (shards[0].File->Get(name));
+    TTree * out_tree = ref_tree->CloneTree(0);
+    out_tree->SetDirectory(&out_file);
+    for(unsigned int i = 0; i < shards.size(); i++) {
+      TTree * tree = dynamic_cast<TTree *> (shards[i].File->Get(name));
+      Long64_t ncopied = out_tree->CopyEntries(tree, -1, "fast");
+      if(ncopied != tree->GetEntries()) {
+        LOG("grwghtmerge", pFATAL)
+          << "Failed to copy tree " << name << " from " << shards[i].File->GetName();
+        gAbortingInErr = true;
+        exit(1);
+      }
+    }
+    LOG("grwghtmerge", pNOTICE)
+      << "Merged tree " << name << ": " << out_tree->GetEntries() << " entries";
+    out_tree->Write();
+  }
+
+  GReWeightIOWeightCodec * codec = dynamic_cast<GReWeightIOWeightCodec *> (
+                                      shards[0].File->Get("weight_codec"));
+  if(codec) {
+    out_file.cd();
+    codec->Write("weight_codec");
+  }
+
+  // state multiplicities of grwghtnp --chain outputs (identical in all
+  // shards, as part of the configuration)
+  TObject * multiplicity = shards[0].File->Get("multiplicity");
+  if(multiplicity) {
+    out_file.cd();
+    multiplicity->Write("multiplicity");
+  }
+
+  if(contiguous) {
+    GReWeightIOShardManifest manifest(ref);
+    manifest.SetEventRange(first, last);
+    out_file.cd();
+    manifest.Write("shard_manifest");
+  } else {
+    LOG("grwghtmerge", pWARN)
+      << "The merged shards are not contiguous - No shard manifest written";
+  }
+
+  out_file.Close();
+
+  for(unsigned int i = 0; i < shards.size(); i++) {
+    shards[i].File->Close();
+    delete shards[i].File;
+  }
+
+  LOG("grwghtmerge", pNOTICE)
+    << "Merged " << shards.size() << " shards in " << gOptOutFilename;
+  LOG("grwghtmerge", pNOTICE)  << "Done!";
+
+  return 0;
+}
+//_________________________________________________________________________________
+bool OrderByFirstEvent(const Shard & a, const Shard & b)
+{
+  return a.Manifest->FirstEvent() < b.Manifest->FirstEvent();
+}
+//_________________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("grwghtmerge", pINFO) << "*** Parsing command line arguments";
+
+  // Common run options. Set defaults and read.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  // get shard files
+  if(parser.OptionExists('f')) {
+    LOG("grwghtmerge", pINFO) << "Reading shard filenames";
+    gOptInpFilenames = parser.ArgAsStringTokens('f', ",");
+  }
+  if(gOptInpFilenames.size() == 0) {
+    LOG("grwghtmerge", pFATAL)
+        << "Unspecified shard filenames - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // get output file
+  if(parser.OptionExists('o')) {
+    LOG("grwghtmerge", pINFO) << "Reading output filename";
+    gOptOutFilename = parser.ArgAsString('o');
+  } else {
+    LOG("grwghtmerge", pFATAL)
+        << "Unspecified output filename - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // allow partial coverage?
+  gOptAllowPartial = parser.OptionExists("allow-partial");
+}
+//_________________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("grwghtmerge", pFATAL)
+     << "\n\n"
+     << "grwghtmerge                  \n"
+     << "     -f shard_file[,shard_file,...] \n"
+     << "     -o output_file          \n"
+     << "    [--allow-partial]        \n"
+     << "    [--message-thresholds xml_file]\n\n\n"
+     << " See the GENIE Physics and User manual for more details";
+}
+//_________________________________________________________________________________
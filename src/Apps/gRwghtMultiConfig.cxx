@@ -0,0 +1,1134 @@
+//____________________________________________________________________________
+/*!
+
+\program grwghtmulti
+
+\brief   Generates weights for several independent reweighting setups in a
+         single pass over an input GHEP event file.
+         Each setup (`configuration block') has its own set of systematic
+         params to scan, its own weight calculator modes and its own table
+         of one-sigma uncertainties, and it is written out in its own ROOT
+         file. Events are read and decoded once, in chunks, and every chunk
+         is passed to all setups before the next one is read.
+         For each scanned systematic param, the output file contains a tree
+         (named after the param) with the same layout as the grwght1scan
+         output: an entry for every input event, holding a TArrayF of all
+         computed weights and a TArrayF of all used tweak dial values, as
+         well as summaries of the weights over the dial values (weights_min,
+         weights_max, weights_mean, weights_rms and weights_fnonpos).
+
+\syntax  grwghtmulti \
+           -f input_event_file
+           -c configuration_file
+          [-n n1[,n2]]
+          [-p neutrino_codes]
+          [--chunk-size n_events]
+          [--select cut_expression]
+          [--rejected skip|unity]
+          [--preflight n_events]
+          [--seed random_number_seed]
+          [--table-cache file]
+          [--startup-timing json_file]
+          [--weight-storage type]
+          [--log-weight-range lnw_min,lnw_max]
+          [--compression algorithm[:level]]
+          [--basket-size bytes]
+          [--auto-flush n_entries]
+          [--message-thresholds xml_file]
+          [--event-record-print-level level]
+
+         where
+         [] is an optional argument.
+
+         -f
+            Specifies an input file with a GHEP event tree or, if it has
+            none, a flat `gst' summary tree (as written by gntpc -f gst).
+            Systematics which can not be reweighted from the gst format
+            are rejected at startup.
+         -c
+            Specifies a text file with one or more configuration blocks.
+            Each block starts with a [name] line, followed by `key = value'
+            lines. Lines starting with # are ignored. Example:
+
+              [ma_scan]
+              output      = weights_ma_scan.root
+              syst        = MaCCQE
+              syst        = MaCCRES
+              ntwk        = 11
+              min-tweak   = -2
+              max-tweak   = +2
+              calc-mode   = xsec_ccqe:Ma
+              uncertainty = MaCCQE:0.10,0.10
+
+            Recognized keys:
+            - output      : output weights file
+                            (default: weights_<name>.root)
+            - syst        : systematic param to scan (may be repeated).
+                            Each param is scanned on its own, with all
+                            others held at their nominal value.
+            - ntwk        : number of tweak dial values (forced odd, >=3)
+            - min-tweak   : minimum tweak dial value (default: -1)
+            - max-tweak   : maximum tweak dial value (default: +1)
+            - calc-mode   : calculator:mode, overriding the mode chosen
+                            automatically from the scanned params.
+                            Supported: xsec_ccqe:{Ma,NormAndMaShape,ZExp},
+                            xsec_ccres:{MaMv,NormAndMaMvShape},
+                            xsec_ncres:{MaMv,NormAndMaMvShape},
+                            xsec_dis:{ABCV12u,ABCV12uShape}
+            - uncertainty : syst:plus_err[,minus_err], fractional one-sigma
+                            error seen by this block only
+         -n
+            Specifies an event range.
+            Examples:
+            - Type `-n 50,2350' to process all 2301 events from 50 up to 2350.
+              Note: Both 50 and 2350 are included.
+            - Type `-n 1000' to process the first 1000 events;
+              from event number 0 up to event number 999.
+            This is an optional argument.
+            By default GENIE will process all events.
+         -p
+            If set, grwghtmulti reweights *only* the specified neutrino
+            species. The input is a comma separated list of PDG codes.
+            This is an optional argument.
+            By default GENIE will reweight all neutrino species.
+         --chunk-size
+            Number of events held in memory at a time.
+            Each chunk costs one reconfiguration per tweak dial value
+            and per configuration block. Default: 1000
+         --select, --rejected
+            Event selection, applied to all configuration blocks before any
+            weight calculator runs, and what to write for rejected events.
+            See grwght1scan.
+         --preflight
+            Number of events, spread over the event range, for the check of
+            the differential cross sections stored with the events against
+            those of the default models, which decides where calculators may
+            use the stored values. Done once, for all configuration blocks.
+            0 disables the check. Ignored for gst input. See grwght1scan.
+            Default: 1000
+         --seed
+            Random number seed.
+            Each output file contains a GReWeightIOShardManifest object
+            named `shard_manifest' recording the input file identity, the
+            event range, a hash of the configuration block and the seed, so
+            that outputs of jobs processing different event ranges can be
+            validated and merged with grwghtmerge.
+         --table-cache
+            Cache file for the tables weight calculators derive at startup,
+            shared by all configuration blocks. See grwght1scan.
+         --startup-timing
+            Times the startup phases, up to the end of the first chunk of
+            events, and reports them as a table in the log and as JSON in
+            the specified file. See grwght1scan.
+         --weight-storage, --log-weight-range, --compression,
+         --basket-size, --auto-flush
+            Weight storage type and output file layout, applied to the
+            output of all configuration blocks. See grwght1scan.
+         --message-thresholds
+            Allows users to customize the message stream thresholds.
+            The thresholds are specified using an XML file.
+            See $GENIE/config/Messenger.xml for the XML schema.
+
+\author  The GENIE Collaboration
+
+\created Oct 18, 2026
+
+\cpright Copyright (c) 2003-2018, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <cassert>
+
+#include <TSystem.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TArrayF.h>
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/Ntuple/NtpMCTreeHeader.h"
+#include "Framework/Ntuple/NtpMCEventRecord.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/ParticleData/PDGCodeList.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/StringUtils.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightI.h"
+#include "RwFramework/GSystSet.h"
+#include "RwFramework/GSyst.h"
+#include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightSelection.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+#include "RwIO/GReWeightIOEventBuffer.h"
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwIO/GReWeightIOWeightCodec.h"
+#include "RwIO/GReWeightIOWeightStats.h"
+#include "RwIO/GReWeightIOUtils.h"
+#include "RwIO/GReWeightIOShardManifest.h"
+#include "RwCalculators/GReWeightNuXSecNCEL.h"
+#include "RwCalculators/GReWeightNuXSecCCQE.h"
+#include "RwCalculators/GReWeightNuXSecCCRES.h"
+#include "RwCalculators/GReWeightNuXSecCOH.h"
+#include "RwCalculators/GReWeightNonResonanceBkg.h"
+#include "RwCalculators/GReWeightFGM.h"
+#include "RwCalculators/GReWeightDISNuclMod.h"
+#include "RwCalculators/GReWeightResonanceDecay.h"
+#include "RwCalculators/GReWeightFZone.h"
+#include "RwCalculators/GReWeightINuke.h"
+#include "RwCalculators/GReWeightAGKY.h"
+#include "RwCalculators/GReWeightNuXSecCCQEaxial.h"
+#include "RwCalculators/GReWeightNuXSecCCQEvec.h"
+#include "RwCalculators/GReWeightNuXSecNCRES.h"
+#include "RwCalculators/GReWeightNuXSecDIS.h"
+#include "RwCalculators/GReWeightNuXSecNC.h"
+#include "RwCalculators/GReWeightXSecEmpiricalMEC.h"
+#include "RwCalculators/GReWeightPreflight.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::ostringstream;
+using std::ifstream;
+
+using namespace genie;
+using namespace genie::rew;
+
+// A single reweighting setup, as read from the configuration file
+struct RwConfig {
+  string              Name;        ///< block name
+  string              OutFilename; ///< output weights file
+  vector<GSyst_t>     Syst;        ///< params to scan (one at a time)
+  int                 NTwk;        ///< # of tweak dial values
+  double              MinTwk;      ///< minimum tweak dial value
+  double              MaxTwk;      ///< maximum tweak dial value
+  map<string, string> CalcModes;   ///< calculator name -> mode (user overrides)
+  map<GSyst_t, std::pair<double,double> > Uncertainties; ///< +/- fractional errors
+  string              Text;        ///< normalized block contents
+};
+
+// A reweighting setup, ready to run
+struct RwJob {
+  RwConfig         Config;
+  GReWeight *      ReWeight;
+  TFile *          OutFile;
+  vector<TTree *>  Trees;          ///< one per scanned systematic
+  vector<GReWeightIOWeightBranch *> WeightBranches; ///< weights branch of each tree
+  vector<GReWeightIOWeightStats *>  WeightStats;    ///< weights summary columns of each tree
+  TArrayF *        TwkDialArray;   ///< twkdials branch buffer
+  int              EventNum;
+};
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+void GetEventRange      (Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast);
+void ReadConfigurations (string fname, vector<RwConfig> & configs);
+void AdoptWeightCalcs   (GReWeight & rw);
+void SetCalcModes       (const RwConfig & config, GReWeight & rw);
+void SetCalcMode        (string calc, string mode, GReWeight & rw);
+void Preflight          (GReWeightPreflight & preflight, TTree * tree,
+                         Long64_t nfirst, Long64_t nlast, const vector<RwJob *> & jobs);
+
+string      gOptInpFilename; ///< name for input file (contains input event tree)
+string      gOptCfgFilename; ///< name for configuration file
+Long64_t    gOptNEvt1;       ///< range of events to process (1st input, if any)
+Long64_t    gOptNEvt2;       ///< range of events to process (2nd input, if any)
+int         gOptChunkSize;   ///< # of events held in memory at a time
+PDGCodeList gOptNu(false);   ///< neutrinos to consider
+long int    gOptRanSeed;     ///< random number seed
+GReWeightIOWeightCodec gOptWghtCodec(GReWeightIOWeightCodec::kStoreFloat); ///< weight storage
+string      gOptCompression; ///< output compression spec (algorithm[:level])
+int         gOptBasketSize;  ///< basket size for the weights tree branches
+Long64_t    gOptAutoFlush;   ///< # of entries per cluster in the weights tree
+GReWeightSelection gOptSelection; ///< events to reweight
+bool        gOptSkipRejected; ///< write no entry for events failing the selection?
+int         gOptPreflight;   ///< # of events for the stored cross section preflight (0: none)
+string      gOptTableCache;  ///< table cache file, if any
+string      gOptStartupTiming; ///< startup timing JSON file, if timing
+
+//___________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
+
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  if(gOptStartupTiming.size() > 0) timer->Enable();
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  timer->Lap("message thresholds");
+  utils::app_init::RandGen(gOptRanSeed);
+  GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
+  timer->Lap("random number generator");
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("grwghtmulti", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+  timer->Lap("build tune");
+
+  // Read the reweighting setups
+  vector<RwConfig> configs;
+  ReadConfigurations(gOptCfgFilename, configs);
+  timer->Lap("read configurations");
+
+  // Get the input event sample
+  TFile file(gOptInpFilename.c_str(),"READ");
+  TTree *           tree = dynamic_cast <TTree *>           ( file.Get("gtree")  );
+  NtpMCTreeHeader * thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
+  bool gst = false;
+  if(!tree) {
+    tree = dynamic_cast <TTree *> ( file.Get("gst") );
+    gst  = GReWeightIOGstReader::IsGstTree(tree);
+    if(!gst) tree = 0;
+  }
+  if(!tree){
+    LOG("grwghtmulti", pFATAL)
+      << "Can't find a GHEP or gst tree in input file: "<< file.GetName();
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  if(thdr) {
+    LOG("grwghtmulti", pNOTICE) << "Input tree header: " << *thdr;
+  }
+
+  Long64_t nev_in_file = tree->GetEntries();
+  Long64_t nfirst = 0;
+  Long64_t nlast  = 0;
+  GetEventRange(nev_in_file, nfirst, nlast);
+  Long64_t nev = (nlast - nfirst + 1);
+  timer->Lap("open input");
+
+  // Load the derived calculator tables from the cache, if one is used
+  if(gOptTableCache.size() > 0) {
+    GReWeightTableCache::Instance()->Open(gOptTableCache);
+  }
+  timer->Lap("table cache");
+
+  //
+  // Build an independent GReWeight for each configuration block
+  //
+
+  vector<RwJob *> jobs;
+  for(unsigned int ic = 0; ic < configs.size(); ic++) {
+
+    RwJob * jobptr = new RwJob;
+    RwJob & job = *jobptr;
+    job.Config   = configs[ic];
+    job.ReWeight = new GReWeight;
+    job.EventNum = 0;
+
+    GReWeight & rw = *job.ReWeight;
+    AdoptWeightCalcs(rw);
+    SetCalcModes(job.Config, rw);
+
+    // Uncertainties seen only by this setup
+    map<GSyst_t, std::pair<double,double> >::const_iterator uit =
+         job.Config.Uncertainties.begin();
+    for( ; uit != job.Config.Uncertainties.end(); ++uit) {
+      rw.Uncertainties().SetUncertainty(
+         uit->first, uit->second.first, uit->second.second);
+    }
+
+    GSystSet & syst = rw.Systematics();
+    for(unsigned int is = 0; is < job.Config.Syst.size(); is++) {
+      syst.Init(job.Config.Syst[is]);
+    }
+
+    // Output file with a tree per scanned param (grwght1scan layout)
+    job.OutFile      = new TFile(job.Config.OutFilename.c_str(), "RECREATE");
+    if(gOptCompression.size() > 0) {
+      if(!utils::rew::SetCompression(job.OutFile, gOptCompression)) {
+        LOG("grwghtmulti", pFATAL) << "Can't set the output compression: " << gOptCompression;
+        gAbortingInErr = true;
+        exit(1);
+      }
+    }
+    job.TwkDialArray = new TArrayF(job.Config.NTwk);
+    for(unsigned int is = 0; is < job.Config.Syst.size(); is++) {
+      job.OutFile->cd();
+      TTree * wght_tree = new TTree(
+          GSyst::AsString(job.Config.Syst[is]).c_str(), "GENIE weights tree");
+      wght_tree->Branch("eventnum", &job.EventNum);
+      job.WeightBranches.push_back(new GReWeightIOWeightBranch(
+          wght_tree, "weights", job.Config.NTwk, gOptWghtCodec));
+      wght_tree->Branch("twkdials", &job.TwkDialArray);
+      job.WeightStats.push_back(new GReWeightIOWeightStats(wght_tree, "weights"));
+      utils::rew::TuneWeightTree(wght_tree,
+          sizeof(int) + 5*sizeof(float) + job.Config.NTwk*(gOptWghtCodec.BytesPerWeight() + sizeof(float)),
+          gOptBasketSize, gOptAutoFlush);
+      job.Trees.push_back(wght_tree);
+    }
+    jobs.push_back(jobptr);
+    timer->Lap("[" + job.Config.Name + "] systematics & output");
+  }
+
+  //
+  // Summarize
+  //
+
+  ostringstream summary;
+  for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+    const RwConfig & cfg = jobs[ij]->Config;
+    summary << "\n - [" << cfg.Name << "] : " << cfg.Syst.size()
+            << " params x " << cfg.NTwk << " tweak dial values in ["
+            << cfg.MinTwk << ", " << cfg.MaxTwk << "] -> " << cfg.OutFilename;
+  }
+  LOG("grwghtmulti", pNOTICE)
+    << "\n"
+    << "\n** grwghtmulti: Will start processing events promptly."
+    << "\nHere is a summary of inputs: "
+    << "\n - Input event file: " << gOptInpFilename
+    << "\n - Processing: " << nev << " events in the range [" << nfirst << ", " << nlast << "]"
+    << "\n - Events held in memory at a time: " << gOptChunkSize
+    << "\n - Neutrino species to reweight : " << gOptNu
+    << "\n - Specified random number seed : " << gOptRanSeed
+    << "\n - Event selection : " << (gOptSelection.IsSet() ? gOptSelection.Expression() : "none")
+    << "\n - Configurations: " << summary.str()
+    << "\n\n";
+
+  // Decide where the stored differential cross sections can be used.
+  // All configurations share the tune, hence the default models: the
+  // checks are done once and their outcome applied to every GReWeight.
+  GReWeightPreflight preflight;
+  if(gOptPreflight > 0 && !gst) {
+    Preflight(preflight, tree, nfirst, nlast, jobs);
+    timer->Lap("preflight");
+  }
+
+  //
+  // Event loop, one chunk at a time. Each chunk is decoded once and
+  // passed through all configurations.
+  //
+
+  GReWeightIOEventBuffer buffer(tree, gOptChunkSize);
+
+  // Make sure all scanned params can be reweighted from a gst tree
+  if(buffer.GstReader()) {
+    bool ok = true;
+    for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+      const RwConfig & cfg = jobs[ij]->Config;
+      for(unsigned int is = 0; is < cfg.Syst.size(); is++) {
+        string why;
+        if(buffer.GstReader()->CanReweight(cfg.Syst[is], why)) continue;
+        LOG("grwghtmulti", pFATAL)
+          << "[" << cfg.Name << "] " << GSyst::AsString(cfg.Syst[is])
+          << " can not be reweighted from a gst tree: " << why;
+        ok = false;
+      }
+    }
+    if(!ok) {
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  vector<double> weights;
+  vector<bool>  selected;
+  Long64_t      nsel = 0;
+
+  for(Long64_t ichunk = nfirst; ichunk <= nlast; ichunk += buffer.Capacity()) {
+
+    unsigned int nbuf = buffer.Fill(ichunk, nlast);
+    if(nbuf == 0) continue;
+    timer->Lap("read first chunk");
+
+    LOG("grwghtmulti", pNOTICE)
+       << "***** Currently at event number: "<< ichunk;
+
+    // Select once per chunk, for all configurations
+    selected.assign(nbuf, true);
+    for(unsigned int iev = 0; iev < nbuf; iev++) {
+      selected[iev] = gOptSelection.Select(buffer.Event(iev));
+      if(selected[iev]) nsel++;
+    }
+
+    for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+
+      RwJob &     job  = *jobs[ij];
+      GReWeight & rw   = *job.ReWeight;
+      GSystSet &  syst = rw.Systematics();
+
+      const int    n_points      = job.Config.NTwk;
+      const double twk_dial_step =
+         (job.Config.MaxTwk - job.Config.MinTwk) / (n_points-1);
+
+      weights.assign(nbuf * n_points, -99999.);
+
+      for(unsigned int is = 0; is < job.Config.Syst.size(); is++) {
+
+        GSyst_t s = job.Config.Syst[is];
+
+        // Twk dial loop
+        for(int ith_dial = 0; ith_dial < n_points; ith_dial++) {
+
+          double twk_dial = job.Config.MinTwk + ith_dial * twk_dial_step;
+          LOG("grwghtmulti", pINFO)
+            << "[" << job.Config.Name << "] Setting " << GSyst::AsString(s)
+            << " tweaking dial to: " << twk_dial;
+          syst.Set(s, twk_dial);
+          rw.Reconfigure();
+
+          for(unsigned int iev = 0; iev < nbuf; iev++) {
+            const EventRecord & event = buffer.Event(iev);
+
+            double wght = 1.;
+            int nupdg = event.Probe()->Pdg();
+            if( selected[iev] && gOptNu.ExistsInPDGCodeList(nupdg) ) {
+              wght = rw.CalcWeight(event);
+            }
+            weights[iev*n_points + ith_dial] = wght;
+          } // evt loop
+        } // twk_dial loop
+
+        // Restore nominal before moving to the next param
+        syst.Set(s, 0.);
+
+        // Store
+        for(unsigned int iev = 0; iev < nbuf; iev++) {
+          if(!selected[iev] && gOptSkipRejected) continue;
+          job.EventNum = buffer.Entry(iev);
+          for(int ith_dial = 0; ith_dial < n_points; ith_dial++) {
+            job.WeightBranches[is] -> Set   (ith_dial, weights[iev*n_points + ith_dial]);
+            job.TwkDialArray       -> AddAt (job.Config.MinTwk + ith_dial * twk_dial_step, ith_dial);
+          }
+          job.WeightStats[is]->Set(&weights[iev*n_points], n_points);
+          job.Trees[is]->Fill();
+        }
+      } // systematics
+    } // configurations
+
+    // Startup is over once the first chunk is done
+    if(timer->IsEnabled()) {
+      timer->Lap("rest of first chunk");
+      timer->Report(gOptStartupTiming);
+      timer->Disable();
+    }
+  } // chunks
+
+  buffer.Clear();
+
+  if(gOptSelection.IsSet()) {
+    LOG("grwghtmulti", pNOTICE)
+      << "Selected " << nsel << " of " << nev << " events ("
+      << (100.*nsel)/nev << "%) for reweighting";
+  }
+
+  //
+  // Save weights
+  //
+
+  for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+    RwJob & job = *jobs[ij];
+    job.OutFile->cd();
+    for(unsigned int it = 0; it < job.Trees.size(); it++) {
+      job.Trees[it]->Write();
+      delete job.WeightBranches[it];
+      delete job.WeightStats[it];
+    }
+    gOptWghtCodec.Write("weight_codec");
+
+    // Describe this job, so that outputs of jobs processing different
+    // event ranges can be validated & merged
+    ostringstream cfg;
+    cfg << "app: grwghtmulti\n"
+        << "[" << job.Config.Name << "]\n" << job.Config.Text
+        << "neutrinos:";
+    for(unsigned int i = 0; i < gOptNu.size(); i++) cfg << " " << gOptNu[i];
+    cfg << "\n"
+        << "storage: " << gOptWghtCodec.AsString() << "\n"
+        << "select: " << gOptSelection.Expression() << "\n"
+        << "rejected: " << (gOptSkipRejected ? "skip" : "unity") << "\n";
+    GReWeightIOShardManifest manifest;
+    manifest.SetApp        ("grwghtmulti");
+    manifest.SetInput      (&file, nev_in_file);
+    manifest.SetEventRange (nfirst, nlast);
+    manifest.SetConfig     (cfg.str());
+    manifest.SetSeed       (gOptRanSeed);
+    manifest.SetSparse     (gOptSelection.IsSet() && gOptSkipRejected);
+    for(unsigned int it = 0; it < job.Trees.size(); it++) {
+      manifest.AddTree(job.Trees[it]->GetName());
+    }
+    manifest.Write("shard_manifest");
+
+    job.OutFile->Close();
+    delete job.OutFile;
+    delete job.TwkDialArray;
+    delete job.ReWeight;
+    LOG("grwghtmulti", pNOTICE)
+      << "[" << job.Config.Name << "] Weights saved in " << job.Config.OutFilename;
+    delete jobs[ij];
+  }
+  jobs.clear();
+
+  // Store any derived calculator tables built in this job
+  GReWeightTableCache::Instance()->Save();
+
+  // Close event file
+  file.Close();
+
+  LOG("grwghtmulti", pNOTICE)  << "Done!";
+
+  return 0;
+}
+//___________________________________________________________________
+void ReadConfigurations(string fname, vector<RwConfig> & configs)
+{
+  configs.clear();
+
+  ifstream cfg_stream(fname.c_str());
+  if(!cfg_stream.good()) {
+    LOG("grwghtmulti", pFATAL) << "Can't read configuration file: " << fname;
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  RwConfig * current = 0;
+  string line;
+  int iline = 0;
+  while(std::getline(cfg_stream, line)) {
+    iline++;
+    line = utils::str::TrimSpaces(line);
+    if(line.size() == 0 || line[0] == '#') continue;
+
+    // new configuration block
+    if(line[0] == '[') {
+      if(line[line.size()-1] != ']') {
+        LOG("grwghtmulti", pFATAL)
+          << fname << ":" << iline << ": Malformed block name: " << line;
+        gAbortingInErr = true;
+        exit(1);
+      }
+      RwConfig cfg;
+      cfg.Name   = utils::str::TrimSpaces(line.substr(1, line.size()-2));
+      cfg.NTwk   = 0;
+      cfg.MinTwk = -1.;
+      cfg.MaxTwk = +1.;
+      configs.push_back(cfg);
+      current = &configs.back();
+      continue;
+    }
+
+    string::size_type ieq = line.find("=");
+    if(!current || ieq == string::npos) {
+      LOG("grwghtmulti", pFATAL)
+        << fname << ":" << iline << ": Expected `key = value' in a [block]: " << line;
+      gAbortingInErr = true;
+      exit(1);
+    }
+    string key   = utils::str::TrimSpaces(line.substr(0, ieq));
+    string value = utils::str::TrimSpaces(line.substr(ieq+1));
+    current->Text += key + " = " + value + "\n";
+
+    if(key == "output") {
+      current->OutFilename = value;
+    }
+    else if(key == "syst") {
+      GSyst_t s = GSyst::FromString(value);
+      if(s == kNullSystematic) {
+        LOG("grwghtmulti", pFATAL)
+          << fname << ":" << iline << ": Unknown systematic: " << value;
+        gAbortingInErr = true;
+        exit(1);
+      }
+      current->Syst.push_back(s);
+    }
+    else if(key == "ntwk") {
+      current->NTwk = atoi(value.c_str());
+    }
+    else if(key == "min-tweak") {
+      current->MinTwk = atof(value.c_str());
+    }
+    else if(key == "max-tweak") {
+      current->MaxTwk = atof(value.c_str());
+    }
+    else if(key == "calc-mode") {
+      vector<string> cm = utils::str::Split(value, ":");
+      if(cm.size() != 2) {
+        LOG("grwghtmulti", pFATAL)
+          << fname << ":" << iline << ": Expected calculator:mode, got: " << value;
+        gAbortingInErr = true;
+        exit(1);
+      }
+      current->CalcModes[utils::str::TrimSpaces(cm[0])] = utils::str::TrimSpaces(cm[1]);
+    }
+    else if(key == "uncertainty") {
+      vector<string> su = utils::str::Split(value, ":");
+      GSyst_t s = (su.size()==2) ? GSyst::FromString(utils::str::TrimSpaces(su[0])) : kNullSystematic;
+      vector<string> errs;
+      if(su.size()==2) errs = utils::str::Split(su[1], ",");
+      if(s == kNullSystematic || errs.size() < 1 || errs.size() > 2) {
+        LOG("grwghtmulti", pFATAL)
+          << fname << ":" << iline << ": Expected syst:plus_err[,minus_err], got: " << value;
+        gAbortingInErr = true;
+        exit(1);
+      }
+      double plus_err  = atof(errs[0].c_str());
+      double minus_err = (errs.size()==2) ? atof(errs[1].c_str()) : plus_err;
+      current->Uncertainties[s] = std::make_pair(plus_err, minus_err);
+    }
+    else {
+      LOG("grwghtmulti", pFATAL)
+        << fname << ":" << iline << ": Unknown key: " << key;
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  if(configs.size() == 0) {
+    LOG("grwghtmulti", pFATAL) << "No configuration blocks found in: " << fname;
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  // Validate and fill-in defaults
+  for(unsigned int ic = 0; ic < configs.size(); ic++) {
+    RwConfig & cfg = configs[ic];
+    if(cfg.Syst.size() == 0) {
+      LOG("grwghtmulti", pFATAL)
+        << "[" << cfg.Name << "] No systematic params to scan";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    if(cfg.NTwk % 2 == 0) cfg.NTwk += 1;
+    if(cfg.NTwk < 3) {
+      LOG("grwghtmulti", pFATAL)
+        << "[" << cfg.Name << "] Specified number of tweak dial is too low, min value is 3";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    if(cfg.OutFilename.size() == 0) {
+      cfg.OutFilename = "weights_" + cfg.Name + ".root";
+    }
+    for(unsigned int jc = 0; jc < ic; jc++) {
+      if(configs[jc].OutFilename == cfg.OutFilename) {
+        LOG("grwghtmulti", pFATAL)
+          << "[" << cfg.Name << "] and [" << configs[jc].Name
+          << "] write to the same output file: " << cfg.OutFilename;
+        gAbortingInErr = true;
+        exit(1);
+      }
+    }
+  }
+}
+//___________________________________________________________________
+void Preflight(
+   GReWeightPreflight & preflight, TTree * tree,
+   Long64_t nfirst, Long64_t nlast, const vector<RwJob *> & jobs)
+{
+  //
+  // Checks the stored differential cross sections of up to gOptPreflight
+  // events, evenly spread over the event range (skipping those failing
+  // the selection), and sets the per-process choice of stored or
+  // recomputed values of the weight calculators of all configurations
+  //
+  if(jobs.empty()) return;
+
+  NtpMCEventRecord * mcrec = 0;
+  tree->SetBranchAddress("gmcrec", &mcrec);
+
+  Long64_t step = TMath::Max(1LL, (nlast - nfirst + 1) / gOptPreflight);
+  for(Long64_t iev = nfirst; iev <= nlast; iev += step) {
+    tree->GetEntry(iev);
+    if(mcrec->event && gOptSelection.Select(*mcrec->event)) {
+      preflight.Check(*jobs[0]->ReWeight, *mcrec->event);
+    }
+    mcrec->Clear();
+  }
+
+  // the event buffer reads the tree with its own record
+  tree->ResetBranchAddresses();
+  delete mcrec;
+
+  for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+    preflight.Apply(*jobs[ij]->ReWeight);
+  }
+  preflight.Print();
+}
+//___________________________________________________________________
+void AdoptWeightCalcs(GReWeight & rw)
+{
+  rw.AdoptWghtCalc( "xsec_ncel",       new GReWeightNuXSecNCEL      );
+  rw.AdoptWghtCalc( "xsec_ccqe",       new GReWeightNuXSecCCQE      );
+  rw.AdoptWghtCalc( "xsec_ccqe_axial", new GReWeightNuXSecCCQEaxial );
+  rw.AdoptWghtCalc( "xsec_ccqe_vec",   new GReWeightNuXSecCCQEvec   );
+  rw.AdoptWghtCalc( "xsec_ccres",      new GReWeightNuXSecCCRES     );
+  rw.AdoptWghtCalc( "xsec_ncres",      new GReWeightNuXSecNCRES     );
+  rw.AdoptWghtCalc( "xsec_nonresbkg",  new GReWeightNonResonanceBkg );
+  rw.AdoptWghtCalc( "xsec_coh",        new GReWeightNuXSecCOH       );
+  rw.AdoptWghtCalc( "xsec_dis",        new GReWeightNuXSecDIS       );
+  rw.AdoptWghtCalc( "nuclear_qe",      new GReWeightFGM             );
+  rw.AdoptWghtCalc( "nuclear_dis",     new GReWeightDISNuclMod      );
+  rw.AdoptWghtCalc( "hadro_res_decay", new GReWeightResonanceDecay  );
+  rw.AdoptWghtCalc( "hadro_fzone",     new GReWeightFZone           );
+  rw.AdoptWghtCalc( "hadro_intranuke", new GReWeightINuke           );
+  rw.AdoptWghtCalc( "hadro_agky",      new GReWeightAGKY            );
+  rw.AdoptWghtCalc( "xsec_nc",         new GReWeightNuXSecNC        );
+  rw.AdoptWghtCalc( "xsec_empmec",     new GReWeightXSecEmpiricalMEC);
+}
+//___________________________________________________________________
+void SetCalcModes(const RwConfig & config, GReWeight & rw)
+{
+  // Modes implied by the scanned params (as in grwght1scan)
+  map<string, string> modes;
+  for(unsigned int is = 0; is < config.Syst.size(); is++) {
+    GSyst_t s = config.Syst[is];
+    string calc = "";
+    string mode = "";
+    if ( s == kXSecTwkDial_MaCCQE ) {
+      calc = "xsec_ccqe";  mode = "Ma";
+    }
+    else if ( s == kXSecTwkDial_MaCCRES || s == kXSecTwkDial_MvCCRES ) {
+      calc = "xsec_ccres"; mode = "MaMv";
+    }
+    else if ( s == kXSecTwkDial_MaNCRES || s == kXSecTwkDial_MvNCRES ) {
+      calc = "xsec_ncres"; mode = "MaMv";
+    }
+    else if ( s == kXSecTwkDial_AhtBYshape  || s == kXSecTwkDial_BhtBYshape  ||
+              s == kXSecTwkDial_CV1uBYshape || s == kXSecTwkDial_CV2uBYshape ) {
+      calc = "xsec_dis";   mode = "ABCV12uShape";
+    }
+    if(calc.size() == 0) continue;
+    if(modes.count(calc) && modes[calc] != mode) {
+      LOG("grwghtmulti", pFATAL)
+        << "[" << config.Name << "] Scanned params need conflicting "
+        << calc << " modes (" << modes[calc] << ", " << mode << ")";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    modes[calc] = mode;
+  }
+
+  // User overrides
+  map<string, string>::const_iterator it = config.CalcModes.begin();
+  for( ; it != config.CalcModes.end(); ++it) {
+    modes[it->first] = it->second;
+  }
+
+  for(it = modes.begin(); it != modes.end(); ++it) {
+    LOG("grwghtmulti", pNOTICE)
+      << "[" << config.Name << "] Setting " << it->first << " to mode " << it->second;
+    SetCalcMode(it->first, it->second, rw);
+  }
+}
+//___________________________________________________________________
+void SetCalcMode(string calc, string mode, GReWeight & rw)
+{
+  bool ok = false;
+
+  if(calc == "xsec_ccqe") {
+    GReWeightNuXSecCCQE * rwc =
+       dynamic_cast<GReWeightNuXSecCCQE *> (rw.WghtCalc(calc));
+    if     (mode == "Ma"            ) { rwc->SetMode(GReWeightNuXSecCCQE::kModeMa);             ok = true; }
+    else if(mode == "NormAndMaShape") { rwc->SetMode(GReWeightNuXSecCCQE::kModeNormAndMaShape); ok = true; }
+    else if(mode == "ZExp"          ) { rwc->SetMode(GReWeightNuXSecCCQE::kModeZExp);           ok = true; }
+  }
+  else if(calc == "xsec_ccres") {
+    GReWeightNuXSecCCRES * rwc =
+       dynamic_cast<GReWeightNuXSecCCRES *> (rw.WghtCalc(calc));
+    if     (mode == "MaMv"            ) { rwc->SetMode(GReWeightNuXSecCCRES::kModeMaMv);             ok = true; }
+    else if(mode == "NormAndMaMvShape") { rwc->SetMode(GReWeightNuXSecCCRES::kModeNormAndMaMvShape); ok = true; }
+  }
+  else if(calc == "xsec_ncres") {
+    GReWeightNuXSecNCRES * rwc =
+       dynamic_cast<GReWeightNuXSecNCRES *> (rw.WghtCalc(calc));
+    if     (mode == "MaMv"            ) { rwc->SetMode(GReWeightNuXSecNCRES::kModeMaMv);             ok = true; }
+    else if(mode == "NormAndMaMvShape") { rwc->SetMode(GReWeightNuXSecNCRES::kModeNormAndMaMvShape); ok = true; }
+  }
+  else if(calc == "xsec_dis") {
+    GReWeightNuXSecDIS * rwc =
+       dynamic_cast<GReWeightNuXSecDIS *> (rw.WghtCalc(calc));
+    if     (mode == "ABCV12u"     ) { rwc->SetMode(GReWeightNuXSecDIS::kModeABCV12u);      ok = true; }
+    else if(mode == "ABCV12uShape") { rwc->SetMode(GReWeightNuXSecDIS::kModeABCV12uShape); ok = true; }
+  }
+
+  if(!ok) {
+    LOG("grwghtmulti", pFATAL)
+      << "Unsupported calculator mode: " << calc << ":" << mode;
+    gAbortingInErr = true;
+    exit(1);
+  }
+}
+//___________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("grwghtmulti", pINFO) << "*** Parsing command line arguments";
+
+  // Common run options. Set defaults and read.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  // get GENIE event sample
+  if(parser.OptionExists('f')) {
+    LOG("grwghtmulti", pINFO) << "Reading event sample filename";
+    gOptInpFilename = parser.ArgAsString('f');
+  } else {
+    LOG("grwghtmulti", pFATAL)
+        << "Unspecified input filename - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // get configuration file
+  if(parser.OptionExists('c')) {
+    LOG("grwghtmulti", pINFO) << "Reading configuration filename";
+    gOptCfgFilename = parser.ArgAsString('c');
+  } else {
+    LOG("grwghtmulti", pFATAL)
+        << "Unspecified configuration filename - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // range of event numbers to process
+  if ( parser.OptionExists('n') ) {
+    //
+    LOG("grwghtmulti", pINFO) << "Reading number of events to analyze";
+    string nev =  parser.ArgAsString('n');
+    if (nev.find(",") != string::npos) {
+      vector<long> vecn = parser.ArgAsLongTokens('n',",");
+      if(vecn.size()!=2) {
+         LOG("grwghtmulti", pFATAL) << "Invalid syntax";
+         gAbortingInErr = true;
+         PrintSyntax();
+         exit(1);
+      }
+      // User specified a comma-separated set of values n1,n2.
+      // Use [n1,n2] as the event range to process.
+      gOptNEvt1 = vecn[0];
+      gOptNEvt2 = vecn[1];
+    } else {
+      // User specified a single number n.
+      // Use [0,n] as the event range to process.
+      gOptNEvt1 = -1;
+      gOptNEvt2 = parser.ArgAsLong('n');
+    }
+  } else {
+    LOG("grwghtmulti", pINFO)
+      << "Unspecified number of events to analyze - Use all";
+    gOptNEvt1 = -1;
+    gOptNEvt2 = -1;
+  }
+  LOG("grwghtmulti", pDEBUG)
+    << "Input event range: " << gOptNEvt1 << ", " << gOptNEvt2;
+
+  // which species to reweight?
+  if(parser.OptionExists('p')) {
+   LOG("grwghtmulti", pINFO)
+      << "Reading input list of neutrino codes";
+   vector<int> vecpdg = parser.ArgAsIntTokens('p',",");
+   if(vecpdg.size()==0) {
+      LOG("grwghtmulti", pFATAL)
+         << "Empty list of neutrino codes!?";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+   }
+   vector<int>::const_iterator it = vecpdg.begin();
+   for( ; it!=vecpdg.end(); ++it) {
+     gOptNu.push_back(*it);
+   }
+  } else {
+    LOG("grwghtmulti", pINFO)
+       << "Considering all neutrino species";
+    gOptNu.push_back (kPdgNuE      );
+    gOptNu.push_back (kPdgAntiNuE  );
+    gOptNu.push_back (kPdgNuMu     );
+    gOptNu.push_back (kPdgAntiNuMu );
+    gOptNu.push_back (kPdgNuTau    );
+    gOptNu.push_back (kPdgAntiNuTau);
+  }
+
+  // chunk size
+  if( parser.OptionExists("chunk-size") ) {
+    LOG("grwghtmulti", pINFO) << "Reading chunk size";
+    gOptChunkSize = parser.ArgAsInt("chunk-size");
+    if(gOptChunkSize < 1) {
+      LOG("grwghtmulti", pFATAL) << "Chunk size must be positive - Exiting";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  } else {
+    gOptChunkSize = 1000;
+  }
+
+  // random number seed
+  if( parser.OptionExists("seed") ) {
+    LOG("grwghtmulti", pINFO) << "Reading random number seed";
+    gOptRanSeed = parser.ArgAsLong("seed");
+  } else {
+    LOG("grwghtmulti", pINFO) << "Unspecified random number seed - Using default";
+    gOptRanSeed = -1;
+  }
+
+  // table cache
+  gOptTableCache = "";
+  if( parser.OptionExists("table-cache") ) {
+    gOptTableCache = parser.ArgAsString("table-cache");
+  }
+
+  // startup timing
+  gOptStartupTiming = "";
+  if( parser.OptionExists("startup-timing") ) {
+    gOptStartupTiming = parser.ArgAsString("startup-timing");
+  }
+
+  // weight storage
+  if( parser.OptionExists("weight-storage") ) {
+    LOG("grwghtmulti", pINFO) << "Reading weight storage type";
+    string storage_name = parser.ArgAsString("weight-storage");
+    GReWeightIOWeightCodec::WeightStorage_t storage;
+    if(!GReWeightIOWeightCodec::FromString(storage_name, storage)) {
+      LOG("grwghtmulti", pFATAL) << "Unknown weight storage type: " << storage_name;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec = GReWeightIOWeightCodec(storage);
+  }
+  if( parser.OptionExists("log-weight-range") ) {
+    vector<double> range = parser.ArgAsDoubleTokens("log-weight-range",",");
+    if(gOptWghtCodec.Storage() != GReWeightIOWeightCodec::kStoreLog16 ||
+       range.size() != 2 || range[1] <= range[0]) {
+      LOG("grwghtmulti", pFATAL)
+        << "--log-weight-range needs --weight-storage log16 and lnw_min < lnw_max";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec.SetLogRange(range[0], range[1]);
+  }
+
+  // output compression & layout
+  gOptCompression = "";
+  if( parser.OptionExists("compression") ) {
+    gOptCompression = parser.ArgAsString("compression");
+    int settings = 0;
+    if(!utils::rew::CompressionSettings(gOptCompression, settings)) {
+      LOG("grwghtmulti", pFATAL) << "Invalid --compression: " << gOptCompression;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  gOptBasketSize = 0;
+  if( parser.OptionExists("basket-size") ) {
+    gOptBasketSize = parser.ArgAsInt("basket-size");
+  }
+  gOptAutoFlush = 0;
+  if( parser.OptionExists("auto-flush") ) {
+    gOptAutoFlush = parser.ArgAsLong("auto-flush");
+  }
+
+  // event selection
+  if( parser.OptionExists("select") ) {
+    LOG("grwghtmulti", pINFO) << "Reading event selection";
+    string error;
+    if(!gOptSelection.Compile(parser.ArgAsString("select"), error)) {
+      LOG("grwghtmulti", pFATAL) << "Invalid --select expression: " << error;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  gOptSkipRejected = false;
+  if( parser.OptionExists("rejected") ) {
+    string rejected = parser.ArgAsString("rejected");
+    if(rejected != "skip" && rejected != "unity") {
+      LOG("grwghtmulti", pFATAL) << "--rejected must be skip or unity, not: " << rejected;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptSkipRejected = (rejected == "skip");
+  }
+
+  // stored cross section preflight
+  gOptPreflight = 1000;
+  if( parser.OptionExists("preflight") ) {
+    gOptPreflight = parser.ArgAsInt("preflight");
+  }
+  if(gOptPreflight < 0) {
+    LOG("grwghtmulti", pFATAL) << "--preflight can not be negative";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+}
+//_________________________________________________________________________________
+void GetEventRange(Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast)
+{
+  nfirst = 0;
+  nlast  = 0;
+
+  if(gOptNEvt1>=0 && gOptNEvt2>=0) {
+    // Input was `-n N1,N2'.
+    // Process events [N1,N2].
+    // Note: Incuding N1 and N2.
+    nfirst = gOptNEvt1;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2>=0) {
+    // Input was `-n N'.
+    // Process first N events [0,N).
+    // Note: Event N is not included.
+    nfirst = 0;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2-1);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2<0) {
+    // No input. Process all events.
+    nfirst = 0;
+    nlast  = nev_in_file-1;
+  }
+
+  assert(nfirst <= nlast && nfirst >= 0 && nlast <= nev_in_file-1);
+}
+//_________________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("grwghtmulti", pFATAL)
+     << "\n\n"
+     << "grwghtmulti                  \n"
+     << "     -f input_event_file     \n"
+     << "     -c configuration_file   \n"
+     << "    [-n n1[,n2]]             \n"
+     << "    [-p neutrino_codes]      \n"
+     << "    [--chunk-size n_events]  \n"
+     << "    [--select cut_expression] \n"
+     << "    [--rejected skip|unity]  \n"
+     << "    [--preflight n_events]   \n"
+     << "    [--seed random_number_seed] \n"
+     << "    [--table-cache file]     \n"
+     << "    [--startup-timing json_file] \n"
+     << "    [--weight-storage type]  \n"
+     << "    [--log-weight-range lnw_min,lnw_max] \n"
+     << "    [--compression algorithm[:level]] \n"
+     << "    [--basket-size bytes]    \n"
+     << "    [--auto-flush n_entries] \n"
+     << "    [--message-thresholds xml_file]\n"
+     << "    [--event-record-print-level level]\n\n\n"
+     << " See the GENIE Physics and User manual for more details";
+}
+//_________________________________________________________________________________
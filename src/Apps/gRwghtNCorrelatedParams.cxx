@@ -11,23 +11,67 @@
          It outputs a ROOT file containing a tree with an entry for every
          input event. Each such tree entry contains a TArrayD of all computed
          weights and TArrayD for each requested systematic of all of the
-         corresponding randomly generated tweak dial values.
+         corresponding randomly generated tweak dial values, as well as
+         summaries of the weights over the throws (weights_min, weights_max,
+         weights_mean, weights_rms and weights_fnonpos, the fraction of
+         throws with weight <= 0), for outlier checks without reading the
+         weight arrays.
+         Alternatively (--histograms), it outputs only weighted histograms
+         of event summary quantities for each parameter throw.
+         Instead of random throws, the tweak dial values can be read from
+         a chain of posterior samples (--chain).
 
 \syntax  grwghtnp \
            -f input_event_file
            -c input_covariance_file
            -s systematic1[,systematic2[,...]]
            -v central_value1[,central_value2[,...]]
-           -t n_twk_dial_values
+           -t n_twk_dial_values | --chain chain_file
+          [--chain-expand]
           [-n n1[,n2]]
           [-r run_key]
           [-o output_weights_file]
+          [--select cut_expression]
+          [--rejected skip|unity]
+          [--preflight n_events]
+          [--histograms spec1[;spec2[;...]]]
+          [--sensitivity n_events]
+          [--sensitivity-threshold threshold]
+          [--sensitivity-action warn|drop]
+          [--sensitivity-binning spec1[;spec2[;...]]]
+          [--adaptive tolerance]
+          [--adaptive-block n_throws]
+          [--adaptive-binning spec1[;spec2[;...]]]
+          [--antithetic]
+          [--response-surface calc[:degree[:levels]][,...]]
+          [--surface-tolerance tolerance]
+          [--seed random_number_seed]
+          [--table-cache file]
+          [--startup-timing json_file]
+          [--trace json_file]
+          [--trace-sample n]
+          [--block-memory MB]
+          [--block-events n_events]
+          [--block-throws n_throws]
+          [--threads n_threads]
+          [--weight-storage type]
+          [--log-weight-range lnw_min,lnw_max]
+          [--compression algorithm[:level]]
+          [--basket-size bytes]
+          [--auto-flush n_entries]
 
          where
          [] is an optional argument.
 
          -f
-            Specifies a GHEP input file.
+            Specifies an input file with a GHEP event tree or, if it has
+            none, a flat `gst' summary tree (as written by gntpc -f gst).
+            Systematics which can not be reweighted from the gst format
+            are rejected at startup. If all weight calculators of the
+            systematics (but those with --response-surface) handle compact
+            event views (eg the hadron fate ones), each buffered event is
+            decoded once into a view, reweighted for all throws from it.
+            GHEP events are still read as full event records.
          -c
             Specifies a binary ROOT file which contains the covariance matrix
             as a TMatrixD object.
@@ -42,6 +86,26 @@
          -t
             Number of random drawings of tweak values between -1 and 1.
             Values for tweaks respect the covariance of systematics
+         --chain
+            Instead of -t random throws, reweights for the tweak dial values
+            (in units of the one-sigma errors set by -c) of the samples of
+            a chain, eg the Markov chain of a fit posterior, read from a
+            text file: one sample per line, the dial values separated by
+            spaces, tabs or commas, in the order of -s. A first line naming
+            the columns (eg `MaCCQE MaCCRES logL') maps the columns to the
+            systematics instead, and other columns are then ignored. Lines
+            starting with `#' are skipped.
+            Repeated states are reweighted once: the throws are the distinct
+            states, in the order of their first appearance, and the output
+            file contains a TVectorD `multiplicity' with the number of chain
+            samples in each state, by which its weights are to be counted.
+            Not compatible with --antithetic, --adaptive and
+            --sensitivity-action drop.
+         --chain-expand
+            Writes the weights (and tweak dial values) of every chain
+            sample, in chain order, instead of those of the distinct states
+            and their multiplicities. Each state is still reweighted once.
+            Ignored with --histograms.
          -n
             Specifies an event range.
             Examples:
@@ -55,6 +119,181 @@
             Specifies an integer run key.
             Changes temporary file names so that multiple instances can run
             without overwriting each other's temporary tree files
+         --select
+            A cut expression selecting the events to reweight, evaluated on
+            cheap event summary quantities before any weight calculator runs.
+            Quantities: probe, cc, nc, em, qel, res, dis, coh, mec, dfr, charm,
+            Ev, Q2, W, x, y, target, A, Z, hitnuc, fsl, Elep and the final
+            state multiplicities np, nn, npip, npim, npi0, nKp, nKm, nK0,
+            ngamma. Operators: abs(), ! - * / + - < <= > >= == != && ||.
+            Example: --select "cc && abs(probe)==14 && Ev<10 && A==12"
+            By default all events are reweighted.
+         --rejected
+            What to write for events failing the --select expression:
+            `unity' (default) writes an entry with all weights set to 1,
+            `skip' writes no entry at all (the `eventnum' branch then
+            identifies the reweighted events).
+            Rejected events are never filled with --histograms.
+         --preflight
+            Before reweighting, compares the differential cross sections
+            stored with the events against those of each cross section
+            weight calculator's default model, for (selected) events spread
+            over the event range: up to 20 events for each calculator and
+            process (scattering & interaction type, target). Calculators
+            use the stored values (fast) for the processes where all agree,
+            and recompute them for the others; the decisions are reported
+            in the log. 0 disables the check, in which case the stored
+            values are always used and only checked for the first events.
+            Ignored for gst input. Default: 1000
+         --histograms
+            Histogram-only mode: rather than a weight per event & throw,
+            accumulates in memory, for each throw, weighted histograms of
+            the specified quantities and writes only those. Each histogram
+            is specified as [name=]expression:nbins,min,max, where
+            expression uses the --select quantities and operators.
+            Example: --histograms "Ev:50,0,10; q2=Q2:40,0,4; Ev-Elep:50,0,5"
+            For each histogram, the output file contains a TH2D `name'
+            (x: the quantity, y: the throw, with sum-of-squared-weight
+            errors) and a TH1D `name_nominal' (unit weights), and, for all
+            of them, a TH1D `sumw' (sum of weights & squared weights per
+            throw), the TMatrixD of throws `throws' (throw x parameter) and
+            a TNamed `params' listing the parameters. Outputs of jobs using
+            the same seed on different event ranges can be added with hadd.
+            The weight storage & tree layout options are ignored.
+         --sensitivity
+            Runs a pre-pass over a random subsample of the specified number
+            of (selected) events, which measures the effect of each
+            systematic, on its own at -1 and +1 sigma, on the total weight
+            (rate) and on the weighted distributions of the binning below
+            (the sum of the absolute changes of all bins, relative to the
+            number of events; never smaller than the rate effect).
+            It reports both, the fraction of events whose weight changes
+            and the weight calculation time per event, for each systematic.
+         --sensitivity-threshold
+            Systematics whose binned effect is below this value are
+            negligible for the input sample. Default: 1E-3
+         --sensitivity-action
+            What to do with negligible systematics: `warn' (default) only
+            reports them, `drop' removes them (and their rows & columns of
+            the covariance matrix) before the parameter throws are made.
+         --sensitivity-binning
+            Binning for the binned effect, with the --histograms syntax.
+            Default: the --histograms specification if given, otherwise
+            "Ev:20,0,10; Q2:20,0,4".
+         --adaptive
+            Makes -t the maximum number of throws: throws are processed in
+            blocks and, after each block, the covariance (over the throws
+            so far) of the weighted distributions of the binning below is
+            compared with the one after the previous block. Processing
+            stops once the relative change (Frobenius norm of the change
+            over that of the covariance) is below the given tolerance.
+            Only the throws processed are written. Shards of a job can
+            stop after different numbers of throws and can then not be
+            merged, so keep -t fixed for sharded production.
+         --adaptive-block
+            Number of throws per block in --adaptive mode. Default: 50
+         --adaptive-binning
+            Binning for the --adaptive convergence test, with the
+            --histograms syntax. Default: the --histograms specification
+            if given, otherwise "Ev:20,0,10; Q2:20,0,4".
+         --antithetic
+            Makes throws in antithetic pairs: every second throw is minus
+            the previous one, which cancels the odd-order fluctuations of
+            the throw-averaged predictions. -t (and --adaptive-block) must
+            then be even.
+         --response-surface
+            Weight calculators (by name, eg xsec_ccres, hadro_intranuke,
+            xsec_empmec) whose weights are synthesized, rather than
+            recomputed for each throw, from a per-event polynomial in all
+            of the calculator's dials, cross terms included. The
+            polynomial (default degree: 2) is fitted to the calculator's
+            weights on a grid of training points (default: degree+2
+            levels per dial) spanning the range of the throws, so that
+            the calculator runs once per training point instead of once
+            per throw. The fit error of each event is estimated (RMS of
+            the leave-one-out residuals) and events whose error exceeds
+            --surface-tolerance are recomputed for each throw instead.
+            Training is done in event chunks whose weights at all training
+            points fit in 256 MB (each event read once per point and
+            chunk); the fitted coefficients of all events are kept, ie
+            n_events x n_terms doubles per calculator.
+         --surface-tolerance
+            Largest acceptable fit error of a synthesized weight.
+            Default: 1E-3
+         --seed
+            Random number seed for the parameter throws.
+            All throws are made before any event is reweighted, so jobs
+            processing different event ranges with the same seed use
+            identical throws and their outputs can be merged (grwghtmerge).
+            The output file contains a GReWeightIOShardManifest object named
+            `shard_manifest' recording the input file identity, the event
+            range, a hash of the configuration and the seed.
+         --table-cache
+            A ROOT file caching the tables weight calculators derive at
+            startup or on first use (resonance branching ratios vs W,
+            nucleon momentum distributions, pdf normalizations). Tables
+            found in the file are loaded instead of rebuilt; new ones are
+            added to it at the end of the job. The file is keyed by the
+            GENIE version and tune, and is rebuilt if they do not match.
+            By default no cache is used.
+         --startup-timing
+            Times the startup phases (input & covariance files, each weight
+            calculator's construction, first reconfiguration and first
+            weight calculation, ...) and reports the wall time and resident
+            memory change of each, as a table in the log and as JSON in
+            the specified file, once the first event is done.
+         --trace
+            Records timed spans (weight calculation, each calculator's
+            weight calculation & reconfiguration, cross section
+            evaluations & integrals, event reading) for a sample of events
+            and writes them as Chrome trace JSON in the specified file, to
+            be viewed with chrome://tracing or ui.perfetto.dev. The slowest
+            traced events are listed in the log.
+         --trace-sample
+            Traces every n-th event (by event number). Default: 100
+         --block-memory
+            Memory (MB) for a work block. The weights are computed in
+            blocks of (event range x throw range): the events of a block
+            are read & decoded once for all of its throws, and the weight
+            calculators are reconfigured for each throw once per event
+            range. The block shape minimizes the time spent decoding and
+            reconfiguring, as measured at startup, within this memory
+            (the whole sample, for all throws, if it fits).
+            Default: half of the free memory.
+         --block-events, --block-throws
+            Fix the number of events (entries) and of throws per block.
+            With --adaptive, throw blocks divide --adaptive-block unless
+            fixed.
+         --threads
+            Number of threads computing the weights. The events of each
+            work block are shared out among the threads, each with its own
+            weight calculators configured for every throw of the block,
+            within this process: the calculators' tables are built once and
+            shared. Random numbers used by the weight calculators (eg the
+            AGKY sampling) come from a stream per throw & event, seeded from
+            --seed, with any number of threads (1 included), so that the
+            weights depend neither on the number of threads nor on the work
+            blocks. Default: 1
+         --weight-storage
+            How weights are stored: double (default), float, log16 (16-bit
+            fixed-point ln(w), stored in a `weights_q' branch) or float16
+            (half-precision w-1, stored in a `weights_q' branch).
+            The output file contains a GReWeightIOWeightCodec object named
+            `weight_codec' which decodes the stored values and documents
+            their precision bound (1.2E-4 relative error for log16 with the
+            default ln(w) range, 2^-11 |w-1| for float16).
+         --log-weight-range
+            The ln(w) range covered by log16 storage. Default: -8,8.
+            Weights outside the range are clipped at its edges.
+         --compression
+            Output compression: zlib, lzma, lz4 or zstd, optionally followed
+            by :level (eg `zstd:5'). Default: the ROOT default.
+         --basket-size
+            Basket size (in bytes) for the weights tree branches.
+            Default: large enough to hold one cluster of entries.
+         --auto-flush
+            Number of entries per cluster, which should match the chunks in
+            which the weights are read back. Default: ~16 MB of weights.
 
 \author  Aaron Meyer <asmeyer2012 \at uchicago.edu>
          University of Chicago, Fermi National Accelerator Laboratory
@@ -67,13 +306,23 @@
 //____________________________________________________________________________
 
 
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
 #include <TArrayD.h>
 #include <TFile.h>
 #include <TKey.h>
 #include <TList.h>
 #include <TMath.h>
 #include <TMatrixD.h>
+#include <TNamed.h>
+#include <TRandom3.h>
+#include <TStopwatch.h>
+#include <TSystem.h>
 #include <TTree.h>
+#include <TVectorD.h>
 #include <TRandom.h>
 
 // GENIE/Generator includes
@@ -88,18 +337,38 @@
 #include "Framework/Utils/CmdLnArgParser.h"
 #include "Framework/Numerical/MathUtils.h"
 #include "Framework/Utils/StringUtils.h"
+#include "Framework/Utils/AppInit.h"
 
 // GENIE/Reweight includes
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
 #include "RwFramework/GReWeightI.h"
+#include "RwFramework/GReWeightEventView.h"
 #include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightSelection.h"
+#include "RwFramework/GReWeightEventSummary.h"
+#include "RwFramework/GReWeightBlockPlan.h"
+#include "RwFramework/GReWeightResponseSurface.h"
+#include "RwFramework/GReWeightServices.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+#include "RwFramework/GReWeightTracer.h"
+#include "RwIO/GReWeightIOWeightCodec.h"
+#include "RwIO/GReWeightIOUtils.h"
+#include "RwIO/GReWeightIOShardManifest.h"
+#include "RwIO/GReWeightIOChain.h"
+#include "RwIO/GReWeightIOEventBuffer.h"
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwIO/GReWeightIOUniverseHists.h"
+#include "RwIO/GReWeightIOWeightStats.h"
 #include "RwCalculators/GReWeightAGKY.h"
 #include "RwCalculators/GReWeightDISNuclMod.h"
 #include "RwCalculators/GReWeightFGM.h"
 #include "RwCalculators/GReWeightFZone.h"
+#include "RwCalculators/GReWeightHandle.h"
 #include "RwCalculators/GReWeightINuke.h"
 #include "RwCalculators/GReWeightNonResonanceBkg.h"
+#include "RwCalculators/GReWeightPreflight.h"
 #include "RwCalculators/GReWeightNuXSecCCQE.h"
 #include "RwCalculators/GReWeightNuXSecCCQEvec.h"
 #include "RwCalculators/GReWeightNuXSecCCRES.h"
@@ -107,6 +376,7 @@
 #include "RwCalculators/GReWeightNuXSecDIS.h"
 #include "RwCalculators/GReWeightNuXSecCOH.h"
 #include "RwCalculators/GReWeightResonanceDecay.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 using namespace genie;
 using namespace genie::constants;
@@ -118,8 +388,47 @@ void PrintSyntax();
 void GetEventRange       (Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast);
 void GetCommandLineArgs  (int argc, char ** argv);
 void GetCorrelationMatrix(string fname, TMatrixD *& cmat);
-void AdoptWeightCalcs    (vector<GSyst_t> lsyst, GReWeight & rw);
+string ConfigurationString(const TMatrixD & cmat);
 bool FindIncompatibleSystematics(vector<GSyst_t> lsyst);
+vector<GSyst_t> SensitivityPrePass(GReWeight & rw, TTree * tree, NtpMCEventRecord * mcrec,
+                    GReWeightIOGstReader * gst, const vector<bool> & selected, Long64_t nfirst);
+void Preflight(GReWeightPreflight & preflight, GReWeight & rw, TTree * tree,
+                    NtpMCEventRecord * mcrec, const vector<bool> & selected, Long64_t nfirst);
+
+// a calculator whose weights are synthesized from per-event response surfaces
+struct ResponseSurface_t {
+  string                   Calc;
+  int                      Degree;
+  int                      Levels;
+  vector<int>              Params;  ///< indices of the calculator's dials in gOptVSyst
+  GReWeightResponseSurface Surface;
+  vector<double>           Coef;    ///< [event][term]
+  vector<bool>             Exact;   ///< [event]: fit error over tolerance, recompute
+  vector<double>           X;       ///< dial values of the current throw
+  vector<double>           M;       ///< their monomials
+};
+bool ParseResponseSurfaces(const string & spec, vector<ResponseSurface_t> & surfaces, string & error);
+void TrainResponseSurfaces(GReWeight & rw, vector<ResponseSurface_t> & surfaces,
+                    const TMatrixD & throws, TTree * tree, NtpMCEventRecord * mcrec,
+                    GReWeightIOGstReader * gst, const vector<bool> & selected,
+                    Long64_t nfirst, Long64_t nlast);
+// a work block (its throws, over the buffered events), with the events
+// shared out among the threads computing the weights
+struct ThrowBlock_t {
+  int                        First;     ///< first throw of the block
+  int                        N;         ///< # of throws in the block
+  const TMatrixD *           Throws;
+  vector<ResponseSurface_t> *Surfaces;
+  GReWeightIOEventBuffer *   Buffer;
+  unsigned int               NEvents;   ///< # of buffered events
+  Long64_t                   NFirst;
+  vector<double> *           Weights;   ///< [event][throw of the block]
+  GReWeightIOUniverseHists * Hists;     ///< (null if not filled)
+  const int *                Bins;      ///< [event][variable]
+  GReWeightIOUniverseHists * ConvHists; ///< (null if not filled)
+  const int *                ConvBins;
+};
+void ReweightThrows(GReWeight * rw, int slot, int nslots, const ThrowBlock_t * blk);
 
 vector<GSyst_t> gOptVSyst;
 vector<double>  gOptVCentVal;
@@ -131,33 +440,103 @@ Long64_t gOptNEvt2;
 int      gOptRunKey= 0;
 int      gOptNSyst = 0;
 int      gOptNTwk  = 0;
+long int gOptRanSeed = -1;
 TRandom *tRnd = new TRandom(); // to access normal distribution
+GReWeightIOWeightCodec gOptWghtCodec(GReWeightIOWeightCodec::kStoreDouble);
+string   gOptCompression;
+int      gOptBasketSize = 0;
+Long64_t gOptAutoFlush  = 0;
+GReWeightSelection gOptSelection;
+bool     gOptSkipRejected = false;
+string   gOptHistograms;
+int      gOptPreflight     = 1000;
+int      gOptSensEvents    = 0;
+double   gOptSensThreshold = 1E-3;
+bool     gOptSensDrop      = false;
+string   gOptSensBinning;
+double   gOptAdaptTol     = 0.;
+int      gOptAdaptBlock   = 50;
+string   gOptAdaptBinning;
+bool     gOptAntithetic   = false;
+string   gOptSurfaces;
+double   gOptSurfaceTol   = 1E-3;
+string   gOptTableCache;
+string   gOptStartupTiming;
+string   gOptTrace;
+long     gOptTraceSample  = 100;
+double   gOptBlockMemory    = 0.;
+Long64_t gOptBlockEvents    = 0;
+int      gOptBlockThrows    = 0;
+int      gOptThreads        = 1;
+string   gOptChain;
+bool     gOptChainExpand    = false;
+GReWeightIOChain gChain;
 
 //___________________________________________________________________
 int main(int argc, char ** argv)
 {
   GetCommandLineArgs (argc, argv);
 
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  if(gOptStartupTiming.size() > 0) timer->Enable();
+
+  GReWeightTracer * tracer = GReWeightTracer::Instance();
+  tracer->SetSampling(gOptTraceSample);
+  if(gOptTrace.size() > 0) tracer->Enable();
+
+  utils::app_init::RandGen(gOptRanSeed);
+  GReWeightServices::Prepare(gOptRanSeed);
+  timer->Lap("random number generator");
+
   // open the ROOT file and get the TTree & its header
+  // (or, if there is no GHEP tree, a gst tree)
   TTree *           tree = 0;
   NtpMCTreeHeader * thdr = 0;
+  GReWeightIOGstReader * gst = 0;
   TFile file(gOptInpFilename.c_str(),"READ");
   tree = dynamic_cast <TTree *>           ( file.Get("gtree")  );
   thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
+  if(!tree) {
+    tree = dynamic_cast <TTree *> ( file.Get("gst") );
+    if(GReWeightIOGstReader::IsGstTree(tree)) gst = new GReWeightIOGstReader(tree);
+    else tree = 0;
+  }
+  if(gst && !gst->IsValid()) {
+    LOG("grwghtnp", pFATAL)
+      << "Can't read the gst tree of input file " << file.GetName() << ": " << gst->Error();
+    gAbortingInErr = true;
+    exit(1);
+  }
   if(!tree){
     LOG("grwghtnp", pFATAL)
-      << "Can't find a GHEP tree in input file: "<< file.GetName();
+      << "Can't find a GHEP or gst tree in input file: "<< file.GetName();
     gAbortingInErr = true;
     PrintSyntax();
     exit(1);
   }
-  LOG("grwghtnp", pNOTICE) << "Input tree header: " << *thdr;
+  if(thdr) {
+    LOG("grwghtnp", pNOTICE) << "Input tree header: " << *thdr;
+  }
   if(!FindIncompatibleSystematics(gOptVSyst))
   {
     LOG("grwghtnp", pFATAL) << "Error: conflicting systematics";
     gAbortingInErr = true;
     exit(1);
   }
+  if(gst) {
+    bool ok = true;
+    for(unsigned int i = 0; i < gOptVSyst.size(); i++) {
+      string why;
+      if(gst->CanReweight(gOptVSyst[i], why)) continue;
+      LOG("grwghtnp", pFATAL)
+        << GSyst::AsString(gOptVSyst[i]) << " can not be reweighted from a gst tree: " << why;
+      ok = false;
+    }
+    if(!ok) {
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
 
   //
   // Preparation for finding correlated vectors
@@ -177,6 +556,7 @@ int main(int argc, char ** argv)
   // Assumed errors from covariance are stored in one sigma errors for parameters
   GetCorrelationMatrix(gOptInpCovariance,cmat);
   TMatrixD lTri = CholeskyDecomposition(*cmat);
+  timer->Lap("open input & covariance");
 
   //LOG("grwghtnp", pNOTICE) << "Correlation matrix:";
   //cmat->Print();
@@ -184,7 +564,7 @@ int main(int argc, char ** argv)
   //lTri.Print();
 
   NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
+  if(!gst) tree->SetBranchAddress("gmcrec", &mcrec);
 
   Long64_t nev_in_file = tree->GetEntries();
   Long64_t nfirst = 0;
@@ -194,6 +574,48 @@ int main(int argc, char ** argv)
 
   LOG("grwghtnp", pNOTICE) << "Will process " << nev << " events";
 
+  // Describe this job, so that outputs of jobs processing different
+  // event ranges can be validated & merged
+  GReWeightIOShardManifest manifest;
+  manifest.SetApp        ("grwghtnp");
+  manifest.SetInput      (&file, nev_in_file);
+  manifest.SetEventRange (nfirst, nlast);
+  manifest.SetConfig     (ConfigurationString(*cmat));
+  manifest.SetSeed       (gOptRanSeed);
+  manifest.SetRunKey     (gOptRunKey);
+  if(gOptHistograms.size() == 0) manifest.AddTree("covrwt");
+  manifest.SetSparse     (gOptSelection.IsSet() && gOptSkipRejected);
+
+  timer->Lap("event range & manifest");
+
+  // Apply the event selection up-front, so that rejected events are
+  // neither read nor reweighted for each throw
+  vector<bool> selected(nev, true);
+  if(gOptSelection.IsSet()) {
+    int nsel = 0;
+    for(int iev = nfirst; iev <= nlast; iev++) {
+      EventRecord * evp = 0;
+      if(gst) evp = gst->ReadEvent(iev);
+      else {
+        tree->GetEntry(iev);
+        evp = mcrec->event;
+      }
+      selected[iev - nfirst] = (evp != 0 && gOptSelection.Select(*evp));
+      if(selected[iev - nfirst]) nsel++;
+      if(mcrec) mcrec->Clear();
+    }
+    LOG("grwghtnp", pNOTICE)
+      << "Selected " << nsel << " of " << nev << " events ("
+      << (100.*nsel)/nev << "%) with: " << gOptSelection.Expression();
+  }
+  timer->Lap("event selection");
+
+  // Load the derived calculator tables from the cache, if one is used
+  if(gOptTableCache.size() > 0) {
+    GReWeightTableCache::Instance()->Open(gOptTableCache);
+  }
+  timer->Lap("table cache");
+
   //
   // Create a GReWeight object and add to it a set of
   // weight calculators
@@ -203,7 +625,14 @@ int main(int argc, char ** argv)
   //
 
   GReWeight rw;
-  AdoptWeightCalcs(gOptVSyst, rw);
+  GReWeightHandle::AdoptWeightCalcs(gOptVSyst, rw);
+
+  // Decide where the stored differential cross sections can be used
+  GReWeightPreflight preflight;
+  if(gOptPreflight > 0 && !gst) {
+    Preflight(preflight, rw, tree, mcrec, selected, nfirst);
+    timer->Lap("preflight");
+  }
 
   //
   // Create a list of systematic params (more to be found at GSyst.h)
@@ -219,17 +648,112 @@ int main(int argc, char ** argv)
 
   GSystSet & syst = rw.Systematics();
 
-  // Declare the weights, twkvals
+  // Find the systematics with a negligible effect on this sample and,
+  // if requested, drop them before the expensive throw loop
+  if(gOptSensEvents > 0) {
+    vector<GSyst_t> negligible =
+      SensitivityPrePass(rw, tree, mcrec, gst, selected, nfirst);
+    if(gOptSensDrop && negligible.size() > 0) {
+      vector<int> keep;
+      for(int i = 0; i < gOptNSyst; i++) {
+        if(std::find(negligible.begin(), negligible.end(), gOptVSyst[i]) == negligible.end()) {
+          keep.push_back(i);
+        } else {
+          LOG("grwghtnp", pNOTICE)
+            << "Dropping negligible systematic: " << GSyst::AsString(gOptVSyst[i]);
+          syst.Remove(gOptVSyst[i]);
+        }
+      }
+      if(keep.size() == 0) {
+        LOG("grwghtnp", pFATAL) << "All systematics are negligible for this sample - Exiting";
+        gAbortingInErr = true;
+        exit(1);
+      }
+      vector<GSyst_t> vsyst;
+      vector<double>  vcent;
+      TMatrixD * reduced = new TMatrixD(keep.size(), keep.size());
+      for(unsigned int i = 0; i < keep.size(); i++) {
+        vsyst.push_back(gOptVSyst   [keep[i]]);
+        vcent.push_back(gOptVCentVal[keep[i]]);
+        for(unsigned int j = 0; j < keep.size(); j++) {
+          (*reduced)(i,j) = (*cmat)(keep[i],keep[j]);
+        }
+      }
+      gOptVSyst    = vsyst;
+      gOptVCentVal = vcent;
+      gOptNSyst    = gOptVSyst.size();
+      delete cmat;
+      cmat = reduced;
+      lTri.ResizeTo(gOptNSyst, gOptNSyst);
+      lTri = CholeskyDecomposition(*cmat);
+      manifest.SetConfig(ConfigurationString(*cmat));
+    }
+    // make the throws independent of the pre-pass
+    utils::app_init::RandGen(gOptRanSeed);
+    timer->Lap("sensitivity pre-pass");
+  }
+
   const int n_params = (const int) gOptNSyst;
   const int n_tweaks = (const int) gOptNTwk;
-  TVectorD twkvals(n_params);
 
-  // Initialize
-  for (int ipr = 0; ipr < n_params; ipr++) { twkvals(ipr) = 0.; }
+  // Make all throws up-front, so that they depend only on the seed and
+  // not on the random numbers used by weight calculators for the events
+  // processed in between
+  TMatrixD throws(n_tweaks, n_params);
+  for (int itk = 0; itk < n_tweaks; itk++) {
+    if(gOptChain.size() > 0) {
+      for (int ipr = 0; ipr < n_params; ipr++) { throws(itk,ipr) = gChain.Dial(itk,ipr); }
+      continue;
+    }
+    if(gOptAntithetic && itk%2 == 1) {
+      for (int ipr = 0; ipr < n_params; ipr++) { throws(itk,ipr) = -throws(itk-1,ipr); }
+      continue;
+    }
+    TVectorD thr = CholeskyGenerateCorrelatedParamVariations(lTri);
+    for (int ipr = 0; ipr < n_params; ipr++) { throws(itk,ipr) = thr(ipr); }
+  }
+  timer->Lap("systematics & throws");
+
+  // Fit the response surfaces of the calculators whose weights are
+  // synthesized, and leave those calculators out of the weight calculation
+  vector<ResponseSurface_t> surfaces;
+  if(gOptSurfaces.size() > 0) {
+    string error;
+    ParseResponseSurfaces(gOptSurfaces, surfaces, error); // already validated
+    TrainResponseSurfaces(rw, surfaces, throws, tree, mcrec, gst, selected, nfirst, nlast);
+    timer->Lap("response surfaces");
+  }
+
+  // In histogram-only mode, per-throw histograms are accumulated in memory
+  // instead of writing (& consolidating) a weight per event & throw
+  bool hist_mode = (gOptHistograms.size() > 0);
+  GReWeightIOUniverseHists hists(n_tweaks, gOptThreads);
+  if(hist_mode) {
+    string error;
+    hists.AddVariables(gOptHistograms, error); // already validated
+    LOG("grwghtnp", pNOTICE) << "Histograms: " << hists.Specification();
+  }
+  GReWeightEventSummary summary;
+
+  // In adaptive mode, the binned predictions of each throw (the histograms
+  // themselves, if their binning is the one asked for) and running sums of
+  // their products, for the covariance after each block of throws
+  bool adaptive = (gOptAdaptTol > 0.);
+  bool own_conv = adaptive && !(hist_mode && gOptAdaptBinning == gOptHistograms);
+  GReWeightIOUniverseHists conv_hists(own_conv ? n_tweaks : 1, gOptThreads);
+  GReWeightIOUniverseHists * conv = (own_conv) ? &conv_hists : &hists;
+  if(own_conv) {
+    string error;
+    conv_hists.AddVariables(gOptAdaptBinning, error); // already validated
+  }
+  int            conv_nbins = (adaptive) ? conv->NBins() : 0;
+  vector<double> conv_sum  (conv_nbins, 0.);
+  vector<double> conv_sum2 ((size_t)conv_nbins * conv_nbins, 0.);
+  vector<double> conv_prev;
+  int            n_done = n_tweaks;
 
   // objects to pass elements into tree
   int     branch_eventnum = 0;
-  double  branch_weight   = 0.;
 
   // objects used in processing
   vector<GSyst_t>::iterator it;
@@ -237,103 +761,360 @@ int main(int argc, char ** argv)
   stringstream tmpName;
   int ip;
 
+  //
+  // WORK BLOCKS
+  // -- the (events x throws) weights are computed in blocks of (event
+  //    range x throw range): the events of a block are decoded once, for
+  //    all of its throws, and each throw is configured once per event range.
+  //    The block shape follows from the measured cost of decoding an event,
+  //    of reconfiguring for a throw and the memory available.
+  //
+  int nsel = std::count(selected.begin(), selected.end(), true);
+  double sel_fraction = (nev > 0) ? double(nsel) / nev : 0.;
+
+  // reweight from event views if all calculators that may be tweaked
+  // (but the synthesized ones) handle them
+  bool use_views = true;
+  const vector<string> & calc_names = rw.WghtCalcNames();
+  for (unsigned int ic = 0; ic < calc_names.size(); ic++) {
+    bool synthesized = false;
+    for (unsigned int is = 0; is < surfaces.size(); is++) {
+      if(surfaces[is].Calc == calc_names[ic]) synthesized = true;
+    }
+    GReWeightI * wcalc = rw.WghtCalc(calc_names[ic]);
+    bool tweaked = false;
+    for (unsigned int ip = 0; ip < gOptVSyst.size(); ip++) {
+      if(wcalc->IsHandled(gOptVSyst[ip])) tweaked = true;
+    }
+    if(tweaked && !synthesized && !wcalc->HandlesEventView()) use_views = false;
+  }
+  // views of gst events are then decoded with no event record, unless
+  // records are needed for binning or exact synthesized weights
+  bool use_records = !use_views || hist_mode || own_conv || !surfaces.empty();
+  LOG("grwghtnp", pNOTICE)
+    << "Reweighting from " << ((use_views) ? "event views" : "event records");
+
+  GReWeightIOEventBuffer * buffer = new GReWeightIOEventBuffer(tree, 100);
+  buffer->SetViews(use_views);
+  buffer->SetRecords(use_records);
+  ProcInfo_t proc_before, proc_after;
+  gSystem->GetProcInfo(&proc_before);
+  TStopwatch decode_timer;
+  unsigned int nsample = buffer->Fill(nfirst, nlast, selected, nfirst);
+  decode_timer.Stop();
+  gSystem->GetProcInfo(&proc_after);
+  delete buffer;
+  double decode_cost = (nsample > 0) ? decode_timer.RealTime() / nsample : 0.;
+  double event_bytes = (nsample > 0) ?
+     1024. * (proc_after.fMemResident - proc_before.fMemResident) / nsample : 0.;
+  event_bytes = TMath::Max(event_bytes, 1024.);
+
+  TStopwatch config_timer;
+  int nconfig = TMath::Min(n_tweaks, 3);
+  for (int itk = 0; itk < nconfig; itk++) {
+    ip = 0;
+    for (it = gOptVSyst.begin(); it != gOptVSyst.end(); it++, ip++) syst.Set(*it, throws(itk,ip));
+    rw.Reconfigure();
+  }
+  config_timer.Stop();
+  double config_cost = (nconfig > 0) ? config_timer.RealTime() / nconfig : 0.;
+
+  double budget = gOptBlockMemory;
+  if(budget <= 0.) {
+    MemInfo_t mem;
+    gSystem->GetMemInfo(&mem);
+    budget = (mem.fMemFree > 0) ? 0.5 * mem.fMemFree : 1024.;
+  }
+
+  // blocks span event entries, of which only the selected ones are decoded
+  GReWeightBlockPlan plan;
+  plan.SetSize         (nev, n_tweaks);
+  plan.SetCosts        (sel_fraction * decode_cost, config_cost);
+  plan.SetMemory       (sel_fraction * event_bytes, budget * 1024. * 1024.);
+  plan.FixEvents       (gOptBlockEvents);
+  plan.FixUniverses    (gOptBlockThrows);
+  if(adaptive) plan.SetUniverseStep(gOptAdaptBlock);
+  plan.Plan();
+  LOG("grwghtnp", pNOTICE) << "Work blocks: " << plan.Description();
+  timer->Lap("work block plan");
+
+  const Long64_t blk_events = plan.NEvents();
+  const int      blk_throws = plan.NUniverses();
+  const int      n_tblocks  = plan.NUniverseBlocks();
+
+  // the events of a block are reweighted throw after throw: keep the
+  // default integrals of a whole block (up to 2 per event & calculator)
+  // cached
+  GReWeightXSecIntegrator::SetDefaultCacheSize(
+     TMath::Max((Long64_t) GReWeightXSecIntegrator::DefaultCacheSize(), 2*blk_events));
+
+  buffer = new GReWeightIOEventBuffer(tree, blk_events);
+  buffer->SetViews(use_views);
+  buffer->SetRecords(use_records);
+  vector<double> blk_weights((size_t) blk_events * blk_throws, 1.);
+  vector<double> row_weights(blk_throws, 1.);
+  const int nvars      = hists.NVariables();
+  const int conv_nvars = conv->NVariables();
+  vector<int> ev_bins     ((size_t) blk_events * nvars      + 1);
+  vector<int> ev_conv_bins((size_t) blk_events * conv_nvars + 1);
+
+  // Weight calculators of the other threads
+  vector<GReWeight *> rws(1, &rw);
+  for (int ith = 1; ith < gOptThreads; ith++) {
+    GReWeight * wrw = new GReWeight;
+    GReWeightHandle::AdoptWeightCalcs(gOptVSyst, *wrw);
+    preflight.Apply(*wrw);
+    for (unsigned int is = 0; is < surfaces.size(); is++) wrw->ExcludeWghtCalc(surfaces[is].Calc);
+    rws.push_back(wrw);
+  }
+  if(gOptThreads > 1) timer->Lap("thread weight calculators");
+
   //
   // REWEIGHTING LOOP
-  // -- do all of reweighting, save to temporary files
+  // -- do all of reweighting, save to temporary files (one per throw block)
   //
   TFile * wght_file = NULL;
   TTree * wght_tree = NULL;
-  for (int itk = 0; itk < gOptNTwk; itk++) {
+  for (int ib = 0; ib < n_tblocks && n_done == n_tweaks; ib++) {
+    const int itk0 = ib * blk_throws;
+    const int ntk  = TMath::Min(blk_throws, n_tweaks - itk0);
+
     // Make temporary output trees for saving the weights.
     // This step is necessary because ROOT trees cannot be edited once filled
     // Later consolidate the trees into a single tree with the requested filename
-    tmpName.str("");
-    tmpName << "_temporary_rwght." <<itk <<"." <<gOptRunKey <<".root";
-    LOG("grwghtnp", pINFO) <<"temporary file: " <<tmpName.str();
-    wght_file = new TFile(tmpName.str().c_str(),"RECREATE");
-    wght_tree = new TTree("covrwt","GENIE weights tree");
+    if(!hist_mode) {
+      tmpName.str("");
+      tmpName << "_temporary_rwght." <<ib <<"." <<gOptRunKey <<".root";
+      LOG("grwghtnp", pINFO) <<"temporary file: " <<tmpName.str();
+      wght_file = new TFile(tmpName.str().c_str(),"RECREATE");
+      wght_tree = new TTree("covrwt","GENIE weights tree");
+
+      // Create tree branches
+      stringstream leaves;
+      leaves << "weights[" << ntk << "]/D";
+      wght_tree->Branch("eventnum", &branch_eventnum);
+      wght_tree->Branch("weights",  &row_weights[0], leaves.str().c_str());
+    }
 
-    // Create tree branches
-    wght_tree->Branch("eventnum", &branch_eventnum);
-    wght_tree->Branch("weights",  &branch_weight);
+    for (Long64_t ichunk = nfirst; ichunk <= nlast; ichunk += blk_events) {
+
+      Long64_t ilast = TMath::Min(nlast, ichunk + blk_events - 1);
+      unsigned int nbuf = buffer->Fill(ichunk, ilast, selected, nfirst);
+
+      LOG("grwghtnp", pNOTICE)
+        << "***** Throws [" << itk0 << ", " << itk0 + ntk - 1
+        << "], events [" << ichunk << ", " << ilast << "]";
+
+      // bins of the buffered events, for all throws of the block
+      if(hist_mode || own_conv) {
+        for (unsigned int iev = 0; iev < nbuf; iev++) {
+          summary.Fill(buffer->Event(iev));
+          if(hist_mode) {
+            hists.FindBins(summary, &ev_bins[(size_t)iev * nvars]);
+            if(itk0 == 0) hists.FillNominal(0, &ev_bins[(size_t)iev * nvars]);
+          }
+          if(own_conv) conv_hists.FindBins(summary, &ev_conv_bins[(size_t)iev * conv_nvars]);
+        }
+      }
 
-    // Construct multiple branches to streamline loading later
-    // Load tweaks into reweighting
-    twkvals = CholeskyGenerateCorrelatedParamVariations(lTri);
-    // scale the size of the vector to avg length 1
-    //twkvals *= 1./(TMath::Sqrt((double)gOptNSyst));
-    ip = 0;
-    for (it = gOptVSyst.begin();it != gOptVSyst.end(); it++, ip++) {
-      twk_dial_brnch_name.str("");
-      twk_dial_brnch_name << "twk_" << GSyst::AsString(*it);
-      // each array element individually
-      wght_tree->Branch(twk_dial_brnch_name.str().c_str(), &twkvals(ip));
-      //LOG("grwghtnp", pINFO) << "Setting systematic : "
-      //  <<GSyst::AsString(*it) <<", " <<twkvals(ip);
-      syst.Set(*it,twkvals(ip));
-    }
-    rw.Reconfigure();
+      ThrowBlock_t blk;
+      blk.First     = itk0;
+      blk.N         = ntk;
+      blk.Throws    = &throws;
+      blk.Surfaces  = &surfaces;
+      blk.Buffer    = buffer;
+      blk.NEvents   = nbuf;
+      blk.NFirst    = nfirst;
+      blk.Weights   = &blk_weights;
+      blk.Hists     = (hist_mode) ? &hists      : 0;
+      blk.Bins      = &ev_bins[0];
+      blk.ConvHists = (own_conv)  ? &conv_hists : 0;
+      blk.ConvBins  = &ev_conv_bins[0];
+      if(gOptThreads == 1) {
+        ReweightThrows(&rw, 0, 1, &blk);
+      } else {
+        vector<std::thread> workers;
+        for (int ith = 0; ith < gOptThreads; ith++) {
+          workers.push_back(std::thread(ReweightThrows, rws[ith], ith, gOptThreads, &blk));
+        }
+        for (int ith = 0; ith < gOptThreads; ith++) workers[ith].join();
+      }
 
-    stringstream str_wght;
-    str_wght.str("");
-    str_wght << ", parameter tweaks : ";
-    for (int ipr=0; ipr < n_params; ipr++) {
-       if (ipr > 0) str_wght << ", ";
-       str_wght << ipr << " -> " << twkvals(ipr);
+      // Write the block's entries in event order; events failing the
+      // selection (unless skipped) or not readable get unit weights
+      if(!hist_mode) {
+        unsigned int ibuf = 0;
+        for (Long64_t iev = ichunk; iev <= ilast; iev++) {
+          if(!selected[iev - nfirst] && gOptSkipRejected) continue;
+          branch_eventnum = iev;
+          bool done = (ibuf < nbuf && buffer->Entry(ibuf) == iev);
+          for (int itb = 0; itb < ntk; itb++) {
+            row_weights[itb] = (done) ? blk_weights[(size_t)ibuf * ntk + itb] : 1.;
+          }
+          if(done) ibuf++;
+          wght_tree->Fill();
+        }
+      }
+    } // event blocks
+
+    hists.Merge();
+    conv_hists.Merge();
+
+    if(!hist_mode) {
+      // close out temporary file
+      wght_file->cd();
+      wght_tree->Write();
+      wght_file->Close();
+      //delete wght_tree; // segfault when deleted
+      wght_tree = 0;
+      delete wght_file;
     }
 
-    for(int iev = nfirst; iev <= nlast; iev++) {
-      branch_eventnum = iev;
-      tree->GetEntry(iev);
+    // Adaptive mode: stop once the covariance of the binned predictions
+    // changed by less than the tolerance over the last block of throws
+    // (throw blocks end on the --adaptive-block boundaries)
+    for (int itk = itk0; adaptive && itk < itk0 + ntk; itk++) {
+      for (int i = 0; i < conv_nbins; i++) {
+        double xi = conv->SumW(itk, i);
+        conv_sum[i] += xi;
+        for (int j = 0; j <= i; j++) {
+          conv_sum2[(size_t)i*conv_nbins + j] += xi * conv->SumW(itk, j);
+        }
+      }
+      int n = itk + 1;
+      if(n % gOptAdaptBlock != 0 || n < 2 || n == n_tweaks) continue;
+      vector<double> cov((size_t)conv_nbins * conv_nbins, 0.);
+      for (int i = 0; i < conv_nbins; i++) {
+        for (int j = 0; j <= i; j++) {
+          size_t ij = (size_t)i*conv_nbins + j;
+          cov[ij] = (conv_sum2[ij] - conv_sum[i]*conv_sum[j]/n) / (n-1);
+        }
+      }
+      if(conv_prev.size() > 0) {
+        double diff = 0., norm = 0.;
+        for (size_t ij = 0; ij < cov.size(); ij++) {
+          diff += (cov[ij] - conv_prev[ij]) * (cov[ij] - conv_prev[ij]);
+          norm += cov[ij] * cov[ij];
+        }
+        double change = (norm > 0.) ? TMath::Sqrt(diff/norm) : 0.;
+        LOG("grwghtnp", pNOTICE)
+          << "Throws: " << n << " - relative change of the binned covariance: " << change;
+        if(change < gOptAdaptTol) {
+          LOG("grwghtnp", pNOTICE)
+            << "Binned covariance converged after " << n << " of " << n_tweaks << " throws";
+          n_done = n;
+          break;
+        }
+      }
+      conv_prev = cov;
+    }
+  } // throw blocks
+  delete buffer;
+  for (unsigned int ith = 1; ith < rws.size(); ith++) delete rws[ith];
+
+  // Keep only the throws processed
+  if(n_done < n_tweaks) {
+    gOptNTwk = n_done;
+    throws.ResizeTo(n_done, n_params);
+    hists.Truncate(n_done);
+    manifest.SetConfig(ConfigurationString(*cmat));
+  }
 
-      EventRecord & event = *(mcrec->event);
-      LOG("rwghtzexpaxff", pNOTICE) << "Event_num  => " << iev;
-      //LOG("rwghtzexpaxff", pNOTICE) << event;
+  if(tracer->IsEnabled()) {
+    tracer->Disable();
+    tracer->Report(gOptTrace);
+  }
 
-      branch_weight = rw.CalcWeight(event);
-      mcrec->Clear();
-      wght_tree->Fill();
+  // Store any derived calculator tables built in this job
+  GReWeightTableCache::Instance()->Save();
 
-    } // event loop
+  // Close event file
+  delete gst;
+  file.Close();
 
-    // close out temporary file
+  // Histogram-only mode: write the histograms, throws & manifest and stop
+  if(hist_mode) {
+    LOG("grwghtnp", pNOTICE) << "Writing histograms to " << gOptOutFilename;
+    hists.Merge();
+    wght_file = new TFile(gOptOutFilename.c_str(),"RECREATE");
+    if(gOptCompression.size() > 0) {
+      if(!utils::rew::SetCompression(wght_file, gOptCompression)) {
+        LOG("grwghtnp", pFATAL) << "Can't set the output compression: " << gOptCompression;
+        gAbortingInErr = true;
+        exit(1);
+      }
+    }
+    hists.Write(wght_file);
+    string param_names;
+    for (unsigned int i = 0; i < gOptVSyst.size(); i++) {
+      if(i > 0) param_names += ",";
+      param_names += GSyst::AsString(gOptVSyst[i]);
+    }
+    TNamed params("params", param_names.c_str());
+    wght_file->WriteTObject(&params, "params");
+    wght_file->WriteTObject(&throws, "throws");
+    if(gOptChain.size() > 0) {
+      TVectorD multiplicity(n_tweaks);
+      for (int itk = 0; itk < n_tweaks; itk++) multiplicity(itk) = gChain.Multiplicity(itk);
+      wght_file->WriteTObject(&multiplicity, "multiplicity");
+    }
     wght_file->cd();
-    wght_tree->Write();
+    manifest.Write("shard_manifest");
     wght_file->Close();
-    //delete wght_tree; // segfault when deleted
-    wght_tree = 0;
     delete wght_file;
-  } // tweak loop
 
-  // Close event file
-  file.Close();
+    LOG("grwghtnp", pNOTICE)  << "Done!";
+    return 0;
+  }
 
   // open temporary trees for consolidation
   LOG("rwghtzexpaxff", pNOTICE)
     << "Consolidating temporary files into ROOT file " << gOptOutFilename;
   wght_file = new TFile(gOptOutFilename.c_str(),"RECREATE"); // new file
+  if(gOptCompression.size() > 0) {
+    if(!utils::rew::SetCompression(wght_file, gOptCompression)) {
+      LOG("grwghtnp", pFATAL) << "Can't set the output compression: " << gOptCompression;
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
   wght_tree = new TTree("covrwt","GENIE covariant reweighting tree");
-  wght_tree->Branch("n_tweaks", &gOptNTwk);
+
+  // With --chain-expand, an output row per chain sample, from its state's
+  // weights (each distinct state is reweighted once and copied to all of
+  // its samples); otherwise a row per distinct state
+  const bool expand = (gOptChain.size() > 0 && gOptChainExpand);
+  int n_out = (expand) ? gChain.NSamples() : gOptNTwk;
+  vector<double> expanded(n_out, 1.);
+
+  wght_tree->Branch("n_tweaks", &n_out);
   wght_tree->Branch("eventnum", &branch_eventnum);
-  TFile * file_list[n_tweaks];
-  TTree * wght_list[n_tweaks];
-  for (int itk=0; itk < n_tweaks; itk++) {
+  const int n_tblocks_done = (gOptNTwk + blk_throws - 1) / blk_throws;
+  vector<TFile *> file_list(n_tblocks_done);
+  vector<TTree *> wght_list(n_tblocks_done);
+  for (int ib=0; ib < n_tblocks_done; ib++) {
     tmpName.str("");
-    tmpName << "_temporary_rwght." <<itk <<"." <<gOptRunKey <<".root";
-    file_list[itk] = new TFile(tmpName.str().c_str(),"READ");
-    wght_list[itk] = (TTree*)file_list[itk]->Get("covrwt");
+    tmpName << "_temporary_rwght." <<ib <<"." <<gOptRunKey <<".root";
+    file_list[ib] = new TFile(tmpName.str().c_str(),"READ");
+    wght_list[ib] = (TTree*)file_list[ib]->Get("covrwt");
   }
 
   // objects to load data into and fill new tree with
-  TArrayD   branch_weights_array(gOptNTwk);
-  double  * branch_weights_ptr = branch_weights_array.GetArray();
+  // (each throw block's weights are loaded into their place in the row)
+  vector<double> branch_weights((size_t)n_tblocks_done * blk_throws, 1.);
+  double  * branch_weights_ptr = &branch_weights[0];
   TArrayD * branch_twkdials_array[n_params];
-  double  * branch_twkdials_ptr  [n_params];
 
   // set up streamlined weight loading
-  wght_tree->Branch("weights",  &branch_weights_array);
-  for (int itk = 0; itk < gOptNTwk; itk++) {
-    wght_list[itk]->SetBranchAddress("weights",&branch_weights_ptr[itk]);
+  GReWeightIOWeightBranch * wght_branch =
+    new GReWeightIOWeightBranch(wght_tree, "weights", n_out, gOptWghtCodec);
+  GReWeightIOWeightStats wght_stats(wght_tree, "weights");
+  vector<double> multiplicity;
+  if(gOptChain.size() > 0 && !expand) {
+    for (int itk = 0; itk < gOptNTwk; itk++) multiplicity.push_back(gChain.Multiplicity(itk));
+  }
+  for (int ib = 0; ib < n_tblocks_done; ib++) {
+    wght_list[ib]->SetBranchAddress("weights",&branch_weights_ptr[ib * blk_throws]);
   }
 
   ip = 0;
@@ -341,44 +1122,65 @@ int main(int argc, char ** argv)
     twk_dial_brnch_name.str("");
     twk_dial_brnch_name << "twk_" << GSyst::AsString(*it);
 
-    // access TArrayD memory directly
-    branch_twkdials_array[ip] = new TArrayD(gOptNTwk);
-    branch_twkdials_ptr[ip] = branch_twkdials_array[ip]->GetArray();
+    // the tweak values are the same for all entries
+    branch_twkdials_array[ip] = new TArrayD(n_out);
+    for (int i=0; i < n_out; i++) {
+      branch_twkdials_array[ip]->SetAt(throws((expand) ? gChain.StateOf(i) : i, ip), i);
+    }
 
     // create branch
     wght_tree->Branch(twk_dial_brnch_name.str().c_str(), branch_twkdials_array[ip]);
     LOG("grwghtnp", pINFO) << "Creating tweak branch : " << twk_dial_brnch_name.str();
-
-    // set up loading directly into TArrayD
-    for (int i=0; i < n_tweaks; i++) {
-      wght_list[i]->SetBranchAddress(twk_dial_brnch_name.str().c_str(),&branch_twkdials_ptr[ip][i]);
-      //LOG("grwghtnp", pINFO) << "Loading tweak value : "<<branch_twkdials_array[ip]->fArray[i];
-    }
   }
 
+  utils::rew::TuneWeightTree(wght_tree,
+     2*sizeof(int) + 5*sizeof(float) + n_out*(gOptWghtCodec.BytesPerWeight() + n_params*sizeof(double)),
+     gOptBasketSize, gOptAutoFlush);
+
   //
   // CONSOLIDATION LOOP
   // -- combine all data from reweighting into single file
   //
   wght_file->cd();
+  Long64_t ientry = 0;
   for(int iev = nfirst; iev <= nlast; iev++) {
+    if(!selected[iev - nfirst] && gOptSkipRejected) continue;
     branch_eventnum = iev;
-    for (int itk = 0; itk < n_tweaks; itk++) {
-      wght_list[itk]->GetEntry(iev);
-    } // tweak loop
+    for (int ib = 0; ib < n_tblocks_done; ib++) {
+      wght_list[ib]->GetEntry(ientry);
+    } // throw block loop
+    ientry++;
+    if(expand) {
+      for (int i = 0; i < n_out; i++) expanded[i] = branch_weights[gChain.StateOf(i)];
+      wght_branch->Set(&expanded[0]);
+      wght_stats .Set(&expanded[0], n_out);
+    } else {
+      wght_branch->Set(branch_weights_ptr);
+      wght_stats .Set(branch_weights_ptr, n_out,
+                      (multiplicity.size() > 0) ? &multiplicity[0] : 0);
+    }
     wght_tree->Fill();
   } // event loop
   wght_file->cd();
   wght_tree->Write();
+  gOptWghtCodec.Write("weight_codec");
+  manifest.Write("shard_manifest");
+  if(gOptChain.size() > 0 && !expand) {
+    TVectorD multiplicity(gOptNTwk);
+    for (int itk = 0; itk < gOptNTwk; itk++) multiplicity(itk) = gChain.Multiplicity(itk);
+    multiplicity.Write("multiplicity");
+  }
+  delete wght_branch;
 
   //
   // CLEANUP LOOP
   //
 
   // delete temporary files
-  for (int itk = 0; itk < gOptNTwk; itk++) {
+  for (int ib = 0; ib < n_tblocks_done; ib++) {
+    delete file_list[ib];
     tmpName.str("");
-    tmpName << "_temporary_rwght." <<itk <<"." <<gOptRunKey <<".root";
+    tmpName << "_temporary_rwght." <<ib <<"." <<gOptRunKey <<".root";
     if( remove(tmpName.str().c_str()) != 0 )
     { LOG("grwghtnp", pWARN) << "Could not delete temporary file : " << tmpName.str(); }
     //else
@@ -393,7 +1195,6 @@ int main(int argc, char ** argv)
   for (int ipr = 0; ipr < n_params; ipr++) {
     delete branch_twkdials_array[ipr];
   }
-
   LOG("grwghtnp", pNOTICE)  << "Done!";
   return 0;
 }
@@ -426,6 +1227,15 @@ void GetCommandLineArgs(int argc, char ** argv)
     exit(1);
   }
 
+  // random number seed
+  if( parser.OptionExists("seed") ) {
+    LOG("grwghtnp", pINFO) << "Reading random number seed";
+    gOptRanSeed = parser.ArgAsLong("seed");
+  } else {
+    LOG("grwghtnp", pINFO) << "Unspecified random number seed - Using default";
+    gOptRanSeed = -1;
+  }
+
   // output weight file
   if(parser.OptionExists('o')) {
     LOG("grwghtnp", pINFO) << "Reading requested output filename";
@@ -506,8 +1316,30 @@ void GetCommandLineArgs(int argc, char ** argv)
     exit(1);
   }
 
+  // posterior chain (instead of random throws):
+  if( parser.OptionExists("chain") ) {
+    gOptChain = parser.ArgAsString("chain");
+    string error;
+    if(!gChain.Read(gOptChain, gOptVSyst, error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --chain: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  gOptChainExpand = parser.OptionExists("chain-expand");
+  if(gOptChainExpand && gOptChain.size() == 0) {
+    LOG("grwghtnp", pFATAL) << "--chain-expand needs --chain";
+    PrintSyntax();
+    exit(1);
+  }
+
   // number of tweaks:
-  if( parser.OptionExists('t') ) {
+  if(gOptChain.size() > 0) {
+    if( parser.OptionExists('t') ) {
+      LOG("grwghtnp", pWARN) << "Ignoring -t: the throws are the states of the --chain";
+    }
+    gOptNTwk = gChain.NStates();
+  } else if( parser.OptionExists('t') ) {
     LOG("grwghtnp", pINFO) << "Reading number of tweaks";
     gOptNTwk = parser.ArgAsInt('t');
 
@@ -534,6 +1366,225 @@ void GetCommandLineArgs(int argc, char ** argv)
       << "Run key set to " <<gOptRunKey;
   }
 
+  // histogram-only mode
+  gOptHistograms = "";
+  if( parser.OptionExists("histograms") ) {
+    LOG("grwghtnp", pINFO) << "Reading histogram specification";
+    gOptHistograms = parser.ArgAsString("histograms");
+    string error;
+    GReWeightIOUniverseHists hists(1);
+    if(!hists.AddVariables(gOptHistograms, error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --histograms specification: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+
+  // stored cross section preflight
+  if( parser.OptionExists("preflight") ) {
+    gOptPreflight = parser.ArgAsInt("preflight");
+  }
+  if(gOptPreflight < 0) {
+    LOG("grwghtnp", pFATAL) << "--preflight can not be negative";
+    PrintSyntax();
+    exit(1);
+  }
+
+  // sensitivity pre-pass
+  if( parser.OptionExists("sensitivity") ) {
+    gOptSensEvents = parser.ArgAsInt("sensitivity");
+  }
+  if( parser.OptionExists("sensitivity-threshold") ) {
+    gOptSensThreshold = parser.ArgAsDouble("sensitivity-threshold");
+  }
+  if( parser.OptionExists("sensitivity-action") ) {
+    string action = parser.ArgAsString("sensitivity-action");
+    if(action != "warn" && action != "drop") {
+      LOG("grwghtnp", pFATAL) << "--sensitivity-action must be warn or drop, not: " << action;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptSensDrop = (action == "drop");
+  }
+  gOptSensBinning = (gOptHistograms.size() > 0) ? gOptHistograms : "Ev:20,0,10; Q2:20,0,4";
+  if( parser.OptionExists("sensitivity-binning") ) {
+    gOptSensBinning = parser.ArgAsString("sensitivity-binning");
+  }
+  if(gOptSensEvents > 0) {
+    string error;
+    GReWeightIOUniverseHists hists(1);
+    if(!hists.AddVariables(gOptSensBinning, error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --sensitivity-binning specification: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+
+  // adaptive number of throws & antithetic throws
+  gOptAntithetic = parser.OptionExists("antithetic");
+  if( parser.OptionExists("adaptive") ) {
+    gOptAdaptTol = parser.ArgAsDouble("adaptive");
+  }
+  if( parser.OptionExists("adaptive-block") ) {
+    gOptAdaptBlock = parser.ArgAsInt("adaptive-block");
+  }
+  if(gOptChain.size() > 0 && (gOptAntithetic || gOptAdaptTol > 0. || gOptSensDrop)) {
+    LOG("grwghtnp", pFATAL)
+      << "--chain can not be used with --antithetic, --adaptive or --sensitivity-action drop";
+    PrintSyntax();
+    exit(1);
+  }
+  if(gOptAntithetic && gOptNTwk % 2 != 0) {
+    LOG("grwghtnp", pFATAL)
+      << "--antithetic needs an even number of throws, not: " << gOptNTwk;
+    PrintSyntax();
+    exit(1);
+  }
+  if(gOptAdaptBlock < 2 || (gOptAntithetic && gOptAdaptBlock % 2 != 0)) {
+    LOG("grwghtnp", pFATAL)
+      << "--adaptive-block must be at least 2 (and even with --antithetic), not: "
+      << gOptAdaptBlock;
+    PrintSyntax();
+    exit(1);
+  }
+  gOptAdaptBinning = (gOptHistograms.size() > 0) ? gOptHistograms : "Ev:20,0,10; Q2:20,0,4";
+  if( parser.OptionExists("adaptive-binning") ) {
+    gOptAdaptBinning = parser.ArgAsString("adaptive-binning");
+  }
+  if(gOptAdaptTol > 0.) {
+    string error;
+    GReWeightIOUniverseHists hists(1);
+    if(!hists.AddVariables(gOptAdaptBinning, error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --adaptive-binning specification: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+
+  // response surfaces
+  if( parser.OptionExists("response-surface") ) {
+    gOptSurfaces = parser.ArgAsString("response-surface");
+    vector<ResponseSurface_t> surfaces;
+    string error;
+    if(!ParseResponseSurfaces(gOptSurfaces, surfaces, error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --response-surface specification: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  if( parser.OptionExists("surface-tolerance") ) {
+    gOptSurfaceTol = parser.ArgAsDouble("surface-tolerance");
+  }
+
+  // table cache
+  gOptTableCache = "";
+  if( parser.OptionExists("table-cache") ) {
+    gOptTableCache = parser.ArgAsString("table-cache");
+  }
+
+  // startup timing
+  gOptStartupTiming = "";
+  if( parser.OptionExists("startup-timing") ) {
+    gOptStartupTiming = parser.ArgAsString("startup-timing");
+  }
+
+  // tracing
+  gOptTrace = "";
+  if( parser.OptionExists("trace") ) {
+    gOptTrace = parser.ArgAsString("trace");
+  }
+  if( parser.OptionExists("trace-sample") ) {
+    gOptTraceSample = parser.ArgAsLong("trace-sample");
+  }
+
+  // work blocks
+  if( parser.OptionExists("block-memory") ) {
+    gOptBlockMemory = parser.ArgAsDouble("block-memory");
+  }
+  if( parser.OptionExists("block-events") ) {
+    gOptBlockEvents = parser.ArgAsLong("block-events");
+  }
+  if( parser.OptionExists("block-throws") ) {
+    gOptBlockThrows = parser.ArgAsInt("block-throws");
+  }
+  if(gOptBlockMemory < 0. || gOptBlockEvents < 0 || gOptBlockThrows < 0) {
+    LOG("grwghtnp", pFATAL)
+      << "--block-memory, --block-events & --block-throws can not be negative";
+    PrintSyntax();
+    exit(1);
+  }
+  if( parser.OptionExists("threads") ) {
+    gOptThreads = parser.ArgAsInt("threads");
+  }
+  if(gOptThreads < 1) {
+    LOG("grwghtnp", pFATAL) << "--threads must be at least 1";
+    PrintSyntax();
+    exit(1);
+  }
+
+  // weight storage:
+  if( parser.OptionExists("weight-storage") ) {
+    LOG("grwghtnp", pINFO) << "Reading weight storage type";
+    string storage_name = parser.ArgAsString("weight-storage");
+    GReWeightIOWeightCodec::WeightStorage_t storage;
+    if(!GReWeightIOWeightCodec::FromString(storage_name, storage)) {
+      LOG("grwghtnp", pFATAL) << "Unknown weight storage type: " << storage_name;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec = GReWeightIOWeightCodec(storage);
+  }
+  if( parser.OptionExists("log-weight-range") ) {
+    vector<double> range = parser.ArgAsDoubleTokens("log-weight-range",",");
+    if(gOptWghtCodec.Storage() != GReWeightIOWeightCodec::kStoreLog16 ||
+       range.size() != 2 || range[1] <= range[0]) {
+      LOG("grwghtnp", pFATAL)
+        << "--log-weight-range needs --weight-storage log16 and lnw_min < lnw_max";
+      PrintSyntax();
+      exit(1);
+    }
+    gOptWghtCodec.SetLogRange(range[0], range[1]);
+  }
+  LOG("grwghtnp", pINFO) << "Weight storage : " << gOptWghtCodec.AsString();
+
+  // output compression & layout:
+  if( parser.OptionExists("compression") ) {
+    gOptCompression = parser.ArgAsString("compression");
+    int settings = 0;
+    if(!utils::rew::CompressionSettings(gOptCompression, settings)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --compression: " << gOptCompression;
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  if( parser.OptionExists("basket-size") ) {
+    gOptBasketSize = parser.ArgAsInt("basket-size");
+  }
+  if( parser.OptionExists("auto-flush") ) {
+    gOptAutoFlush = parser.ArgAsLong("auto-flush");
+  }
+
+  // event selection
+  if( parser.OptionExists("select") ) {
+    LOG("grwghtnp", pINFO) << "Reading event selection";
+    string error;
+    if(!gOptSelection.Compile(parser.ArgAsString("select"), error)) {
+      LOG("grwghtnp", pFATAL) << "Invalid --select expression: " << error;
+      PrintSyntax();
+      exit(1);
+    }
+  }
+  if( parser.OptionExists("rejected") ) {
+    string rejected = parser.ArgAsString("rejected");
+    if(rejected != "skip" && rejected != "unity") {
+      LOG("grwghtnp", pFATAL) << "--rejected must be skip or unity, not: " << rejected;
+      PrintSyntax();
+      exit(1);
+    }
+    gOptSkipRejected = (rejected == "skip");
+  }
+
 }
 //_________________________________________________________________________________
 void GetEventRange(Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast)
@@ -640,6 +1691,327 @@ void GetCorrelationMatrix(string fname, TMatrixD *& cmat)
   return;
 }
 //_________________________________________________________________________________
+string ConfigurationString(const TMatrixD & cmat)
+{
+  //
+  // Canonical description of everything that determines the weights,
+  // apart from the input events and the event range
+  //
+  GSystUncertainty * unc = GSystUncertainty::Instance();
+
+  std::ostringstream cfg;
+  cfg.precision(17);
+  cfg << "app: grwghtnp\n";
+  cfg << "n_tweaks: " << gOptNTwk << "\n";
+  for (unsigned int i = 0; i < gOptVSyst.size(); i++) {
+    cfg << "syst: " << GSyst::AsString(gOptVSyst[i])
+        << " central: " << gOptVCentVal[i]
+        << " err: " << unc->OneSigmaErr(gOptVSyst[i], +1)
+        << ","      << unc->OneSigmaErr(gOptVSyst[i], -1) << "\n";
+  }
+  cfg << "correlation:";
+  for (int i = 0; i < cmat.GetNrows(); i++) {
+    for (int j = 0; j < cmat.GetNcols(); j++) { cfg << " " << cmat(i,j); }
+  }
+  cfg << "\n";
+  cfg << "storage: " << gOptWghtCodec.AsString() << "\n";
+  cfg << "select: " << gOptSelection.Expression() << "\n";
+  cfg << "rejected: " << (gOptSkipRejected ? "skip" : "unity") << "\n";
+  if(gOptHistograms.size() > 0) {
+    GReWeightIOUniverseHists hists(1);
+    string error;
+    hists.AddVariables(gOptHistograms, error);
+    cfg << "histograms: " << hists.Specification() << "\n";
+  }
+  if(gOptAntithetic) cfg << "antithetic: yes\n";
+  if(gOptChain.size() > 0) {
+    cfg << "chain: " << GReWeightIOShardManifest::Hash(gChain.Digest())
+        << (gOptChainExpand ? " expanded" : "") << "\n";
+  }
+  if(gOptSurfaces.size() > 0) {
+    cfg << "response-surface: " << gOptSurfaces << " tolerance: " << gOptSurfaceTol << "\n";
+  }
+  if(gOptAdaptTol > 0.) {
+    GReWeightIOUniverseHists hists(1);
+    string error;
+    hists.AddVariables(gOptAdaptBinning, error);
+    cfg << "adaptive: " << gOptAdaptTol << " block: " << gOptAdaptBlock
+        << " binning: " << hists.Specification() << "\n";
+  }
+  return cfg.str();
+}
+//_________________________________________________________________________________
+void Preflight(
+   GReWeightPreflight & preflight, GReWeight & rw, TTree * tree,
+   NtpMCEventRecord * mcrec, const vector<bool> & selected, Long64_t nfirst)
+{
+  //
+  // Checks the stored differential cross sections of up to gOptPreflight
+  // selected events, evenly spread over the event range so that all
+  // processes & targets of the sample are met, and sets the per-process
+  // choice of stored or recomputed values of the weight calculators
+  //
+  vector<Long64_t> entries;
+  for(unsigned int i = 0; i < selected.size(); i++) {
+    if(selected[i]) entries.push_back(nfirst + i);
+  }
+  unsigned int step = TMath::Max(1, int(entries.size() / gOptPreflight));
+  for(unsigned int i = 0; i < entries.size(); i += step) {
+    tree->GetEntry(entries[i]);
+    if(mcrec->event) preflight.Check(rw, *mcrec->event);
+    mcrec->Clear();
+  }
+  preflight.Apply(rw);
+  preflight.Print();
+}
+//_________________________________________________________________________________
+vector<GSyst_t> SensitivityPrePass(
+   GReWeight & rw, TTree * tree, NtpMCEventRecord * mcrec,
+   GReWeightIOGstReader * gst, const vector<bool> & selected, Long64_t nfirst)
+{
+  //
+  // Measures the effect of each systematic, on its own at -1 & +1 sigma,
+  // on a random subsample of the selected events, and returns those with
+  // a negligible effect
+  //
+  vector<GSyst_t> negligible;
+
+  // Random subsample, drawn with its own generator
+  vector<Long64_t> entries;
+  for(unsigned int i = 0; i < selected.size(); i++) {
+    if(selected[i]) entries.push_back(nfirst + i);
+  }
+  TRandom3 rnd(gOptRanSeed >= 0 ? gOptRanSeed : 0);
+  unsigned int nsub = TMath::Min((unsigned int) gOptSensEvents, (unsigned int) entries.size());
+  for(unsigned int i = 0; i < nsub; i++) {
+    unsigned int j = i + rnd.Integer(entries.size() - i);
+    std::swap(entries[i], entries[j]);
+  }
+  entries.resize(nsub);
+  std::sort(entries.begin(), entries.end());
+
+  vector<EventRecord *> events;
+  for(unsigned int i = 0; i < nsub; i++) {
+    EventRecord * evp = 0;
+    if(gst) evp = gst->ReadEvent(entries[i]);
+    else {
+      tree->GetEntry(entries[i]);
+      evp = mcrec->event;
+    }
+    if(evp) events.push_back(new EventRecord(*evp));
+    if(mcrec) mcrec->Clear();
+  }
+  nsub = events.size();
+  if(nsub == 0) {
+    LOG("grwghtnp", pWARN) << "No events for the sensitivity pre-pass";
+    return negligible;
+  }
+
+  // -1 & +1 sigma universes of each systematic
+  const int nsyst = gOptVSyst.size();
+  GReWeightIOUniverseHists hists(2 * nsyst);
+  string error;
+  hists.AddVariables(gOptSensBinning, error); // already validated
+  const int nvars = hists.NVariables();
+  vector<int> bins(nsub * nvars);
+  GReWeightEventSummary summary;
+  for(unsigned int iev = 0; iev < nsub; iev++) {
+    summary.Fill(*events[iev]);
+    hists.FindBins(summary, &bins[iev * nvars]);
+    hists.FillNominal(0, &bins[iev * nvars]);
+  }
+
+  GSystSet & syst = rw.Systematics();
+  vector<double> cost     (nsyst, 0.);
+  vector<int>    naffected(nsyst, 0);
+  for(int is = 0; is < nsyst; is++) {
+    vector<bool> affected(nsub, false);
+    for(int isign = 0; isign < 2; isign++) {
+      syst.Set(gOptVSyst[is], (isign == 0) ? -1. : +1.);
+      rw.Reconfigure();
+      TStopwatch stopwatch;
+      stopwatch.Start();
+      for(unsigned int iev = 0; iev < nsub; iev++) {
+        double w = rw.CalcWeight(*events[iev]);
+        if(TMath::Abs(w - 1.) > 1E-6) affected[iev] = true;
+        hists.Fill(0, 2*is + isign, &bins[iev * nvars], w);
+      }
+      stopwatch.Stop();
+      cost[is] += stopwatch.RealTime();
+    }
+    syst.Set(gOptVSyst[is], 0.);
+    naffected[is] = std::count(affected.begin(), affected.end(), true);
+  }
+  rw.Reconfigure();
+  hists.Merge();
+
+  for(unsigned int iev = 0; iev < nsub; iev++) delete events[iev];
+
+  // Report
+  std::ostringstream report;
+  report << "Sensitivity of " << nsub << " events to each systematic at -1/+1 sigma"
+         << " (binning: " << hists.Specification() << "):\n";
+  for(int is = 0; is < nsyst; is++) {
+    double rate   = 0.;
+    double binned = 0.;
+    for(int isign = 0; isign < 2; isign++) {
+      int iu = 2*is + isign;
+      rate = TMath::Max(rate, TMath::Abs(hists.NormW(iu) / nsub - 1.));
+      double sum = 0.;
+      for(int ib = 0; ib < hists.NBins(); ib++) {
+        sum += TMath::Abs(hists.SumW(iu, ib) - hists.Nominal(ib));
+      }
+      binned = TMath::Max(binned, sum / (nsub * nvars));
+    }
+    bool small = (binned < gOptSensThreshold);
+    if(small) negligible.push_back(gOptVSyst[is]);
+    report << " " << GSyst::AsString(gOptVSyst[is])
+           << ": rate " << rate << ", binned " << binned
+           << ", affected events " << (100. * naffected[is]) / nsub << "%"
+           << ", " << 1E6 * cost[is] / (2 * nsub) << " us/event"
+           << (small ? " - negligible" : "") << "\n";
+  }
+  LOG("grwghtnp", pNOTICE) << report.str();
+
+  if(negligible.size() > 0 && !gOptSensDrop) {
+    for(unsigned int i = 0; i < negligible.size(); i++) {
+      LOG("grwghtnp", pWARN)
+        << GSyst::AsString(negligible[i]) << " has a negligible effect (< "
+        << gOptSensThreshold << ") on this sample; use --sensitivity-action drop to drop it";
+    }
+  }
+  return negligible;
+}
+//_________________________________________________________________________________
+bool ParseResponseSurfaces(
+  const string & spec, vector<ResponseSurface_t> & surfaces, string & error)
+{
+  //
+  // calc[:degree[:levels]][,calc[:degree[:levels]]...]
+  //
+  surfaces.clear();
+  error = "";
+  vector<string> entries = utils::str::Split(spec, ",");
+  for (unsigned int i = 0; i < entries.size(); i++) {
+    string entry = utils::str::TrimSpaces(entries[i]);
+    if(entry.size() == 0) continue;
+    vector<string> fields = utils::str::Split(entry, ":");
+    ResponseSurface_t s;
+    s.Calc   = utils::str::TrimSpaces(fields[0]);
+    s.Degree = (fields.size() > 1) ? atoi(fields[1].c_str()) : 2;
+    s.Levels = (fields.size() > 2) ? atoi(fields[2].c_str()) : s.Degree + 2;
+    if(s.Calc.size() == 0 || fields.size() > 3 || s.Degree < 1 || s.Levels <= s.Degree) {
+      error = "bad entry `" + entry + "' (calc[:degree[:levels]], levels > degree >= 1)";
+      return false;
+    }
+    surfaces.push_back(s);
+  }
+  if(surfaces.size() == 0) {
+    error = "no calculators";
+    return false;
+  }
+  return true;
+}
+//_________________________________________________________________________________
+void TrainResponseSurfaces(GReWeight & rw, vector<ResponseSurface_t> & surfaces,
+  const TMatrixD & throws, TTree * tree, NtpMCEventRecord * mcrec,
+  GReWeightIOGstReader * gst, const vector<bool> & selected,
+  Long64_t nfirst, Long64_t nlast)
+{
+  //
+  // For each calculator: run it at each training point (all other dials
+  // at 0) over all events, fit each event's response and leave the
+  // calculator out of GReWeight::CalcWeight()
+  //
+  GSystSet & syst = rw.Systematics();
+  const int nev = nlast - nfirst + 1;
+
+  for (unsigned int is = 0; is < surfaces.size(); is++) {
+    ResponseSurface_t & s = surfaces[is];
+    GReWeightI * wcalc = rw.WghtCalc(s.Calc);
+    if(!wcalc) {
+      LOG("grwghtnp", pFATAL)
+        << "--response-surface: no weight calculator " << s.Calc << " for these systematics";
+      gAbortingInErr = true;
+      exit(1);
+    }
+
+    // the calculator's dials, over the range of the throws
+    vector<double> lo, hi;
+    for (unsigned int ip = 0; ip < gOptVSyst.size(); ip++) {
+      if(!wcalc->IsHandled(gOptVSyst[ip])) continue;
+      s.Params.push_back(ip);
+      double tmin = 0., tmax = 0.;
+      for (int itk = 0; itk < throws.GetNrows(); itk++) {
+        tmin = TMath::Min(tmin, throws(itk,ip));
+        tmax = TMath::Max(tmax, throws(itk,ip));
+      }
+      if(tmax - tmin < 1E-6) { tmin -= 0.5; tmax += 0.5; }
+      lo.push_back(tmin);
+      hi.push_back(tmax);
+    }
+    string error;
+    if(!s.Surface.Configure(lo, hi, s.Degree, s.Levels, error)) {
+      LOG("grwghtnp", pFATAL)
+        << "--response-surface: can not build the response of " << s.Calc << ": " << error;
+      gAbortingInErr = true;
+      exit(1);
+    }
+    LOG("grwghtnp", pNOTICE)
+      << "Response surface of " << s.Calc << ": " << s.Surface.Description();
+
+    // the calculator's weights at the training points, then the fits, in
+    // chunks of events so that the training weights stay within kMaxTrain
+    const int npts   = s.Surface.NPoints();
+    const int ndims  = s.Surface.NDims();
+    const int nterms = s.Surface.NTerms();
+    const size_t kMaxTrain = 256*1024*1024 / sizeof(double);
+    const int nchunk = (int) TMath::Max((size_t)1, TMath::Min((size_t)nev, kMaxTrain / npts));
+    s.Coef .assign((size_t)nev * nterms, 0.);
+    s.Exact.assign(nev, false);
+    s.X    .assign(ndims,  0.);
+    s.M    .assign(nterms, 0.);
+    int    nexact = 0;
+    double sumerr = 0., maxerr = 0.;
+    vector<double> wtrain((size_t)nchunk * npts);
+    for (int ic0 = 0; ic0 < nev; ic0 += nchunk) {
+      const int ic1 = TMath::Min(nev, ic0 + nchunk);
+      std::fill(wtrain.begin(), wtrain.end(), 1.);
+      for (int ipt = 0; ipt < npts; ipt++) {
+        for (unsigned int ip = 0; ip < gOptVSyst.size(); ip++) syst.Set(gOptVSyst[ip], 0.);
+        for (int id = 0; id < ndims; id++) syst.Set(gOptVSyst[s.Params[id]], s.Surface.Point(ipt,id));
+        rw.Reconfigure();
+        for (int i = ic0; i < ic1; i++) {
+          if(!selected[i]) continue;
+          EventRecord * evp = 0;
+          if(gst) evp = gst->ReadEvent(nfirst + i);
+          else {
+            tree->GetEntry(nfirst + i);
+            evp = mcrec->event;
+          }
+          if(evp) wtrain[(size_t)(i - ic0) * npts + ipt] = rw.CalcWeight(*evp, s.Calc);
+          if(mcrec) mcrec->Clear();
+        }
+      }
+      for (int i = ic0; i < ic1; i++) {
+        double err = s.Surface.Fit(&wtrain[(size_t)(i - ic0) * npts], &s.Coef[(size_t)i * nterms]);
+        s.Exact[i] = (err > gOptSurfaceTol);
+        if(s.Exact[i]) nexact++;
+        sumerr += err;
+        maxerr  = TMath::Max(maxerr, err);
+      }
+    }
+    LOG("grwghtnp", pNOTICE)
+      << "Response surface of " << s.Calc << ": mean fit error " << sumerr/nev
+      << ", max " << maxerr << "; " << nexact << " of " << nev
+      << " events over the tolerance (" << gOptSurfaceTol << ") are recomputed";
+
+    rw.ExcludeWghtCalc(s.Calc);
+  }
+  for (unsigned int ip = 0; ip < gOptVSyst.size(); ip++) syst.Set(gOptVSyst[ip], 0.);
+  rw.Reconfigure();
+}
+//_________________________________________________________________________________
 bool FindIncompatibleSystematics(vector<GSyst_t> lsyst)
 {
   //
@@ -762,117 +2134,76 @@ bool FindIncompatibleSystematics(vector<GSyst_t> lsyst)
 
 }
 //_________________________________________________________________________________
-void AdoptWeightCalcs (vector<GSyst_t> lsyst, GReWeight & rw)
+void ReweightThrows(GReWeight * rw, int slot, int nslots, const ThrowBlock_t * blk)
 {
-  //
-  // Sets of systematics can be incompatible because they request different
-  // reweighting modes. If one of these systematics is requested, adopt a
-  // reweighting calculator and set it to the appropriate mode.
-  //
-  vector<GSyst_t>::iterator it;
-  for(it=lsyst.begin();it != lsyst.end();it++)
-  {
-    switch(*it){
-    // CC QE
-    case kXSecTwkDial_MaCCQE:
-    case kXSecTwkDial_NormCCQE:
-    case kXSecTwkDial_MaCCQEshape:
-      if ( ! rw.WghtCalc("xsec_ccqe") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ccqe weight calc";
-        rw.AdoptWghtCalc( "xsec_ccqe", new GReWeightNuXSecCCQE );
-        GReWeightNuXSecCCQE * rwccqe =
-          dynamic_cast<GReWeightNuXSecCCQE *> (rw.WghtCalc("xsec_ccqe"));
-        if (*it == kXSecTwkDial_MaCCQE) {
-               rwccqe->SetMode(GReWeightNuXSecCCQE::kModeMa); }
-        else { rwccqe->SetMode(GReWeightNuXSecCCQE::kModeNormAndMaShape); }
-      }
-    break;
-    case kXSecTwkDial_ZNormCCQE:
-    case kXSecTwkDial_ZExpA1CCQE:
-    case kXSecTwkDial_ZExpA2CCQE:
-    case kXSecTwkDial_ZExpA3CCQE:
-    case kXSecTwkDial_ZExpA4CCQE:
-      if ( ! rw.WghtCalc("xsec_ccqe") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ccqe weight calc";
-        rw.AdoptWghtCalc( "xsec_ccqe", new GReWeightNuXSecCCQE );
-        GReWeightNuXSecCCQE * rwccqe =
-          dynamic_cast<GReWeightNuXSecCCQE *> (rw.WghtCalc("xsec_ccqe"));
-        rwccqe->SetMode(GReWeightNuXSecCCQE::kModeZExp);
-      }
-    break;
-    // CC Res
-    case kXSecTwkDial_MaCCRES:
-    case kXSecTwkDial_MvCCRES:
-      if ( ! rw.WghtCalc("xsec_ccres") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ccres weight calc";
-        rw.AdoptWghtCalc( "xsec_ccres", new GReWeightNuXSecCCRES );
-        GReWeightNuXSecCCRES * rwccres =
-          dynamic_cast<GReWeightNuXSecCCRES *> (rw.WghtCalc("xsec_ccres"));
-        rwccres->SetMode(GReWeightNuXSecCCRES::kModeMaMv);
-      }
-    break;
-    case kXSecTwkDial_NormCCRES:
-    case kXSecTwkDial_MaCCRESshape:
-    case kXSecTwkDial_MvCCRESshape:
-      if ( ! rw.WghtCalc("xsec_ccres") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ccres weight calc";
-        rw.AdoptWghtCalc( "xsec_ccres", new GReWeightNuXSecCCQE );
-        GReWeightNuXSecCCQE * rwccres =
-          dynamic_cast<GReWeightNuXSecCCQE *> (rw.WghtCalc("xsec_ccres"));
-        rwccres->SetMode(GReWeightNuXSecCCRES::kModeNormAndMaMvShape);
-      }
-    break;
-    // DIS
-    case kXSecTwkDial_AhtBYshape:
-    case kXSecTwkDial_BhtBYshape:
-    case kXSecTwkDial_CV1uBYshape:
-    case kXSecTwkDial_CV2uBYshape:
-      if ( ! rw.WghtCalc("xsec_dis") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_dis weight calc";
-        rw.AdoptWghtCalc( "xsec_dis", new GReWeightNuXSecDIS );
-        GReWeightNuXSecDIS * rwdis =
-          dynamic_cast<GReWeightNuXSecDIS *> (rw.WghtCalc("xsec_dis"));
-        rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12uShape);
-      }
-    break;
-    case kXSecTwkDial_AhtBY:
-    case kXSecTwkDial_BhtBY:
-    case kXSecTwkDial_CV1uBY:
-    case kXSecTwkDial_CV2uBY:
-      if ( ! rw.WghtCalc("xsec_dis") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_dis weight calc";
-        rw.AdoptWghtCalc( "xsec_dis", new GReWeightNuXSecDIS );
-        GReWeightNuXSecDIS * rwdis =
-          dynamic_cast<GReWeightNuXSecDIS *> (rw.WghtCalc("xsec_dis"));
-        rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12u);
-      }
-    break;
-    // NC Res
-    case kXSecTwkDial_MaNCRES:
-    case kXSecTwkDial_MvNCRES:
-      if ( ! rw.WghtCalc("xsec_ncres") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ncres weight calc";
-        rw.AdoptWghtCalc( "xsec_ncres", new GReWeightNuXSecNCRES );
-        GReWeightNuXSecNCRES * rwncres =
-          dynamic_cast<GReWeightNuXSecNCRES *> (rw.WghtCalc("xsec_ncres"));
-        rwncres->SetMode(GReWeightNuXSecNCRES::kModeMaMv);
+// Computes the weights of the slot's share of the buffered events (the
+// slot-th of nslots contiguous ranges) for all throws of a work block, with
+// the slot's own weight calculators. The cross section calculators modify
+// an event's interaction while computing its weight, so no two threads may
+// share an event. The random numbers used by the weight calculators come
+// from a stream per throw & event, whatever the thread or block shape.
+
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  GSystSet & syst = rw->Systematics();
+  const TMatrixD & throws = *blk->Throws;
+  vector<ResponseSurface_t> & surfaces = *blk->Surfaces;
+  const int nvars      = (blk->Hists)     ? blk->Hists    ->NVariables() : 0;
+  const int conv_nvars = (blk->ConvHists) ? blk->ConvHists->NVariables() : 0;
+
+  // dial values & monomials of the current throw, per surface
+  vector< vector<double> > X(surfaces.size()), M(surfaces.size());
+  for (unsigned int is = 0; is < surfaces.size(); is++) {
+    X[is].resize(surfaces[is].X.size());
+    M[is].resize(surfaces[is].M.size());
+  }
+
+  const unsigned int nshare = (blk->NEvents + nslots - 1) / nslots;
+  const unsigned int iev0   = TMath::Min(blk->NEvents, slot * nshare);
+  const unsigned int iev1   = TMath::Min(blk->NEvents, iev0 + nshare);
+  if(iev0 == iev1) return;
+
+  for (int itb = 0; itb < blk->N; itb++) {
+    const int itk = blk->First + itb;
+
+    // Load tweaks into reweighting
+    for (unsigned int ip = 0; ip < gOptVSyst.size(); ip++) {
+      syst.Set(gOptVSyst[ip], throws(itk,ip));
+    }
+    rw->Reconfigure();
+    for (unsigned int is = 0; is < surfaces.size(); is++) {
+      ResponseSurface_t & s = surfaces[is];
+      for (unsigned int id = 0; id < s.Params.size(); id++) X[is][id] = throws(itk, s.Params[id]);
+      s.Surface.Monomials(&X[is][0], &M[is][0]);
+    }
+
+    for (unsigned int iev = iev0; iev < iev1; iev++) {
+      Long64_t ientry = blk->Buffer->Entry(iev);
+      GReWeightTracer::BeginEvent(ientry);
+      GReWeightServices::SetStream(itk + 1, ientry + 1);
+
+      double weight = (blk->Buffer->HasViews() && rw->HandlesEventView()) ?
+         rw->CalcWeight(blk->Buffer->View(iev)) : rw->CalcWeight(blk->Buffer->Event(iev));
+      for (unsigned int is = 0; is < surfaces.size(); is++) {
+        ResponseSurface_t & s = surfaces[is];
+        int idx = ientry - blk->NFirst;
+        weight *= (s.Exact[idx]) ? rw->CalcWeight(blk->Buffer->Event(iev), s.Calc) :
+           s.Surface.Eval(&s.Coef[(size_t)idx * s.Surface.NTerms()], &M[is][0]);
       }
-    break;
-    case kXSecTwkDial_NormNCRES:
-    case kXSecTwkDial_MaNCRESshape:
-    case kXSecTwkDial_MvNCRESshape:
-      if ( ! rw.WghtCalc("xsec_ncres") ){
-        LOG("grwghtnp", pNOTICE) << "Adopting xsec_ncres weight calc";
-        rw.AdoptWghtCalc( "xsec_ncres", new GReWeightNuXSecNCRES );
-        GReWeightNuXSecNCRES * rwncres =
-          dynamic_cast<GReWeightNuXSecNCRES *> (rw.WghtCalc("xsec_ncres"));
-        rwncres->SetMode(GReWeightNuXSecNCRES::kModeNormAndMaMvShape);
+      (*blk->Weights)[(size_t)iev * blk->N + itb] = weight;
+
+      // Startup is over once the first event is done
+      if(slot == 0 && timer->IsEnabled()) {
+        timer->Lap("rest of first event");
+        timer->Report(gOptStartupTiming);
+        timer->Disable();
       }
-    break;
-    default: // no fine-tuning needed
-    break;
-    }
-  }
+
+      if(blk->Hists)     blk->Hists    ->Fill(slot, itk, &blk->Bins    [(size_t)iev * nvars],      weight);
+      if(blk->ConvHists) blk->ConvHists->Fill(slot, itk, &blk->ConvBins[(size_t)iev * conv_nvars], weight);
+    } // event loop
+    GReWeightTracer::EndEvent();
+  } // throws of the block
+  GReWeightServices::SetStream(0);
 }
 //_________________________________________________________________________________
 void PrintSyntax(void)
@@ -882,11 +2213,40 @@ void PrintSyntax(void)
      << "grwghtnp                    \n"
      << "     -f input_event_file     \n"
      << "     -c input_covariance_file\n"
-     << "     -t num_twk              \n"
+     << "     -t num_twk | --chain chain_file \n"
      << "     -s syst1[,syst2[,...]]  \n"
      << "     -v cval1[,cval2[,...]]  \n"
+     << "    [--chain-expand]         \n"
      << "    [-n n1[,n2]]             \n"
      << "    [-r run_key]             \n"
-     << "    [-o output_weights_file]";
+     << "    [-o output_weights_file] \n"
+     << "    [--select cut_expression] \n"
+     << "    [--rejected skip|unity]  \n"
+     << "    [--preflight n_events]   \n"
+     << "    [--histograms spec1[;spec2[;...]]] \n"
+     << "    [--sensitivity n_events] \n"
+     << "    [--sensitivity-threshold threshold] \n"
+     << "    [--sensitivity-action warn|drop] \n"
+     << "    [--sensitivity-binning spec1[;spec2[;...]]] \n"
+     << "    [--adaptive tolerance]   \n"
+     << "    [--adaptive-block n_throws] \n"
+     << "    [--adaptive-binning spec1[;spec2[;...]]] \n"
+     << "    [--antithetic]           \n"
+     << "    [--response-surface calc[:degree[:levels]][,...]] \n"
+     << "    [--surface-tolerance tolerance] \n"
+     << "    [--seed random_number_seed] \n"
+     << "    [--table-cache file]     \n"
+     << "    [--startup-timing json_file] \n"
+     << "    [--trace json_file]      \n"
+     << "    [--trace-sample n]       \n"
+     << "    [--block-memory MB]      \n"
+     << "    [--block-events n_events] \n"
+     << "    [--block-throws n_throws] \n"
+     << "    [--threads n_threads]    \n"
+     << "    [--weight-storage type]  \n"
+     << "    [--log-weight-range lnw_min,lnw_max] \n"
+     << "    [--compression algorithm[:level]] \n"
+     << "    [--basket-size bytes]    \n"
+     << "    [--auto-flush n_entries]";
 }
 //_________________________________________________________________________________
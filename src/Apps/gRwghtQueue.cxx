@@ -0,0 +1,852 @@
+//____________________________________________________________________________
+/*!
+
+\program grwghtqueue
+
+\brief   A node-local job queue for reweighting jobs, for many users running
+         scans against the same few event samples at once.
+         Jobs are submitted to a spool directory shared by the users of the
+         node. A coordinator (--serve) collects the queued jobs, groups
+         those reading the same input file with the same event range,
+         selection and storage options, and runs each group as a single
+         grwghtmulti pass: the input events are read and decoded once for
+         all jobs of the group, and every job still gets its own weight
+         calculators and its own output files.
+         Jobs are grwghtmulti configuration blocks, ie one-dial scans (as
+         with grwght1scan). Correlated multi-parameter throws (grwghtnp)
+         are not supported: grwghtmulti has no such blocks, so these jobs
+         still have to be run with grwghtnp, on their own.
+
+\syntax  grwghtqueue --spool directory --submit job_file
+         grwghtqueue --spool directory --serve
+          [--gather seconds]
+          [--poll seconds]
+          [--once]
+          [--runner command]
+          [--table-cache file]
+          [--message-thresholds xml_file]
+         grwghtqueue --spool directory --status
+
+         where
+         [] is an optional argument.
+
+         --spool
+            The spool directory holding the queue. It must be writable by
+            all users submitting jobs and by the coordinator.
+         --submit
+            Validates a job file and queues it. A job file starts with
+            `key = value' lines describing the pass over the input events,
+            followed by one or more grwghtmulti configuration blocks (see
+            grwghtmulti -c), each with its own output file. Example:
+
+              input     = /data/numu_C12.ghep.root
+              events    = 0,99999
+              select    = cc && Ev<10
+
+              [ma_scan]
+              output    = weights_ma_scan.root
+              syst      = MaCCQE
+              ntwk      = 11
+              min-tweak = -2
+              max-tweak = +2
+
+            Pass keys: input (required), events (n1,n2 or n), neutrinos
+            (PDG codes), select, rejected, weight-storage, log-weight-range
+            and seed, as the corresponding grwghtmulti options. Relative
+            input & output paths are relative to the submission directory.
+            Jobs run together only if all their pass keys are identical.
+            Output files are written by the coordinator, on behalf of the
+            submitter: they must not exist, must be in directories the
+            submitter can write to, and must not be the output of another
+            queued or running job. The submitter's user id is recorded in
+            the queued job (as `uid = ...', which job files can't set).
+         --serve
+            Runs the coordinator: waits for queued jobs and runs them.
+            Each job file moves through the states (file extensions) .job
+            (queued), .run (claimed by a coordinator), .done or .failed;
+            a line appended to the finished job file gives the exit status
+            and the log file of its pass. If a pass fails, each of its jobs
+            is run on its own, so that one bad job fails alone.
+            Before running a job, the coordinator checks again that its
+            file is owned by the recorded submitter and that the submitter
+            could write its outputs; jobs failing the checks, or with an
+            output file of an earlier job still running (in this or another
+            coordinator), fail. The coordinator records its host & process
+            id next to the jobs it claims (.claim); jobs claimed by a
+            coordinator that is no longer running are stale, and are queued
+            again.
+         --gather
+            Seconds to wait, once a job is queued, for others to join its
+            pass. Default: 10
+         --poll
+            Seconds between checks of an empty queue. Default: 5
+         --once
+            Exit once the queue is empty instead of waiting for more jobs.
+         --runner
+            The command running a pass. Default: grwghtmulti
+         --table-cache
+            A table cache file (see grwghtmulti) shared by all passes, so
+            that the weight calculators' tables are built once per node.
+         --status
+            Lists the jobs in the spool directory and their states, stale
+            jobs included.
+         --message-thresholds
+            Allows users to customize the message stream thresholds.
+            The thresholds are specified using an XML file.
+            See $GENIE/config/Messenger.xml for the XML schema.
+
+\author  The GENIE Collaboration
+
+\created Oct 18, 2026
+
+\cpright Copyright (c) 2003-2018, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pwd.h>
+#include <grp.h>
+
+#include <TSystem.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/StringUtils.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GSyst.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::ostringstream;
+using std::ifstream;
+using std::ofstream;
+
+using namespace genie;
+using namespace genie::rew;
+
+// A queued job, as read from its job file
+struct QueueJob_t {
+  string              Id;       ///< job id (job file name without extension)
+  string              Input;    ///< input event file
+  map<string, string> Pass;     ///< pass options (input included)
+  vector<string>      Blocks;   ///< grwghtmulti configuration block lines
+  vector<string>      Outputs;  ///< output file of each block
+  int                 Uid;      ///< user id of the submitter (-1 if not recorded)
+};
+
+void   GetCommandLineArgs (int argc, char ** argv);
+void   PrintSyntax        (void);
+void   Submit             (void);
+void   Serve              (void);
+void   Status             (void);
+bool   ReadJob            (string fname, bool submit, QueueJob_t & job, string & error);
+string JobText            (const QueueJob_t & job);
+string PassKey            (const QueueJob_t & job);
+bool   RunPass            (const vector<QueueJob_t *> & jobs, string & log);
+void   FinishJob          (const QueueJob_t & job, bool ok, string note);
+bool   CheckOwner         (string fname, const QueueJob_t & job, string & error);
+bool   CheckOutputs       (const QueueJob_t & job, string & error);
+vector<string> OutputsInUse (string extension, const vector<string> & skip);
+bool   UserCanWrite       (int uid, string dir);
+void   ClaimJob           (string id);
+bool   IsStale            (string id, string & why);
+void   RequeueStale       (void);
+vector<string> ListJobs   (string extension);
+string SpoolPath          (string id, string extension);
+string AbsolutePath       (string path);
+string DirName            (string path);
+string ShellQuote         (string text);
+
+string gOptSpool;        ///< spool directory
+string gOptSubmit;       ///< job file to submit
+bool   gOptServe;        ///< run the coordinator?
+bool   gOptStatus;       ///< list the jobs?
+int    gOptGather;       ///< seconds to wait for jobs joining a pass
+int    gOptPoll;         ///< seconds between checks of an empty queue
+bool   gOptOnce;         ///< exit when the queue is empty?
+string gOptRunner;       ///< command running a pass
+string gOptTableCache;   ///< table cache file, if any
+
+// pass options & the corresponding grwghtmulti options
+const char * kPassKeys[][2] = {
+  { "input",            "-f"                 },
+  { "events",           "-n"                 },
+  { "neutrinos",        "-p"                 },
+  { "select",           "--select"           },
+  { "rejected",         "--rejected"         },
+  { "weight-storage",   "--weight-storage"   },
+  { "log-weight-range", "--log-weight-range" },
+  { "seed",             "--seed"             }
+};
+const int kNPassKeys = sizeof(kPassKeys) / sizeof(kPassKeys[0]);
+
+//_________________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  if(gOptSubmit.size() > 0) Submit();
+  if(gOptServe)             Serve();
+  if(gOptStatus)            Status();
+
+  return 0;
+}
+//_________________________________________________________________________________
+void Submit(void)
+{
+  QueueJob_t job;
+  string     error;
+  if(!ReadJob(gOptSubmit, true, job, error)) {
+    LOG("grwghtqueue", pFATAL) << "Invalid job file " << gOptSubmit << ": " << error;
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  // the coordinator writes the outputs on behalf of the submitter
+  job.Uid = (int) getuid();
+  if(!CheckOutputs(job, error)) {
+    LOG("grwghtqueue", pFATAL) << "Can't queue job file " << gOptSubmit << ": " << error;
+    gAbortingInErr = true;
+    exit(1);
+  }
+  vector<string> in_use = OutputsInUse(".job", vector<string>());
+  vector<string> running = OutputsInUse(".run", vector<string>());
+  in_use.insert(in_use.end(), running.begin(), running.end());
+  for(unsigned int io = 0; io < job.Outputs.size(); io++) {
+    if(std::find(in_use.begin(), in_use.end(), job.Outputs[io]) != in_use.end()) {
+      LOG("grwghtqueue", pFATAL)
+        << "Can't queue job file " << gOptSubmit
+        << ": output file of another queued or running job: " << job.Outputs[io];
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  // job ids order the queue by submission time
+  UserGroup_t * user = gSystem->GetUserInfo();
+  ostringstream id;
+  id << (long) time(0) << "." << (user ? user->fUser.Data() : "user")
+     << "." << gSystem->GetPid();
+  delete user;
+  job.Id = id.str();
+
+  // write under a temporary name & rename, so that a coordinator never
+  // sees a partial job file
+  string tmp = SpoolPath(job.Id, ".tmp");
+  ofstream out(tmp.c_str());
+  out << JobText(job);
+  out.close();
+  if(!out || gSystem->Rename(tmp.c_str(), SpoolPath(job.Id, ".job").c_str()) != 0) {
+    LOG("grwghtqueue", pFATAL) << "Can't queue the job in spool directory: " << gOptSpool;
+    gSystem->Unlink(tmp.c_str());
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  LOG("grwghtqueue", pNOTICE)
+    << "Queued job " << job.Id << " (" << job.Outputs.size()
+    << " configuration blocks on " << job.Input << ")";
+}
+//_________________________________________________________________________________
+void Serve(void)
+{
+  LOG("grwghtqueue", pNOTICE) << "Serving the job queue in: " << gOptSpool;
+
+  while(true) {
+    RequeueStale();
+
+    vector<string> queued = ListJobs(".job");
+    if(queued.size() == 0) {
+      if(gOptOnce) break;
+      gSystem->Sleep(1000 * gOptPoll);
+      continue;
+    }
+
+    // let jobs submitted at about the same time join the pass
+    if(gOptGather > 0) {
+      gSystem->Sleep(1000 * gOptGather);
+      queued = ListJobs(".job");
+    }
+
+    // claim the queued jobs (another coordinator may take some first)
+    vector<QueueJob_t *> jobs;
+    for(unsigned int i = 0; i < queued.size(); i++) {
+      string queued_file  = SpoolPath(queued[i], ".job");
+      string claimed_file = SpoolPath(queued[i], ".run");
+      if(gSystem->Rename(queued_file.c_str(), claimed_file.c_str()) != 0) continue;
+      ClaimJob(queued[i]);
+
+      QueueJob_t * job = new QueueJob_t;
+      string error;
+      if(!ReadJob(claimed_file, false, *job, error)) {
+        job->Id = queued[i];
+        FinishJob(*job, false, "invalid job file: " + error);
+        delete job;
+        continue;
+      }
+      job->Id = queued[i];
+      if(!CheckOwner(claimed_file, *job, error) || !CheckOutputs(*job, error)) {
+        FinishJob(*job, false, error);
+        delete job;
+        continue;
+      }
+      jobs.push_back(job);
+    }
+
+    // outputs must be distinct across all jobs running at once: the ones
+    // claimed now (earlier submissions first) & the ones still running in
+    // other coordinators
+    vector<string> claimed;
+    for(unsigned int i = 0; i < jobs.size(); i++) claimed.push_back(jobs[i]->Id);
+    vector<string> outputs = OutputsInUse(".run", claimed);
+    vector<QueueJob_t *> accepted;
+    for(unsigned int i = 0; i < jobs.size(); i++) {
+      QueueJob_t * job = jobs[i];
+      string clash;
+      for(unsigned int io = 0; io < job->Outputs.size(); io++) {
+        if(std::find(outputs.begin(), outputs.end(), job->Outputs[io]) != outputs.end()) {
+          clash = job->Outputs[io];
+        }
+      }
+      if(clash.size() > 0) {
+        FinishJob(*job, false, "output file already written by another job: " + clash);
+        delete job;
+        continue;
+      }
+      outputs.insert(outputs.end(), job->Outputs.begin(), job->Outputs.end());
+      accepted.push_back(job);
+    }
+    jobs = accepted;
+
+    // group the jobs by pass, in the order of submission
+    vector<string> keys;
+    map<string, vector<QueueJob_t *> > passes;
+    for(unsigned int i = 0; i < jobs.size(); i++) {
+      string key = PassKey(*jobs[i]);
+      if(passes.count(key) == 0) keys.push_back(key);
+      passes[key].push_back(jobs[i]);
+    }
+
+    for(unsigned int ip = 0; ip < keys.size(); ip++) {
+
+      const vector<QueueJob_t *> & pass = passes[keys[ip]];
+
+      LOG("grwghtqueue", pNOTICE)
+        << "Running " << pass.size() << " job(s) in a single pass over " << pass[0]->Input;
+
+      string log;
+      bool ok = RunPass(pass, log);
+      if(ok || pass.size() == 1) {
+        for(unsigned int i = 0; i < pass.size(); i++) {
+          FinishJob(*pass[i], ok, "log: " + log);
+        }
+        continue;
+      }
+
+      // isolate the failing job(s)
+      LOG("grwghtqueue", pWARN)
+        << "Pass over " << pass[0]->Input << " failed (log: " << log
+        << ") - Running its jobs one at a time";
+      for(unsigned int i = 0; i < pass.size(); i++) {
+        vector<QueueJob_t *> single(1, pass[i]);
+        bool single_ok = RunPass(single, log);
+        FinishJob(*pass[i], single_ok, "log: " + log);
+      }
+    }
+
+    for(unsigned int i = 0; i < jobs.size(); i++) delete jobs[i];
+  }
+
+  LOG("grwghtqueue", pNOTICE) << "The job queue is empty - Exiting";
+}
+//_________________________________________________________________________________
+void Status(void)
+{
+  const char * states[][2] = {
+    { ".job", "queued"  }, { ".run", "running" },
+    { ".done", "done"   }, { ".failed", "failed" }
+  };
+  ostringstream table;
+  for(int is = 0; is < 4; is++) {
+    vector<string> ids = ListJobs(states[is][0]);
+    for(unsigned int i = 0; i < ids.size(); i++) {
+      string why;
+      if(is == 1 && IsStale(ids[i], why)) {
+        table << "\n stale\t" << ids[i] << " (" << why << ")";
+        continue;
+      }
+      table << "\n " << states[is][1] << "\t" << ids[i];
+    }
+  }
+  LOG("grwghtqueue", pNOTICE) << "Jobs in " << gOptSpool << ":" << table.str();
+}
+//_________________________________________________________________________________
+bool ReadJob(string fname, bool submit, QueueJob_t & job, string & error)
+{
+  job.Uid = -1;
+
+  ifstream in(fname.c_str());
+  if(!in.good()) {
+    error = "can't read " + fname;
+    return false;
+  }
+
+  bool   in_block = false;
+  string line;
+  int    iline = 0;
+  while(std::getline(in, line)) {
+    iline++;
+    line = utils::str::TrimSpaces(line);
+    if(line.size() == 0 || line[0] == '#') continue;
+
+    ostringstream where;
+    where << "line " << iline << ": ";
+
+    if(line[0] == '[') {
+      in_block = true;
+      job.Blocks.push_back(line);
+      continue;
+    }
+    string::size_type ieq = line.find("=");
+    if(ieq == string::npos) {
+      error = where.str() + "expected `key = value': " + line;
+      return false;
+    }
+    string key   = utils::str::TrimSpaces(line.substr(0, ieq));
+    string value = utils::str::TrimSpaces(line.substr(ieq+1));
+
+    // configuration blocks are checked by grwghtmulti, except for what
+    // the coordinator relies upon
+    if(in_block) {
+      if(key == "output") {
+        if(submit) value = AbsolutePath(value);
+        job.Outputs.push_back(value);
+      }
+      if(key == "syst" && value.find_first_of(",;") != string::npos) {
+        error = where.str() + "one systematic per block (correlated throws, "
+                "as with grwghtnp, can not be queued): " + value;
+        return false;
+      }
+      if(key == "syst" && GSyst::FromString(value) == kNullSystematic) {
+        error = where.str() + "unknown systematic: " + value;
+        return false;
+      }
+      job.Blocks.push_back(key + " = " + value);
+      continue;
+    }
+
+    // the submitter, recorded by --submit
+    if(key == "uid") {
+      if(submit) {
+        error = where.str() + "the uid is recorded by grwghtqueue --submit";
+        return false;
+      }
+      job.Uid = atoi(value.c_str());
+      continue;
+    }
+
+    bool known = false;
+    for(int ik = 0; ik < kNPassKeys; ik++) known = known || (key == kPassKeys[ik][0]);
+    if(!known) {
+      error = where.str() + "unknown pass option: " + key;
+      return false;
+    }
+    if(key == "input") {
+      if(submit) value = AbsolutePath(value);
+      job.Input = value;
+    }
+    job.Pass[key] = value;
+  }
+
+  if(job.Input.size() == 0) {
+    error = "no input file";
+    return false;
+  }
+  if(submit && gSystem->AccessPathName(job.Input.c_str())) {
+    error = "can't access input file " + job.Input;
+    return false;
+  }
+  int nblocks = 0;
+  for(unsigned int i = 0; i < job.Blocks.size(); i++) {
+    if(job.Blocks[i][0] == '[') nblocks++;
+  }
+  if(nblocks == 0) {
+    error = "no configuration blocks";
+    return false;
+  }
+  if((int) job.Outputs.size() != nblocks) {
+    error = "each configuration block needs an output file";
+    return false;
+  }
+  return true;
+}
+//_________________________________________________________________________________
+string JobText(const QueueJob_t & job)
+{
+  ostringstream text;
+  text << "uid = " << job.Uid << "\n";
+  map<string, string>::const_iterator it = job.Pass.begin();
+  for( ; it != job.Pass.end(); ++it) text << it->first << " = " << it->second << "\n";
+  for(unsigned int i = 0; i < job.Blocks.size(); i++) {
+    if(job.Blocks[i][0] == '[') text << "\n";
+    text << job.Blocks[i] << "\n";
+  }
+  return text.str();
+}
+//_________________________________________________________________________________
+string PassKey(const QueueJob_t & job)
+{
+  ostringstream key;
+  map<string, string>::const_iterator it = job.Pass.begin();
+  for( ; it != job.Pass.end(); ++it) key << it->first << "=" << it->second << ";";
+  return key.str();
+}
+//_________________________________________________________________________________
+bool RunPass(const vector<QueueJob_t *> & jobs, string & log)
+{
+  const QueueJob_t & first = *jobs[0];
+
+  // the configuration blocks of all jobs, named after their job
+  string cfg_file = SpoolPath(first.Id, ".cfg");
+  ofstream cfg(cfg_file.c_str());
+  for(unsigned int ij = 0; ij < jobs.size(); ij++) {
+    const vector<string> & blocks = jobs[ij]->Blocks;
+    for(unsigned int i = 0; i < blocks.size(); i++) {
+      if(blocks[i][0] == '[') {
+        cfg << "\n[" << jobs[ij]->Id << "/" << blocks[i].substr(1) << "\n";
+      } else {
+        cfg << blocks[i] << "\n";
+      }
+    }
+  }
+  cfg.close();
+
+  ostringstream cmd;
+  cmd << gOptRunner << " -c " << ShellQuote(cfg_file);
+  for(int ik = 0; ik < kNPassKeys; ik++) {
+    map<string, string>::const_iterator it = first.Pass.find(kPassKeys[ik][0]);
+    if(it != first.Pass.end()) cmd << " " << kPassKeys[ik][1] << " " << ShellQuote(it->second);
+  }
+  if(gOptTableCache.size() > 0) cmd << " --table-cache " << ShellQuote(gOptTableCache);
+
+  log = SpoolPath(first.Id, ".log");
+  cmd << " > " << ShellQuote(log) << " 2>&1";
+
+  LOG("grwghtqueue", pINFO) << "Executing: " << cmd.str();
+  int status = gSystem->Exec(cmd.str().c_str());
+  gSystem->Unlink(cfg_file.c_str());
+  return (status == 0);
+}
+//_________________________________________________________________________________
+void FinishJob(const QueueJob_t & job, bool ok, string note)
+{
+  string claimed_file  = SpoolPath(job.Id, ".run");
+  string finished_file = SpoolPath(job.Id, ok ? ".done" : ".failed");
+  gSystem->Rename(claimed_file.c_str(), finished_file.c_str());
+  gSystem->Unlink(SpoolPath(job.Id, ".claim").c_str());
+
+  time_t now = time(0);
+  string date = ctime(&now);
+  std::ofstream out(finished_file.c_str(), std::ios::app);
+  out << "\n# " << (ok ? "done" : "failed") << " on "
+      << utils::str::TrimSpaces(date) << ", " << note << "\n";
+
+  LOG("grwghtqueue", ((ok) ? pNOTICE : pERROR))
+    << "Job " << job.Id << (ok ? " done" : " failed") << " (" << note << ")";
+}
+//_________________________________________________________________________________
+bool CheckOwner(string fname, const QueueJob_t & job, string & error)
+{
+// the job file must be owned by the submitter it records
+//
+  struct stat st;
+  if(stat(fname.c_str(), &st) != 0) {
+    error = "can't stat " + fname;
+    return false;
+  }
+  if(job.Uid < 0) {
+    error = "no submitter recorded (queue jobs with grwghtqueue --submit)";
+    return false;
+  }
+  if(st.st_uid != (uid_t) job.Uid) {
+    ostringstream msg;
+    msg << "job file owned by uid " << st.st_uid << ", not by its submitter (uid "
+        << job.Uid << ")";
+    error = msg.str();
+    return false;
+  }
+  return true;
+}
+//_________________________________________________________________________________
+bool CheckOutputs(const QueueJob_t & job, string & error)
+{
+// the outputs must be new files, distinct, in directories the submitter
+// can write to
+//
+  for(unsigned int io = 0; io < job.Outputs.size(); io++) {
+    const string & output = job.Outputs[io];
+    if(!gSystem->IsAbsoluteFileName(output.c_str())) {
+      error = "output file is not an absolute path: " + output;
+      return false;
+    }
+    if(std::count(job.Outputs.begin(), job.Outputs.end(), output) > 1) {
+      error = "output file of several configuration blocks: " + output;
+      return false;
+    }
+    if(!gSystem->AccessPathName(output.c_str())) {
+      error = "output file already exists: " + output;
+      return false;
+    }
+    if(!UserCanWrite(job.Uid, DirName(output))) {
+      ostringstream msg;
+      msg << "uid " << job.Uid << " can't write to the directory of output file: " << output;
+      error = msg.str();
+      return false;
+    }
+  }
+  return true;
+}
+//_________________________________________________________________________________
+vector<string> OutputsInUse(string extension, const vector<string> & skip)
+{
+// outputs of the jobs in a state (but the skipped ones)
+//
+  vector<string> outputs;
+  vector<string> ids = ListJobs(extension);
+  for(unsigned int i = 0; i < ids.size(); i++) {
+    if(std::find(skip.begin(), skip.end(), ids[i]) != skip.end()) continue;
+    QueueJob_t job;
+    string error;
+    if(!ReadJob(SpoolPath(ids[i], extension), false, job, error)) continue;
+    outputs.insert(outputs.end(), job.Outputs.begin(), job.Outputs.end());
+  }
+  return outputs;
+}
+//_________________________________________________________________________________
+bool UserCanWrite(int uid, string dir)
+{
+// can the user create files in the directory? (permission bits only, as
+// for the owner, a group of the user or others; no ACLs)
+//
+  struct stat st;
+  if(uid < 0 || stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return false;
+  if(uid == 0) return true;
+
+  mode_t wx = S_IWOTH | S_IXOTH;
+  if(st.st_uid == (uid_t) uid) {
+    wx = S_IWUSR | S_IXUSR;
+  } else {
+    struct passwd * pw = getpwuid((uid_t) uid);
+    if(pw) {
+      int ngroups = 64;
+      vector<gid_t> groups(ngroups);
+      if(getgrouplist(pw->pw_name, pw->pw_gid, &groups[0], &ngroups) < 0) {
+        groups.resize(ngroups);
+        getgrouplist(pw->pw_name, pw->pw_gid, &groups[0], &ngroups);
+      }
+      groups.resize(ngroups);
+      if(std::find(groups.begin(), groups.end(), st.st_gid) != groups.end()) {
+        wx = S_IWGRP | S_IXGRP;
+      }
+    }
+  }
+  return (st.st_mode & wx) == wx;
+}
+//_________________________________________________________________________________
+void ClaimJob(string id)
+{
+// record which coordinator runs a claimed job
+//
+  ofstream out(SpoolPath(id, ".claim").c_str());
+  out << gSystem->HostName() << " " << gSystem->GetPid() << "\n";
+}
+//_________________________________________________________________________________
+bool IsStale(string id, string & why)
+{
+// is a claimed job left over by a coordinator no longer running?
+//
+  ifstream in(SpoolPath(id, ".claim").c_str());
+  string host;
+  long   pid = 0;
+  if(!(in >> host >> pid)) {
+    // claimed, but the claim not written yet (or lost): stale if that was
+    // a while ago (the rename of the job file sets its change time)
+    struct stat st;
+    if(stat(SpoolPath(id, ".run").c_str(), &st) != 0) return false;
+    if(time(0) - st.st_ctime < 60) return false;
+    why = "no coordinator recorded";
+    return true;
+  }
+  if(host != gSystem->HostName()) return false;
+  if(kill((pid_t) pid, 0) == 0 || errno != ESRCH) return false;
+  ostringstream msg;
+  msg << "coordinator " << pid << " is gone";
+  why = msg.str();
+  return true;
+}
+//_________________________________________________________________________________
+void RequeueStale(void)
+{
+  vector<string> ids = ListJobs(".run");
+  for(unsigned int i = 0; i < ids.size(); i++) {
+    string why;
+    if(!IsStale(ids[i], why)) continue;
+    gSystem->Unlink(SpoolPath(ids[i], ".claim").c_str());
+    if(gSystem->Rename(SpoolPath(ids[i], ".run").c_str(), SpoolPath(ids[i], ".job").c_str()) != 0) continue;
+    LOG("grwghtqueue", pWARN) << "Queued stale job " << ids[i] << " again (" << why << ")";
+  }
+}
+//_________________________________________________________________________________
+vector<string> ListJobs(string extension)
+{
+  vector<string> ids;
+  void * dir = gSystem->OpenDirectory(gOptSpool.c_str());
+  if(!dir) return ids;
+  const char * entry = 0;
+  while((entry = gSystem->GetDirEntry(dir)) != 0) {
+    string name = entry;
+    if(name.size() > extension.size() &&
+       name.compare(name.size() - extension.size(), extension.size(), extension) == 0) {
+      ids.push_back(name.substr(0, name.size() - extension.size()));
+    }
+  }
+  gSystem->FreeDirectory(dir);
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+//_________________________________________________________________________________
+string SpoolPath(string id, string extension)
+{
+  return gOptSpool + "/" + id + extension;
+}
+//_________________________________________________________________________________
+string AbsolutePath(string path)
+{
+  if(gSystem->IsAbsoluteFileName(path.c_str())) return path;
+  return string(gSystem->WorkingDirectory()) + "/" + path;
+}
+//_________________________________________________________________________________
+string DirName(string path)
+{
+  string::size_type islash = path.rfind('/');
+  if(islash == string::npos) return ".";
+  if(islash == 0) return "/";
+  return path.substr(0, islash);
+}
+//_________________________________________________________________________________
+string ShellQuote(string text)
+{
+  string quoted = "'";
+  for(unsigned int i = 0; i < text.size(); i++) {
+    if(text[i] == '\'') quoted += "'\\''";
+    else quoted += text[i];
+  }
+  return quoted + "'";
+}
+//_________________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("grwghtqueue", pINFO) << "*** Parsing command line arguments";
+
+  // Common run options. Set defaults and read.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  // get spool directory
+  if(parser.OptionExists("spool")) {
+    gOptSpool = parser.ArgAsString("spool");
+  } else {
+    LOG("grwghtqueue", pFATAL)
+        << "Unspecified spool directory - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  if(gSystem->AccessPathName(gOptSpool.c_str())) {
+    LOG("grwghtqueue", pFATAL) << "Can't access spool directory: " << gOptSpool;
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  // what to do
+  gOptSubmit = "";
+  if(parser.OptionExists("submit")) {
+    gOptSubmit = parser.ArgAsString("submit");
+  }
+  gOptServe  = parser.OptionExists("serve");
+  gOptStatus = parser.OptionExists("status");
+  if(int(gOptSubmit.size() > 0) + int(gOptServe) + int(gOptStatus) != 1) {
+    LOG("grwghtqueue", pFATAL)
+        << "Specify one of --submit, --serve or --status - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // coordinator options
+  gOptGather = 10;
+  if(parser.OptionExists("gather")) {
+    gOptGather = parser.ArgAsInt("gather");
+  }
+  gOptPoll = 5;
+  if(parser.OptionExists("poll")) {
+    gOptPoll = parser.ArgAsInt("poll");
+  }
+  if(gOptGather < 0 || gOptPoll < 1) {
+    LOG("grwghtqueue", pFATAL)
+        << "--gather can not be negative and --poll must be at least 1";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  gOptOnce = parser.OptionExists("once");
+  gOptRunner = "grwghtmulti";
+  if(parser.OptionExists("runner")) {
+    gOptRunner = parser.ArgAsString("runner");
+  }
+  gOptTableCache = "";
+  if(parser.OptionExists("table-cache")) {
+    gOptTableCache = AbsolutePath(parser.ArgAsString("table-cache"));
+  }
+}
+//_________________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("grwghtqueue", pFATAL)
+     << "\n\n"
+     << "grwghtqueue --spool directory --submit job_file \n"
+     << "grwghtqueue --spool directory --serve \n"
+     << "    [--gather seconds]       \n"
+     << "    [--poll seconds]         \n"
+     << "    [--once]                 \n"
+     << "    [--runner command]       \n"
+     << "    [--table-cache file]     \n"
+     << "    [--message-thresholds xml_file]\n"
+     << "grwghtqueue --spool directory --status \n\n\n"
+     << " See the GENIE Physics and User manual for more details";
+}
+//_________________________________________________________________________________
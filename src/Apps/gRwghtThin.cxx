@@ -0,0 +1,736 @@
+//____________________________________________________________________________
+/*!
+
+\program grwghtthin
+
+\brief   Builds a reduced (`thinned') copy of an input GHEP event file for
+         fast, approximate fits, keeping the events that reweighting makes
+         important.
+         Every input event is first reweighted for a set of universes (one
+         at a time dial scans of the specified systematic params or, with
+         --throws, random throws of all of them). Events are then grouped
+         in strata (interaction type, scattering mode, target, Ev bin, Q2
+         bin) and, within each stratum, kept with a probability proportional
+         to the RMS of their weights over the universes (see
+         GReWeightThinning). Kept events carry the compensating weight
+         1/probability, so that weighted sums over the thinned sample are
+         unbiased estimates of the same sums over the full sample.
+         The bias and the sampling error induced by the thinning are
+         reported, for the total weight of each universe and for its ratio
+         to the nominal total, relative to the full sample.
+
+         The output file contains:
+         - the thinned event tree (`gtree' or `gst', as in the input) and
+           the input tree header, if any,
+         - a `thinwght' tree, with an entry for every thinned event entry:
+           the event number in the input file (`eventnum'), the
+           compensating weight (`weight') and the stratum index (`stratum'),
+         - a `thinbias' tree, with an entry for every universe: the full
+           sample (`full') and thinned sample (`thinned') total weights and
+           the sampling error of the latter (`sigma'), and the same for the
+           ratio to the nominal total (`ratio_full', `ratio_thinned',
+           `ratio_sigma'), and a TNamed `universes' describing them,
+         - a TNamed `thinning_report' with the printed report.
+
+\syntax  grwghtthin \
+           -f input_event_file
+           -s systematic1[,systematic2[,...]]
+          [-n n1[,n2]]
+          [-o output_file]
+          [--dials twk1[,twk2[,...]]]
+          [--throws n_throws]
+          [--fraction f]
+          [--min-per-stratum n]
+          [--ev-bins e1,e2[,...]]
+          [--q2-bins q1,q2[,...]]
+          [--chunk-size n_events]
+          [--seed random_number_seed]
+          [--table-cache file]
+          [--message-thresholds xml_file]
+
+         where
+         [] is an optional argument.
+
+         -f
+            Specifies an input file with a GHEP event tree or, if it has
+            none, a flat `gst' summary tree (as written by gntpc -f gst).
+         -s
+            Specifies the systematic params defining the universes.
+         -n
+            Specifies an event range (see grwght1scan).
+            By default all events are processed.
+         -o
+            Output file name. Default: thinned.root
+         --dials
+            Tweak dial values at which each systematic param is scanned, on
+            its own, to build the universes. Default: -1,1
+         --throws
+            Use, instead of dial scans, the specified number of universes
+            in which all systematic params are thrown from independent unit
+            Gaussians.
+         --fraction
+            Fraction of the events of each stratum to keep (on average).
+            Default: 0.1
+         --min-per-stratum
+            Minimum number of events to keep (on average) per stratum; all
+            events of smaller strata are kept. Default: 10
+         --ev-bins, --q2-bins
+            Ev (GeV) and Q2 (GeV^2) bin edges used for the strata.
+            Default: 0,0.5,1,1.5,2,3,4,6,10,20 and 0,0.1,0.2,0.5,1,2,5
+         --chunk-size
+            Number of events held in memory at a time. Default: 1000
+         --seed
+            Random number seed, for the throws and the event selection.
+         --table-cache
+            Cache file for the tables weight calculators derive at startup.
+            See grwght1scan.
+         --message-thresholds
+            Allows users to customize the message stream thresholds.
+            The thresholds are specified using an XML file.
+            See $GENIE/config/Messenger.xml for the XML schema.
+
+         The weights of all events for all universes are held in memory
+         (4 bytes per event and universe) until the selection is made.
+
+\author  The GENIE Collaboration
+
+\created Oct 18, 2026
+
+\cpright Copyright (c) 2003-2018, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <cassert>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TEntryList.h>
+#include <TNamed.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Ntuple/NtpMCTreeHeader.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/RandomGen.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/StringUtils.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightI.h"
+#include "RwFramework/GSystSet.h"
+#include "RwFramework/GSyst.h"
+#include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightEventSummary.h"
+#include "RwFramework/GReWeightThinning.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwIO/GReWeightIOEventBuffer.h"
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwCalculators/GReWeightNuXSecNCEL.h"
+#include "RwCalculators/GReWeightNuXSecCCQE.h"
+#include "RwCalculators/GReWeightNuXSecCCRES.h"
+#include "RwCalculators/GReWeightNuXSecCOH.h"
+#include "RwCalculators/GReWeightNonResonanceBkg.h"
+#include "RwCalculators/GReWeightFGM.h"
+#include "RwCalculators/GReWeightDISNuclMod.h"
+#include "RwCalculators/GReWeightResonanceDecay.h"
+#include "RwCalculators/GReWeightFZone.h"
+#include "RwCalculators/GReWeightINuke.h"
+#include "RwCalculators/GReWeightAGKY.h"
+#include "RwCalculators/GReWeightNuXSecCCQEaxial.h"
+#include "RwCalculators/GReWeightNuXSecCCQEvec.h"
+#include "RwCalculators/GReWeightNuXSecNCRES.h"
+#include "RwCalculators/GReWeightNuXSecDIS.h"
+#include "RwCalculators/GReWeightNuXSecNC.h"
+#include "RwCalculators/GReWeightXSecEmpiricalMEC.h"
+
+using std::string;
+using std::vector;
+using std::ostringstream;
+
+using namespace genie;
+using namespace genie::rew;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+void GetEventRange      (Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast);
+void AdoptWeightCalcs   (GReWeight & rw);
+void SetCalcModes       (GReWeight & rw);
+
+string          gOptInpFilename;  ///< name for input file (contains input event tree)
+string          gOptOutFilename;  ///< name for output file
+Long64_t        gOptNEvt1;        ///< range of events to process (1st input, if any)
+Long64_t        gOptNEvt2;        ///< range of events to process (2nd input, if any)
+vector<GSyst_t> gOptVSyst;        ///< systematic params defining the universes
+vector<double>  gOptDials;        ///< tweak dial values of the dial scans
+int             gOptNThrows;      ///< # of random throws (0: use dial scans)
+double          gOptFraction;     ///< fraction of events to keep per stratum
+int             gOptMinPerStratum;///< min # of events to keep per stratum
+vector<double>  gOptEvBins;       ///< Ev bin edges for the strata
+vector<double>  gOptQ2Bins;       ///< Q2 bin edges for the strata
+int             gOptChunkSize;    ///< # of events held in memory at a time
+long int        gOptRanSeed;      ///< random number seed
+string          gOptTableCache;   ///< table cache file, if any
+
+//___________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  utils::app_init::RandGen(gOptRanSeed);
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("grwghtthin", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+
+  // Get the input event sample
+  TFile file(gOptInpFilename.c_str(),"READ");
+  TTree *           tree = dynamic_cast <TTree *>           ( file.Get("gtree")  );
+  NtpMCTreeHeader * thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
+  if(!tree) {
+    tree = dynamic_cast <TTree *> ( file.Get("gst") );
+    if(!GReWeightIOGstReader::IsGstTree(tree)) tree = 0;
+  }
+  if(!tree){
+    LOG("grwghtthin", pFATAL)
+      << "Can't find a GHEP or gst tree in input file: "<< file.GetName();
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  if(thdr) {
+    LOG("grwghtthin", pNOTICE) << "Input tree header: " << *thdr;
+  }
+
+  Long64_t nev_in_file = tree->GetEntries();
+  Long64_t nfirst = 0;
+  Long64_t nlast  = 0;
+  GetEventRange(nev_in_file, nfirst, nlast);
+  Long64_t nev = (nlast - nfirst + 1);
+
+  //
+  // Universes: tweak dial values of all params in each universe
+  //
+  const int n_params = gOptVSyst.size();
+  vector< vector<double> > universes;
+  vector<string>           universe_names;
+  TRandom3 & rnd = RandomGen::Instance()->RndGen();
+  if(gOptNThrows > 0) {
+    for(int it = 0; it < gOptNThrows; it++) {
+      vector<double> twk(n_params, 0.);
+      ostringstream name;
+      name << "throw " << it << ":";
+      for(int ip = 0; ip < n_params; ip++) {
+        twk[ip] = rnd.Gaus(0., 1.);
+        name << " " << GSyst::AsString(gOptVSyst[ip]) << "=" << twk[ip];
+      }
+      universes.push_back(twk);
+      universe_names.push_back(name.str());
+    }
+  } else {
+    for(int ip = 0; ip < n_params; ip++) {
+      for(unsigned int id = 0; id < gOptDials.size(); id++) {
+        vector<double> twk(n_params, 0.);
+        twk[ip] = gOptDials[id];
+        ostringstream name;
+        name << GSyst::AsString(gOptVSyst[ip]) << "=" << gOptDials[id];
+        universes.push_back(twk);
+        universe_names.push_back(name.str());
+      }
+    }
+  }
+  const int n_univ = universes.size();
+
+  LOG("grwghtthin", pNOTICE)
+    << "\n"
+    << "\n** grwghtthin: Will start processing events promptly."
+    << "\nHere is a summary of inputs: "
+    << "\n - Input event file: " << gOptInpFilename
+    << "\n - Processing: " << nev << " events in the range [" << nfirst << ", " << nlast << "]"
+    << "\n - Universes: " << n_univ << ((gOptNThrows > 0) ? " throws" : " dial values")
+    << " of " << n_params << " params"
+    << "\n - Fraction of events to keep: " << gOptFraction
+    << " (at least " << gOptMinPerStratum << " per stratum)"
+    << "\n - Weights held in memory: " << (4. * nev * n_univ) / (1024.*1024.) << " MB"
+    << "\n - Output file: " << gOptOutFilename
+    << "\n\n";
+
+  // Load the derived calculator tables from the cache, if one is used
+  if(gOptTableCache.size() > 0) {
+    GReWeightTableCache::Instance()->Open(gOptTableCache);
+  }
+
+  GReWeight rw;
+  AdoptWeightCalcs(rw);
+  SetCalcModes(rw);
+  GSystSet & syst = rw.Systematics();
+  for(int ip = 0; ip < n_params; ip++) {
+    syst.Init(gOptVSyst[ip]);
+  }
+
+  //
+  // Reweight all events for all universes, one chunk of events at a time
+  //
+
+  GReWeightIOEventBuffer * buffer = new GReWeightIOEventBuffer(tree, gOptChunkSize);
+  if(buffer->GstReader()) {
+    bool ok = true;
+    for(int ip = 0; ip < n_params; ip++) {
+      string why;
+      if(buffer->GstReader()->CanReweight(gOptVSyst[ip], why)) continue;
+      LOG("grwghtthin", pFATAL)
+        << GSyst::AsString(gOptVSyst[ip]) << " can not be reweighted from a gst tree: " << why;
+      ok = false;
+    }
+    if(!ok) {
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  vector<float>    weights;   // [event * n_univ + universe]
+  vector<Long64_t> entries;   // input tree entry of each event
+  vector<string>   strata;    // stratum of each event
+  weights.reserve((size_t) nev * n_univ);
+  entries.reserve(nev);
+  strata .reserve(nev);
+
+  GReWeightThinning thinning;
+  thinning.SetFraction      (gOptFraction);
+  thinning.SetMinPerStratum (gOptMinPerStratum);
+  if(gOptEvBins.size() > 0) thinning.SetEvBins(gOptEvBins);
+  if(gOptQ2Bins.size() > 0) thinning.SetQ2Bins(gOptQ2Bins);
+
+  GReWeightEventSummary summary;
+  for(Long64_t ichunk = nfirst; ichunk <= nlast; ichunk += buffer->Capacity()) {
+
+    unsigned int nbuf = buffer->Fill(ichunk, nlast);
+    if(nbuf == 0) continue;
+
+    LOG("grwghtthin", pNOTICE)
+       << "***** Currently at event number: "<< ichunk;
+
+    size_t first = entries.size();
+    for(unsigned int iev = 0; iev < nbuf; iev++) {
+      summary.Fill(buffer->Event(iev));
+      entries.push_back(buffer->Entry(iev));
+      strata .push_back(thinning.StratumName(summary));
+    }
+    weights.resize((first + nbuf) * n_univ, 1.);
+
+    for(int iu = 0; iu < n_univ; iu++) {
+      for(int ip = 0; ip < n_params; ip++) {
+        syst.Set(gOptVSyst[ip], universes[iu][ip]);
+      }
+      rw.Reconfigure();
+      for(unsigned int iev = 0; iev < nbuf; iev++) {
+        weights[(first + iev) * n_univ + iu] = rw.CalcWeight(buffer->Event(iev));
+      }
+    } // universes
+  } // chunks
+  delete buffer;
+
+  //
+  // Select the events to keep
+  //
+
+  int nread = entries.size();
+  for(int iev = 0; iev < nread; iev++) {
+    thinning.AddEvent(strata[iev],
+       GReWeightThinning::Importance(&weights[(size_t) iev * n_univ], n_univ));
+  }
+  strata.clear();
+  thinning.Select(rnd);
+
+  //
+  // Bias & sampling error of the thinned sample, relative to the full one
+  //
+
+  ostringstream report;
+  report.precision(4);
+  GReWeightThinning::Sum nominal = thinning.Total(0, 1);
+  report << "Kept " << thinning.NSelected() << " of " << nread << " events in "
+         << thinning.NStrata() << " strata, effective sample size "
+         << thinning.EffectiveSize() << "\n"
+         << "Nominal total: full " << nominal.Full << ", thinned " << nominal.Thinned
+         << " +/- " << nominal.Sigma << "\n"
+         << "Per universe: relative bias & expected sampling error of the total,"
+         << " and of its ratio to the nominal total\n";
+
+  double chi2 = 0.;
+  vector<GReWeightThinning::Sum> totals(n_univ), ratios(n_univ);
+  for(int iu = 0; iu < n_univ; iu++) {
+    GReWeightThinning::Sum & t = totals[iu];
+    GReWeightThinning::Sum & r = ratios[iu];
+    t = thinning.Total(&weights[iu], n_univ);
+
+    // the ratio to the nominal total, & its error by linearization
+    r.Full    = t.Full / nominal.Full;
+    r.Thinned = t.Thinned / nominal.Thinned;
+    r.Sigma   = thinning.Total(&weights[iu], n_univ, r.Full).Sigma / nominal.Full;
+
+    double pull = (r.Sigma > 0.) ? (r.Thinned - r.Full) / r.Sigma : 0.;
+    chi2 += pull * pull;
+    report << " " << universe_names[iu]
+           << ": total " << (t.Thinned / t.Full - 1.) << " +/- " << (t.Sigma / t.Full)
+           << ", ratio " << (r.Thinned / r.Full - 1.) << " +/- " << (r.Sigma / r.Full)
+           << " (pull " << pull << ")\n";
+  }
+  report << "Ratio pulls: chi2/ndf = " << chi2 << "/" << n_univ;
+  LOG("grwghtthin", pNOTICE) << "Thinning report:\n" << report.str();
+
+  //
+  // Write the thinned sample
+  //
+
+  TFile out(gOptOutFilename.c_str(), "RECREATE");
+  if(out.IsZombie()) {
+    LOG("grwghtthin", pFATAL) << "Can't create output file: " << gOptOutFilename;
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  TEntryList elist("thin_entries", "thinned events");
+  elist.SetTree(tree);
+  for(int iev = 0; iev < nread; iev++) {
+    if(thinning.Selected(iev)) elist.Enter(entries[iev]);
+  }
+  tree->SetBranchStatus("*", 1);
+  tree->SetEntryList(&elist);
+  out.cd();
+  TTree * thin_tree = tree->CopyTree("");
+  tree->SetEntryList(0);
+  thin_tree->Write();
+  if(thdr) thdr->Write("header");
+
+  int    branch_eventnum = 0;
+  double branch_weight   = 0.;
+  int    branch_stratum  = 0;
+  TTree * wght_tree = new TTree("thinwght", "GENIE thinning weights");
+  wght_tree->Branch("eventnum", &branch_eventnum);
+  wght_tree->Branch("weight",   &branch_weight);
+  wght_tree->Branch("stratum",  &branch_stratum);
+  for(int iev = 0; iev < nread; iev++) {
+    if(!thinning.Selected(iev)) continue;
+    branch_eventnum = entries[iev];
+    branch_weight   = thinning.Weight(iev);
+    branch_stratum  = thinning.Stratum(iev);
+    wght_tree->Fill();
+  }
+  wght_tree->Write();
+
+  double full, thinned, sigma, ratio_full, ratio_thinned, ratio_sigma;
+  TTree * bias_tree = new TTree("thinbias", "GENIE thinning bias per universe");
+  bias_tree->Branch("full",          &full);
+  bias_tree->Branch("thinned",       &thinned);
+  bias_tree->Branch("sigma",         &sigma);
+  bias_tree->Branch("ratio_full",    &ratio_full);
+  bias_tree->Branch("ratio_thinned", &ratio_thinned);
+  bias_tree->Branch("ratio_sigma",   &ratio_sigma);
+  ostringstream universe_list;
+  for(int iu = 0; iu < n_univ; iu++) {
+    full          = totals[iu].Full;
+    thinned       = totals[iu].Thinned;
+    sigma         = totals[iu].Sigma;
+    ratio_full    = ratios[iu].Full;
+    ratio_thinned = ratios[iu].Thinned;
+    ratio_sigma   = ratios[iu].Sigma;
+    bias_tree->Fill();
+    universe_list << iu << ": " << universe_names[iu] << "\n";
+  }
+  bias_tree->Write();
+
+  ostringstream strata_list;
+  for(int is = 0; is < thinning.NStrata(); is++) {
+    strata_list << is << ": " << thinning.StratumName(is) << "\n";
+  }
+  TNamed universes_named ("universes",       universe_list.str().c_str());
+  TNamed strata_named    ("strata",          strata_list.str().c_str());
+  TNamed report_named    ("thinning_report", report.str().c_str());
+  universes_named.Write();
+  strata_named.Write();
+  report_named.Write();
+  out.Close();
+
+  // Store any derived calculator tables built in this job
+  GReWeightTableCache::Instance()->Save();
+
+  // Close event file
+  file.Close();
+
+  LOG("grwghtthin", pNOTICE)
+    << "Thinned sample saved in " << gOptOutFilename;
+  LOG("grwghtthin", pNOTICE)  << "Done!";
+
+  return 0;
+}
+//___________________________________________________________________
+void AdoptWeightCalcs(GReWeight & rw)
+{
+  rw.AdoptWghtCalc( "xsec_ncel",       new GReWeightNuXSecNCEL      );
+  rw.AdoptWghtCalc( "xsec_ccqe",       new GReWeightNuXSecCCQE      );
+  rw.AdoptWghtCalc( "xsec_ccqe_axial", new GReWeightNuXSecCCQEaxial );
+  rw.AdoptWghtCalc( "xsec_ccqe_vec",   new GReWeightNuXSecCCQEvec   );
+  rw.AdoptWghtCalc( "xsec_ccres",      new GReWeightNuXSecCCRES     );
+  rw.AdoptWghtCalc( "xsec_ncres",      new GReWeightNuXSecNCRES     );
+  rw.AdoptWghtCalc( "xsec_nonresbkg",  new GReWeightNonResonanceBkg );
+  rw.AdoptWghtCalc( "xsec_coh",        new GReWeightNuXSecCOH       );
+  rw.AdoptWghtCalc( "xsec_dis",        new GReWeightNuXSecDIS       );
+  rw.AdoptWghtCalc( "nuclear_qe",      new GReWeightFGM             );
+  rw.AdoptWghtCalc( "nuclear_dis",     new GReWeightDISNuclMod      );
+  rw.AdoptWghtCalc( "hadro_res_decay", new GReWeightResonanceDecay  );
+  rw.AdoptWghtCalc( "hadro_fzone",     new GReWeightFZone           );
+  rw.AdoptWghtCalc( "hadro_intranuke", new GReWeightINuke           );
+  rw.AdoptWghtCalc( "hadro_agky",      new GReWeightAGKY            );
+  rw.AdoptWghtCalc( "xsec_nc",         new GReWeightNuXSecNC        );
+  rw.AdoptWghtCalc( "xsec_empmec",     new GReWeightXSecEmpiricalMEC);
+}
+//___________________________________________________________________
+void SetCalcModes(GReWeight & rw)
+{
+  // Modes implied by the params (as in grwght1scan)
+  for(unsigned int is = 0; is < gOptVSyst.size(); is++) {
+    GSyst_t s = gOptVSyst[is];
+    if ( s == kXSecTwkDial_MaCCQE ) {
+      GReWeightNuXSecCCQE * rwccqe =
+        dynamic_cast<GReWeightNuXSecCCQE *> (rw.WghtCalc("xsec_ccqe"));
+      rwccqe->SetMode(GReWeightNuXSecCCQE::kModeMa);
+    }
+    else if ( s == kXSecTwkDial_MaCCRES || s == kXSecTwkDial_MvCCRES ) {
+      GReWeightNuXSecCCRES * rwccres =
+        dynamic_cast<GReWeightNuXSecCCRES *> (rw.WghtCalc("xsec_ccres"));
+      rwccres->SetMode(GReWeightNuXSecCCRES::kModeMaMv);
+    }
+    else if ( s == kXSecTwkDial_MaNCRES || s == kXSecTwkDial_MvNCRES ) {
+      GReWeightNuXSecNCRES * rwncres =
+        dynamic_cast<GReWeightNuXSecNCRES *> (rw.WghtCalc("xsec_ncres"));
+      rwncres->SetMode(GReWeightNuXSecNCRES::kModeMaMv);
+    }
+    else if ( s == kXSecTwkDial_AhtBYshape  || s == kXSecTwkDial_BhtBYshape  ||
+              s == kXSecTwkDial_CV1uBYshape || s == kXSecTwkDial_CV2uBYshape ) {
+      GReWeightNuXSecDIS * rwdis =
+        dynamic_cast<GReWeightNuXSecDIS *> (rw.WghtCalc("xsec_dis"));
+      rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12uShape);
+    }
+  }
+}
+//___________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("grwghtthin", pINFO) << "*** Parsing command line arguments";
+
+  // Common run options. Set defaults and read.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  // get GENIE event sample
+  if(parser.OptionExists('f')) {
+    LOG("grwghtthin", pINFO) << "Reading event sample filename";
+    gOptInpFilename = parser.ArgAsString('f');
+  } else {
+    LOG("grwghtthin", pFATAL)
+        << "Unspecified input filename - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // output file
+  if(parser.OptionExists('o')) {
+    gOptOutFilename = parser.ArgAsString('o');
+  } else {
+    gOptOutFilename = "thinned.root";
+  }
+
+  // range of event numbers to process
+  if ( parser.OptionExists('n') ) {
+    //
+    LOG("grwghtthin", pINFO) << "Reading number of events to analyze";
+    string nev =  parser.ArgAsString('n');
+    if (nev.find(",") != string::npos) {
+      vector<long> vecn = parser.ArgAsLongTokens('n',",");
+      if(vecn.size()!=2) {
+         LOG("grwghtthin", pFATAL) << "Invalid syntax";
+         gAbortingInErr = true;
+         PrintSyntax();
+         exit(1);
+      }
+      // User specified a comma-separated set of values n1,n2.
+      // Use [n1,n2] as the event range to process.
+      gOptNEvt1 = vecn[0];
+      gOptNEvt2 = vecn[1];
+    } else {
+      // User specified a single number n.
+      // Use [0,n] as the event range to process.
+      gOptNEvt1 = -1;
+      gOptNEvt2 = parser.ArgAsLong('n');
+    }
+  } else {
+    LOG("grwghtthin", pINFO)
+      << "Unspecified number of events to analyze - Use all";
+    gOptNEvt1 = -1;
+    gOptNEvt2 = -1;
+  }
+
+  // systematic params
+  if( parser.OptionExists('s') ) {
+    LOG("grwghtthin", pINFO) << "Reading systematic params";
+    vector<string> names = utils::str::Split(parser.ArgAsString('s'), ",");
+    for(unsigned int i = 0; i < names.size(); i++) {
+      GSyst_t s = GSyst::FromString(utils::str::TrimSpaces(names[i]));
+      if(s == kNullSystematic) {
+        LOG("grwghtthin", pFATAL) << "Unknown systematic param: " << names[i];
+        gAbortingInErr = true;
+        PrintSyntax();
+        exit(1);
+      }
+      gOptVSyst.push_back(s);
+    }
+  } else {
+    LOG("grwghtthin", pFATAL)
+        << "Unspecified systematic params - Exiting";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // universes
+  gOptDials.clear();
+  if( parser.OptionExists("dials") ) {
+    gOptDials = parser.ArgAsDoubleTokens("dials",",");
+  } else {
+    gOptDials.push_back(-1.);
+    gOptDials.push_back(+1.);
+  }
+  gOptNThrows = 0;
+  if( parser.OptionExists("throws") ) {
+    gOptNThrows = parser.ArgAsInt("throws");
+  }
+  if(gOptDials.size() == 0 && gOptNThrows < 1) {
+    LOG("grwghtthin", pFATAL) << "No universes: give --dials values or --throws > 0";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+
+  // thinning
+  gOptFraction = 0.1;
+  if( parser.OptionExists("fraction") ) {
+    gOptFraction = parser.ArgAsDouble("fraction");
+  }
+  gOptMinPerStratum = 10;
+  if( parser.OptionExists("min-per-stratum") ) {
+    gOptMinPerStratum = parser.ArgAsInt("min-per-stratum");
+  }
+  if(gOptFraction <= 0. || gOptFraction > 1. || gOptMinPerStratum < 0) {
+    LOG("grwghtthin", pFATAL)
+      << "--fraction must be in (0,1] and --min-per-stratum non-negative";
+    gAbortingInErr = true;
+    PrintSyntax();
+    exit(1);
+  }
+  gOptEvBins.clear();
+  if( parser.OptionExists("ev-bins") ) {
+    gOptEvBins = parser.ArgAsDoubleTokens("ev-bins",",");
+  }
+  gOptQ2Bins.clear();
+  if( parser.OptionExists("q2-bins") ) {
+    gOptQ2Bins = parser.ArgAsDoubleTokens("q2-bins",",");
+  }
+
+  // chunk size
+  if( parser.OptionExists("chunk-size") ) {
+    LOG("grwghtthin", pINFO) << "Reading chunk size";
+    gOptChunkSize = parser.ArgAsInt("chunk-size");
+    if(gOptChunkSize < 1) {
+      LOG("grwghtthin", pFATAL) << "Chunk size must be positive - Exiting";
+      gAbortingInErr = true;
+      PrintSyntax();
+      exit(1);
+    }
+  } else {
+    gOptChunkSize = 1000;
+  }
+
+  // random number seed
+  if( parser.OptionExists("seed") ) {
+    LOG("grwghtthin", pINFO) << "Reading random number seed";
+    gOptRanSeed = parser.ArgAsLong("seed");
+  } else {
+    LOG("grwghtthin", pINFO) << "Unspecified random number seed - Using default";
+    gOptRanSeed = -1;
+  }
+
+  // table cache
+  gOptTableCache = "";
+  if( parser.OptionExists("table-cache") ) {
+    gOptTableCache = parser.ArgAsString("table-cache");
+  }
+}
+//_________________________________________________________________________________
+void GetEventRange(Long64_t nev_in_file, Long64_t & nfirst, Long64_t & nlast)
+{
+  nfirst = 0;
+  nlast  = 0;
+
+  if(gOptNEvt1>=0 && gOptNEvt2>=0) {
+    // Input was `-n N1,N2'.
+    // Process events [N1,N2].
+    // Note: Incuding N1 and N2.
+    nfirst = gOptNEvt1;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2>=0) {
+    // Input was `-n N'.
+    // Process first N events [0,N).
+    // Note: Event N is not included.
+    nfirst = 0;
+    nlast  = TMath::Min(nev_in_file-1, gOptNEvt2-1);
+  }
+  else
+  if(gOptNEvt1<0 && gOptNEvt2<0) {
+    // No input. Process all events.
+    nfirst = 0;
+    nlast  = nev_in_file-1;
+  }
+
+  assert(nfirst <= nlast && nfirst >= 0 && nlast <= nev_in_file-1);
+}
+//_________________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("grwghtthin", pFATAL)
+     << "\n\n"
+     << "grwghtthin                   \n"
+     << "     -f input_event_file     \n"
+     << "     -s syst1[,syst2[,...]]  \n"
+     << "    [-n n1[,n2]]             \n"
+     << "    [-o output_file]         \n"
+     << "    [--dials twk1[,twk2[,...]]] \n"
+     << "    [--throws n_throws]      \n"
+     << "    [--fraction f]           \n"
+     << "    [--min-per-stratum n]    \n"
+     << "    [--ev-bins e1,e2[,...]]  \n"
+     << "    [--q2-bins q1,q2[,...]]  \n"
+     << "    [--chunk-size n_events]  \n"
+     << "    [--seed random_number_seed] \n"
+     << "    [--table-cache file]     \n"
+     << "    [--message-thresholds xml_file]\n\n\n"
+     << " See the GENIE Physics and User manual for more details";
+}
+//_________________________________________________________________________________
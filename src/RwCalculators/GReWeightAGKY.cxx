@@ -8,13 +8,16 @@
 */
 //____________________________________________________________________________
 
+#include <sstream>
+#include <vector>
+
 #include <TLorentzVector.h>
-#include <TGenPhaseSpace.h>
 #include <TF1.h>
-#include <TH2F.h>
+#include <TRandom3.h>
 #include <TMath.h>
 #include <TFile.h>
 #include <TNtupleD.h>
+#include <TVectorD.h>
 
 // GENIE/Generator includes
 #include "Framework/Conventions/Controls.h"
@@ -28,11 +31,24 @@
 #include "RwCalculators/GReWeightAGKY.h"
 #include "RwCalculators/GReWeightUtils.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightTracer.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
 using namespace genie::constants;
 
+namespace {
+  // bin of x on a fixed-width axis, as TAxis::FindBin (0: underflow, nbin+1: overflow)
+  int FindBin(double x, int nbin, double xmin, double xmax)
+  {
+    if(x <  xmin) return 0;
+    if(x >= xmax) return nbin+1;
+    return 1 + (int) (nbin * (x-xmin) / (xmax-xmin));
+  }
+}
+
 //_______________________________________________________________________________________
 GReWeightAGKY::GReWeightAGKY() :
 GReWeightModel("AGKY")
@@ -143,6 +159,8 @@ double GReWeightAGKY::RewxFpT1pi(const EventRecord & event)
   bool tweaked = (PT2tweaked || XFtweaked);
   if(!tweaked) return 1.;
 
+  GReWeightTraceSpan span("AGKY RewxFpT1pi", "calc");
+
   //
   // Did the hadronization code produced a `nucleon+pion' system?
   // If yes, keep the nucleon xF and pT (in HCM) for event reweighting.
@@ -255,60 +273,78 @@ double GReWeightAGKY::RewxFpT1pi(const EventRecord & event)
   }
 
   // Default and tweaked nucleon xF:pT2 distribution at given W and for
-  // given tweaking dials.
-  Double_t masses[2] = { kNucleonMass, kPionMass } ;
-  int ndec=20000;
-  int nbin=20;
-  RandomGen * rnd = RandomGen::Instance();
-  TLorentzVector ph(0,0,0,W);
-  TGenPhaseSpace phspgen;
-  phspgen.SetDecay(ph, 2, masses);
-  TH2F hdef("hdef","def xF:pT2 at given W", nbin, fXFmin, fXFmax, nbin, fPT2min, fPT2max);
-  TH2F htwk("htwk","twk xF:pT2 at given W", nbin, fXFmin, fXFmax, nbin, fPT2min, fPT2max);
-  for (Int_t n=0;n<ndec;n++) {
-    double dec_weight = phspgen.Generate();
-    TLorentzVector * nucp4 = phspgen.GetDecay(0);
-    double dec_px=nucp4->Px();
-    double dec_py=nucp4->Py();
-    double dec_pz=nucp4->Pz();
+  // given tweaking dials. The nucleon-pion decay is sampled isotropically
+  // at the hadronic CM (all two-body phase space points weigh the same) and
+  // binned in (nbin+2)^2 arrays laid out as a TH2F, under/overflows included.
+  const int ndec = 20000;
+  const int nbin = 20;
+  double m1 = kNucleonMass;
+  double m2 = kPionMass;
+  if(W <= m1 + m2) return 1.;
+  double pstar = TMath::Sqrt((W*W-(m1+m2)*(m1+m2))*(W*W-(m1-m2)*(m1-m2))) / (2.*W);
+
+  // GENIE's hadronization generator, unless the thread has a stream
+  TRandom3 & rnd = (GReWeightServices::HasStream()) ?
+     GReWeightServices::Random() : RandomGen::Instance()->RndHadro();
+
+  std::vector<double> hdef((nbin+2)*(nbin+2), 0.);
+  std::vector<double> htwk((nbin+2)*(nbin+2), 0.);
+
+  double fpT2max    = 1.1 * fBaryonXFpdf    ->GetMaximum(fXFmin, fXFmax );
+  double fxFmax     = 1.1 * fBaryonPT2pdf   ->GetMaximum(fPT2min,fPT2max);
+  double fpT2maxTwk = 1.1 * fBaryonXFpdfTwk ->GetMaximum(fXFmin, fXFmax );
+  double fxFmaxTwk  = 1.1 * fBaryonPT2pdfTwk->GetMaximum(fPT2min,fPT2max);
+
+  for (int n=0;n<ndec;n++) {
+    double costh = 2.*rnd.Rndm() - 1.;
+    double phi   = 2.*kPi*rnd.Rndm();
+    double sinth = TMath::Sqrt(TMath::Max(0., 1.-costh*costh));
+    double dec_px = pstar*sinth*TMath::Cos(phi);
+    double dec_py = pstar*sinth*TMath::Sin(phi);
+    double dec_pz = pstar*costh;
     double dec_pT2 = dec_px*dec_px+dec_py*dec_py;
     double dec_xF  = dec_pz/(W/2.);
+    int    ibin    = FindBin(dec_xF,  nbin, fXFmin,  fXFmax ) * (nbin+2) +
+                     FindBin(dec_pT2, nbin, fPT2min, fPT2max);
 
-    double fpT2max = 1.1 * fBaryonXFpdf ->GetMaximum(fXFmin, fXFmax );
-    double fxFmax  = 1.1 * fBaryonPT2pdf->GetMaximum(fPT2min,fPT2max);
-    double fpT2rnd = fpT2max * rnd->RndHadro().Rndm();
-    double fxFrnd  = fxFmax  * rnd->RndHadro().Rndm();
+    double fpT2rnd = fpT2max * rnd.Rndm();
+    double fxFrnd  = fxFmax  * rnd.Rndm();
     double fpT2pdf = fBaryonPT2pdf->Eval(dec_pT2);
     double fxFpdf  = fBaryonXFpdf ->Eval(dec_xF );
     if(fxFrnd < fxFpdf && fpT2rnd < fpT2pdf) {
-      hdef.Fill(dec_xF, dec_pT2, dec_weight);
+      hdef[ibin] += 1.;
     }
 
-    fpT2max = 1.1 * fBaryonXFpdfTwk ->GetMaximum(fXFmin, fXFmax );
-    fxFmax  = 1.1 * fBaryonPT2pdfTwk->GetMaximum(fPT2min,fPT2max);
-    fpT2rnd = fpT2max * rnd->RndHadro().Rndm();
-    fxFrnd  = fxFmax  * rnd->RndHadro().Rndm();
+    fpT2rnd = fpT2maxTwk * rnd.Rndm();
+    fxFrnd  = fxFmaxTwk  * rnd.Rndm();
     fpT2pdf = fBaryonPT2pdfTwk->Eval(dec_pT2);
     fxFpdf  = fBaryonXFpdfTwk ->Eval(dec_xF );
     if(fxFrnd < fxFpdf && fpT2rnd < fpT2pdf) {
-      htwk.Fill(dec_xF, dec_pT2, dec_weight);
+      htwk[ibin] += 1.;
     }
   }//ndec
 
-  double Idef = hdef.Integral("width");
-  double Itwk = htwk.Integral("width");
-  if(Idef > 0 && Itwk > 0) {
-     hdef.Scale(1./hdef.Integral("width"));
-     htwk.Scale(1./htwk.Integral("width"));
-  } else {
+  // integrals over the in-range bins, times the bin area
+  double Idef = 0.;
+  double Itwk = 0.;
+  for(int i = 1; i <= nbin; i++) {
+    for(int j = 1; j <= nbin; j++) {
+      Idef += hdef[i*(nbin+2)+j];
+      Itwk += htwk[i*(nbin+2)+j];
+    }
+  }
+  double area = (fXFmax-fXFmin) * (fPT2max-fPT2min) / (nbin*nbin);
+  Idef *= area;
+  Itwk *= area;
+  if(Idef <= 0 || Itwk <= 0) {
      return 1.;
   }
 
-  int xfbin  = hdef.GetXaxis()->FindBin(XF);
-  int pt2bin = hdef.GetYaxis()->FindBin(PT2);
+  int ibin = FindBin(XF,  nbin, fXFmin,  fXFmax ) * (nbin+2) +
+             FindBin(PT2, nbin, fPT2min, fPT2max);
 
-  double prob_def = hdef.GetBinContent(xfbin,pt2bin);
-  double prob_twk = htwk.GetBinContent(xfbin,pt2bin);
+  double prob_def = hdef[ibin] / Idef;
+  double prob_twk = htwk[ibin] / Itwk;
   if(prob_def <= 0 || prob_twk < 0) {
     return 1.;
   }
@@ -324,6 +360,8 @@ double GReWeightAGKY::RewxFpT1pi(const EventRecord & event)
 //_______________________________________________________________________________________
 void GReWeightAGKY::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   this->RewNue    (true);
   this->RewNuebar (true);
   this->RewNumu   (true);
@@ -345,8 +383,24 @@ void GReWeightAGKY::Init(void)
   fBaryonPT2pdf = new TF1("fBaryonPT2pdf",
                    "exp(-0.214-6.625*x)", fPT2min, fPT2max);
 
-  fI0XFpdf  = fBaryonXFpdf ->Integral(fXFmin, fXFmax);
-  fI0PT2pdf = fBaryonPT2pdf->Integral(fPT2min,fPT2max);
+  // default pdf normalizations (from the table cache, if available)
+  GReWeightTableCache * cache = GReWeightTableCache::Instance();
+  std::ostringstream cache_cfg;
+  cache_cfg << fBaryonXFpdf ->GetTitle() << " in [" << fXFmin  << ", " << fXFmax  << "]; "
+            << fBaryonPT2pdf->GetTitle() << " in [" << fPT2min << ", " << fPT2max << "]";
+  TVectorD * norm = dynamic_cast<TVectorD *> (cache->Get(fName, cache_cfg.str(), "I0"));
+  if(norm && norm->GetNrows() == 2) {
+    fI0XFpdf  = (*norm)(0);
+    fI0PT2pdf = (*norm)(1);
+  } else {
+    fI0XFpdf  = fBaryonXFpdf ->Integral(fXFmin, fXFmax);
+    fI0PT2pdf = fBaryonPT2pdf->Integral(fPT2min,fPT2max);
+    TVectorD I0(2);
+    I0(0) = fI0XFpdf;
+    I0(1) = fI0PT2pdf;
+    cache->Put(fName, cache_cfg.str(), "I0", I0);
+  }
+  delete norm;
 
   //
   // Now, define same function as above, but insert tweaking dials.
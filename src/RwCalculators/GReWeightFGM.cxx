@@ -8,8 +8,12 @@
 */
 //____________________________________________________________________________
 
+#include <sstream>
+
 #include <TFile.h>
+#include <TH1D.h>
 #include <TNtupleD.h>
+#include <TRandom3.h>
 
 // GENIE/Generator includes
 #include "Framework/Algorithm/AlgFactory.h"
@@ -17,6 +21,7 @@
 #include "Framework/EventGen/EventRecord.h"
 #include "Framework/GHEP/GHepParticle.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/RandomGen.h"
 #include "Physics/NuclearState/FermiMomentumTablePool.h"
 #include "Physics/NuclearState/FermiMomentumTable.h"
 #include "Physics/NuclearState/NuclearModelI.h"
@@ -26,11 +31,21 @@
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightFGM.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
 using namespace genie::utils;
 
+namespace {
+  // FG & SF momentum distributions, shared by all instances:
+  // (hit nucleon, target) -> (FG, SF)
+  map<MomDistroKey_t, MomDistro_t> gMomDistro;
+
+  const unsigned int kMomDistroSeed = 1989; ///< seed of the generators sampling the nuclear models
+}
+
 //_______________________________________________________________________________________
 GReWeightFGM::GReWeightFGM() :
 GReWeightModel("FermiGasModel")
@@ -213,40 +228,26 @@ double GReWeightFGM::RewCCQEMomDistroFGtoSF(const EventRecord & event)
   it = mapsf.find(tgtpdg);
   if(it != mapsf.end()) { hsf = it->second; }
 
+  // build the momentum distributions on first use, once per process: the
+  // nuclear models, the table cache & GENIE's random number generators are
+  // shared with other threads & instances
   bool have_weight_func = (hfg!=0) && (hsf!=0);
   if(!have_weight_func) {
-     const int kNEv  = 20000;
-     const int kNP   = 500;
-     hfg = new TH1D("","",kNP,0.,kPmax);
-     hsf = new TH1D("","",kNP,0.,kPmax);
-     hfg -> SetDirectory(0);
-     hsf -> SetDirectory(0);
-     const Target & tgt = event.Summary()->InitState().Tgt();
-     bool ok = true;
-     for(int iev=0; iev<kNEv; iev++) {
-       ok = fFG->GenerateNucleon(tgt);
-       if(!ok) {
-         delete hfg;
-         delete hsf;
-         return 1.;
-       }
-       hfg->Fill(fFG->Momentum());
-     }//fg
-     for(int iev=0; iev<kNEv; iev++) {
-       ok = fSF->GenerateNucleon(tgt);
-       if(!ok) {
-         delete hfg;
-         delete hsf;
-         return 1.;
-       }
-       hsf->Fill(fSF->Momentum());
-     }//sf
-     hfg->Scale(1. / hfg->Integral("width"));
-     hsf->Scale(1. / hsf->Integral("width"));
-     mapfg.insert(map<int,TH1D*>::value_type(tgtpdg,hfg));
-     mapsf.insert(map<int,TH1D*>::value_type(tgtpdg,hsf));
-  }//create & store momentum distributions
-
+    GReWeightServices::AlgorithmLock lock;
+    MomDistroKey_t key(nucpdg, tgtpdg);
+    map<MomDistroKey_t, MomDistro_t>::iterator dit = gMomDistro.find(key);
+    if(dit == gMomDistro.end()) {
+       const Target & tgt = event.Summary()->InitState().Tgt();
+       MomDistro_t distro = this->BuildMomDistro(tgt, nucpdg, tgtpdg);
+       if(distro.first == 0) return 1.;
+       dit = gMomDistro.insert(
+               map<MomDistroKey_t, MomDistro_t>::value_type(key, distro)).first;
+    }
+    hfg = dit->second.first;
+    hsf = dit->second.second;
+    mapfg.insert(map<int,TH1D*>::value_type(tgtpdg,hfg));
+    mapsf.insert(map<int,TH1D*>::value_type(tgtpdg,hsf));
+  }
 
   double f_fg = hfg->GetBinContent( hfg->FindBin(p) );
   double f_sf = hsf->GetBinContent( hsf->FindBin(p) );
@@ -256,8 +257,80 @@ double GReWeightFGM::RewCCQEMomDistroFGtoSF(const EventRecord & event)
   return wght;
 }
 //_______________________________________________________________________________________
+MomDistro_t GReWeightFGM::BuildMomDistro(
+  const Target & tgt, int nucpdg, int tgtpdg) const
+{
+// FG & SF momentum distributions of the nucleon nucpdg in the target tgtpdg,
+// looked up in the table cache or sampled from the nuclear models (caller
+// holds the algorithm lock). 0s if the models can't generate a nucleon.
+
+  const int    kNEv  = 20000;
+  const int    kNP   = 500;
+  const double kPmax = 0.5;
+
+  // look the momentum distributions up in the table cache
+  GReWeightTableCache * cache = GReWeightTableCache::Instance();
+  std::ostringstream cache_cfg, namefg, namesf;
+  if(cache->IsOpen()) {
+     cache_cfg << "FG: " << fFG->Id().Key() << "; SF: " << fSF->Id().Key()
+               << "; nev: " << kNEv << "; p bins: " << kNP << ", 0, " << kPmax
+               << "; seed: " << kMomDistroSeed;
+     namefg << "FG" << (pdg::IsNeutron(nucpdg) ? "n" : "p") << "_" << tgtpdg;
+     namesf << "SF" << (pdg::IsNeutron(nucpdg) ? "n" : "p") << "_" << tgtpdg;
+     TH1D * hfg = dynamic_cast<TH1D *> (cache->Get(fName, cache_cfg.str(), namefg.str()));
+     TH1D * hsf = dynamic_cast<TH1D *> (cache->Get(fName, cache_cfg.str(), namesf.str()));
+     if(hfg && hsf) return MomDistro_t(hfg, hsf);
+     delete hfg;
+     delete hsf;
+  }
+
+  TH1D * hfg = new TH1D("","",kNP,0.,kPmax);
+  TH1D * hsf = new TH1D("","",kNP,0.,kPmax);
+  hfg -> SetDirectory(0);
+  hsf -> SetDirectory(0);
+
+  // sample the models with GENIE's generators reseeded to a fixed seed (&
+  // restored after), so that the distributions do not depend on which
+  // thread, event or instance builds them, nor on what ran before
+  TRandom3 & rnd = RandomGen::Instance()->RndGen();
+  TRandom3   rnd_saved(rnd);
+  TRandom *  global_saved = gRandom;
+  TRandom3   global_fixed(kMomDistroSeed);
+  rnd.SetSeed(kMomDistroSeed);
+  gRandom = &global_fixed;
+
+  bool ok = true;
+  for(int iev=0; ok && iev<kNEv; iev++) {
+    ok = fFG->GenerateNucleon(tgt);
+    if(ok) hfg->Fill(fFG->Momentum());
+  }//fg
+  for(int iev=0; ok && iev<kNEv; iev++) {
+    ok = fSF->GenerateNucleon(tgt);
+    if(ok) hsf->Fill(fSF->Momentum());
+  }//sf
+
+  rnd     = rnd_saved;
+  gRandom = global_saved;
+
+  if(!ok) {
+    delete hfg;
+    delete hsf;
+    return MomDistro_t(0, 0);
+  }
+
+  hfg->Scale(1. / hfg->Integral("width"));
+  hsf->Scale(1. / hsf->Integral("width"));
+  if(cache->IsOpen()) {
+    cache->Put(fName, cache_cfg.str(), namefg.str(), *hfg);
+    cache->Put(fName, cache_cfg.str(), namesf.str(), *hsf);
+  }
+  return MomDistro_t(hfg, hsf);
+}
+//_______________________________________________________________________________________
 void GReWeightFGM::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   fKFTwkDial        = 0.;
   fMomDistroTwkDial = 0.;
 
@@ -268,6 +341,9 @@ void GReWeightFGM::Init(void)
   fSF = dynamic_cast<const NuclearModelI*> (
     algf->GetAlgorithm("genie::SpectralFunc","Default"));
 
+  // load the Fermi momentum tables now, not in a (concurrent) CalcWeight()
+  FermiMomentumTablePool::Instance();
+
 #ifdef _G_REWEIGHT_FGM_DEBUG_
   fTestFile = new TFile("./fgm_reweight_test.root","recreate");
   fTestNtp  = new TNtupleD("testntp","","Q2:wght");
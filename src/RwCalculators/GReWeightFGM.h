@@ -24,6 +24,7 @@
 //#define _G_REWEIGHT_FGM_DEBUG_
 
 #include <map>
+#include <utility>
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
@@ -38,9 +39,13 @@ class TFile;
 namespace genie {
 
 class NuclearModelI;
+class Target;
 
 namespace rew   {
 
+ typedef std::pair<int, int>       MomDistroKey_t; ///< (hit nucleon, target) pdg codes
+ typedef std::pair<TH1D *, TH1D *> MomDistro_t;    ///< FG & SF nucleon momentum distributions
+
  class GReWeightFGM : public GReWeightModel
  {
  public:
@@ -62,12 +67,15 @@ namespace rew   {
    double RewCCQEPauliSupViaKF   (const EventRecord & event);
    double RewCCQEMomDistroFGtoSF (const EventRecord & event);
 
+   MomDistro_t BuildMomDistro (const Target & tgt, int nucpdg, int tgtpdg) const;
+
    double fKFTwkDial;
    double fMomDistroTwkDial;
 
    const NuclearModelI * fFG;
    const NuclearModelI * fSF;
 
+   // this instance's view of the process-wide momentum distributions
    std::map<int, TH1D *> fMapFGn;
    std::map<int, TH1D *> fMapFGp;
    std::map<int, TH1D *> fMapSFn;
@@ -0,0 +1,371 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwCalculators/GReWeightHandle.h"
+#include "RwCalculators/GReWeightAGKY.h"
+#include "RwCalculators/GReWeightDISNuclMod.h"
+#include "RwCalculators/GReWeightFGM.h"
+#include "RwCalculators/GReWeightFZone.h"
+#include "RwCalculators/GReWeightINuke.h"
+#include "RwCalculators/GReWeightNonResonanceBkg.h"
+#include "RwCalculators/GReWeightNuXSecCCQE.h"
+#include "RwCalculators/GReWeightNuXSecCCQEaxial.h"
+#include "RwCalculators/GReWeightNuXSecCCQEvec.h"
+#include "RwCalculators/GReWeightNuXSecCCRES.h"
+#include "RwCalculators/GReWeightNuXSecCOH.h"
+#include "RwCalculators/GReWeightNuXSecDIS.h"
+#include "RwCalculators/GReWeightNuXSecNC.h"
+#include "RwCalculators/GReWeightNuXSecNCEL.h"
+#include "RwCalculators/GReWeightNuXSecNCRES.h"
+#include "RwCalculators/GReWeightResonanceDecay.h"
+#include "RwCalculators/GReWeightXSecEmpiricalMEC.h"
+#include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightServices.h"
+#include "RwFramework/GSystSet.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  std::mutex gEvaluateMutex; // serializes Evaluate() across handles
+
+  std::size_t ThisThread(void)
+  {
+    return std::hash<std::thread::id>()(std::this_thread::get_id());
+  }
+
+  // the calculators tried, in order, for systematics needing no
+  // particular calculation mode
+  const int kNCalcs = 17;
+  GReWeightI * NewCalc(int i, string & name)
+  {
+    switch(i) {
+      case  0: name = "xsec_ncel";       return new GReWeightNuXSecNCEL;
+      case  1: name = "xsec_ccqe";       return new GReWeightNuXSecCCQE;
+      case  2: name = "xsec_ccqe_axial"; return new GReWeightNuXSecCCQEaxial;
+      case  3: name = "xsec_ccqe_vec";   return new GReWeightNuXSecCCQEvec;
+      case  4: name = "xsec_ccres";      return new GReWeightNuXSecCCRES;
+      case  5: name = "xsec_ncres";      return new GReWeightNuXSecNCRES;
+      case  6: name = "xsec_nonresbkg";  return new GReWeightNonResonanceBkg;
+      case  7: name = "xsec_coh";        return new GReWeightNuXSecCOH;
+      case  8: name = "xsec_dis";        return new GReWeightNuXSecDIS;
+      case  9: name = "nuclear_qe";      return new GReWeightFGM;
+      case 10: name = "nuclear_dis";     return new GReWeightDISNuclMod;
+      case 11: name = "hadro_res_decay"; return new GReWeightResonanceDecay;
+      case 12: name = "hadro_fzone";     return new GReWeightFZone;
+      case 13: name = "hadro_intranuke"; return new GReWeightINuke;
+      case 14: name = "hadro_agky";      return new GReWeightAGKY;
+      case 15: name = "xsec_nc";         return new GReWeightNuXSecNC;
+      case 16: name = "xsec_empmec";     return new GReWeightXSecEmpiricalMEC;
+      default: name = "";                return 0;
+    }
+  }
+}
+//____________________________________________________________________________
+GReWeightHandle::GReWeightHandle() :
+fConfigured (false),
+fReWeight   (0),
+fOwner      (ThisThread())
+{
+
+}
+//____________________________________________________________________________
+GReWeightHandle::~GReWeightHandle()
+{
+  delete fReWeight;
+}
+//____________________________________________________________________________
+GReWeightHandle * GReWeightHandle::Create(const string & spec, string & error)
+{
+  error = "";
+
+  // dial[=central] entries, separated by commas, semicolons or white space
+  string text = spec;
+  for(unsigned int i = 0; i < text.size(); i++) {
+    if(text[i] == ',' || text[i] == ';') text[i] = ' ';
+  }
+  vector<GSyst_t> dials;
+  vector<double>  central;
+  std::istringstream entries(text);
+  string entry;
+  while(entries >> entry) {
+    string name  = entry;
+    double value = 0.;
+    string::size_type eq = entry.find('=');
+    if(eq != string::npos) {
+      name = entry.substr(0, eq);
+      std::istringstream in(entry.substr(eq+1));
+      if(!(in >> value) || !in.eof()) {
+        error = "invalid central value in `" + entry + "'";
+        return 0;
+      }
+    }
+    GSyst_t syst = GSyst::FromString(name);
+    if(syst == kNullSystematic) {
+      error = "unknown systematic `" + name + "'";
+      return 0;
+    }
+    for(unsigned int i = 0; i < dials.size(); i++) {
+      if(dials[i] == syst) {
+        error = "systematic `" + name + "' given twice";
+        return 0;
+      }
+    }
+    dials  .push_back(syst);
+    central.push_back(value);
+  }
+  if(dials.size() == 0) {
+    error = "no systematics given";
+    return 0;
+  }
+
+  GReWeightHandle * handle = new GReWeightHandle;
+  handle->fDials   = dials;
+  handle->fCentral = central;
+
+  // creating handles goes through GENIE's shared algorithm factory
+  // and configuration pool
+  GReWeightServices::AlgorithmLock lock;
+  handle->fReWeight = new GReWeight;
+  AdoptWeightCalcs(dials, *handle->fReWeight);
+  GSystSet & syst = handle->fReWeight->Systematics();
+  for(unsigned int i = 0; i < dials.size(); i++) {
+    syst.Init(dials[i]);
+  }
+  return handle;
+}
+//____________________________________________________________________________
+bool GReWeightHandle::Configure(const double * values)
+{
+  int ndials = fDials.size();
+  bool changed = !fConfigured;
+  for(int i = 0; i < ndials && !changed; i++) {
+    if(values[i] != fCurrent[i]) changed = true;
+  }
+  if(!changed) return false;
+
+  fCurrent.assign(values, values + ndials);
+  fConfigured = true;
+  GSystSet & syst = fReWeight->Systematics();
+  for(int i = 0; i < ndials; i++) {
+    syst.Set(fDials[i], values[i]);
+  }
+  fReWeight->Reconfigure();
+  return true;
+}
+//____________________________________________________________________________
+bool GReWeightHandle::Evaluate(
+   const EventRecord * const * events, int nevents,
+   const double * universes, int nuniverses, double * weights)
+{
+  if(ThisThread() != fOwner) {
+    LOG("ReW", pERROR)
+      << "A reweighting handle can only be used by the thread that created it";
+    return false;
+  }
+  if(!universes) {
+    universes  = &fCentral[0];
+    nuniverses = 1;
+  }
+  if(nevents < 0 || nuniverses <= 0 || (nevents > 0 && (!events || !weights))) {
+    LOG("ReW", pERROR) << "Invalid batch of events or universes";
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(gEvaluateMutex);
+
+  // the universe the calculators are at (if any of the batch) first
+  int ndials = fDials.size();
+  int ifirst = 0;
+  for(int iu = 0; iu < nuniverses && fConfigured; iu++) {
+    bool same = true;
+    for(int i = 0; i < ndials && same; i++) {
+      same = (universes[iu*ndials + i] == fCurrent[i]);
+    }
+    if(same) { ifirst = iu; break; }
+  }
+
+  for(int n = 0; n < nuniverses; n++) {
+    int iu = (ifirst + n) % nuniverses;
+    this->Configure(&universes[iu*ndials]);
+    for(int iev = 0; iev < nevents; iev++) {
+      weights[iev*nuniverses + iu] =
+        (events[iev]) ? fReWeight->CalcWeight(*events[iev]) : 1.;
+    }
+  }
+  return true;
+}
+//____________________________________________________________________________
+bool GReWeightHandle::Evaluate(
+   const vector<const EventRecord *> & events,
+   const vector<double> & universes, vector<double> & weights)
+{
+  int ndials = fDials.size();
+  if(universes.size() % ndials != 0) {
+    LOG("ReW", pERROR)
+      << "The universes must hold " << ndials << " dial values each";
+    return false;
+  }
+  int nuniverses = universes.size() / ndials;
+  if(nuniverses == 0) nuniverses = 1;
+  weights.resize(events.size() * nuniverses);
+  if(events.size() == 0) return true;
+  return this->Evaluate(&events[0], events.size(),
+     (universes.size() > 0) ? &universes[0] : 0, nuniverses, &weights[0]);
+}
+//____________________________________________________________________________
+void GReWeightHandle::AdoptWeightCalcs(const vector<GSyst_t> & dials, GReWeight & rw)
+{
+  //
+  // Sets of systematics can be incompatible because they request different
+  // reweighting modes. If one of these systematics is requested, adopt a
+  // reweighting calculator and set it to the appropriate mode.
+  //
+  vector<GSyst_t>::const_iterator it;
+  for(it=dials.begin();it != dials.end();it++)
+  {
+    switch(*it){
+    // CC QE
+    case kXSecTwkDial_MaCCQE:
+    case kXSecTwkDial_NormCCQE:
+    case kXSecTwkDial_MaCCQEshape:
+      if ( ! rw.WghtCalc("xsec_ccqe") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ccqe weight calc";
+        GReWeightNuXSecCCQE * rwccqe = new GReWeightNuXSecCCQE;
+        if (*it == kXSecTwkDial_MaCCQE) {
+               rwccqe->SetMode(GReWeightNuXSecCCQE::kModeMa); }
+        else { rwccqe->SetMode(GReWeightNuXSecCCQE::kModeNormAndMaShape); }
+        rw.AdoptWghtCalc( "xsec_ccqe", rwccqe );
+      }
+    break;
+    case kXSecTwkDial_ZNormCCQE:
+    case kXSecTwkDial_ZExpA1CCQE:
+    case kXSecTwkDial_ZExpA2CCQE:
+    case kXSecTwkDial_ZExpA3CCQE:
+    case kXSecTwkDial_ZExpA4CCQE:
+      if ( ! rw.WghtCalc("xsec_ccqe") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ccqe weight calc";
+        GReWeightNuXSecCCQE * rwccqe = new GReWeightNuXSecCCQE;
+        rwccqe->SetMode(GReWeightNuXSecCCQE::kModeZExp);
+        rw.AdoptWghtCalc( "xsec_ccqe", rwccqe );
+      }
+    break;
+    // CC Res
+    case kXSecTwkDial_MaCCRES:
+    case kXSecTwkDial_MvCCRES:
+      if ( ! rw.WghtCalc("xsec_ccres") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ccres weight calc";
+        GReWeightNuXSecCCRES * rwccres = new GReWeightNuXSecCCRES;
+        rwccres->SetMode(GReWeightNuXSecCCRES::kModeMaMv);
+        rw.AdoptWghtCalc( "xsec_ccres", rwccres );
+      }
+    break;
+    case kXSecTwkDial_NormCCRES:
+    case kXSecTwkDial_MaCCRESshape:
+    case kXSecTwkDial_MvCCRESshape:
+      if ( ! rw.WghtCalc("xsec_ccres") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ccres weight calc";
+        GReWeightNuXSecCCRES * rwccres = new GReWeightNuXSecCCRES;
+        rwccres->SetMode(GReWeightNuXSecCCRES::kModeNormAndMaMvShape);
+        rw.AdoptWghtCalc( "xsec_ccres", rwccres );
+      }
+    break;
+    // DIS
+    case kXSecTwkDial_AhtBYshape:
+    case kXSecTwkDial_BhtBYshape:
+    case kXSecTwkDial_CV1uBYshape:
+    case kXSecTwkDial_CV2uBYshape:
+      if ( ! rw.WghtCalc("xsec_dis") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_dis weight calc";
+        GReWeightNuXSecDIS * rwdis = new GReWeightNuXSecDIS;
+        rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12uShape);
+        rw.AdoptWghtCalc( "xsec_dis", rwdis );
+      }
+    break;
+    case kXSecTwkDial_AhtBY:
+    case kXSecTwkDial_BhtBY:
+    case kXSecTwkDial_CV1uBY:
+    case kXSecTwkDial_CV2uBY:
+      if ( ! rw.WghtCalc("xsec_dis") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_dis weight calc";
+        GReWeightNuXSecDIS * rwdis = new GReWeightNuXSecDIS;
+        rwdis->SetMode(GReWeightNuXSecDIS::kModeABCV12u);
+        rw.AdoptWghtCalc( "xsec_dis", rwdis );
+      }
+    break;
+    // NC Res
+    case kXSecTwkDial_MaNCRES:
+    case kXSecTwkDial_MvNCRES:
+      if ( ! rw.WghtCalc("xsec_ncres") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ncres weight calc";
+        GReWeightNuXSecNCRES * rwncres = new GReWeightNuXSecNCRES;
+        rwncres->SetMode(GReWeightNuXSecNCRES::kModeMaMv);
+        rw.AdoptWghtCalc( "xsec_ncres", rwncres );
+      }
+    break;
+    case kXSecTwkDial_NormNCRES:
+    case kXSecTwkDial_MaNCRESshape:
+    case kXSecTwkDial_MvNCRESshape:
+      if ( ! rw.WghtCalc("xsec_ncres") ){
+        LOG("ReW", pNOTICE) << "Adopting xsec_ncres weight calc";
+        GReWeightNuXSecNCRES * rwncres = new GReWeightNuXSecNCRES;
+        rwncres->SetMode(GReWeightNuXSecNCRES::kModeNormAndMaMvShape);
+        rw.AdoptWghtCalc( "xsec_ncres", rwncres );
+      }
+    break;
+    default: // no fine-tuning needed
+    break;
+    }
+  }
+
+  //
+  // Any other systematic gets the first (default mode) calculator
+  // handling it
+  //
+  vector<GSyst_t> unhandled;
+  const vector<string> & names = rw.WghtCalcNames();
+  for(it=dials.begin();it != dials.end();it++) {
+    bool handled = false;
+    for(unsigned int i = 0; i < names.size() && !handled; i++) {
+      handled = rw.WghtCalc(names[i])->IsHandled(*it);
+    }
+    if(!handled) unhandled.push_back(*it);
+  }
+  for(int icalc = 0; icalc < kNCalcs && unhandled.size() > 0; icalc++) {
+    string name;
+    GReWeightI * wcalc = NewCalc(icalc, name);
+    if(rw.WghtCalc(name)) { delete wcalc; continue; }
+    vector<GSyst_t> remaining;
+    for(unsigned int i = 0; i < unhandled.size(); i++) {
+      if(!wcalc->IsHandled(unhandled[i])) remaining.push_back(unhandled[i]);
+    }
+    if(remaining.size() == unhandled.size()) { delete wcalc; continue; }
+    LOG("ReW", pNOTICE) << "Adopting " << name << " weight calc";
+    rw.AdoptWghtCalc(name, wcalc);
+    unhandled = remaining;
+  }
+  for(unsigned int i = 0; i < unhandled.size(); i++) {
+    LOG("ReW", pWARN)
+      << "No weight calculator handles " << GSyst::AsString(unhandled[i]);
+  }
+}
+//____________________________________________________________________________
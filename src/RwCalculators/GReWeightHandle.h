@@ -0,0 +1,106 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightHandle
+
+\brief    Embedding interface for experiment frameworks that hold GENIE event
+          records in memory and want weights inline, with no GHEP file
+          written and no reweighting application run:
+
+            std::string error;
+            GReWeightHandle * h =
+               GReWeightHandle::Create("MaCCQE, MaCCRES, MFP_pi=0.5", error);
+            if(!h) { ... error ... }
+            // weights[iev*nuniverses + iu], for dial values
+            // universes[iu*h->NDials() + idial]
+            h->Evaluate(events, nevents, universes, nuniverses, weights);
+
+          The spec lists the systematics (GSyst names), separated by commas,
+          semicolons or white space, each with an optional central value
+          (default: 0) used when Evaluate() is given no universes. The
+          weight calculators handling them are adopted, in the calculation
+          modes the systematics need (see AdoptWeightCalcs(), also used by
+          the reweighting applications). ReWeight() gives access to the
+          underlying GReWeight, for uncertainties or calculator options.
+
+          Evaluate() works on a batch of events and universes, writing
+          into a caller-provided buffer: calculators are reconfigured once
+          per universe and batch (and not at all if the universe did not
+          change since the last call), so batches should be large.
+
+          A handle is confined to the thread that created it: Evaluate()
+          from any other thread fails. Frameworks running several threads
+          create one handle per thread (creation is serialized, as it goes
+          through GENIE's shared algorithm factory and configuration pool).
+          Evaluate() calls are serialized too, across all handles, by a
+          process-wide lock: the calculators set the running kinematics of
+          the events they weight and reach GENIE's shared algorithms, so
+          the calls of several threads do not overlap (and an event passed
+          from two threads is not modified by both at once). Threads only
+          run their other work concurrently with the weighting.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_HANDLE_H_
+#define _G_REWEIGHT_HANDLE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// GENIE/Reweight includes
+#include "RwFramework/GSyst.h"
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeight;
+
+class GReWeightHandle {
+
+public:
+  static GReWeightHandle * Create (const std::string & spec, std::string & error); ///< 0 if the spec is invalid
+ ~GReWeightHandle();
+
+  int         NDials    (void)  const { return fDials.size(); }
+  GSyst_t     Dial      (int i) const { return fDials[i];     }
+  double      Central   (int i) const { return fCentral[i];   }
+  GReWeight & ReWeight  (void)        { return *fReWeight;    }
+
+  bool Evaluate (const EventRecord * const * events, int nevents,
+                 const double * universes, int nuniverses,
+                 double * weights); ///< weights[iev*nuniverses+iu]; universes=0: central values only (nuniverses=1)
+  bool Evaluate (const std::vector<const EventRecord *> & events,
+                 const std::vector<double> & universes,
+                 std::vector<double> & weights); ///< as above, with # of universes = universes.size()/NDials()
+
+  static void AdoptWeightCalcs (const std::vector<GSyst_t> & dials, GReWeight & rw); ///< adopt the calculators the dials need
+
+private:
+
+  GReWeightHandle();
+
+  bool Configure (const double * values); ///< set all dials, reconfigure if changed
+
+  std::vector<GSyst_t> fDials;      ///< systematics
+  std::vector<double>  fCentral;    ///< their central values
+  std::vector<double>  fCurrent;    ///< values the calculators are configured at
+  bool                 fConfigured; ///< fCurrent valid?
+  GReWeight *          fReWeight;   ///< the weight calculators
+  std::size_t          fOwner;      ///< hash of the creating thread's id
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -29,12 +29,15 @@
 #include "Framework/ParticleData/PDGUtils.h"
 #include "Physics/NuclearState/NuclearUtils.h"
 #include "Physics/HadronTransport/INukeHadroData.h"
+#include "Physics/HadronTransport/INukeHadroData2018.h"
 #include "Physics/HadronTransport/INukeHadroFates.h"
 #include "Physics/HadronTransport/INukeUtils.h"
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightINuke.h"
 #include "RwCalculators/GReWeightUtils.h"
+#include "RwFramework/GReWeightEventView.h"
+#include "RwFramework/GReWeightServices.h"
 #include "RwFramework/GSystUncertainty.h"
 
 using namespace genie;
@@ -44,6 +47,12 @@ using namespace genie::rew;
 GReWeightINuke::GReWeightINuke() :
 GReWeightModel("IntraNuke")
 {
+  // build the hadron cross section tables now rather than on the first
+  // CalcWeight(), which may be running on several threads
+  {
+    GReWeightServices::AlgorithmLock lock;
+    INukeHadroData2018::Instance();
+  }
 #ifdef _G_REWEIGHT_INUKE_DEBUG_NTP_
   fTestFile = new TFile("./intranuke_reweight_test.root","recreate");
   fTestNtp  = new TNtuple("testntp","","pdg:E:mfp_twk_dial:d:d_mfp:fate:interact:w_mfp:w_fate");
@@ -162,74 +171,120 @@ double GReWeightINuke::CalcWeight(const EventRecord & event)
 
      // Determine the interaction type for current hadron in nucleus, if any
      int fsi_code = p->RescatterCode();
-     LOG("ReW", pDEBUG)
-        << "Attempting to reweight hadron at position = " << ip
-        << " with PDG code = " << pdgc
-        << " and FSI code = "  << fsi_code
-        << " (" << INukeHadroFates::AsString((INukeFateHA_t)fsi_code) << ")";
      if(fsi_code == -1 || fsi_code == (int)kIHAFtUndefined) {
        LOG("ReW", pFATAL) << "INTRANUKE didn't set a valid rescattering code for event in position: " << ip;
        LOG("ReW", pFATAL) << "Here is the problematic event:";
        LOG("ReW", pFATAL) << event;
        exit(1);
      }
-     bool escaped    = (fsi_code == (int)kIHAFtNoInteraction);
-     bool interacted = !escaped;
 
      // Get 4-momentum and 4-position
      TLorentzVector x4 (p->Vx(), p->Vy(), p->Vz(), 0.    );
      TLorentzVector p4 (p->Px(), p->Py(), p->Pz(), p->E());
 
-     // Init current hadron weights
-     double w_mfp  = 1.0;
-     double w_fate = 1.0;
+     // Update the current event weight
+     event_weight *= this->HadronWeight(ip, pdgc, fsi_code, x4, p4, A, Z);
 
-     // Check which weights need to be calculated (only if relevant params were tweaked)
-     bool calc_w_mfp  = fINukeRwParams.MeanFreePathParams(pdgc)->IsTweaked();
-     bool calc_w_fate = fINukeRwParams.FateParams(pdgc)->IsTweaked();
+  }//particle loop
 
-     // Compute weight to account for changes in the total rescattering probability
-     double mfp_scale_factor = 1.;
-     if(calc_w_mfp)
-     {
-        mfp_scale_factor = fINukeRwParams.MeanFreePathParams(pdgc)->ScaleFactor();
-        w_mfp = utils::rew::MeanFreePathWeight(pdgc,x4,p4,A,Z,mfp_scale_factor,interacted);
-     } // calculate mfp weight?
+  return event_weight;
+}
+//_______________________________________________________________________________________
+double GReWeightINuke::CalcViewWeight(const GReWeightEventView & event)
+{
+// Same as above, reading the particle arrays of a compact event view
+//
+  if (event.TargetNucleusPosition() < 0) return 1.0;
+  double A = event.TargetA();
+  double Z = event.TargetZ();
+  if (A<=1) return 1.0;
+  if (Z<=1) return 1.0;
 
-     // Compute weight to account for changes in relative fractions of reaction channels
-     if(calc_w_fate && interacted)
-     {
-        double fate_fraction_scale_factor =
-             fINukeRwParams.FateParams(pdgc)->ScaleFactor(
-                  GSyst::INukeFate2GSyst((INukeFateHA_t)fsi_code,pdgc), p4);
-        w_fate = fate_fraction_scale_factor;
-     }
+  fINukeRwParams.SetTargetA( A );
 
-     // Calculate the current hadron weight
-     double hadron_weight = w_mfp * w_fate;
+  double event_weight  = 1.0;
 
-     LOG("ReW", pNOTICE)
-        << "Reweighted hadron at position = " << ip
-        << " with PDG code = " << pdgc
-        << ", FSI code = "  << fsi_code
-        << " (" << INukeHadroFates::AsString((INukeFateHA_t)fsi_code) << ") :"
-        << " w_mfp = "  << w_mfp
-        <<", w_fate = " << w_fate;
+  int np = event.NParticles();
+  for(int ip = 0; ip < np; ip++) {
+     if(event.Status(ip) != kIStHadronInTheNucleus) continue;
+     int pdgc = event.Pdg(ip);
+     if(!pdg::IsPion(pdgc) && !pdg::IsNucleon(pdgc)) continue;
 
-     // Debug info
-#ifdef _G_REWEIGHT_INUKE_DEBUG_NTP_
-     double d        = utils::intranuke::Dist2Exit(x4,p4,A);
-     double d_mfp    = utils::intranuke::Dist2ExitMFP(pdgc,x4,p4,A,Z);
-     double Eh       = p->E();
-     double iflag    = (interacted) ? 1 : 0;
-     fTestNtp->Fill(pdgc, Eh, mfp_scale_factor, d, d_mfp, fsi_code, iflag, w_mfp, w_fate);
-#endif
+     int fsi_code = event.RescatterCode(ip);
+     if(fsi_code == -1 || fsi_code == (int)kIHAFtUndefined) {
+       LOG("ReW", pFATAL) << "INTRANUKE didn't set a valid rescattering code for event in position: " << ip;
+       exit(1);
+     }
 
-     // Update the current event weight
-     event_weight *= hadron_weight;
+     TLorentzVector x4 (event.Vx(ip), event.Vy(ip), event.Vz(ip), 0.);
+     TLorentzVector p4 (event.Px(ip), event.Py(ip), event.Pz(ip), event.E(ip));
 
-  }//particle loop
+     event_weight *= this->HadronWeight(ip, pdgc, fsi_code, x4, p4, A, Z);
+  }
 
   return event_weight;
 }
 //_______________________________________________________________________________________
+double GReWeightINuke::HadronWeight(
+   int ip, int pdgc, int fsi_code,
+   const TLorentzVector & x4, const TLorentzVector & p4, double A, double Z)
+{
+// Weight for a hadron produced in the nucleus, with a valid rescattering code
+//
+  LOG("ReW", pDEBUG)
+     << "Attempting to reweight hadron at position = " << ip
+     << " with PDG code = " << pdgc
+     << " and FSI code = "  << fsi_code
+     << " (" << INukeHadroFates::AsString((INukeFateHA_t)fsi_code) << ")";
+
+  bool escaped    = (fsi_code == (int)kIHAFtNoInteraction);
+  bool interacted = !escaped;
+
+  // Init current hadron weights
+  double w_mfp  = 1.0;
+  double w_fate = 1.0;
+
+  // Check which weights need to be calculated (only if relevant params were tweaked)
+  bool calc_w_mfp  = fINukeRwParams.MeanFreePathParams(pdgc)->IsTweaked();
+  bool calc_w_fate = fINukeRwParams.FateParams(pdgc)->IsTweaked();
+
+  // Compute weight to account for changes in the total rescattering probability
+  double mfp_scale_factor = 1.;
+  if(calc_w_mfp)
+  {
+     mfp_scale_factor = fINukeRwParams.MeanFreePathParams(pdgc)->ScaleFactor();
+     w_mfp = utils::rew::MeanFreePathWeight(pdgc,x4,p4,A,Z,mfp_scale_factor,interacted);
+  } // calculate mfp weight?
+
+  // Compute weight to account for changes in relative fractions of reaction channels
+  if(calc_w_fate && interacted)
+  {
+     double fate_fraction_scale_factor =
+          fINukeRwParams.FateParams(pdgc)->ScaleFactor(
+               GSyst::INukeFate2GSyst((INukeFateHA_t)fsi_code,pdgc), p4);
+     w_fate = fate_fraction_scale_factor;
+  }
+
+  // Calculate the current hadron weight
+  double hadron_weight = w_mfp * w_fate;
+
+  LOG("ReW", pNOTICE)
+     << "Reweighted hadron at position = " << ip
+     << " with PDG code = " << pdgc
+     << ", FSI code = "  << fsi_code
+     << " (" << INukeHadroFates::AsString((INukeFateHA_t)fsi_code) << ") :"
+     << " w_mfp = "  << w_mfp
+     <<", w_fate = " << w_fate;
+
+  // Debug info
+#ifdef _G_REWEIGHT_INUKE_DEBUG_NTP_
+  double d        = utils::intranuke::Dist2Exit(x4,p4,A);
+  double d_mfp    = utils::intranuke::Dist2ExitMFP(pdgc,x4,p4,A,Z);
+  double Eh       = p4.E();
+  double iflag    = (interacted) ? 1 : 0;
+  fTestNtp->Fill(pdgc, Eh, mfp_scale_factor, d, d_mfp, fsi_code, iflag, w_mfp, w_fate);
+#endif
+
+  return hadron_weight;
+}
+//_______________________________________________________________________________________
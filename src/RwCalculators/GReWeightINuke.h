@@ -61,9 +61,14 @@ namespace rew   {
    void   Reset          (void);
    void   Reconfigure    (void);
    double CalcWeight     (const EventRecord & event);
+   bool   HandlesEventView (void) const { return true; }
+   double CalcViewWeight (const GReWeightEventView & event);
 
  private:
 
+   double HadronWeight   (int ip, int pdgc, int fsi_code,
+                          const TLorentzVector & x4, const TLorentzVector & p4, double A, double Z);
+
    GReWeightINukeParams fINukeRwParams;
 
 #ifdef _G_REWEIGHT_INUKE_DEBUG_NTP_
@@ -10,7 +10,14 @@
 */
 //____________________________________________________________________________
 
+#include <cmath>
+#include <sstream>
+
 // GENIE/Generator includes
+#include "Framework/Conventions/Controls.h"
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/XSecAlgorithmI.h"
+#include "Framework/Interaction/Interaction.h"
 #include "Framework/Messenger/Messenger.h"
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
@@ -48,3 +55,78 @@ void GReWeightModel::UseOldWeightFromFile(bool should_we)
   fUseOldWeightFromFile = should_we;
 }
 //_______________________________________________________________________________________
+void GReWeightModel::UseOldWeightFromFile(const std::string & process, bool should_we)
+{
+  fUseOldWeightByProcess[process] = should_we;
+}
+//_______________________________________________________________________________________
+bool GReWeightModel::DefaultDiffXSec(const EventRecord & event, double & xsec)
+{
+  Interaction * interaction = event.Summary();
+  const ProcessInfo & proc_info = interaction->ProcInfo();
+  if(!this->AppliesTo(proc_info.ScatteringTypeId(), proc_info.IsWeakCC())) return false;
+
+  KinePhaseSpace_t phase_space = kPSNull;
+  const XSecAlgorithmI * model = this->DefaultXSecModel(event, phase_space);
+  if(!model) return false;
+
+  // same kinematics as in CalcWeight()
+  interaction->KinePtr()->UseSelectedKinematics();
+  if (phase_space == kPSQ2fE) {
+    interaction->SetBit(kIAssumeFreeNucleon);
+  }
+
+  xsec = model->XSec(interaction, phase_space);
+
+  interaction->KinePtr()->ClearRunningValues();
+  if (phase_space == kPSQ2fE) {
+    interaction->ResetBit(kIAssumeFreeNucleon);
+  }
+  return true;
+}
+//_______________________________________________________________________________________
+std::string GReWeightModel::ProcessKey(const EventRecord & event)
+{
+  const Interaction * interaction = event.Summary();
+  const ProcessInfo & proc_info   = interaction->ProcInfo();
+
+  std::ostringstream key;
+  key << proc_info.ScatteringTypeAsString() << ";"
+      << proc_info.InteractionTypeAsString() << ";"
+      << interaction->InitState().Tgt().Pdg();
+  return key.str();
+}
+//_______________________________________________________________________________________
+double GReWeightModel::OldDiffXSec(
+  const EventRecord & event, const XSecAlgorithmI * model, KinePhaseSpace_t kps)
+{
+  double old_xsec = event.DiffXSec();
+
+  // a per-process choice is final: no spot checks
+  bool use_old = fUseOldWeightFromFile;
+  bool check   = (fNWeightChecksDone < fNWeightChecksToDo);
+  if(!fUseOldWeightByProcess.empty()) {
+    std::map<std::string, bool>::const_iterator it =
+      fUseOldWeightByProcess.find(ProcessKey(event));
+    if(it != fUseOldWeightByProcess.end()) {
+      use_old = it->second;
+      check   = false;
+    }
+  }
+
+  if (!use_old || check) {
+    double calc_old_xsec = model->XSec(event.Summary(), kps);
+    if (check) {
+      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
+        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
+        fFailedWeightCheck = true;
+      }
+      fNWeightChecksDone++;
+    }
+    if(!use_old) {
+      old_xsec = calc_old_xsec;
+    }
+  }
+  return old_xsec;
+}
+//_______________________________________________________________________________________
@@ -18,12 +18,19 @@
 #ifndef _G_REWEIGHT_MODEL_BASE_H_
 #define _G_REWEIGHT_MODEL_BASE_H_
 
+#include <map>
+#include <string>
+
+// GENIE/Generator includes
+#include "Framework/Conventions/KinePhaseSpace.h"
+
 // GENIE/Reweight includes
 #include "RwFramework/GReWeightI.h"
 
 namespace genie {
 
 class EventRecord;
+class XSecAlgorithmI;
 
 namespace rew   {
 
@@ -57,11 +64,29 @@ namespace rew   {
   //! If using the weight from the file, how many times should we check by calculating it ourself?
   virtual void SetNWeightChecks(int);
 
+  //! Use the old weight from the file for one process (see ProcessKey()), overriding the above & its checks
+  void UseOldWeightFromFile(const std::string & process, bool should_we);
+
+  //! Old differential cross section of the event from the default model (false if the event's is not used)
+  bool DefaultDiffXSec(const genie::EventRecord & event, double & xsec);
+
+  //! Process of an event, for the per-process choice of the old weight: scattering, interaction & target
+  static std::string ProcessKey(const genie::EventRecord & event);
+
  protected:
+   //! default model & kinematic phase space of the event's old differential cross section (0 if not used)
+   virtual const XSecAlgorithmI * DefaultXSecModel(const genie::EventRecord & /*event*/,
+                                                   KinePhaseSpace_t & /*kps*/) const { return 0; }
+
+   //! old differential cross section: from the file or the default model (kinematics already selected)
+   double OldDiffXSec(const genie::EventRecord & event, const XSecAlgorithmI * model,
+                      KinePhaseSpace_t kps);
+
    bool fUseOldWeightFromFile;
    int  fNWeightChecksToDo;
    int  fNWeightChecksDone;
    bool fFailedWeightCheck;
+   std::map<std::string, bool> fUseOldWeightByProcess; ///< per-process choices (eg from a preflight)
 
    std::string fName;
  };
@@ -26,8 +26,10 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightNonResonanceBkg.h"
+#include "RwFramework/GReWeightEventView.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -175,6 +177,50 @@ double GReWeightNonResonanceBkg::CalcWeight(const genie::EventRecord & event)
      }
   }//p
 
+  return this->MultiplicityWeight(itype, probe, hitnuc, nhadmult, nnuc, npi);
+}
+//_______________________________________________________________________________________
+double GReWeightNonResonanceBkg::CalcViewWeight(const GReWeightEventView & event)
+{
+// Same as above, from the process, selected W & particle list of a compact
+// event view
+//
+  bool is_dis = (event.ScatteringTypeId() == kScDeepInelastic);
+  if(!is_dis) return 1.;
+
+  double W = event.W();
+  bool in_transition = (W<fWmin);
+  if(!in_transition) return 1.;
+
+  int iprobe = event.ProbePosition();
+  int probe  = (iprobe >= 0) ? event.Pdg(iprobe) : 0;
+  int hitnuc = event.HitNucleonPdg();
+
+  int nhadmult = 0;
+  int nnuc     = 0;
+  int npi      = 0;
+
+  int np = event.NParticles();
+  for(int ip = 0; ip < np; ip++) {
+     int imom = event.FirstMother(ip);
+     if(imom < 0 || imom >= np) continue;
+
+     if(event.Pdg(imom) == kPdgHadronicSyst)
+     {
+        int pdgc = event.Pdg(ip);
+        nhadmult++;
+        if ( pdg::IsNucleon(pdgc) ) { nnuc++; }
+        if ( pdg::IsPion   (pdgc) ) { npi++;  }
+     }
+  }//ip
+
+  return this->MultiplicityWeight(
+     event.InteractionTypeId(), probe, hitnuc, nhadmult, nnuc, npi);
+}
+//_______________________________________________________________________________________
+double GReWeightNonResonanceBkg::MultiplicityWeight(
+   InteractionType_t itype, int probe, int hitnuc, int nhadmult, int nnuc, int npi)
+{
   if(nhadmult < 2 || nhadmult > 3) return 1.;
   if(nnuc != 1) return 1.;
 
@@ -194,6 +240,8 @@ double GReWeightNonResonanceBkg::CalcWeight(const genie::EventRecord & event)
 //_______________________________________________________________________________________
 void GReWeightNonResonanceBkg::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   this->SetWminCut(2.0*units::GeV);
 
   // Get the "common" (shared) parameters
@@ -42,13 +42,17 @@ namespace rew   {
    void   Reset          (void);
    void   Reconfigure    (void);
    double CalcWeight     (const EventRecord & event);
+   bool   HandlesEventView (void) const { return true; }
+   double CalcViewWeight (const GReWeightEventView & event);
 
    // various config options
    void SetWminCut (double W ) { fWmin = W; }
 
  private:
 
-   void Init (void);
+   void   Init (void);
+   double MultiplicityWeight (InteractionType_t itype, int probe, int hitnuc,
+                              int nhadmult, int nnuc, int npi);
 
    double fWmin;   ///< W_{min} cut. Reweight only events with W < W_{min}
 
@@ -35,6 +35,7 @@
 #include "RwCalculators/GReWeightUtils.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -298,6 +299,7 @@ void GReWeightNuXSecCCQE::Reconfigure(void)
       r.Set(alg_key.str(), fZExpCurr[i]);
     }
   }
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 }
 //_______________________________________________________________________________________
@@ -338,8 +340,17 @@ double GReWeightNuXSecCCQE::CalcWeight(const genie::EventRecord & event)
   return 1.;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecCCQE::DefaultXSecModel(
+  const EventRecord & event, KinePhaseSpace_t & kps) const
+{
+  kps = event.DiffXSecVars();
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecCCQE::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/QEL-CC");
@@ -446,25 +457,12 @@ double GReWeightNuXSecCCQE::CalcWeightMa(const genie::EventRecord & event)
 
   // Retrieve the kinematic phase space used to generate the event
   const KinePhaseSpace_t phase_space = event.DiffXSecVars();
-  double old_xsec = event.DiffXSec();
 
   if (phase_space == kPSQ2fE) {
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-        fFailedWeightCheck = true;
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
@@ -495,24 +493,12 @@ double GReWeightNuXSecCCQE::CalcWeightMaShape(const genie::EventRecord & event)
 
   // Retrieve the kinematic phase space used to generate the event
   const KinePhaseSpace_t phase_space = event.DiffXSecVars();
-  double old_xsec = event.DiffXSec();
 
   if (phase_space == kPSQ2fE) {
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec = this->OldDiffXSec(event, fXSecModelDef, phase_space);
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
   double new_weight = old_weight * (new_xsec/old_xsec);
@@ -523,8 +509,8 @@ double GReWeightNuXSecCCQE::CalcWeightMaShape(const genie::EventRecord & event)
 //LOG("ReW", pDEBUG) << "new weight = " << new_weight;
 
 //double old_integrated_xsec = event.XSec();
-  double old_integrated_xsec = fXSecModelDef -> Integral(interaction);
-  double new_integrated_xsec = fXSecModel    -> Integral(interaction);
+  double old_integrated_xsec = fIntegrator.Nominal(fXSecModelDef, interaction);
+  double new_integrated_xsec = fIntegrator.Tweaked(fXSecModelDef, fXSecModel, interaction, phase_space);
   assert(new_integrated_xsec > 0);
   new_weight *= (old_integrated_xsec/new_integrated_xsec);
 
@@ -563,24 +549,12 @@ double GReWeightNuXSecCCQE::CalcWeightZExp(const genie::EventRecord & event)
 
   // Retrieve the kinematic phase space used to generate the event
   const KinePhaseSpace_t phase_space = event.DiffXSecVars();
-  double old_xsec = event.DiffXSec();
 
   if (phase_space == kPSQ2fE) {
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec = this->OldDiffXSec(event, fXSecModelDef, phase_space);
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
   double new_weight = old_weight * (new_xsec/old_xsec);
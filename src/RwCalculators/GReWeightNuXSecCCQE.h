@@ -27,6 +27,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 class TFile;
 class TNtupleD;
@@ -74,6 +75,7 @@ namespace rew   {
  private:
 
    void   Init                (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
    double CalcWeightNorm      (const EventRecord & event);
    double CalcWeightMaShape   (const EventRecord & event);
    double CalcWeightMa        (const EventRecord & event);
@@ -82,6 +84,7 @@ namespace rew   {
    XSecAlgorithmI * fXSecModelDef;    ///< default model
    XSecAlgorithmI * fXSecModel;       ///< tweaked model
    Registry *       fXSecModelConfig; ///< config in tweaked model
+   GReWeightXSecIntegrator fIntegrator; ///< integrated cross sections for the shape-only weights
    string fFFModel; ///< String name of form factor model
    bool fModelIsDipole;           ///< Using dipole form factors?
    bool fModelIsZExp;             ///< Using Zexp form factors?
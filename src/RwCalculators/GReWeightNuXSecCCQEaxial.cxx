@@ -36,6 +36,7 @@
 #include "RwCalculators/GReWeightNuXSecCCQEaxial.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -137,19 +138,7 @@ double GReWeightNuXSecCCQEaxial::CalcWeight(const genie::EventRecord & event)
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight           = event.Weight();
   double dial                 = fFFTwkDial;
@@ -193,8 +182,17 @@ double GReWeightNuXSecCCQEaxial::CalcChisq()
   return chisq;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecCCQEaxial::DefaultXSecModel(
+  const EventRecord & event, KinePhaseSpace_t & kps) const
+{
+  kps = event.DiffXSecVars();
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecCCQEaxial::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/QEL-CC");
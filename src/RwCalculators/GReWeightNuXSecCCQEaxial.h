@@ -62,6 +62,7 @@ namespace rew   {
  private:
 
    void Init (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
 
    XSecAlgorithmI * fXSecModelDef;   ///< Model loaded from the XML, with dipole FF
    XSecAlgorithmI * fXSecModel_zexp;  ///< CCQE model with z-expansion f/f ("maximally" tweaked)
@@ -33,6 +33,7 @@
 #include "RwCalculators/GReWeightNuXSecCCQEvec.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -134,25 +135,13 @@ double GReWeightNuXSecCCQEvec::CalcWeight(const genie::EventRecord & event)
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModel_bba->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModel_bba, phase_space);
 
   double dial                = fFFTwkDial;
   double old_weight          = event.Weight();
   double dpl_xsec            = fXSecModel_dpl->XSec(interaction, phase_space);
-  double def_integrated_xsec = fXSecModel_bba->Integral(interaction);
-  double dpl_integrated_xsec = fXSecModel_dpl->Integral(interaction);
+  double def_integrated_xsec = fIntegrator.Nominal(fXSecModel_bba, interaction);
+  double dpl_integrated_xsec = fIntegrator.Nominal(fXSecModel_dpl, interaction);
 
   assert(def_integrated_xsec > 0.);
   assert(dpl_integrated_xsec > 0.);
@@ -182,8 +171,17 @@ double GReWeightNuXSecCCQEvec::CalcWeight(const genie::EventRecord & event)
   return weight;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecCCQEvec::DefaultXSecModel(
+  const EventRecord & event, KinePhaseSpace_t & kps) const
+{
+  kps = event.DiffXSecVars();
+  return fXSecModel_bba;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecCCQEvec::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/QEL-CC");
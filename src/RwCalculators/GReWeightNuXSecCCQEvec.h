@@ -29,6 +29,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 
 class TFile;
@@ -63,9 +64,11 @@ namespace rew   {
  private:
 
    void Init (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
 
    XSecAlgorithmI * fXSecModel_bba;  ///< CCQE model with BBA05  f/f (default)
    XSecAlgorithmI * fXSecModel_dpl;  ///< CCQE model with dipole f/f ("maximally" tweaked)
+   GReWeightXSecIntegrator fIntegrator; ///< integrated cross sections of both (not tweaked)
 
    double fFFTwkDial;    ///< tweaking dial (0: bba/default, +1: dipole)
 
@@ -34,6 +34,7 @@
 #include "RwCalculators/GReWeightNuXSecCCRES.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -170,6 +171,7 @@ void GReWeightNuXSecCCRES::Reconfigure(void)
 
   r.Set(fMaPath, fMaCurr);
   r.Set(fMvPath, fMvCurr);
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 
 //LOG("ReW, pDEBUG) << *fXSecModel;
@@ -202,8 +204,17 @@ double GReWeightNuXSecCCRES::CalcWeight(const genie::EventRecord & event)
   return 1.;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecCCRES::DefaultXSecModel(
+  const EventRecord & /*event*/, KinePhaseSpace_t & kps) const
+{
+  kps = kPSWQ2fE;
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecCCRES::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/RES-CC");
@@ -276,19 +287,7 @@ double GReWeightNuXSecCCRES::CalcWeightMaMv(const genie::EventRecord & event)
 
   const KinePhaseSpace_t phase_space = kPSWQ2fE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
@@ -312,19 +311,7 @@ double GReWeightNuXSecCCRES::CalcWeightMaMvShape(const genie::EventRecord & even
 
   const KinePhaseSpace_t phase_space = kPSWQ2fE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
   double new_weight = old_weight * (new_xsec/old_xsec);
@@ -335,8 +322,8 @@ double GReWeightNuXSecCCRES::CalcWeightMaMvShape(const genie::EventRecord & even
 //LOG("ReW", pDEBUG) << "new weight = " << new_weight;
 
 //double old_integrated_xsec = event.XSec();
-  double old_integrated_xsec = fXSecModelDef -> Integral(interaction);
-  double twk_integrated_xsec = fXSecModel    -> Integral(interaction);
+  double old_integrated_xsec = fIntegrator.Nominal(fXSecModelDef, interaction);
+  double twk_integrated_xsec = fIntegrator.Tweaked(fXSecModelDef, fXSecModel, interaction, phase_space);
   assert(twk_integrated_xsec > 0);
   new_weight *= (old_integrated_xsec/twk_integrated_xsec);
 
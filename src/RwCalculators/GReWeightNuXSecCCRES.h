@@ -27,6 +27,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 class TFile;
 class TNtupleD;
@@ -68,6 +69,7 @@ namespace rew   {
  private:
 
    void   Init                (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
    double CalcWeightNorm      (const EventRecord & event);
    double CalcWeightMaMvShape (const EventRecord & event);
    double CalcWeightMaMv      (const EventRecord & event);
@@ -75,6 +77,7 @@ namespace rew   {
    XSecAlgorithmI * fXSecModelDef;    ///< default model
    XSecAlgorithmI * fXSecModel;       ///< tweaked model
    Registry *       fXSecModelConfig; ///< config in tweaked model
+   GReWeightXSecIntegrator fIntegrator; ///< integrated cross sections for the shape-only weights
 
    std::string fManualModelName; ///< If using a tweaked model that isn't the same as default, name
    std::string fManualModelType; ///< If using a tweaked model that isn't the same as default, type
@@ -30,6 +30,7 @@
 #include "RwCalculators/GReWeightNuXSecCOH.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -122,6 +123,7 @@ void GReWeightNuXSecCOH::Reconfigure(void)
   r.Set(fMaPath, fMaCurr);
   r.Set(fR0Path, fR0Curr);
 
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 
 //LOG("ReW", pDEBUG) << *fXSecModel;
@@ -154,19 +156,7 @@ double GReWeightNuXSecCOH::CalcWeight(const genie::EventRecord & event)
 
   const KinePhaseSpace_t phase_space = kPSxyfE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
@@ -177,8 +167,17 @@ double GReWeightNuXSecCOH::CalcWeight(const genie::EventRecord & event)
   return new_weight;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecCOH::DefaultXSecModel(
+  const EventRecord & /*event*/, KinePhaseSpace_t & kps) const
+{
+  kps = kPSxyfE;
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecCOH::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
 // -->  RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/COH-CC");
@@ -61,6 +61,7 @@ namespace rew   {
  private:
 
    void Init (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
 
    XSecAlgorithmI * fXSecModel;       ///< tweaked model
    XSecAlgorithmI * fXSecModelDef;    ///< default model
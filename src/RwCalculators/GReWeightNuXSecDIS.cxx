@@ -34,6 +34,7 @@
 #include "RwCalculators/GReWeightNuXSecDIS.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -179,6 +180,7 @@ void GReWeightNuXSecDIS::Reconfigure(void)
   r.Set(fCV1uBYPath, fCV1uBYCur);
   r.Set(fCV2uBYPath, fCV2uBYCur);
 
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 
 //LOG("ReW", pDEBUG) << *fXSecModel;
@@ -270,27 +272,15 @@ double GReWeightNuXSecDIS::CalcWeightABCV12uShape(const genie::EventRecord & eve
 
   const KinePhaseSpace_t phase_space = kPSxyfE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double twk_xsec   = fXSecModel->XSec(interaction, phase_space);
   double weight = old_weight * (twk_xsec/old_xsec);
 
 //double old_integrated_xsec = event.XSec();
-  double old_integrated_xsec = fXSecModelDef -> Integral(interaction);
-  double twk_integrated_xsec = fXSecModel    -> Integral(interaction);
+  double old_integrated_xsec = fIntegrator.Nominal(fXSecModelDef, interaction);
+  double twk_integrated_xsec = fIntegrator.Tweaked(fXSecModelDef, fXSecModel, interaction, phase_space);
 
   assert(twk_integrated_xsec > 0);
   weight *= (old_integrated_xsec/twk_integrated_xsec);
@@ -300,8 +290,17 @@ double GReWeightNuXSecDIS::CalcWeightABCV12uShape(const genie::EventRecord & eve
   return weight;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecDIS::DefaultXSecModel(
+  const EventRecord & /*event*/, KinePhaseSpace_t & kps) const
+{
+  kps = kPSxyfE;
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecDIS::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgId id("genie::QPMDISPXSec","Default");
 
   AlgFactory * algf = AlgFactory::Instance();
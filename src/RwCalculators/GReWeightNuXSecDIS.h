@@ -25,6 +25,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 class TFile;
 class TNtupleD;
@@ -72,12 +73,14 @@ namespace rew   {
  private:
 
    void   Init                   (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
    double CalcWeightABCV12u      (const genie::EventRecord & event); ///< rew. Aht,Bht,CV1u,CV2u
    double CalcWeightABCV12uShape (const genie::EventRecord & event); ///< rew. AhtShape,BhtShape,CV1uShape,CV2uShape
 
    XSecAlgorithmI * fXSecModelDef;    ///< default model
    XSecAlgorithmI * fXSecModel;       ///< tweaked model
    Registry *       fXSecModelConfig; ///< config in tweaked model
+   GReWeightXSecIntegrator fIntegrator; ///< integrated cross sections for the shape-only weights
 
    bool   fRewNue;               ///< reweight nu_e?
    bool   fRewNuebar;            ///< reweight nu_e_bar?
@@ -20,6 +20,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightNuXSecHelper.h"
+#include "RwFramework/GReWeightTracer.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -126,12 +127,20 @@ double GReWeightNuXSecHelper::NewWeight(
 
   double old_xsec   = event.DiffXSec();
   double old_weight = event.Weight();
-  double new_xsec   = xsec_model->XSec(&interaction,kps);
+  double new_xsec   = 0.;
+  {
+    GReWeightTraceSpan span("XSec", "xsec");
+    new_xsec = xsec_model->XSec(&interaction,kps);
+  }
   double new_weight = old_weight * (new_xsec/old_xsec);
 
   if(shape_only) {
     double old_integrated_xsec = event.XSec();
-    double new_integrated_xsec = xsec_model->Integral(&interaction);
+    double new_integrated_xsec = 0.;
+    {
+      GReWeightTraceSpan span("Integral", "xsec");
+      new_integrated_xsec = xsec_model->Integral(&interaction);
+    }
     assert(new_integrated_xsec > 0);
     new_weight *= (old_integrated_xsec/new_integrated_xsec);
   }
@@ -24,6 +24,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightNuXSecNC.h"
+#include "RwFramework/GReWeightEventView.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
 
@@ -93,19 +94,41 @@ double GReWeightNuXSecNC::CalcWeight(const genie::EventRecord & event)
   if(!tweaked) return 1.;
 
   Interaction * interaction = event.Summary();
-  bool is_nc  = interaction->ProcInfo().IsWeakNC();
+  const ProcessInfo & proc_info = interaction->ProcInfo();
+
+  return this->ProcessWeight(proc_info.InteractionTypeId(),
+     proc_info.ScatteringTypeId(), interaction->InitState().ProbePdg());
+}
+//_______________________________________________________________________________________
+double GReWeightNuXSecNC::CalcViewWeight(const GReWeightEventView & event)
+{
+// Same as above, from the process & probe of a compact event view
+//
+  bool tweaked = (TMath::Abs(fNCTwkDial) > controls::kASmallNum);
+  if(!tweaked) return 1.;
+
+  int iprobe = event.ProbePosition();
+  if(iprobe < 0) return 1.;
+
+  return this->ProcessWeight(event.InteractionTypeId(),
+     event.ScatteringTypeId(), event.Pdg(iprobe));
+}
+//_______________________________________________________________________________________
+double GReWeightNuXSecNC::ProcessWeight(
+   InteractionType_t itype, ScatteringType_t stype, int nupdg) const
+{
+  bool is_nc  = (itype == kIntWeakNC);
   if(!is_nc) return 1.;
 
-  bool is_qel = event.Summary()->ProcInfo().IsQuasiElastic();
+  bool is_qel = (stype == kScQuasiElastic);
   if(is_qel && !fRewQE) return 1.;
 
-  bool is_res = event.Summary()->ProcInfo().IsResonant();
+  bool is_res = (stype == kScResonant);
   if(is_res && !fRewRES) return 1.;
 
-  bool is_dis = event.Summary()->ProcInfo().IsDeepInelastic();
+  bool is_dis = (stype == kScDeepInelastic);
   if(is_dis && !fRewDIS) return 1.;
 
-  int nupdg = interaction->InitState().ProbePdg();
   if(nupdg==kPdgNuMu     && !fRewNumu   ) return 1.;
   if(nupdg==kPdgAntiNuMu && !fRewNumubar) return 1.;
   if(nupdg==kPdgNuE      && !fRewNue    ) return 1.;
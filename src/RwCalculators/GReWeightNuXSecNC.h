@@ -43,6 +43,8 @@ namespace rew   {
    void   Reset          (void);
    void   Reconfigure    (void);
    double CalcWeight     (const EventRecord & event);
+   bool   HandlesEventView (void) const { return true; }
+   double CalcViewWeight (const GReWeightEventView & event);
 
    // various config options
    void RewNue       (bool   tf)  { fRewNue     = tf; }
@@ -56,6 +58,7 @@ namespace rew   {
  private:
 
    void   Init (void);
+   double ProcessWeight (InteractionType_t itype, ScatteringType_t stype, int nupdg) const;
 
    bool   fRewNue;         ///< reweight nu_e?
    bool   fRewNuebar;      ///< reweight nu_e_bar?
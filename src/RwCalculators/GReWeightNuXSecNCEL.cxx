@@ -30,6 +30,7 @@
 #include "RwCalculators/GReWeightUtils.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -128,6 +129,7 @@ void GReWeightNuXSecNCEL::Reconfigure(void)
 
   r.Set(fMaPath,  fMaCurr );
   r.Set(fEtaPath, fEtaCurr);
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 
 //LOG("ReW, pDEBUG) << *fXSecModel;
@@ -160,19 +162,7 @@ double GReWeightNuXSecNCEL::CalcWeight(const genie::EventRecord & event)
     interaction->SetBit(kIAssumeFreeNucleon);
   }
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space );
@@ -198,8 +188,17 @@ double GReWeightNuXSecNCEL::CalcWeight(const genie::EventRecord & event)
   return new_weight;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecNCEL::DefaultXSecModel(
+  const EventRecord & event, KinePhaseSpace_t & kps) const
+{
+  kps = event.DiffXSecVars();
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecNCEL::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/QEL-NC");
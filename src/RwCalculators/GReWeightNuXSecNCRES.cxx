@@ -32,6 +32,7 @@
 #include "RwCalculators/GReWeightNuXSecNCRES.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -163,6 +164,7 @@ void GReWeightNuXSecNCRES::Reconfigure(void)
 
   r.Set(fMaPath, fMaCurr);
   r.Set(fMvPath, fMvCurr);
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 
 //LOG("ReW, pDEBUG) << *fXSecModel;
@@ -195,8 +197,17 @@ double GReWeightNuXSecNCRES::CalcWeight(const genie::EventRecord & event)
   return 1.;
 }
 //_______________________________________________________________________________________
+const XSecAlgorithmI * GReWeightNuXSecNCRES::DefaultXSecModel(
+  const EventRecord & /*event*/, KinePhaseSpace_t & kps) const
+{
+  kps = kPSWQ2fE;
+  return fXSecModelDef;
+}
+//_______________________________________________________________________________________
 void GReWeightNuXSecNCRES::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgConfigPool * conf_pool = AlgConfigPool::Instance();
   Registry * gpl = conf_pool->GlobalParameterList();
   RgAlg xsec_alg = gpl->GetAlg("XSecModel@genie::EventGenerator/RES-NC");
@@ -264,19 +275,7 @@ double GReWeightNuXSecNCRES::CalcWeightMaMv(const genie::EventRecord & event)
 
   const KinePhaseSpace_t phase_space = kPSWQ2fE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
@@ -300,19 +299,7 @@ double GReWeightNuXSecNCRES::CalcWeightMaMvShape(const genie::EventRecord & even
 
   const KinePhaseSpace_t phase_space = kPSWQ2fE;
 
-  double old_xsec   = event.DiffXSec();
-  if (!fUseOldWeightFromFile || fNWeightChecksDone < fNWeightChecksToDo) {
-    double calc_old_xsec = fXSecModelDef->XSec(interaction, phase_space);
-    if (fNWeightChecksDone < fNWeightChecksToDo) {
-      if (std::abs(calc_old_xsec - old_xsec)/old_xsec > controls::kASmallNum) {
-        LOG("ReW",pWARN) << "Warning - default dxsec does not match dxsec saved in tree. Does the config match?";
-      }
-      fNWeightChecksDone++;
-    }
-    if(!fUseOldWeightFromFile) {
-      old_xsec = calc_old_xsec;
-    }
-  }
+  double old_xsec   = this->OldDiffXSec(event, fXSecModelDef, phase_space);
 
   double old_weight = event.Weight();
   double new_xsec   = fXSecModel->XSec(interaction, phase_space);
@@ -324,8 +311,8 @@ double GReWeightNuXSecNCRES::CalcWeightMaMvShape(const genie::EventRecord & even
 //LOG("ReW", pDEBUG) << "new weight = " << new_weight;
 
 //double old_integrated_xsec = event.XSec();
-  double old_integrated_xsec = fXSecModelDef -> Integral(interaction);
-  double twk_integrated_xsec = fXSecModel    -> Integral(interaction);
+  double old_integrated_xsec = fIntegrator.Nominal(fXSecModelDef, interaction);
+  double twk_integrated_xsec = fIntegrator.Tweaked(fXSecModelDef, fXSecModel, interaction, phase_space);
   assert(twk_integrated_xsec > 0);
   new_weight *= (old_integrated_xsec/twk_integrated_xsec);
 
@@ -26,6 +26,7 @@
 
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightXSecIntegrator.h"
 
 namespace genie {
 
@@ -64,6 +65,7 @@ namespace rew   {
  private:
 
    void   Init                (void);
+   const XSecAlgorithmI * DefaultXSecModel (const EventRecord & event, KinePhaseSpace_t & kps) const;
    double CalcWeightNorm      (const EventRecord & event);
    double CalcWeightMaMvShape (const EventRecord & event);
    double CalcWeightMaMv      (const EventRecord & event);
@@ -71,6 +73,7 @@ namespace rew   {
    XSecAlgorithmI * fXSecModelDef;    ///< default model
    XSecAlgorithmI * fXSecModel;       ///< tweaked model
    Registry *       fXSecModelConfig; ///< config in tweaked model
+   GReWeightXSecIntegrator fIntegrator; ///< integrated cross sections for the shape-only weights
 
    int    fMode;         ///< 0: Ma/Mv, 1: Norm and MaShape/MvShape
    string fMaPath;       ///< M_{A} path in configuration
@@ -0,0 +1,123 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+// GENIE/Generator includes
+#include "Framework/Conventions/Controls.h"
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwCalculators/GReWeightModel.h"
+#include "RwCalculators/GReWeightPreflight.h"
+#include "RwFramework/GReWeight.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+//____________________________________________________________________________
+GReWeightPreflight::GReWeightPreflight() :
+fTolerance (controls::kASmallNum),
+fNChecks   (20)
+{
+
+}
+//____________________________________________________________________________
+void GReWeightPreflight::Check(GReWeight & rw, const EventRecord & event)
+{
+  string process = GReWeightModel::ProcessKey(event);
+  double stored  = event.DiffXSec();
+
+  const vector<string> & names = rw.WghtCalcNames();
+  for(unsigned int i = 0; i < names.size(); i++) {
+    GReWeightModel * model = dynamic_cast<GReWeightModel *> (rw.WghtCalc(names[i]));
+    if(!model) continue;
+
+    ProcessChecks_t & checks = fChecks[names[i]];
+    ProcessChecks_t::const_iterator it = checks.find(process);
+    if(it != checks.end() && it->second.n >= fNChecks) continue;
+
+    double computed = 0.;
+    if(!model->DefaultDiffXSec(event, computed)) continue;
+
+    double diff = (stored > 0.) ?
+      std::abs(computed - stored) / stored : ((computed == stored) ? 0. : 1.);
+    Check_t & check = checks[process];
+    check.n++;
+    if(!(diff <= fTolerance)) check.nfail++;
+    if(!(diff <= check.maxdiff)) check.maxdiff = diff;
+  }
+}
+//____________________________________________________________________________
+void GReWeightPreflight::Apply(GReWeight & rw) const
+{
+  std::map<string, ProcessChecks_t>::const_iterator calc = fChecks.begin();
+  for( ; calc != fChecks.end(); ++calc) {
+    GReWeightModel * model = dynamic_cast<GReWeightModel *> (rw.WghtCalc(calc->first));
+    if(!model) continue;
+    ProcessChecks_t::const_iterator it = calc->second.begin();
+    for( ; it != calc->second.end(); ++it) {
+      model->UseOldWeightFromFile(it->first, it->second.nfail == 0);
+    }
+  }
+}
+//____________________________________________________________________________
+void GReWeightPreflight::Print(void) const
+{
+  std::ostringstream table;
+  std::map<string, ProcessChecks_t>::const_iterator calc = fChecks.begin();
+  for( ; calc != fChecks.end(); ++calc) {
+    ProcessChecks_t::const_iterator it = calc->second.begin();
+    for( ; it != calc->second.end(); ++it) {
+      const Check_t & check = it->second;
+      table << "\n " << std::setw(24) << std::left << calc->first
+            << std::setw(40) << it->first << std::right
+            << std::setw(5) << check.n << " checked, "
+            << std::setw(5) << check.nfail << " failed, max rel. diff "
+            << std::setw(10) << std::setprecision(3) << check.maxdiff
+            << " -> " << ((check.nfail == 0) ? "stored" : "recomputed");
+    }
+  }
+  LOG("ReW", pNOTICE)
+    << "Preflight check of the stored differential cross sections: "
+    << this->NTrusted() << " of " << this->NChecked()
+    << " calculator & process pairs use the stored values" << table.str();
+  if(this->NTrusted() < this->NChecked()) {
+    LOG("ReW", pWARN)
+      << "Stored differential cross sections disagree with the default models "
+      << "for some processes: they will be recomputed. Does the config match?";
+  }
+}
+//____________________________________________________________________________
+int GReWeightPreflight::NChecked(void) const
+{
+  int n = 0;
+  std::map<string, ProcessChecks_t>::const_iterator calc = fChecks.begin();
+  for( ; calc != fChecks.end(); ++calc) n += calc->second.size();
+  return n;
+}
+//____________________________________________________________________________
+int GReWeightPreflight::NTrusted(void) const
+{
+  int n = 0;
+  std::map<string, ProcessChecks_t>::const_iterator calc = fChecks.begin();
+  for( ; calc != fChecks.end(); ++calc) {
+    ProcessChecks_t::const_iterator it = calc->second.begin();
+    for( ; it != calc->second.end(); ++it) if(it->second.nfail == 0) n++;
+  }
+  return n;
+}
+//____________________________________________________________________________
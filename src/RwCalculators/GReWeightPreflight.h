@@ -0,0 +1,81 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightPreflight
+
+\brief    Decides, before a reweighting job, where the differential cross
+          sections stored in the event file can be trusted.
+
+          The cross section weight calculators divide by the event's
+          generation-time differential cross section: either the one stored
+          with the event (fast) or the default model's, recomputed for every
+          event. Check() compares the two for a sample of events, for every
+          calculator of a GReWeight and every process (scattering &
+          interaction type, target; see GReWeightModel::ProcessKey()) it
+          handles, up to SetNChecks() events each. Apply() then tells each
+          calculator to use the stored values for the processes where they
+          all agreed within the tolerance, and to recompute them for the
+          others. Processes not met in the sample keep the calculator's
+          default (stored values, with the first few events checked).
+
+          The sample should cover the event file (eg events spread over it)
+          so that rare processes & targets are checked too.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_PREFLIGHT_H_
+#define _G_REWEIGHT_PREFLIGHT_H_
+
+#include <map>
+#include <string>
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeight;
+
+class GReWeightPreflight {
+
+public:
+  GReWeightPreflight();
+ ~GReWeightPreflight() {}
+
+  void SetTolerance (double tol) { fTolerance = tol; } ///< max relative difference of stored & default dxsec
+  void SetNChecks   (int n)      { fNChecks   = n;   } ///< events checked per calculator & process
+
+  void Check (GReWeight & rw, const EventRecord & event); ///< compare the event's stored & default dxsec
+  void Apply (GReWeight & rw) const;                      ///< set the per-process choices of the calculators
+  void Print (void) const;                                ///< summary of the checks & decisions
+
+  int  NChecked (void) const;   ///< # of checked (calculator, process) pairs
+  int  NTrusted (void) const;   ///< # of them using the stored dxsec
+
+private:
+
+  struct Check_t {
+    Check_t() : n(0), nfail(0), maxdiff(0.) {}
+    int    n;        ///< # of events checked
+    int    nfail;    ///< # of them beyond the tolerance
+    double maxdiff;  ///< max relative difference
+  };
+  typedef std::map<std::string, Check_t> ProcessChecks_t;
+
+  double fTolerance;
+  int    fNChecks;
+  std::map<std::string, ProcessChecks_t> fChecks;  ///< [calculator][process]
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
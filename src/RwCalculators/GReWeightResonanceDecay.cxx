@@ -8,6 +8,8 @@
 */
 //____________________________________________________________________________
 
+#include <sstream>
+
 #include <TFile.h>
 #include <TNtupleD.h>
 #include <TH1D.h>
@@ -26,6 +28,9 @@
 // GENIE/Reweight includes
 #include "RwCalculators/GReWeightResonanceDecay.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightMath.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -333,7 +338,7 @@ double GReWeightResonanceDecay::RewThetaDelta2Npi(const EventRecord & event)
   double p32rs    = 0.75;
   double p12rs    = 0.25;
   double costheta = p4pip.Vect().CosTheta();
-  double P2       = 0.5 * (3.*costheta*costheta - 1.);
+  double P2       = GReWeightMath::LegendreP2(costheta);
   double Wiso     = 1 - p32iso * P2 + p12iso * P2; // = 1.0
   double Wrs      = 1 - p32rs  * P2 + p12rs  * P2;
   double dial     = fThetaDelta2NpiTwkDial;
@@ -357,6 +362,8 @@ double GReWeightResonanceDecay::RewThetaDelta2Npi(const EventRecord & event)
 //_______________________________________________________________________________________
 void GReWeightResonanceDecay::Init(void)
 {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   this->RewNue    (true);
   this->RewNuebar (true);
   this->RewNumu   (true);
@@ -402,9 +409,30 @@ void GReWeightResonanceDecay::Init(void)
   }
 
   // find corresponding decay channels and store default BR
+  // (unless already in the table cache)
+  GReWeightTableCache * cache = GReWeightTableCache::Instance();
+  std::ostringstream cache_cfg;
+  cache_cfg << "W bins: " << kNW << ", " << kWmin << ", " << kWmax;
   PDGLibrary * pdglib = PDGLibrary::Instance();
   ires=0;
   while((respdg = respdgarray[ires++])) {
+    std::ostringstream name1gamma, name1eta;
+    name1gamma << "BR1gamma_" << respdg;
+    name1eta   << "BR1eta_"   << respdg;
+    TH1D * cached1gamma = dynamic_cast<TH1D *> (
+       cache->Get(fName, cache_cfg.str(), name1gamma.str()));
+    TH1D * cached1eta   = dynamic_cast<TH1D *> (
+       cache->Get(fName, cache_cfg.str(), name1eta.str()));
+    if(cached1gamma && cached1eta) {
+      delete fMpBR1gammaDef [respdg];
+      delete fMpBR1etaDef   [respdg];
+      fMpBR1gammaDef [respdg] = cached1gamma;
+      fMpBR1etaDef   [respdg] = cached1eta;
+      continue;
+    }
+    delete cached1gamma;
+    delete cached1eta;
+
     TParticlePDG * res = pdglib->Find(respdg);
     if(!res) continue;
     for(int j=0; j<res->NDecayChannels(); j++) {
@@ -429,6 +457,8 @@ void GReWeightResonanceDecay::Init(void)
           if(is_allowed && is_1eta  ) { fMpBR1etaDef  [respdg]->Fill(W, br); }
         }//W bins
     }//decay channels
+    cache->Put(fName, cache_cfg.str(), name1gamma.str(), *fMpBR1gammaDef[respdg]);
+    cache->Put(fName, cache_cfg.str(), name1eta.str(),   *fMpBR1etaDef  [respdg]);
   }//resonances
 
 #ifdef _G_REWEIGHT_RESDEC_DEBUG_
@@ -36,6 +36,7 @@
 #include "RwCalculators/GReWeightXSecEmpiricalMEC.h"
 #include "RwFramework/GSystSet.h"
 #include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightServices.h"
 
 using namespace genie;
 using namespace genie::rew;
@@ -55,6 +56,8 @@ GReWeightXSecEmpiricalMEC::~GReWeightXSecEmpiricalMEC() {
 }
 
 void GReWeightXSecEmpiricalMEC::Init(void) {
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
+
   AlgId id("genie::EmpiricalMECPXSec2015", "Default");
 
   AlgFactory *algf = AlgFactory::Instance();
@@ -271,6 +274,7 @@ void GReWeightXSecEmpiricalMEC::Reconfigure(void) {
     r.Set("EmpiricalMEC-FracEMQE", fFracEMQE_Curr);
   }
 
+  GReWeightServices::AlgorithmLock lock; // shared algorithm factory & config pool
   fXSecModel->Configure(r);
 }
 
@@ -0,0 +1,306 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <TLorentzVector.h>
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/XSecAlgorithmI.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Interaction/KPhaseSpace.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/KineUtils.h"
+#include "Framework/Utils/Range1.h"
+
+// GENIE/Reweight includes
+#include "RwCalculators/GReWeightXSecIntegrator.h"
+#include "RwFramework/GReWeightMath.h"
+#include "RwFramework/GReWeightTracer.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  // Simpson sums over the n+1 nodes (fine) & over every other node (coarse)
+  void Simpson(const vector<double> & ffine, const vector<double> & fcoarse,
+               int n, double h, double & fine, double & coarse)
+  {
+    fine   = ffine  [0] + ffine  [n];
+    coarse = fcoarse[0] + fcoarse[n];
+    for(int i = 1; i < n; i++) {
+      fine += ((i%2 == 1) ? 4. : 2.) * ffine[i];
+      if(i%2 == 0) coarse += ((i%4 == 2) ? 4. : 2.) * fcoarse[i];
+    }
+    fine   *= h/3.;
+    coarse *= 2.*h/3.;
+  }
+  bool IsSupported(KinePhaseSpace_t kps)
+  {
+    return (kps == kPSQ2fE || kps == kPSWQ2fE || kps == kPSxyfE);
+  }
+
+  unsigned int gDefaultCacheSize = 100000;
+
+  // cross-checks against Integral(), shared by all instances (& threads)
+  std::atomic<unsigned int> gCheckEvery  (0);
+  std::atomic<long>         gNChecks     (0);
+  double                    gCheckMaxDev = 1E-2;
+  double                    gMaxDev      = 0.;
+  std::mutex                gCheckMutex;
+}
+//____________________________________________________________________________
+GReWeightXSecIntegrator::GReWeightXSecIntegrator() :
+fTolerance (1E-3),
+fNMin      (8),
+fNMax      (32),
+fCacheSize (0),
+fNCV       (0),
+fNFallback (0),
+fUses      (0)
+{
+
+}
+//____________________________________________________________________________
+GReWeightXSecIntegrator::~GReWeightXSecIntegrator()
+{
+
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::SetDefaultCacheSize(unsigned int n)
+{
+  gDefaultCacheSize = TMath::Max(n, 2u);
+}
+//____________________________________________________________________________
+unsigned int GReWeightXSecIntegrator::DefaultCacheSize(void)
+{
+  return gDefaultCacheSize;
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::SetCheck(unsigned int every, double max_dev)
+{
+  std::lock_guard<std::mutex> lock(gCheckMutex);
+  gCheckMaxDev = max_dev;
+  gCheckEvery.store(every);
+}
+//____________________________________________________________________________
+long GReWeightXSecIntegrator::NChecks(void)
+{
+  return gNChecks.load();
+}
+//____________________________________________________________________________
+double GReWeightXSecIntegrator::MaxCheckDeviation(void)
+{
+  std::lock_guard<std::mutex> lock(gCheckMutex);
+  return gMaxDev;
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::SetTolerance(double tol)
+{
+  fTolerance = tol;
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::SetGrid(int nmin, int nmax)
+{
+  // the coarse grid of the error estimate needs an even # of intervals
+  fNMin = TMath::Max(4, 4 * ((nmin + 3) / 4));
+  fNMax = TMath::Max(fNMin, nmax);
+}
+//____________________________________________________________________________
+double GReWeightXSecIntegrator::Nominal(
+  const XSecAlgorithmI * model, Interaction * interaction)
+{
+  string key = this->Key(model, interaction);
+  std::map<string, std::pair<double, long> >::iterator it = fCache.find(key);
+  if(it != fCache.end()) {
+    it->second.second = ++fUses;
+    return it->second.first;
+  }
+
+  double integral = 0.;
+  {
+    GReWeightTraceSpan span("Integral", "xsec");
+    integral = model->Integral(interaction);
+  }
+  unsigned int size = (fCacheSize > 0) ? fCacheSize : gDefaultCacheSize;
+  if(fCache.size() >= size) this->Evict();
+  fCache[key] = std::make_pair(integral, ++fUses);
+  return integral;
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::Evict(void)
+{
+// Drops the least recently used half of the cached integrals
+
+  vector<long> uses;
+  uses.reserve(fCache.size());
+  std::map<string, std::pair<double, long> >::iterator it;
+  for(it = fCache.begin(); it != fCache.end(); ++it) uses.push_back(it->second.second);
+  vector<long>::iterator median = uses.begin() + uses.size()/2;
+  std::nth_element(uses.begin(), median, uses.end());
+  for(it = fCache.begin(); it != fCache.end(); ) {
+    if(it->second.second < *median) fCache.erase(it++);
+    else ++it;
+  }
+}
+//____________________________________________________________________________
+double GReWeightXSecIntegrator::Tweaked(
+  const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+  Interaction * interaction, KinePhaseSpace_t kps)
+{
+  if(fTolerance > 0. && IsSupported(kps)) {
+    double I0 = this->Nominal(nominal, interaction);
+
+    GReWeightTraceSpan span("IntegralDifference", "xsec");
+    Kinematics * kine = interaction->KinePtr();
+    double integral = -1.;
+    for(int n = fNMin; n <= fNMax && integral < 0.; n *= 2) {
+      double fine = 0., coarse = 0.;
+      this->Integrate(nominal, tweaked, interaction, kps, 0, n, fine, coarse);
+      double I   = I0 + fine;
+      double err = TMath::Abs(fine - coarse) / 15.;
+      if(I > 0. && err <= fTolerance * I) integral = I;
+    }
+    // back to the event's kinematics
+    kine->ClearRunningValues();
+    kine->UseSelectedKinematics();
+
+    if(integral > 0.) {
+      fNCV++;
+      unsigned int every = gCheckEvery.load();
+      if(every > 0 && fNCV % every == 0) this->Check(tweaked, interaction, integral);
+      return integral;
+    }
+  }
+
+  fNFallback++;
+  GReWeightTraceSpan span("Integral", "xsec");
+  return tweaked->Integral(interaction);
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::Check(
+  const XSecAlgorithmI * tweaked, Interaction * interaction, double integral) const
+{
+// Compares a control variate integral with the tweaked model's Integral()
+
+  double plain = 0.;
+  {
+    GReWeightTraceSpan span("Integral", "xsec");
+    plain = tweaked->Integral(interaction);
+  }
+  double dev = (plain > 0.) ? TMath::Abs(integral / plain - 1.) : 1.;
+
+  double max_dev = 0.;
+  gNChecks++;
+  {
+    std::lock_guard<std::mutex> lock(gCheckMutex);
+    gMaxDev = TMath::Max(gMaxDev, dev);
+    max_dev = gCheckMaxDev;
+  }
+
+  LOG("ReW", ((dev > max_dev) ? pWARN : pDEBUG))
+    << "Control variate integral of " << tweaked->Id().Key() << " for "
+    << interaction->AsString() << ": " << integral << " vs Integral(): "
+    << plain << " (relative deviation: " << dev << ")";
+}
+//____________________________________________________________________________
+void GReWeightXSecIntegrator::Integrate(
+  const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+  Interaction * interaction, KinePhaseSpace_t kps, int level, int n,
+  double & fine, double & coarse) const
+{
+// Integrates the cross section difference over the kinematic variable of
+// the given level (outer to inner: Q2; W, Q2; x, y), at the values of the
+// outer variables already set. Steeply falling variables (Q2, x) are
+// integrated in their logarithm, from 1E-6 of their upper limit.
+
+  const KPhaseSpace & ps = interaction->PhaseSpace();
+  Kinematics * kine = interaction->KinePtr();
+
+  int       nlevels = (kps == kPSQ2fE) ? 1 : 2;
+  Range1D_t lim;
+  bool      logv = false;
+  if(kps == kPSQ2fE)  { lim = ps.Q2Lim(); logv = true; }
+  if(kps == kPSWQ2fE) { lim = (level == 0) ? ps.WLim() : ps.Q2Lim_W(); logv = (level == 1); }
+  if(kps == kPSxyfE)  { lim = (level == 0) ? ps.XLim() : ps.YLim_X();  logv = (level == 0); }
+
+  fine   = 0.;
+  coarse = 0.;
+  double lo = (logv) ? TMath::Max(lim.min, 1E-6 * lim.max) : lim.min;
+  double hi = lim.max;
+  if(!(hi > lo)) return;
+
+  double a = (logv) ? TMath::Log(lo) : lo;
+  double b = (logv) ? TMath::Log(hi) : hi;
+  double h = (b - a) / n;
+
+  // the nodes, all at once (vectorized exponentials)
+  vector<double> nodes(n+1);
+  for(int i = 0; i <= n; i++) nodes[i] = a + i*h;
+  if(logv) GReWeightMath::Exp(&nodes[0], n+1, &nodes[0]);
+
+  vector<double> ffine(n+1, 0.), fcoarse(n+1, 0.);
+  for(int i = 0; i <= n; i++) {
+    double v   = nodes[i];
+    double jac = (logv) ? v : 1.;
+    if(kps == kPSQ2fE || (kps == kPSWQ2fE && level == 1)) kine->SetQ2(v);
+    if(kps == kPSWQ2fE && level == 0) kine->SetW(v);
+    if(kps == kPSxyfE  && level == 0) kine->Setx(v);
+    if(kps == kPSxyfE  && level == 1) kine->Sety(v);
+    if(level + 1 < nlevels) {
+      double fi = 0., co = 0.;
+      this->Integrate(nominal, tweaked, interaction, kps, level+1, n, fi, co);
+      ffine  [i] = jac * fi;
+      fcoarse[i] = jac * co;
+    } else {
+      ffine  [i] = jac * this->DiffXSec(nominal, tweaked, interaction, kps);
+      fcoarse[i] = ffine[i];
+    }
+  }
+  Simpson(ffine, fcoarse, n, h, fine, coarse);
+}
+//____________________________________________________________________________
+double GReWeightXSecIntegrator::DiffXSec(
+  const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+  Interaction * interaction, KinePhaseSpace_t kps) const
+{
+  if(kps == kPSxyfE) {
+    utils::kinematics::UpdateWQ2FromXY(interaction);
+    if(!interaction->PhaseSpace().IsAllowed()) return 0.;
+  }
+  return tweaked->XSec(interaction, kps) - nominal->XSec(interaction, kps);
+}
+//____________________________________________________________________________
+string GReWeightXSecIntegrator::Key(
+  const XSecAlgorithmI * model, const Interaction * interaction) const
+{
+  const InitialState & init_state = interaction->InitState();
+  const Target &       target     = init_state.Tgt();
+
+  std::ostringstream key;
+  key << std::setprecision(17)
+      << model->Id().Key() << ";" << interaction->AsString() << ";"
+      << init_state.ProbeE(kRfLab) << ";"
+      << interaction->TestBit(kIAssumeFreeNucleon);
+  if(target.HitNucIsSet()) {
+    const TLorentzVector * p4 = target.HitNucP4Ptr();
+    key << ";" << p4->Px() << "," << p4->Py() << "," << p4->Pz() << "," << p4->E();
+  }
+  return key.str();
+}
+//____________________________________________________________________________
@@ -0,0 +1,116 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightXSecIntegrator
+
+\brief    Integrated cross sections for the shape-only normalizations of the
+          cross section weight calculators.
+
+          The integral of a default (nominal) model depends only on the
+          interaction & energy, and is cached: an event reweighted for many
+          throws integrates the default model once. As the key includes the
+          probe energy & hit nucleon momentum, entries are per event in
+          practice, so the cache must hold those of a whole block of events
+          reweighted together: apps size it from their block plan with
+          SetDefaultCacheSize(). When full, the least recently used half of
+          the entries is dropped.
+
+          The integral of a tweaked model is computed with the default one
+          as a control variate: the cached default integral plus the
+          integral of the (small & smooth) difference of the tweaked and
+          default differential cross sections, over the event's kinematic
+          phase space on a coarse Simpson grid (in Q2; W & Q2; or x & y).
+          The grid is refined while the estimated error (from the grid of
+          half the size) exceeds the tolerance relative to the integral and,
+          if it does on the finest grid, the tweaked model's own Integral()
+          is used. Other kinematic phase spaces always fall back on
+          Integral(): in particular kPSQELEvGen, that of the GENIE v3 CCQE
+          models (sampled in the outgoing lepton angles & the nucleon
+          momentum), so their CCQE shape weights see no speed-up.
+
+          The tolerance bounds the Simpson error of the difference only.
+          The difference is integrated within the kinematic limits of the
+          phase space (KPhaseSpace), with Q2 & x from 1E-6 of their upper
+          limit, while the default integral comes from the model's own
+          Integral(), whose limits, cuts & method may differ. Where the
+          difference is significant near the limits that may bias the
+          result beyond the tolerance. SetCheck() cross-checks one in n
+          control variate integrals against Integral(), warning about the
+          ones deviating more than a given relative difference (see also
+          scripts/gcint/test/xsec_integrator_check.C).
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_XSEC_INTEGRATOR_H_
+#define _G_REWEIGHT_XSEC_INTEGRATOR_H_
+
+#include <map>
+#include <string>
+
+// GENIE/Generator includes
+#include "Framework/Conventions/KinePhaseSpace.h"
+
+namespace genie {
+
+class Interaction;
+class XSecAlgorithmI;
+
+namespace rew   {
+
+class GReWeightXSecIntegrator {
+
+public:
+  GReWeightXSecIntegrator();
+ ~GReWeightXSecIntegrator();
+
+  void   SetTolerance (double tol);              ///< relative error of tweaked integrals (<=0: always use Integral())
+  void   SetGrid      (int nmin, int nmax);      ///< Simpson intervals per kinematic variable
+  void   SetCacheSize (unsigned int n) { fCacheSize = n; } ///< max # of cached default integrals (0: the default one)
+
+  static void         SetDefaultCacheSize (unsigned int n);   ///< for all instances with no size of their own
+  static unsigned int DefaultCacheSize    (void);
+
+  static void         SetCheck          (unsigned int every, double max_dev = 1E-2); ///< cross-check 1 in `every' control variate integrals (per instance, 0: none) against Integral()
+  static long         NChecks           (void); ///< # of cross-checked integrals, all instances
+  static double       MaxCheckDeviation (void); ///< max relative deviation from Integral(), all instances
+
+  double Nominal (const XSecAlgorithmI * model, Interaction * interaction);  ///< model->Integral(), cached
+  double Tweaked (const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+                  Interaction * interaction, KinePhaseSpace_t kps);          ///< tweaked->Integral()
+
+  void   ClearCache   (void) { fCache.clear(); fUses = 0; }
+  long   NControlVariate (void) const { return fNCV;       } ///< tweaked integrals from the difference
+  long   NFallback       (void) const { return fNFallback; } ///< tweaked integrals from Integral()
+
+private:
+
+  void   Integrate  (const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+                     Interaction * interaction, KinePhaseSpace_t kps, int level, int n,
+                     double & fine, double & coarse) const;
+  double DiffXSec   (const XSecAlgorithmI * nominal, const XSecAlgorithmI * tweaked,
+                     Interaction * interaction, KinePhaseSpace_t kps) const;
+  std::string Key   (const XSecAlgorithmI * model, const Interaction * interaction) const;
+  void   Check      (const XSecAlgorithmI * tweaked, Interaction * interaction, double integral) const;
+  void   Evict      (void);
+
+  double       fTolerance;
+  int          fNMin;
+  int          fNMax;
+  unsigned int fCacheSize;
+  long         fNCV;
+  long         fNFallback;
+  long         fUses;
+  std::map<std::string, std::pair<double, long> > fCache;  ///< default integrals (& last use) by model, interaction & energy
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -29,7 +29,10 @@
 #pragma link C++ class genie::rew::GReWeightNuXSecDIS;
 #pragma link C++ class genie::rew::GReWeightNuXSecNC;
 #pragma link C++ class genie::rew::GReWeightNuXSecHelper;
+#pragma link C++ class genie::rew::GReWeightXSecIntegrator;
+#pragma link C++ class genie::rew::GReWeightPreflight;
 #pragma link C++ class genie::rew::GReWeightXSecEmpiricalMEC;
+#pragma link C++ class genie::rew::GReWeightHandle;
 
 #pragma link C++ ioctortype TRootIOCtor;
 
@@ -11,8 +11,10 @@
 */
 //____________________________________________________________________________
 
+#include <cstdlib>
 #include <vector>
 #include <algorithm>
+#include <sstream>
 
 #include <TMath.h>
 #include <TString.h>
@@ -23,14 +25,38 @@
 #include "Framework/Utils/RunOpt.h"
 // GENIE/Reweight includes
 #include "RwFramework/GReWeight.h"
+#include "RwFramework/GReWeightEventView.h"
+#include "RwFramework/GSystUncertainty.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+#include "RwFramework/GReWeightTracer.h"
 
 using std::vector;
 
 using namespace genie;
 using namespace genie::rew;
 
+namespace {
+  // Makes a GReWeight's own uncertainty table visible, through
+  // GSystUncertainty::Instance(), to its weight calculators while in scope
+  class UncertaintyScope {
+  public:
+    UncertaintyScope(GSystUncertainty * unc) : fActive(unc!=0), fPrev(0) {
+      if(fActive) fPrev = GSystUncertainty::MakeCurrent(unc);
+    }
+   ~UncertaintyScope() {
+      if(fActive) GSystUncertainty::MakeCurrent(fPrev);
+    }
+  private:
+    bool               fActive;
+    GSystUncertainty * fPrev;
+  };
+}
 //____________________________________________________________________________
-GReWeight::GReWeight()
+GReWeight::GReWeight() :
+fUncertainty(0),
+fReconfigured(false),
+fCalculated(false),
+fViewsHandled(true)
 {
   // Disable cacheing that interferes with event reweighting
   RunOpt::Instance()->EnableBareXSecPreCalc(false);
@@ -45,11 +71,16 @@ void GReWeight::AdoptWghtCalc(string name, GReWeightI* wcalc)
 {
   if(!wcalc) return;
 
+  // the calculator was constructed just before being adopted
+  GReWeightStartupTimer::Instance()->Lap("construct " + name);
+
   fWghtCalc.insert(map<string, GReWeightI*>::value_type(name,wcalc));
   
   if (std::find(fWghtCalcNames.begin(),fWghtCalcNames.end(),name) == fWghtCalcNames.end()) {
     fWghtCalcNames.push_back(name);
   }
+
+  this->UpdateViewCalcs();
 }
 //____________________________________________________________________________
 GReWeightI* GReWeight::WghtCalc(string name)
@@ -65,10 +96,25 @@ GSystSet & GReWeight::Systematics(void)
   return fSystSet; 
 }
 //____________________________________________________________________________
+GSystUncertainty & GReWeight::Uncertainties(void)
+{
+  if(!fUncertainty) {
+    fUncertainty = GSystUncertainty::Clone();
+  }
+  return *fUncertainty;
+}
+//____________________________________________________________________________
 void GReWeight::Reconfigure(void)
 {
   LOG("ReW", pNOTICE) << "Reconfiguring ...";
 
+  GReWeightTraceSpan span("GReWeight::Reconfigure", "reconfigure");
+  UncertaintyScope unc_scope(fUncertainty);
+
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  bool timed = timer->IsEnabled() && !fReconfigured;
+  fReconfigured = true;
+
   vector<genie::rew::GSyst_t> svec = fSystSet.AllIncluded();
 
   map<string, GReWeightI *>::iterator it = fWghtCalc.begin();
@@ -83,10 +129,17 @@ void GReWeight::Reconfigure(void)
           wcalc->SetSystematic(syst, val);
       }//params
 
-      wcalc->Reconfigure();
+      if(timed) timer->Begin("first reconfigure " + it->first);
+      {
+        GReWeightTraceSpan calc_span(it->first, "reconfigure");
+        wcalc->Reconfigure();
+      }
+      if(timed) timer->End  ("first reconfigure " + it->first);
 
   }//weight calculators
 
+  this->UpdateViewCalcs();
+
   LOG("ReW", pDEBUG) << "Done reconfiguring";
 }
 //____________________________________________________________________________
@@ -94,11 +147,26 @@ double GReWeight::CalcWeight(const genie::EventRecord & event)
 {
 // calculate weight for all tweaked physics parameters
 //
+  GReWeightTraceSpan span("GReWeight::CalcWeight", "weight");
+  UncertaintyScope unc_scope(fUncertainty);
+
+  GReWeightStartupTimer * timer = GReWeightStartupTimer::Instance();
+  bool timed = timer->IsEnabled() && !fCalculated;
+  fCalculated = true;
+
   double weight = 1.0;
   map<string, GReWeightI *>::iterator it = fWghtCalc.begin();
   for( ; it != fWghtCalc.end(); ++it) {
+    if(fExcluded.size() > 0 &&
+       std::find(fExcluded.begin(), fExcluded.end(), it->first) != fExcluded.end()) continue;
     GReWeightI * wcalc = it->second;
-    double w = wcalc->CalcWeight(event); 
+    if(timed) timer->Begin("first event " + it->first);
+    double w = 1.;
+    {
+      GReWeightTraceSpan calc_span(it->first, "calc");
+      w = wcalc->CalcWeight(event);
+    }
+    if(timed) timer->End  ("first event " + it->first);
     LOG("ReW", pNOTICE) 
        << "Calculator: " << it->first << " => wght = " << w;	
     weight *= w;
@@ -106,6 +174,84 @@ double GReWeight::CalcWeight(const genie::EventRecord & event)
   return weight;
 }
 //____________________________________________________________________________
+double GReWeight::CalcWeight(const GReWeightEventView & event)
+{
+// as above, for event views: calculators with no tweaked params return 1
+// and are skipped, all others must handle event views
+//
+  if(!fViewsHandled) {
+    std::ostringstream names;
+    for(unsigned int i = 0; i < fViewCalcs.size(); i++) {
+      if(!fViewCalcs[i]->HandlesEventView()) names << " " << fViewCalcNames[i];
+    }
+    LOG("ReW", pFATAL)
+      << "Weight calculators with tweaked params need full event records"
+      << " (check HandlesEventView() first):" << names.str();
+    exit(1);
+  }
+
+  GReWeightTraceSpan span("GReWeight::CalcWeight", "weight");
+  UncertaintyScope unc_scope(fUncertainty);
+
+  double weight = 1.0;
+  for(unsigned int i = 0; i < fViewCalcs.size(); i++) {
+    double w = 1.;
+    {
+      GReWeightTraceSpan calc_span(fViewCalcNames[i], "calc");
+      w = fViewCalcs[i]->CalcViewWeight(event);
+    }
+    LOG("ReW", pNOTICE)
+       << "Calculator: " << fViewCalcNames[i] << " => wght = " << w;
+    weight *= w;
+  }
+  return weight;
+}
+//____________________________________________________________________________
+double GReWeight::CalcWeight(const genie::EventRecord & event, string name)
+{
+  GReWeightI * wcalc = this->WghtCalc(name);
+  if(!wcalc) {
+    LOG("ReW", pWARN) << "No weight calculator named " << name;
+    return 1.;
+  }
+
+  UncertaintyScope unc_scope(fUncertainty);
+  GReWeightTraceSpan calc_span(name, "calc");
+  return wcalc->CalcWeight(event);
+}
+//____________________________________________________________________________
+void GReWeight::ExcludeWghtCalc(string name, bool exclude)
+{
+  vector<string>::iterator it = std::find(fExcluded.begin(), fExcluded.end(), name);
+  if(exclude && it == fExcluded.end()) fExcluded.push_back(name);
+  if(!exclude && it != fExcluded.end()) fExcluded.erase(it);
+
+  this->UpdateViewCalcs();
+}
+//____________________________________________________________________________
+void GReWeight::UpdateViewCalcs(void)
+{
+  fViewCalcs.clear();
+  fViewCalcNames.clear();
+  fViewsHandled = true;
+
+  vector<genie::rew::GSyst_t> svec = fSystSet.AllIncluded();
+
+  map<string, GReWeightI *>::iterator it = fWghtCalc.begin();
+  for( ; it != fWghtCalc.end(); ++it) {
+    if(std::find(fExcluded.begin(), fExcluded.end(), it->first) != fExcluded.end()) continue;
+    GReWeightI * wcalc = it->second;
+    bool tweaked = false;
+    for(unsigned int i = 0; i < svec.size(); i++) {
+      if(wcalc->IsHandled(svec[i]) && fSystSet.Info(svec[i])->CurValue != 0.) tweaked = true;
+    }
+    if(!tweaked) continue;
+    fViewCalcs    .push_back(wcalc);
+    fViewCalcNames.push_back(it->first);
+    if(!wcalc->HandlesEventView()) fViewsHandled = false;
+  }
+}
+//____________________________________________________________________________
 void GReWeight::CleanUp(void)
 {
   map<string, GReWeightI *>::iterator it = fWghtCalc.begin();
@@ -117,6 +263,11 @@ void GReWeight::CleanUp(void)
     }
   }
   fWghtCalc.clear();
+
+  if(fUncertainty) {
+    delete fUncertainty;
+    fUncertainty = 0;
+  }
 }
 //____________________________________________________________________________
 void GReWeight::Print()
@@ -35,6 +35,9 @@ class EventRecord;
 
 namespace rew   {
 
+ class GSystUncertainty;
+ class GReWeightEventView;
+
  class GReWeight
  {
  public:
@@ -44,19 +47,35 @@ namespace rew   {
    void        AdoptWghtCalc (string name, GReWeightI* wcalc);   ///< add concrete weight calculator, transfers ownership
    GReWeightI* WghtCalc      (string name);                      ///< access a weight calculator by name
    GSystSet &  Systematics   (void);                             ///< set of enabled systematic params & values
+   GSystUncertainty & Uncertainties (void);                      ///< uncertainties private to this instance (copied from the shared table on first call)
    void        Reconfigure   (void);                             ///< reconfigure weight calculators with new params
    double      CalcWeight    (const genie::EventRecord & event); ///< calculate weight for input event
+   double      CalcWeight    (const GReWeightEventView & event); ///< calculate weight for input event view (if HandlesEventView())
+   double      CalcWeight    (const genie::EventRecord & event, string name); ///< weight from a single calculator (excluded or not)
+   void        ExcludeWghtCalc (string name, bool exclude = true);  ///< leave a calculator out of CalcWeight() (eg when its weights are synthesized)
+   bool        HandlesEventView (void) const { return fViewsHandled; } ///< can all calculators with tweaked params use event views?
    void        Print         (void);                             ///< print
    
    const std::vector<std::string> & WghtCalcNames() const;
 
   private:
 
-   void CleanUp (void);
+   GReWeight(const GReWeight &);              ///< not copyable (owns its calculators & fUncertainty)
+   GReWeight & operator = (const GReWeight &);
+
+   void CleanUp         (void);
+   void UpdateViewCalcs (void);
 
    GSystSet                  fSystSet;   ///< set of enabled nuisance parameters
+   GSystUncertainty *        fUncertainty; ///< own uncertainty table, if any (otherwise the shared one is used)
    std::map<std::string, GReWeightI *> fWghtCalc;  ///< concrete weight calculators
    std::vector<std::string> fWghtCalcNames; ///< list of weight calculators
+   std::vector<std::string> fExcluded;      ///< calculators left out of CalcWeight()
+   bool                      fReconfigured; ///< Reconfigure() called yet? (for startup timing)
+   bool                      fCalculated;   ///< CalcWeight() called yet? (for startup timing)
+   std::vector<GReWeightI *> fViewCalcs;    ///< calculators with tweaked params, for event views
+   std::vector<std::string>  fViewCalcNames;
+   bool                      fViewsHandled; ///< do all of them handle event views?
  };
 
 } // rew   namespace
@@ -0,0 +1,127 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightBlockPlan.h"
+
+using std::string;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  const double kWeightBytes = sizeof(double); // a weight held in a block
+}
+//____________________________________________________________________________
+GReWeightBlockPlan::GReWeightBlockPlan() :
+fNEvents      (1),
+fNUniverses   (1),
+fDecode       (0.),
+fReconfigure  (0.),
+fEventBytes   (0.),
+fBudget       (0.),
+fStep         (0),
+fFixEvents    (0),
+fFixUniverses (0),
+fEvents       (1),
+fUniverses    (1),
+fOverhead     (0.)
+{
+
+}
+//____________________________________________________________________________
+void GReWeightBlockPlan::SetSize(long nevents, int nuniverses)
+{
+  fNEvents    = (nevents    > 0) ? nevents    : 1;
+  fNUniverses = (nuniverses > 0) ? nuniverses : 1;
+}
+//____________________________________________________________________________
+void GReWeightBlockPlan::SetCosts(double decode, double reconfigure)
+{
+  fDecode      = decode;
+  fReconfigure = reconfigure;
+}
+//____________________________________________________________________________
+void GReWeightBlockPlan::SetMemory(double event_bytes, double budget_bytes)
+{
+  fEventBytes = event_bytes;
+  fBudget     = budget_bytes;
+}
+//____________________________________________________________________________
+double GReWeightBlockPlan::Overhead(long nevents, int nuniverses) const
+{
+  double ndecode = (double) fNEvents    * ((fNUniverses + nuniverses - 1) / nuniverses);
+  double nconfig = (double) fNUniverses * ((fNEvents    + nevents    - 1) / nevents);
+  return ndecode * fDecode + nconfig * fReconfigure;
+}
+//____________________________________________________________________________
+void GReWeightBlockPlan::Plan(void)
+{
+  fEvents    = 1;
+  fUniverses = 1;
+  fOverhead  = -1.;
+
+  int numin = 1;
+  int numax = fNUniverses;
+  if(fFixUniverses > 0) numin = numax = std::min(fFixUniverses, fNUniverses);
+
+  for(int nu = numin; nu <= numax; nu++) {
+    // universe blocks end on the step (or hold all universes, if fewer)
+    if(fFixUniverses == 0 && fStep > 0 && fStep % nu != 0 &&
+       !(nu == fNUniverses && nu < fStep)) continue;
+
+    // as many events as the budget allows
+    long ne = fNEvents;
+    if(fFixEvents > 0) ne = fFixEvents;
+    else if(fBudget > 0.) {
+      double n = std::floor(fBudget / (fEventBytes + nu * kWeightBytes));
+      if(n < ne) ne = (n >= 1.) ? (long) n : 1;
+    }
+    if(ne > fNEvents) ne = fNEvents;
+
+    // ties go to larger blocks, which write fewer temporary outputs
+    double overhead = this->Overhead(ne, nu);
+    if(fOverhead < 0. || overhead <= fOverhead) {
+      fEvents    = ne;
+      fUniverses = nu;
+      fOverhead  = overhead;
+    }
+  }
+}
+//____________________________________________________________________________
+long GReWeightBlockPlan::NEventBlocks(void) const
+{
+  return (fNEvents + fEvents - 1) / fEvents;
+}
+//____________________________________________________________________________
+int GReWeightBlockPlan::NUniverseBlocks(void) const
+{
+  return (fNUniverses + fUniverses - 1) / fUniverses;
+}
+//____________________________________________________________________________
+double GReWeightBlockPlan::Memory(void) const
+{
+  return fEvents * (fEventBytes + fUniverses * kWeightBytes);
+}
+//____________________________________________________________________________
+string GReWeightBlockPlan::Description(void) const
+{
+  std::ostringstream desc;
+  desc << this->NEventBlocks() << " x " << this->NUniverseBlocks()
+       << " blocks of " << fEvents << " events x " << fUniverses << " universes ("
+       << this->Memory() / (1024.*1024.) << " MB each); decoding "
+       << fDecode * 1E3 << " ms/event, reconfiguring " << fReconfigure * 1E3
+       << " ms/universe: " << fOverhead << " s of overhead";
+  return desc.str();
+}
+//____________________________________________________________________________
@@ -0,0 +1,88 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightBlockPlan
+
+\brief    Chooses how to partition the (events x universes) weights of a
+          reweighting job into blocks of (event range x universe range),
+          each block's events being decoded once and each of its universes
+          being configured once.
+
+          Over N events and T universes, blocks of E events & U universes
+          decode every event ceil(T/U) times and reconfigure every universe
+          ceil(N/E) times, while holding E decoded events & E*U weights in
+          memory. Given the measured cost of decoding an event and of a
+          Reconfigure(), the memory of a decoded event and a memory budget,
+          Plan() picks the shape minimizing
+
+            N ceil(T/U) t_decode + T ceil(N/E) t_reconfigure
+
+          with E (m_event + U m_weight) within the budget: the whole sample
+          in one block if it fits, few universes per block for expensive
+          events & cheap universes, few events per block the other way round.
+          Either dimension can be fixed, and the universe blocks can be made
+          to divide a step (eg a convergence check every step universes).
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_BLOCK_PLAN_H_
+#define _G_REWEIGHT_BLOCK_PLAN_H_
+
+#include <string>
+
+namespace genie {
+namespace rew   {
+
+class GReWeightBlockPlan {
+
+public:
+  GReWeightBlockPlan();
+ ~GReWeightBlockPlan() {}
+
+  void   SetSize         (long nevents, int nuniverses);
+  void   SetCosts        (double decode, double reconfigure);     ///< [s] per event decoded & per Reconfigure()
+  void   SetMemory       (double event_bytes, double budget_bytes); ///< per decoded event, & for a block
+  void   SetUniverseStep (int step)    { fStep       = step; }    ///< universe blocks must divide step (0: any)
+  void   FixEvents       (long nevents)   { fFixEvents    = nevents;    } ///< force the events per block (0: free)
+  void   FixUniverses    (int nuniverses) { fFixUniverses = nuniverses; } ///< force the universes per block (0: free)
+
+  void   Plan            (void);
+
+  long   NEvents         (void) const { return fEvents;    } ///< events per block
+  int    NUniverses      (void) const { return fUniverses; } ///< universes per block
+  long   NEventBlocks    (void) const;
+  int    NUniverseBlocks (void) const;
+  double Overhead        (void) const { return fOverhead;  } ///< [s] estimated decoding & reconfiguration time
+  double Memory          (void) const;                       ///< [bytes] held by a block
+
+  std::string Description (void) const;
+
+private:
+
+  double Overhead (long nevents, int nuniverses) const;
+
+  long   fNEvents;
+  int    fNUniverses;
+  double fDecode;        ///< [s] per event
+  double fReconfigure;   ///< [s] per universe
+  double fEventBytes;
+  double fBudget;        ///< [bytes]
+  int    fStep;
+  long   fFixEvents;
+  int    fFixUniverses;
+  long   fEvents;        ///< chosen shape
+  int    fUniverses;
+  double fOverhead;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
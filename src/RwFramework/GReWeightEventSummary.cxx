@@ -0,0 +1,198 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <TLorentzVector.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/GHEP/GHepStatus.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/ParticleData/PDGCodes.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightEventSummary.h"
+#include "RwFramework/GReWeightEventView.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  // Names, in Var_t order
+  const char * kVarNames[GReWeightEventSummary::kNVars] = {
+    "probe", "cc", "nc", "em", "qel", "res", "dis", "coh", "mec", "dfr", "charm",
+    "Ev", "Q2", "W", "x", "y",
+    "target", "A", "Z", "hitnuc",
+    "fsl", "Elep",
+    "np", "nn", "npip", "npim", "npi0", "nKp", "nKm", "nK0", "ngamma"
+  };
+}
+//____________________________________________________________________________
+GReWeightEventSummary::GReWeightEventSummary()
+{
+  for(int i = 0; i < kNVars; i++) fValue[i] = 0.;
+}
+//____________________________________________________________________________
+void GReWeightEventSummary::Fill(const EventRecord & event)
+{
+  for(int i = 0; i < kNVars; i++) fValue[i] = 0.;
+
+  const Interaction * interaction = event.Summary();
+  const ProcessInfo & proc_info   = interaction->ProcInfo();
+  const Target &      target      = interaction->InitState().Tgt();
+
+  fValue[kCC]     = proc_info.IsWeakCC();
+  fValue[kNC]     = proc_info.IsWeakNC();
+  fValue[kEM]     = proc_info.IsEM();
+  fValue[kQEL]    = proc_info.IsQuasiElastic();
+  fValue[kRES]    = proc_info.IsResonant();
+  fValue[kDIS]    = proc_info.IsDeepInelastic();
+  fValue[kCOH]    = proc_info.IsCoherentProduction();
+  fValue[kMEC]    = proc_info.IsMEC();
+  fValue[kDFR]    = proc_info.IsDiffractive();
+  fValue[kCharm]  = interaction->ExclTag().IsCharmEvent();
+  fValue[kTarget] = target.Pdg();
+  fValue[kA]      = target.A();
+  fValue[kZ]      = target.Z();
+
+  // Kinematics, from the event record rather than from the (possibly
+  // unset) selected kinematics of the interaction summary
+  GHepParticle * probe  = event.Probe();
+  GHepParticle * fsl    = event.FinalStatePrimaryLepton();
+  GHepParticle * hitnuc = event.HitNucleon();
+
+  fValue[kProbe] = probe->Pdg();
+  fValue[kEv]    = probe->E();
+  if(fsl) {
+    fValue[kFSLepton] = fsl->Pdg();
+    fValue[kElep]     = fsl->E();
+
+    TLorentzVector q = *(probe->P4()) - *(fsl->P4());
+    double Q2 = -1. * q.Mag2();
+    fValue[kQ2] = Q2;
+    if(hitnuc) {
+      const TLorentzVector & p = *(hitnuc->P4());
+      double pq = p.Dot(q);
+      double pk = p.Dot(*(probe->P4()));
+      fValue[kHitNuc] = hitnuc->Pdg();
+      fValue[kW]      = (p + q).M();
+      fValue[kX]      = (pq > 0.) ? Q2 / (2.*pq) : 0.;
+      fValue[kY]      = (pk > 0.) ? pq / pk      : 0.;
+    }
+  }
+
+  // Final state multiplicities
+  int nparticles = event.GetEntries();
+  for(int i = 0; i < nparticles; i++) {
+    GHepParticle * p = event.Particle(i);
+    if(p->Status() != kIStStableFinalState) continue;
+    this->CountFinalState(p->Pdg());
+  }
+}
+//____________________________________________________________________________
+void GReWeightEventSummary::Fill(const GReWeightEventView & event)
+{
+// Same quantities as above, from the particle arrays of the view
+//
+  for(int i = 0; i < kNVars; i++) fValue[i] = 0.;
+
+  InteractionType_t itype = event.InteractionTypeId();
+  ScatteringType_t  stype = event.ScatteringTypeId();
+
+  fValue[kCC]     = (itype == kIntWeakCC);
+  fValue[kNC]     = (itype == kIntWeakNC);
+  fValue[kEM]     = (itype == kIntEM);
+  fValue[kQEL]    = (stype == kScQuasiElastic);
+  fValue[kRES]    = (stype == kScResonant);
+  fValue[kDIS]    = (stype == kScDeepInelastic);
+  fValue[kCOH]    = (stype == kScCoherentProduction);
+  fValue[kMEC]    = (stype == kScMEC);
+  fValue[kDFR]    = (stype == kScDiffractive);
+  fValue[kCharm]  = event.IsCharm();
+  fValue[kTarget] = event.TargetPdg();
+  fValue[kA]      = event.TargetA();
+  fValue[kZ]      = event.TargetZ();
+
+  int iprobe  = event.ProbePosition();
+  int ifsl    = event.FSPrimLeptonPosition();
+  int ihitnuc = event.HitNucleonPosition();
+  if(iprobe < 0) return;
+
+  fValue[kProbe] = event.Pdg(iprobe);
+  fValue[kEv]    = event.E  (iprobe);
+  if(ifsl >= 0) {
+    fValue[kFSLepton] = event.Pdg(ifsl);
+    fValue[kElep]     = event.E  (ifsl);
+
+    TLorentzVector k (event.Px(iprobe), event.Py(iprobe), event.Pz(iprobe), event.E(iprobe));
+    TLorentzVector kl(event.Px(ifsl),   event.Py(ifsl),   event.Pz(ifsl),   event.E(ifsl));
+    TLorentzVector q = k - kl;
+    double Q2 = -1. * q.Mag2();
+    fValue[kQ2] = Q2;
+    if(ihitnuc >= 0) {
+      TLorentzVector p(event.Px(ihitnuc), event.Py(ihitnuc), event.Pz(ihitnuc), event.E(ihitnuc));
+      double pq = p.Dot(q);
+      double pk = p.Dot(k);
+      fValue[kHitNuc] = event.Pdg(ihitnuc);
+      fValue[kW]      = (p + q).M();
+      fValue[kX]      = (pq > 0.) ? Q2 / (2.*pq) : 0.;
+      fValue[kY]      = (pk > 0.) ? pq / pk      : 0.;
+    }
+  }
+
+  int nparticles = event.NParticles();
+  for(int i = 0; i < nparticles; i++) {
+    if(event.Status(i) != kIStStableFinalState) continue;
+    this->CountFinalState(event.Pdg(i));
+  }
+}
+//____________________________________________________________________________
+void GReWeightEventSummary::CountFinalState(int pdg)
+{
+  switch(pdg) {
+    case kPdgProton    : fValue[kNp]++;     break;
+    case kPdgNeutron   : fValue[kNn]++;     break;
+    case kPdgPiP       : fValue[kNpip]++;   break;
+    case kPdgPiM       : fValue[kNpim]++;   break;
+    case kPdgPi0       : fValue[kNpi0]++;   break;
+    case kPdgKP        : fValue[kNKp]++;    break;
+    case kPdgKM        : fValue[kNKm]++;    break;
+    case kPdgK0        :
+    case kPdgAntiK0    :
+    case kPdgK0L       :
+    case kPdgK0S       : fValue[kNK0]++;    break;
+    case kPdgGamma     : fValue[kNgamma]++; break;
+    default : break;
+  }
+}
+//____________________________________________________________________________
+int GReWeightEventSummary::VarIndex(const std::string & name)
+{
+  for(int i = 0; i < kNVars; i++) {
+    if(name == kVarNames[i]) return i;
+  }
+  return -1;
+}
+//____________________________________________________________________________
+const char * GReWeightEventSummary::VarName(int ivar)
+{
+  if(ivar < 0 || ivar >= kNVars) return "";
+  return kVarNames[ivar];
+}
+//____________________________________________________________________________
+std::string GReWeightEventSummary::VarList(void)
+{
+  std::string list;
+  for(int i = 0; i < kNVars; i++) {
+    if(i > 0) list += ", ";
+    list += kVarNames[i];
+  }
+  return list;
+}
+//____________________________________________________________________________
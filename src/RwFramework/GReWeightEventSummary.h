@@ -0,0 +1,96 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightEventSummary
+
+\brief    A handful of cheap event-level quantities (probe, interaction type,
+          process, Ev, Q2, W, x, y, target, final state multiplicities)
+          extracted from a GHEP event record in a single pass, so that events
+          can be selected (see GReWeightSelection) before any weight
+          calculator runs.
+          Quantities are addressed by name (eg `Ev', `Q2', `npip') or by
+          index; booleans are stored as 0/1 and PDG codes as numbers.
+          Can also be filled from a compact GReWeightEventView.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_EVENT_SUMMARY_H_
+#define _G_REWEIGHT_EVENT_SUMMARY_H_
+
+#include <string>
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeightEventView;
+
+class GReWeightEventSummary {
+
+public:
+  typedef enum EVar {
+    kProbe = 0,  ///< probe PDG code
+    kCC,         ///< weak charged current
+    kNC,         ///< weak neutral current
+    kEM,         ///< electromagnetic
+    kQEL,        ///< quasi-elastic
+    kRES,        ///< resonance production
+    kDIS,        ///< deep inelastic
+    kCOH,        ///< coherent production
+    kMEC,        ///< meson exchange current
+    kDFR,        ///< diffractive
+    kCharm,      ///< charm production
+    kEv,         ///< probe energy (GeV)
+    kQ2,         ///< momentum transfer Q2 = -q^2 (GeV^2)
+    kW,          ///< hadronic invariant mass (GeV)
+    kX,          ///< Bjorken x
+    kY,          ///< inelasticity y
+    kTarget,     ///< target PDG code
+    kA,          ///< target mass number
+    kZ,          ///< target atomic number
+    kHitNuc,     ///< hit nucleon PDG code (0 if none)
+    kFSLepton,   ///< final state primary lepton PDG code
+    kElep,       ///< final state primary lepton energy (GeV)
+    kNp,         ///< final state protons
+    kNn,         ///< final state neutrons
+    kNpip,       ///< final state pi+
+    kNpim,       ///< final state pi-
+    kNpi0,       ///< final state pi0
+    kNKp,        ///< final state K+
+    kNKm,        ///< final state K-
+    kNK0,        ///< final state K0, K0bar, K0L, K0S
+    kNgamma,     ///< final state photons
+    kNVars
+  } Var_t;
+
+  GReWeightEventSummary();
+ ~GReWeightEventSummary() {}
+
+  void   Fill  (const EventRecord & event);
+  void   Fill  (const GReWeightEventView & event);
+  double Value (int ivar) const { return fValue[ivar]; }
+
+  static int         VarIndex (const std::string & name); ///< -1 if unknown
+  static const char* VarName  (int ivar);
+  static std::string VarList  (void);                     ///< comma separated names
+
+private:
+
+  void   CountFinalState (int pdg);
+
+  double fValue[kNVars];
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,151 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Interaction/KineVar.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightEventView.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+const double GReWeightEventView::kNoKine = -99999.;
+
+namespace {
+  // selected kinematic variable, without the warning Kinematics logs if it
+  // is not set
+  double SelectedKV(const Kinematics & kine, KineVar_t kv)
+  {
+    return (kine.KVSet(kv)) ? kine.GetKV(kv) : GReWeightEventView::kNoKine;
+  }
+}
+//____________________________________________________________________________
+GReWeightEventView::GReWeightEventView()
+{
+  this->Clear();
+}
+//____________________________________________________________________________
+void GReWeightEventView::Clear(void)
+{
+  // clear() keeps the capacity
+  fPdg      .clear();
+  fStatus   .clear();
+  fRescatter.clear();
+  fMother1  .clear();
+  fMother2  .clear();
+  fDaughter1.clear();
+  fDaughter2.clear();
+  fPx.clear(); fPy.clear(); fPz.clear(); fE .clear();
+  fVx.clear(); fVy.clear(); fVz.clear(); fVt.clear();
+
+  fInteractionType = kIntNull;
+  fScatteringType  = kScNull;
+  fCharm           = false;
+  fTargetPdg  = fTargetA    = fTargetZ    = fHitNucPdg = 0;
+  fx = fy = ft = fQ2 = fW = kNoKine;
+  fProbe      = fTgtNucleus = fHitNucleon = fFSLepton = -1;
+  fWeight     = 1.;
+  fXSec       = 0.;
+  fDiffXSec   = 0.;
+}
+//____________________________________________________________________________
+void GReWeightEventView::Fill(const EventRecord & event)
+{
+  this->Clear();
+
+  int nparticles = event.GetEntries();
+  for(int i = 0; i < nparticles; i++) {
+    GHepParticle * p = event.Particle(i);
+    this->AddParticle(p->Pdg(), (int) p->Status(),
+       p->FirstMother(), p->LastMother(), p->FirstDaughter(), p->LastDaughter(),
+       p->Px(), p->Py(), p->Pz(), p->E(), p->Vx(), p->Vy(), p->Vz(), p->Vt(),
+       p->RescatterCode());
+  }
+
+  const Interaction * interaction = event.Summary();
+  if(interaction) {
+    const ProcessInfo & proc_info = interaction->ProcInfo();
+    const Target &      target    = interaction->InitState().Tgt();
+    this->SetProcess(proc_info.InteractionTypeId(), proc_info.ScatteringTypeId(),
+                     interaction->ExclTag().IsCharmEvent());
+    const Kinematics &  kine      = interaction->Kine();
+    this->SetTarget(target.Pdg(), target.A(), target.Z(),
+                    (target.HitNucIsSet()) ? target.HitNucPdg() : 0);
+    this->SetKinematics(SelectedKV(kine, kKVSelx), SelectedKV(kine, kKVSely),
+                        SelectedKV(kine, kKVSelt), SelectedKV(kine, kKVSelQ2),
+                        SelectedKV(kine, kKVSelW));
+  }
+  this->SetPositions(event.ProbePosition(), event.TargetNucleusPosition(),
+                     event.HitNucleonPosition(), event.FinalStatePrimaryLeptonPosition());
+  this->SetXSec(event.Weight(), event.XSec(), event.DiffXSec());
+}
+//____________________________________________________________________________
+int GReWeightEventView::AddParticle(
+   int pdg, int status, int mom1, int mom2, int dau1, int dau2,
+   double px, double py, double pz, double E,
+   double vx, double vy, double vz, double vt, int rescatter)
+{
+  fPdg      .push_back(pdg);
+  fStatus   .push_back(status);
+  fRescatter.push_back(rescatter);
+  fMother1  .push_back(mom1);
+  fMother2  .push_back(mom2);
+  fDaughter1.push_back(dau1);
+  fDaughter2.push_back(dau2);
+  fPx.push_back(px); fPy.push_back(py); fPz.push_back(pz); fE .push_back(E);
+  fVx.push_back(vx); fVy.push_back(vy); fVz.push_back(vz); fVt.push_back(vt);
+  return fPdg.size() - 1;
+}
+//____________________________________________________________________________
+void GReWeightEventView::SetProcess(
+   InteractionType_t itype, ScatteringType_t stype, bool charm)
+{
+  fInteractionType = itype;
+  fScatteringType  = stype;
+  fCharm           = charm;
+}
+//____________________________________________________________________________
+void GReWeightEventView::SetTarget(int pdg, int A, int Z, int hit_nucleon_pdg)
+{
+  fTargetPdg = pdg;
+  fTargetA   = A;
+  fTargetZ   = Z;
+  fHitNucPdg = hit_nucleon_pdg;
+}
+//____________________________________________________________________________
+void GReWeightEventView::SetKinematics(
+   double x, double y, double t, double Q2, double W)
+{
+  fx  = x;
+  fy  = y;
+  ft  = t;
+  fQ2 = Q2;
+  fW  = W;
+}
+//____________________________________________________________________________
+void GReWeightEventView::SetPositions(
+   int probe, int tgt_nucleus, int hit_nucleon, int fs_lepton)
+{
+  fProbe      = probe;
+  fTgtNucleus = tgt_nucleus;
+  fHitNucleon = hit_nucleon;
+  fFSLepton   = fs_lepton;
+}
+//____________________________________________________________________________
+void GReWeightEventView::SetXSec(double weight, double xsec, double diff_xsec)
+{
+  fWeight   = weight;
+  fXSec     = xsec;
+  fDiffXSec = diff_xsec;
+}
+//____________________________________________________________________________
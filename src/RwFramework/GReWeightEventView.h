@@ -0,0 +1,146 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightEventView
+
+\brief    A compact, reusable, struct-of-arrays representation of an event:
+          for each particle the PDG code, status, rescattering code,
+          mothers & daughters, 4-momentum and 4-position, each kept in its
+          own array, and, for the event, the process, the target & hit
+          nucleon, the selected kinematics, the positions of the probe,
+          target nucleus, hit nucleon & primary lepton and the stored
+          weight & cross sections.
+
+          It is decoded either from a GHEP event record (Fill()) or, with
+          no intermediate objects at all, straight from the branch buffers
+          of a flat gst tree (GReWeightIOGstReader::ReadEventView()).
+          GHEP files store each event record as a single streamed object,
+          which is not decoded by hand: their events are deserialized as
+          usual and filled into views, once per event, by the event buffer
+          (GReWeightIOEventBuffer::SetViews()), which pays off for events
+          reweighted many times (eg for all throws of grwghtnp).
+          Clear() keeps the allocated arrays, so a view reused from event
+          to event allocates nothing once it has seen the largest event.
+
+          Weight calculators that need no GENIE model evaluated at the
+          event's interaction implement GReWeightI::CalcViewWeight() and
+          report HandlesEventView(): the hadron transport (INuke), NC
+          normalization (NuXSecNC) and non-resonant background
+          (NonResonanceBkg) calculators. The other cross section
+          calculators compute differential cross sections from a full
+          interaction & kinematics, and need event records. If all
+          calculators with tweaked params handle views (the others return
+          1), GReWeight::CalcWeight() accepts a view in place of an event
+          record.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_EVENT_VIEW_H_
+#define _G_REWEIGHT_EVENT_VIEW_H_
+
+#include <vector>
+
+// GENIE/Generator includes
+#include "Framework/Interaction/InteractionType.h"
+#include "Framework/Interaction/ScatteringType.h"
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeightEventView {
+
+public:
+  static const double kNoKine; ///< value of the kinematic variables not set
+
+  GReWeightEventView();
+ ~GReWeightEventView() {}
+
+  void Clear       (void);                      ///< drop the event, keep the allocated arrays
+  void Fill        (const EventRecord & event); ///< decode a GHEP event record
+
+  // building a view (for decoders)
+  int  AddParticle (int pdg, int status, int mom1, int mom2, int dau1, int dau2,
+                    double px, double py, double pz, double E,
+                    double vx, double vy, double vz, double vt, int rescatter = -1); ///< returns the particle position
+  void SetProcess  (InteractionType_t itype, ScatteringType_t stype, bool charm);
+  void SetTarget   (int pdg, int A, int Z, int hit_nucleon_pdg = 0);
+  void SetKinematics (double x, double y, double t, double Q2, double W); ///< selected kinematics
+  void SetPositions(int probe, int tgt_nucleus, int hit_nucleon, int fs_lepton);
+  void SetXSec     (double weight, double xsec, double diff_xsec);
+
+  // particles
+  int    NParticles    (void)  const { return fPdg.size();    }
+  int    Pdg           (int i) const { return fPdg[i];        }
+  int    Status        (int i) const { return fStatus[i];     }
+  int    RescatterCode (int i) const { return fRescatter[i];  }
+  int    FirstMother   (int i) const { return fMother1[i];    }
+  int    LastMother    (int i) const { return fMother2[i];    }
+  int    FirstDaughter (int i) const { return fDaughter1[i];  }
+  int    LastDaughter  (int i) const { return fDaughter2[i];  }
+  double Px            (int i) const { return fPx[i];         }
+  double Py            (int i) const { return fPy[i];         }
+  double Pz            (int i) const { return fPz[i];         }
+  double E             (int i) const { return fE[i];          }
+  double Vx            (int i) const { return fVx[i];         }
+  double Vy            (int i) const { return fVy[i];         }
+  double Vz            (int i) const { return fVz[i];         }
+  double Vt            (int i) const { return fVt[i];         }
+
+  // event
+  InteractionType_t InteractionTypeId     (void) const { return fInteractionType; }
+  ScatteringType_t  ScatteringTypeId      (void) const { return fScatteringType;  }
+  bool              IsCharm               (void) const { return fCharm;      }
+  int               TargetPdg             (void) const { return fTargetPdg;  }
+  int               TargetA               (void) const { return fTargetA;    }
+  int               TargetZ               (void) const { return fTargetZ;    }
+  int               HitNucleonPdg         (void) const { return fHitNucPdg;  } ///< 0 if none
+  double            x                     (void) const { return fx;          } ///< selected kinematics (kNoKine if not set)
+  double            y                     (void) const { return fy;          }
+  double            t                     (void) const { return ft;          }
+  double            Q2                    (void) const { return fQ2;         }
+  double            W                     (void) const { return fW;          }
+  int               ProbePosition         (void) const { return fProbe;      } ///< -1 if none, as for all positions
+  int               TargetNucleusPosition (void) const { return fTgtNucleus; } ///< -1 for free nucleon targets
+  int               HitNucleonPosition    (void) const { return fHitNucleon; }
+  int               FSPrimLeptonPosition  (void) const { return fFSLepton;   }
+  double            Weight                (void) const { return fWeight;     }
+  double            XSec                  (void) const { return fXSec;       }
+  double            DiffXSec              (void) const { return fDiffXSec;   }
+
+private:
+
+  // particles, one entry per particle in each array
+  std::vector<int>    fPdg;
+  std::vector<int>    fStatus;
+  std::vector<int>    fRescatter;
+  std::vector<int>    fMother1;
+  std::vector<int>    fMother2;
+  std::vector<int>    fDaughter1;
+  std::vector<int>    fDaughter2;
+  std::vector<double> fPx, fPy, fPz, fE;
+  std::vector<double> fVx, fVy, fVz, fVt;
+
+  // event
+  InteractionType_t   fInteractionType;
+  ScatteringType_t    fScatteringType;
+  bool                fCharm;
+  int                 fTargetPdg, fTargetA, fTargetZ, fHitNucPdg;
+  double              fx, fy, ft, fQ2, fW;
+  int                 fProbe, fTgtNucleus, fHitNucleon, fFSLepton;
+  double              fWeight, fXSec, fDiffXSec;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -31,6 +31,8 @@ class EventRecord;
 
 namespace rew   {
 
+ class GReWeightEventView;
+
  class GReWeightI 
  {
  public:
@@ -60,6 +62,12 @@ namespace rew   {
   
   //! calculate a weight for the input event using the current nuisance param values
   virtual double CalcWeight (const genie::EventRecord & event) = 0;
+
+  //! can the current weight calculator calculate weights from a compact event view?
+  virtual bool HandlesEventView (void) const { return false; }
+
+  //! calculate a weight for the input event view (only called if HandlesEventView())
+  virtual double CalcViewWeight (const GReWeightEventView & /*event*/) { return 1.; }
   
   //! Should we calculate the old weight ourselves, or use the one from the input tree? Default on.
   virtual void UseOldWeightFromFile(bool) = 0;
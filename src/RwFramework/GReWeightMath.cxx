@@ -0,0 +1,236 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _G_REWEIGHT_MATH_X86_
+#include <immintrin.h>
+#endif
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightMath.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+
+  std::atomic<int> gIsa(-1); ///< implementation in use (-1: not picked yet)
+
+  // Vector exp(x) = 2^k exp(r), with x = k ln2 + r, |r| <= ln2/2, and
+  // exp(r) from its Taylor series to r^13 (truncation error < 1E-17).
+  // Within [kExpLo, kExpHi] 2^k is a normal double, built from its bits.
+  // The scalar implementation (& vector remainders) use std::exp.
+  const double   kExpLo     = -708.;
+  const double   kExpHi     =  709.;
+  const double   kLog2e     = 1.4426950408889634074;
+  const double   kLn2Hi     = 6.93147180369123816490e-01; // ln2, low 32 bits zero: k*kLn2Hi exact
+  const double   kLn2Lo     = 1.90821492927058770002e-10; // ln2 - kLn2Hi
+  const double   kRound     = 6755399441055744.;          // 1.5*2^52: x + kRound rounds x to an integer k...
+  const long long kRoundBits = 0x4338000000000000LL;      // ... and the bits of the sum are kRoundBits + k
+  const int      kNExpCoeff = 14;
+  const double   kExpCoeff[kNExpCoeff] = {
+    1., 1., 1./2., 1./6., 1./24., 1./120., 1./720., 1./5040., 1./40320.,
+    1./362880., 1./3628800., 1./39916800., 1./479001600., 1./6227020800.
+  };
+
+#ifdef _G_REWEIGHT_MATH_X86_
+
+#define _G_REWEIGHT_AVX2_   __attribute__((target("avx2,fma")))
+#define _G_REWEIGHT_AVX512_ __attribute__((target("avx512f")))
+
+  //
+  // AVX2 & FMA: 4 doubles per vector
+  //
+  _G_REWEIGHT_AVX2_ inline void StoreExp4(__m256d v, double * y)
+  {
+    const __m256d lo = _mm256_set1_pd(kExpLo);
+    const __m256d hi = _mm256_set1_pd(kExpHi);
+    const __m256d rd = _mm256_set1_pd(kRound);
+
+    // NaNs are clamped to kExpLo (max_pd returns its 2nd operand), then fixed
+    __m256d x = _mm256_min_pd(_mm256_max_pd(v, lo), hi);
+    __m256d t = _mm256_fmadd_pd(x, _mm256_set1_pd(kLog2e), rd);
+    __m256d k = _mm256_sub_pd(t, rd);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kLn2Hi), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kLn2Lo), r);
+    __m256d p = _mm256_set1_pd(kExpCoeff[kNExpCoeff-1]);
+    for(int j = kNExpCoeff-2; j >= 0; j--) {
+      p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(kExpCoeff[j]));
+    }
+    __m256i bits = _mm256_sub_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(kRoundBits));
+    bits = _mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(1023)), 52);
+
+    int out = _mm256_movemask_pd(_mm256_or_pd(
+                 _mm256_cmp_pd(v, lo, _CMP_NGE_UQ), _mm256_cmp_pd(v, hi, _CMP_NLE_UQ)));
+    if(out == 0) {
+      _mm256_storeu_pd(y, _mm256_mul_pd(p, _mm256_castsi256_pd(bits)));
+      return;
+    }
+    double in[4];
+    _mm256_storeu_pd(in, v);
+    _mm256_storeu_pd(y, _mm256_mul_pd(p, _mm256_castsi256_pd(bits)));
+    for(int j = 0; j < 4; j++) {
+      if(out & (1 << j)) y[j] = std::exp(in[j]);
+    }
+  }
+  _G_REWEIGHT_AVX2_ void ExpAVX2(const double * x, int n, double * y)
+  {
+    int i = 0;
+    for( ; i + 4 <= n; i += 4) StoreExp4(_mm256_loadu_pd(x+i), y+i);
+    for( ; i < n; i++) y[i] = std::exp(x[i]);
+  }
+  _G_REWEIGHT_AVX2_ void LegendreP2AVX2(const double * x, int n, double * y)
+  {
+    const __m256d one   = _mm256_set1_pd(1.);
+    const __m256d three = _mm256_set1_pd(3.);
+    const __m256d half  = _mm256_set1_pd(0.5);
+    int i = 0;
+    for( ; i + 4 <= n; i += 4) {
+      __m256d v = _mm256_loadu_pd(x+i);
+      _mm256_storeu_pd(y+i, _mm256_mul_pd(half, _mm256_fmsub_pd(_mm256_mul_pd(three, v), v, one)));
+    }
+    for( ; i < n; i++) y[i] = GReWeightMath::LegendreP2(x[i]);
+  }
+
+  //
+  // AVX-512: 8 doubles per vector
+  //
+  _G_REWEIGHT_AVX512_ inline void StoreExp8(__m512d v, double * y)
+  {
+    const __m512d lo = _mm512_set1_pd(kExpLo);
+    const __m512d hi = _mm512_set1_pd(kExpHi);
+    const __m512d rd = _mm512_set1_pd(kRound);
+
+    // the masked forms (all lanes, zero passthrough) compute the same, but
+    // have no undefined passthrough operand (which g++ flags as possibly
+    // uninitialized)
+    const __m512d  zero = _mm512_setzero_pd();
+    const __mmask8 all  = 0xFF;
+
+    __m512d x = _mm512_mask_min_pd(zero, all, _mm512_mask_max_pd(zero, all, v, lo), hi);
+    __m512d t = _mm512_fmadd_pd(x, _mm512_set1_pd(kLog2e), rd);
+    __m512d k = _mm512_sub_pd(t, rd);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Hi), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Lo), r);
+    __m512d p = _mm512_set1_pd(kExpCoeff[kNExpCoeff-1]);
+    for(int j = kNExpCoeff-2; j >= 0; j--) {
+      p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(kExpCoeff[j]));
+    }
+    __m512i bits = _mm512_sub_epi64(_mm512_castpd_si512(t), _mm512_set1_epi64(kRoundBits));
+    bits = _mm512_mask_slli_epi64(_mm512_setzero_si512(), all,
+                                  _mm512_add_epi64(bits, _mm512_set1_epi64(1023)), 52);
+
+    __mmask8 out = _mm512_cmp_pd_mask(v, lo, _CMP_NGE_UQ) | _mm512_cmp_pd_mask(v, hi, _CMP_NLE_UQ);
+    if(out == 0) {
+      _mm512_storeu_pd(y, _mm512_mul_pd(p, _mm512_castsi512_pd(bits)));
+      return;
+    }
+    double in[8];
+    _mm512_storeu_pd(in, v);
+    _mm512_storeu_pd(y, _mm512_mul_pd(p, _mm512_castsi512_pd(bits)));
+    for(int j = 0; j < 8; j++) {
+      if(out & (1 << j)) y[j] = std::exp(in[j]);
+    }
+  }
+  _G_REWEIGHT_AVX512_ void ExpAVX512(const double * x, int n, double * y)
+  {
+    int i = 0;
+    for( ; i + 8 <= n; i += 8) StoreExp8(_mm512_loadu_pd(x+i), y+i);
+    for( ; i < n; i++) y[i] = std::exp(x[i]);
+  }
+  _G_REWEIGHT_AVX512_ void LegendreP2AVX512(const double * x, int n, double * y)
+  {
+    const __m512d one   = _mm512_set1_pd(1.);
+    const __m512d three = _mm512_set1_pd(3.);
+    const __m512d half  = _mm512_set1_pd(0.5);
+    int i = 0;
+    for( ; i + 8 <= n; i += 8) {
+      __m512d v = _mm512_loadu_pd(x+i);
+      _mm512_storeu_pd(y+i, _mm512_mul_pd(half, _mm512_fmsub_pd(_mm512_mul_pd(three, v), v, one)));
+    }
+    for( ; i < n; i++) y[i] = GReWeightMath::LegendreP2(x[i]);
+  }
+
+#endif // _G_REWEIGHT_MATH_X86_
+}
+//____________________________________________________________________________
+void GReWeightMath::Exp(const double * x, int n, double * y)
+{
+  switch(Isa()) {
+#ifdef _G_REWEIGHT_MATH_X86_
+    case kMathAVX512 : ExpAVX512(x, n, y); return;
+    case kMathAVX2   : ExpAVX2  (x, n, y); return;
+#endif
+    default : break;
+  }
+  for(int i = 0; i < n; i++) y[i] = std::exp(x[i]);
+}
+//____________________________________________________________________________
+void GReWeightMath::LegendreP2(const double * x, int n, double * y)
+{
+  switch(Isa()) {
+#ifdef _G_REWEIGHT_MATH_X86_
+    case kMathAVX512 : LegendreP2AVX512(x, n, y); return;
+    case kMathAVX2   : LegendreP2AVX2  (x, n, y); return;
+#endif
+    default : break;
+  }
+  for(int i = 0; i < n; i++) y[i] = LegendreP2(x[i]);
+}
+//____________________________________________________________________________
+MathIsa_t GReWeightMath::Isa(void)
+{
+  int isa = gIsa.load(std::memory_order_relaxed);
+  if(isa < 0) {
+    isa = BestIsa();
+    gIsa.store(isa, std::memory_order_relaxed);
+  }
+  return (MathIsa_t) isa;
+}
+//____________________________________________________________________________
+MathIsa_t GReWeightMath::BestIsa(void)
+{
+#ifdef _G_REWEIGHT_MATH_X86_
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f")) return kMathAVX512;
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return kMathAVX2;
+#endif
+  return kMathScalar;
+}
+//____________________________________________________________________________
+void GReWeightMath::SetIsa(MathIsa_t isa)
+{
+  MathIsa_t best = BestIsa();
+  if(isa > best) {
+    LOG("ReW", pWARN)
+      << AsString(isa) << " math is not supported on this CPU - Using "
+      << AsString(best);
+    isa = best;
+  }
+  gIsa.store(isa, std::memory_order_relaxed);
+}
+//____________________________________________________________________________
+const char * GReWeightMath::AsString(MathIsa_t isa)
+{
+  switch(isa) {
+    case kMathScalar : return "scalar";
+    case kMathAVX2   : return "AVX2";
+    case kMathAVX512 : return "AVX-512";
+    default          : break;
+  }
+  return "unknown";
+}
+//____________________________________________________________________________
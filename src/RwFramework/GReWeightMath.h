@@ -0,0 +1,64 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightMath
+
+\brief    Batch versions of the few functions reweighting kernels evaluate
+          over and over (exponentials, Legendre P2), so that a kernel
+          filling an array of nodes or events gets vector throughput by
+          calling them, with no intrinsics of its own.
+
+          Each batch function has an AVX-512, an AVX2 (with FMA) and a
+          portable scalar implementation; the best one the CPU supports is
+          picked at first use, and SetIsa() can force a lower one (eg the
+          scalar one, for comparisons with older outputs). Implementations
+          differ by rounding only, within the accuracies below, in ulp
+          (units in the last place) of the exact result:
+
+            Exp()        : 2 ulp. Arguments outside [-708, 709] (where the
+                           result under/overflows) & NaNs go to std::exp,
+                           as do all arguments of the scalar version.
+            LegendreP2() : absolute error below 5E-16, for |x| <= 1.
+
+          Inputs & outputs may be the same array; other overlaps are not
+          allowed. The scalar version of LegendreP2() is inline.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_MATH_H_
+#define _G_REWEIGHT_MATH_H_
+
+namespace genie {
+namespace rew   {
+
+typedef enum EMathIsa {
+  kMathScalar = 0,
+  kMathAVX2,
+  kMathAVX512
+} MathIsa_t;
+
+class GReWeightMath {
+
+public:
+  static void   Exp        (const double * x, int n, double * y); ///< y = exp(x)
+  static void   LegendreP2 (const double * x, int n, double * y); ///< y = (3x^2-1)/2
+
+  static double LegendreP2 (double x) { return 0.5 * (3.*x*x - 1.); }
+
+  static MathIsa_t    Isa      (void);           ///< implementation in use
+  static MathIsa_t    BestIsa  (void);           ///< best implementation the CPU supports
+  static void         SetIsa   (MathIsa_t isa);  ///< use (at most) the given implementation
+  static const char * AsString (MathIsa_t isa);
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,207 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cmath>
+#include <sstream>
+
+#include <TMatrixD.h>
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightResponseSurface.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  const int kMaxPoints = 10000; // hence at most 13 dials (2 levels each)
+  const int kMaxDegree = 15;
+
+  // all exponent tuples of total degree <= degree, lowest degrees first
+  void Exponents(int ndims, int degree, vector<int> & exponents)
+  {
+    exponents.clear();
+    vector<int> e(ndims, 0);
+    for(int total = 0; total <= degree; total++) {
+      // enumerate the tuples summing to `total'
+      e.assign(ndims, 0);
+      e[ndims-1] = total;
+      while(true) {
+        exponents.insert(exponents.end(), e.begin(), e.end());
+        // next composition: move one unit leftwards
+        int i = ndims - 1;
+        while(i > 0 && e[i] == 0) i--;
+        if(i == 0) break;
+        int carry = e[i];
+        e[i] = 0;
+        e[i-1]++;
+        e[ndims-1] = carry - 1;
+      }
+    }
+  }
+}
+//____________________________________________________________________________
+GReWeightResponseSurface::GReWeightResponseSurface() :
+fDegree  (0),
+fNTerms  (0),
+fNPoints (0)
+{
+
+}
+//____________________________________________________________________________
+bool GReWeightResponseSurface::Configure(
+   const vector<double> & lo, const vector<double> & hi,
+   int degree, int levels, string & error)
+{
+  error = "";
+  int ndims = lo.size();
+  if(ndims == 0 || hi.size() != lo.size()) {
+    error = "no dials, or inconsistent dial ranges";
+    return false;
+  }
+  for(int d = 0; d < ndims; d++) {
+    if(!(hi[d] > lo[d])) {
+      error = "empty dial range";
+      return false;
+    }
+  }
+  if(degree < 1 || degree > kMaxDegree || levels < 2) {
+    error = "the degree must be 1 to 15 and the levels at least 2";
+    return false;
+  }
+  if(levels <= degree) {
+    error = "a polynomial of degree n needs at least n+1 levels per dial";
+    return false;
+  }
+  double npoints = std::pow((double)levels, ndims);
+  if(npoints > kMaxPoints) {
+    std::ostringstream msg;
+    msg << levels << "^" << ndims << " training points is too many (max: " << kMaxPoints << ")";
+    error = msg.str();
+    return false;
+  }
+
+  fLo      = lo;
+  fHi      = hi;
+  fDegree  = degree;
+  fNPoints = (int) npoints;
+  Exponents(ndims, degree, fExponents);
+  fNTerms  = fExponents.size() / ndims;
+  if(fNTerms >= fNPoints) {
+    error = "too few training points for the number of polynomial terms (add levels)";
+    return false;
+  }
+
+  // full-factorial grid of training points, equally spaced over the box
+  fPoints.assign((size_t)fNPoints * ndims, 0.);
+  for(int ipt = 0; ipt < fNPoints; ipt++) {
+    int index = ipt;
+    for(int d = 0; d < ndims; d++) {
+      int il = index % levels;
+      index /= levels;
+      fPoints[(size_t)ipt*ndims + d] = lo[d] + (hi[d] - lo[d]) * il / (levels - 1);
+    }
+  }
+
+  // design matrix & least squares projector (X^T X)^-1 X^T
+  fDesign.assign((size_t)fNPoints * fNTerms, 0.);
+  TMatrixD X(fNPoints, fNTerms);
+  for(int ipt = 0; ipt < fNPoints; ipt++) {
+    this->Monomials(&fPoints[(size_t)ipt*ndims], &fDesign[(size_t)ipt*fNTerms]);
+    for(int it = 0; it < fNTerms; it++) X(ipt,it) = fDesign[(size_t)ipt*fNTerms + it];
+  }
+  TMatrixD XT(TMatrixD::kTransposed, X);
+  TMatrixD XTX(XT, TMatrixD::kMult, X);
+  double det = 0.;
+  XTX.Invert(&det);
+  if(det == 0.) {
+    error = "singular least squares system";
+    return false;
+  }
+  TMatrixD P(XTX, TMatrixD::kMult, XT);
+  fProjector.assign((size_t)fNTerms * fNPoints, 0.);
+  for(int it = 0; it < fNTerms; it++) {
+    for(int ipt = 0; ipt < fNPoints; ipt++) fProjector[(size_t)it*fNPoints + ipt] = P(it,ipt);
+  }
+
+  // leverages: h_ii = X_i . P_.i
+  fLeverage.assign(fNPoints, 0.);
+  for(int ipt = 0; ipt < fNPoints; ipt++) {
+    double h = 0.;
+    for(int it = 0; it < fNTerms; it++) {
+      h += fDesign[(size_t)ipt*fNTerms + it] * fProjector[(size_t)it*fNPoints + ipt];
+    }
+    fLeverage[ipt] = h;
+  }
+  return true;
+}
+//____________________________________________________________________________
+double GReWeightResponseSurface::Fit(const double * w, double * coef) const
+{
+  for(int it = 0; it < fNTerms; it++) {
+    const double * p = &fProjector[(size_t)it*fNPoints];
+    double c = 0.;
+    for(int ipt = 0; ipt < fNPoints; ipt++) c += p[ipt] * w[ipt];
+    coef[it] = c;
+  }
+
+  // leave-one-out residuals, r_i / (1 - h_ii), from the single fit
+  double sum2 = 0.;
+  int    n    = 0;
+  for(int ipt = 0; ipt < fNPoints; ipt++) {
+    double fitted = this->Eval(coef, &fDesign[(size_t)ipt*fNTerms]);
+    double denom  = 1. - fLeverage[ipt];
+    if(denom < 1E-9) continue;
+    double r = (w[ipt] - fitted) / denom;
+    sum2 += r*r;
+    n++;
+  }
+  return (n > 0) ? std::sqrt(sum2/n) : 0.;
+}
+//____________________________________________________________________________
+void GReWeightResponseSurface::Monomials(const double * x, double * m) const
+{
+  int ndims = fLo.size();
+
+  // powers of each scaled dial
+  double u[13][kMaxDegree+1];
+  for(int d = 0; d < ndims; d++) {
+    double mid  = 0.5 * (fHi[d] + fLo[d]);
+    double half = 0.5 * (fHi[d] - fLo[d]);
+    u[d][0] = 1.;
+    for(int k = 1; k <= fDegree; k++) u[d][k] = u[d][k-1] * (x[d] - mid) / half;
+  }
+  for(int it = 0; it < fNTerms; it++) {
+    const int * e = &fExponents[(size_t)it*ndims];
+    double v = 1.;
+    for(int d = 0; d < ndims; d++) v *= u[d][e[d]];
+    m[it] = v;
+  }
+}
+//____________________________________________________________________________
+double GReWeightResponseSurface::Eval(const double * coef, const double * m) const
+{
+  double v = 0.;
+  for(int it = 0; it < fNTerms; it++) v += coef[it] * m[it];
+  return v;
+}
+//____________________________________________________________________________
+string GReWeightResponseSurface::Description(void) const
+{
+  std::ostringstream desc;
+  desc << "degree " << fDegree << " in " << fLo.size() << " dial(s), "
+       << fNTerms << " terms, " << fNPoints << " training points, box";
+  for(unsigned int d = 0; d < fLo.size(); d++) {
+    desc << " [" << fLo[d] << "," << fHi[d] << "]";
+  }
+  return desc.str();
+}
+//____________________________________________________________________________
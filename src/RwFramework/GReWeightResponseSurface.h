@@ -0,0 +1,82 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightResponseSurface
+
+\brief    Per-event polynomial response of a weight calculator to several of
+          its dials at once, cross terms included (eg MaCCRES x MvCCRES, the
+          INuke fates renormalized together, the EmpiricalMEC mass, width &
+          Mq2d), so that the calculator's weight for any combination of dial
+          values is synthesized from a few coefficients per event instead of
+          being recomputed.
+
+          The dials span a box, sampled by a full-factorial grid of training
+          points (`levels' per dial). For each event the calculator's weights
+          at the training points are fitted (least squares) by a polynomial of
+          total degree `degree' in the dials, scaled to [-1,1] over the box.
+          The training points are the same for all events, so the fit reduces
+          to a fixed matrix times the event's weights (Fit()). Fit() also
+          returns an error estimate: the RMS of the leave-one-out residuals
+          (what each training weight is predicted to be by the fit to all the
+          others), which needs no extra fits.
+
+          Evaluation is split so that the monomials are computed once per
+          set of dial values (Monomials()) and each event then costs a dot
+          product (Eval()).
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_RESPONSE_SURFACE_H_
+#define _G_REWEIGHT_RESPONSE_SURFACE_H_
+
+#include <string>
+#include <vector>
+
+namespace genie {
+namespace rew   {
+
+class GReWeightResponseSurface {
+
+public:
+  GReWeightResponseSurface();
+ ~GReWeightResponseSurface() {}
+
+  bool   Configure (const std::vector<double> & lo, const std::vector<double> & hi,
+                    int degree, int levels, std::string & error); ///< set the box, the degree & the training grid
+
+  int    NDims     (void) const { return fLo.size();      }
+  int    Degree    (void) const { return fDegree;         }
+  int    NTerms    (void) const { return fNTerms;         }
+  int    NPoints   (void) const { return fNPoints;        }
+  double Point     (int ipt, int idim) const { return fPoints[(size_t)ipt*fLo.size() + idim]; } ///< dial value at a training point
+
+  double Fit       (const double * w, double * coef) const; ///< coefficients from the weights at the training points; returns the error estimate
+  void   Monomials (const double * x, double * m) const;    ///< the NTerms() monomials at dial values x
+  double Eval      (const double * coef, const double * m) const; ///< response for the monomials given by Monomials()
+
+  std::string Description (void) const;
+
+private:
+
+  std::vector<double> fLo, fHi;    ///< the box
+  int                 fDegree;
+  int                 fNTerms;
+  int                 fNPoints;
+  std::vector<int>    fExponents;  ///< [term][dim]
+  std::vector<double> fPoints;     ///< [point][dim], dial values
+  std::vector<double> fDesign;     ///< [point][term], monomials at the training points
+  std::vector<double> fProjector;  ///< [term][point], least squares solution
+  std::vector<double> fLeverage;   ///< [point], diagonal of the hat matrix
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
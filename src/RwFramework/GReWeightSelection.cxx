@@ -0,0 +1,276 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightSelection.h"
+#include "RwFramework/GReWeightEventSummary.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+
+  typedef enum EOpCode {
+    kOpConst = 0, kOpVar,
+    kOpNeg, kOpNot, kOpAbs,
+    kOpMul, kOpDiv, kOpAdd, kOpSub,
+    kOpLT, kOpLE, kOpGT, kOpGE, kOpEQ, kOpNE,
+    kOpAnd, kOpOr
+  } OpCode_t;
+
+  // Recursive descent parser emitting a postfix program.
+  // Precedence, from low to high: ||, &&, comparisons, + -, * /, unary.
+  class Parser {
+  public:
+    Parser(const string & text, vector<int> & codes, vector<double> & args) :
+      fText(text), fPos(0), fCodes(codes), fArgs(args) {}
+
+    bool Run(string & error) {
+      this->Next();
+      this->ParseOr();
+      if(fError.size() == 0 && fTok.size() > 0) this->Fail("unexpected `" + fTok + "'");
+      error = fError;
+      return (fError.size() == 0);
+    }
+
+  private:
+    void Emit(int code, double arg = 0.) { fCodes.push_back(code); fArgs.push_back(arg); }
+    void Fail(const string & msg) {
+      if(fError.size() > 0) return;
+      std::ostringstream err;
+      err << msg << " at position " << fTokPos << " in: " << fText;
+      fError = err.str();
+    }
+    bool Accept(const char * tok) {
+      if(fError.size() > 0 || fTok != tok) return false;
+      this->Next();
+      return true;
+    }
+
+    // Tokenizer: numbers, identifiers, operators
+    void Next(void) {
+      while(fPos < fText.size() && isspace(fText[fPos])) fPos++;
+      fTokPos = fPos;
+      fTok    = "";
+      if(fPos >= fText.size()) return;
+      char c = fText[fPos];
+      if(isdigit(c) || (c == '.' && fPos+1 < fText.size() && isdigit(fText[fPos+1]))) {
+        const char * begin = fText.c_str() + fPos;
+        char * end = 0;
+        strtod(begin, &end);
+        fTok = fText.substr(fPos, end - begin);
+        fPos += fTok.size();
+        return;
+      }
+      if(isalpha(c) || c == '_') {
+        size_t end = fPos;
+        while(end < fText.size() && (isalnum(fText[end]) || fText[end] == '_')) end++;
+        fTok = fText.substr(fPos, end - fPos);
+        fPos = end;
+        return;
+      }
+      static const char * two_char_ops[] = { "&&", "||", "<=", ">=", "==", "!=" };
+      for(int i = 0; i < 6; i++) {
+        if(fText.compare(fPos, 2, two_char_ops[i]) == 0) {
+          fTok = two_char_ops[i];
+          fPos += 2;
+          return;
+        }
+      }
+      fTok = string(1, c);
+      fPos++;
+    }
+
+    void ParseOr(void) {
+      this->ParseAnd();
+      while(this->Accept("||")) { this->ParseAnd(); this->Emit(kOpOr); }
+    }
+    void ParseAnd(void) {
+      this->ParseCmp();
+      while(this->Accept("&&")) { this->ParseCmp(); this->Emit(kOpAnd); }
+    }
+    void ParseCmp(void) {
+      this->ParseSum();
+      int op = -1;
+      if      (this->Accept("<" )) op = kOpLT;
+      else if (this->Accept("<=")) op = kOpLE;
+      else if (this->Accept(">" )) op = kOpGT;
+      else if (this->Accept(">=")) op = kOpGE;
+      else if (this->Accept("==")) op = kOpEQ;
+      else if (this->Accept("!=")) op = kOpNE;
+      if(op < 0) return;
+      this->ParseSum();
+      this->Emit(op);
+    }
+    void ParseSum(void) {
+      this->ParseProd();
+      while(true) {
+        if      (this->Accept("+")) { this->ParseProd(); this->Emit(kOpAdd); }
+        else if (this->Accept("-")) { this->ParseProd(); this->Emit(kOpSub); }
+        else break;
+      }
+    }
+    void ParseProd(void) {
+      this->ParseUnary();
+      while(true) {
+        if      (this->Accept("*")) { this->ParseUnary(); this->Emit(kOpMul); }
+        else if (this->Accept("/")) { this->ParseUnary(); this->Emit(kOpDiv); }
+        else break;
+      }
+    }
+    void ParseUnary(void) {
+      if      (this->Accept("!")) { this->ParseUnary(); this->Emit(kOpNot); }
+      else if (this->Accept("-")) { this->ParseUnary(); this->Emit(kOpNeg); }
+      else if (this->Accept("+")) { this->ParseUnary(); }
+      else this->ParsePrimary();
+    }
+    void ParsePrimary(void) {
+      if(fError.size() > 0) return;
+      if(fTok.size() == 0) {
+        this->Fail("unexpected end of expression");
+        return;
+      }
+      if(this->Accept("(")) {
+        this->ParseOr();
+        if(!this->Accept(")")) this->Fail("expected `)'");
+        return;
+      }
+      char c = fTok[0];
+      if(isdigit(c) || c == '.') {
+        this->Emit(kOpConst, atof(fTok.c_str()));
+        this->Next();
+        return;
+      }
+      if(isalpha(c) || c == '_') {
+        string name = fTok;
+        size_t pos  = fTokPos;
+        this->Next();
+        if(name == "abs") {
+          if(!this->Accept("(")) { this->Fail("expected `(' after abs"); return; }
+          this->ParseOr();
+          if(!this->Accept(")")) { this->Fail("expected `)'"); return; }
+          this->Emit(kOpAbs);
+          return;
+        }
+        int ivar = GReWeightEventSummary::VarIndex(name);
+        if(ivar < 0) {
+          fTokPos = pos;
+          this->Fail("unknown quantity `" + name + "' (known: " +
+                     GReWeightEventSummary::VarList() + ")");
+          return;
+        }
+        this->Emit(kOpVar, ivar);
+        return;
+      }
+      this->Fail("unexpected `" + fTok + "'");
+    }
+
+    const string &   fText;
+    size_t           fPos;
+    size_t           fTokPos;
+    string           fTok;
+    string           fError;
+    vector<int> &    fCodes;
+    vector<double> & fArgs;
+  };
+}
+//____________________________________________________________________________
+GReWeightSelection::GReWeightSelection()
+{
+
+}
+//____________________________________________________________________________
+bool GReWeightSelection::Compile(const string & expression, string & error)
+{
+  fExpression = expression;
+  fOpCodes.clear();
+  fOpArgs.clear();
+  error = "";
+
+  // an all-blank expression selects everything
+  if(expression.find_first_not_of(" \t\n") == string::npos) return true;
+
+  Parser parser(fExpression, fOpCodes, fOpArgs);
+  bool ok = parser.Run(error);
+
+  // check the evaluation stack depth
+  int depth = 0;
+  for(unsigned int i = 0; ok && i < fOpCodes.size(); i++) {
+    int op = fOpCodes[i];
+    if      (op == kOpConst || op == kOpVar)                 depth++;
+    else if (op != kOpNeg && op != kOpNot && op != kOpAbs)   depth--;
+    if(depth > kMaxStack) {
+      error = "expression too deeply nested: " + fExpression;
+      ok = false;
+    }
+  }
+  if(!ok) {
+    fOpCodes.clear();
+    fOpArgs.clear();
+  }
+  return ok;
+}
+//____________________________________________________________________________
+double GReWeightSelection::Evaluate(const GReWeightEventSummary & summary) const
+{
+  double stack[kMaxStack];
+  int n = 0;
+
+  unsigned int nops = fOpCodes.size();
+  for(unsigned int i = 0; i < nops; i++) {
+    switch(fOpCodes[i]) {
+      case kOpConst : stack[n++] = fOpArgs[i];                          break;
+      case kOpVar   : stack[n++] = summary.Value((int)fOpArgs[i]);      break;
+      case kOpNeg   : stack[n-1] = -stack[n-1];                         break;
+      case kOpNot   : stack[n-1] = (stack[n-1] == 0.);                  break;
+      case kOpAbs   : stack[n-1] = TMath::Abs(stack[n-1]);              break;
+      case kOpMul   : n--; stack[n-1] = stack[n-1] *  stack[n];         break;
+      case kOpDiv   : n--; stack[n-1] = (stack[n] != 0.) ? stack[n-1] / stack[n] : 0.; break;
+      case kOpAdd   : n--; stack[n-1] = stack[n-1] +  stack[n];         break;
+      case kOpSub   : n--; stack[n-1] = stack[n-1] -  stack[n];         break;
+      case kOpLT    : n--; stack[n-1] = stack[n-1] <  stack[n];         break;
+      case kOpLE    : n--; stack[n-1] = stack[n-1] <= stack[n];         break;
+      case kOpGT    : n--; stack[n-1] = stack[n-1] >  stack[n];         break;
+      case kOpGE    : n--; stack[n-1] = stack[n-1] >= stack[n];         break;
+      case kOpEQ    : n--; stack[n-1] = stack[n-1] == stack[n];         break;
+      case kOpNE    : n--; stack[n-1] = stack[n-1] != stack[n];         break;
+      case kOpAnd   : n--; stack[n-1] = (stack[n-1] != 0. && stack[n] != 0.); break;
+      case kOpOr    : n--; stack[n-1] = (stack[n-1] != 0. || stack[n] != 0.); break;
+      default : break;
+    }
+  }
+  return (n > 0) ? stack[n-1] : 1.;
+}
+//____________________________________________________________________________
+bool GReWeightSelection::Select(const GReWeightEventSummary & summary) const
+{
+  if(!this->IsSet()) return true;
+  return (this->Evaluate(summary) != 0.);
+}
+//____________________________________________________________________________
+bool GReWeightSelection::Select(const EventRecord & event) const
+{
+  if(!this->IsSet()) return true;
+  GReWeightEventSummary summary;
+  summary.Fill(event);
+  return (this->Evaluate(summary) != 0.);
+}
+//____________________________________________________________________________
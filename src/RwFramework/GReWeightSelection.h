@@ -0,0 +1,66 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightSelection
+
+\brief    An event selection, given as a C-like cut expression over the
+          quantities of a GReWeightEventSummary, eg
+
+            cc && abs(probe) == 14 && Ev < 10 && (npip + npim) >= 1
+
+          The expression is compiled once, into a short postfix program, and
+          evaluated per event without any string handling or allocation.
+          Supported: numbers, summary quantity names, abs(), unary - and !,
+          * / + -, < <= > >= == !=, && and ||, and parentheses.
+          An empty selection accepts all events.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_SELECTION_H_
+#define _G_REWEIGHT_SELECTION_H_
+
+#include <string>
+#include <vector>
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeightEventSummary;
+
+class GReWeightSelection {
+
+public:
+  GReWeightSelection();
+ ~GReWeightSelection() {}
+
+  bool   Compile    (const std::string & expression, std::string & error); ///< false on syntax error
+  bool   IsSet      (void) const { return fOpCodes.size() > 0; }
+  double Evaluate   (const GReWeightEventSummary & summary) const;
+  bool   Select     (const GReWeightEventSummary & summary) const;
+  bool   Select     (const EventRecord & event) const;        ///< fills a summary & selects
+
+  const std::string & Expression (void) const { return fExpression; }
+
+  static const int kMaxStack = 32; ///< max evaluation stack depth
+
+private:
+
+  std::string         fExpression; ///< source expression
+  std::vector<int>    fOpCodes;    ///< postfix program: operations
+  std::vector<double> fOpArgs;     ///< postfix program: constant / quantity index
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
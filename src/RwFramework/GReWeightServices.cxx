@@ -0,0 +1,145 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <TROOT.h>
+#include <TRandom3.h>
+
+// GENIE/Generator includes
+#include "Framework/Algorithm/AlgConfigPool.h"
+#include "Framework/Algorithm/AlgFactory.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/RandomGen.h"
+#include "Framework/ParticleData/PDGLibrary.h"
+#include "Framework/Utils/RunOpt.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightServices.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+#include "RwFramework/GReWeightTableCache.h"
+#include "RwFramework/GReWeightTracer.h"
+#include "RwFramework/GSystUncertainty.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  std::atomic<bool>     gPrepared   (false);
+  std::atomic<long>     gBaseSeed   (4357);
+  std::atomic<long>     gNextStream (1);
+  std::thread::id       gMainThread;            ///< set by Prepare(), before any worker starts
+  std::recursive_mutex  gAlgorithmMutex;
+
+  // per-thread stream (0 until first used on a worker thread, or set),
+  // seeded on first use
+  thread_local TRandom3 * tRandom    = 0;
+  thread_local long       tStream    = 0;
+  thread_local long       tSubstream = 0;
+  thread_local bool       tSeeded    = false;
+
+  bool IsMainThread(void)
+  {
+    return !gPrepared.load() || std::this_thread::get_id() == gMainThread;
+  }
+  unsigned long long Mix(unsigned long long z)
+  {
+    // splitmix64 finalizer
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+  unsigned int StreamSeed(long base, long stream, long substream)
+  {
+    // decorrelate the seeds of consecutive streams & substreams
+    const unsigned long long golden = 0x9E3779B97F4A7C15ULL;
+    unsigned long long z = Mix((unsigned long long) base + golden * (unsigned long long) stream);
+    if(substream != 0) z = Mix(z + golden * (unsigned long long) substream);
+    unsigned int seed = (unsigned int) (z & 0xFFFFFFFFULL);
+    return (seed != 0) ? seed : 1; // 0 would make TRandom3 seed from the clock
+  }
+}
+//____________________________________________________________________________
+void GReWeightServices::Prepare(long seed)
+{
+  if(gPrepared.load()) return;
+
+  AlgorithmLock lock;
+
+  ROOT::EnableThreadSafety();
+
+  // singletons built on first use
+  Messenger::Instance();
+  RunOpt::Instance();
+  RandomGen * rnd = RandomGen::Instance();
+  AlgFactory::Instance();
+  AlgConfigPool::Instance();
+  PDGLibrary::Instance();
+  GSystUncertainty::Instance();
+  GReWeightTableCache::Instance();
+  GReWeightTracer::Instance();
+  GReWeightStartupTimer::Instance();
+
+  gBaseSeed.store((seed >= 0) ? seed : rnd->GetSeed());
+  gMainThread = std::this_thread::get_id();
+  gPrepared.store(true);
+
+  LOG("ReW", pNOTICE)
+    << "Reweighting services prepared for multithreading (base seed: "
+    << gBaseSeed.load() << ")";
+}
+//____________________________________________________________________________
+bool GReWeightServices::IsPrepared(void)
+{
+  return gPrepared.load();
+}
+//____________________________________________________________________________
+TRandom3 & GReWeightServices::Random(void)
+{
+  if(tStream == 0) {
+    if(IsMainThread()) return RandomGen::Instance()->RndGen();
+    SetStream(gNextStream.fetch_add(1));
+  }
+  if(!tSeeded) {
+    if(!tRandom) tRandom = new TRandom3(0);
+    tRandom->SetSeed(StreamSeed(gBaseSeed.load(), tStream, tSubstream));
+    tSeeded = true;
+  }
+  return *tRandom;
+}
+//____________________________________________________________________________
+void GReWeightServices::SetStream(long stream, long substream)
+{
+  tStream    = (stream > 0) ? stream : 0;
+  tSubstream = substream;
+  tSeeded    = false;
+}
+//____________________________________________________________________________
+long GReWeightServices::Stream(void)
+{
+  return tStream;
+}
+//____________________________________________________________________________
+bool GReWeightServices::HasStream(void)
+{
+  return (tStream > 0 || !IsMainThread());
+}
+//____________________________________________________________________________
+GReWeightServices::AlgorithmLock::AlgorithmLock()
+{
+  gAlgorithmMutex.lock();
+}
+//____________________________________________________________________________
+GReWeightServices::AlgorithmLock::~AlgorithmLock()
+{
+  gAlgorithmMutex.unlock();
+}
+//____________________________________________________________________________
@@ -0,0 +1,86 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightServices
+
+\brief    The process-wide GENIE services weight calculators depend on, made
+          usable from several threads at once, each running its own
+          GReWeight (its own calculators, tweak dials & uncertainties):
+
+          - Prepare(), called on the main thread before any worker thread
+            starts, builds the shared singletons which are otherwise built
+            on first use (Messenger, RandomGen, AlgFactory, AlgConfigPool,
+            PDGLibrary, GSystUncertainty, the table cache, ...) and turns
+            on ROOT's thread safety. Singletons owned by GENIE physics
+            libraries (FermiMomentumTablePool, INukeHadroData2018) are
+            built in the Init() of the calculators using them.
+          - Random() gives each thread its own random number stream: GENIE's
+            own generator on the main thread (so that single-threaded jobs
+            are unchanged) and, on other threads, independent TRandom3
+            streams seeded from the base seed & a stream number. SetStream()
+            selects the stream (on any thread, the main one included) by a
+            stream & substream number, eg a throw & an event, so that random
+            numbers do not depend on which thread reweights what. The stream
+            is seeded on its first use only, so selecting it per event costs
+            nothing for events drawing no random numbers.
+          - AlgorithmLock serializes what goes through GENIE's shared
+            algorithm factory & configuration pool, or builds shared tables
+            on first use: the construction (Init()) of the calculators, the
+            Reconfigure() of those reconfiguring GENIE algorithms, and the
+            lazily built tables of CalcWeight(). Each calculator takes it
+            itself, so reconfiguring the others runs concurrently.
+
+          With these, CalcWeight() of distinct GReWeight instances may run
+          concurrently on distinct events: the shared state it reads (the
+          prebuilt tables, the default algorithm instances, the uncertainty
+          table) is not modified. The events are: the cross section
+          calculators set the running kinematics & flags of the event's
+          interaction while computing its weight, so an event must never be
+          reweighted by two threads at once (share out events, not
+          configurations, among threads). A single GReWeight instance is
+          not thread-safe. Messages logged from several threads may
+          interleave.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_SERVICES_H_
+#define _G_REWEIGHT_SERVICES_H_
+
+class TRandom3;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightServices {
+
+public:
+  static void       Prepare    (long seed = -1);  ///< build the shared services (main thread, before any worker)
+  static bool       IsPrepared (void);
+  static TRandom3 & Random     (void);            ///< this thread's random number stream
+  static void       SetStream  (long stream, long substream = 0); ///< (re)seed this thread's stream (stream > 0; 0: back to the default)
+  static long       Stream     (void);            ///< this thread's stream number (0: GENIE's own generator)
+  static bool       HasStream  (void);            ///< does Random() give a stream of this reweighting library (not GENIE's generator)?
+
+  // held while using GENIE's shared algorithm factory, configuration
+  // pool or tables built on first use (recursive)
+  class AlgorithmLock {
+  public:
+    AlgorithmLock();
+   ~AlgorithmLock();
+  private:
+    AlgorithmLock(const AlgorithmLock &);
+    AlgorithmLock & operator = (const AlgorithmLock &);
+  };
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
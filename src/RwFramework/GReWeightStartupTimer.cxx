@@ -0,0 +1,189 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <TSystem.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightStartupTimer.h"
+
+using std::string;
+
+using namespace genie;
+using namespace genie::rew;
+
+GReWeightStartupTimer * GReWeightStartupTimer::fInstance = 0;
+
+//____________________________________________________________________________
+GReWeightStartupTimer::GReWeightStartupTimer() :
+fEnabled(false)
+{
+  fStart.Wall = 0.;
+  fStart.RSS  = 0;
+  fLastLap    = fStart;
+}
+//____________________________________________________________________________
+GReWeightStartupTimer * GReWeightStartupTimer::Instance()
+{
+  if(fInstance == 0) {
+    static GReWeightStartupTimer::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new GReWeightStartupTimer;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::Enable(void)
+{
+  fEnabled = true;
+  fStart   = this->Now();
+  fLastLap = fStart;
+  fOpen.clear();
+  fPhases.clear();
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::Lap(const string & phase)
+{
+  if(!fEnabled) return;
+  Point now = this->Now();
+  this->Record(phase, fLastLap, now);
+  fLastLap = now;
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::Begin(const string & phase)
+{
+  if(!fEnabled) return;
+  fOpen[phase] = this->Now();
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::End(const string & phase)
+{
+  if(!fEnabled) return;
+  std::map<string, Point>::iterator it = fOpen.find(phase);
+  if(it == fOpen.end()) {
+    LOG("ReW", pWARN) << "Startup phase `" << phase << "' was never begun";
+    return;
+  }
+  Point now = this->Now();
+  this->Record(phase, it->second, now);
+  fOpen.erase(it);
+
+  // an interval also closes the current lap, which would include it otherwise
+  fLastLap = now;
+}
+//____________________________________________________________________________
+GReWeightStartupTimer::Point GReWeightStartupTimer::Now(void) const
+{
+  Point p;
+  p.Wall = std::chrono::duration<double>(
+     std::chrono::steady_clock::now().time_since_epoch()).count();
+  ProcInfo_t info;
+  gSystem->GetProcInfo(&info);
+  p.RSS = info.fMemResident;
+  return p;
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::Record(
+   const string & phase, const Point & begin, const Point & end)
+{
+  Phase rec;
+  rec.Name     = phase;
+  rec.Wall     = end.Wall - begin.Wall;
+  rec.DeltaRSS = end.RSS  - begin.RSS;
+  rec.RSS      = end.RSS;
+  rec.Since    = end.Wall - fStart.Wall;
+  fPhases.push_back(rec);
+}
+//____________________________________________________________________________
+string GReWeightStartupTimer::AsTable(void) const
+{
+  unsigned int width = 5;
+  for(unsigned int i = 0; i < fPhases.size(); i++) {
+    if(fPhases[i].Name.size() > width) width = fPhases[i].Name.size();
+  }
+
+  std::ostringstream table;
+  table << std::left  << std::setw(width) << "phase"
+        << std::right << std::setw(12) << "wall [s]"
+        << std::setw(14) << "dRSS [MB]"
+        << std::setw(12) << "RSS [MB]"
+        << std::setw(12) << "at [s]" << "\n";
+  table << std::fixed;
+  for(unsigned int i = 0; i < fPhases.size(); i++) {
+    const Phase & p = fPhases[i];
+    table << std::left  << std::setw(width) << p.Name
+          << std::right << std::setw(12) << std::setprecision(3) << p.Wall
+          << std::setw(14) << std::setprecision(1) << p.DeltaRSS / 1024.
+          << std::setw(12) << std::setprecision(1) << p.RSS / 1024.
+          << std::setw(12) << std::setprecision(3) << p.Since << "\n";
+  }
+  return table.str();
+}
+//____________________________________________________________________________
+string GReWeightStartupTimer::AsJSON(void) const
+{
+  std::ostringstream json;
+  json << "{\n  \"phases\": [";
+  for(unsigned int i = 0; i < fPhases.size(); i++) {
+    const Phase & p = fPhases[i];
+    json << ((i > 0) ? ",\n" : "\n")
+         << "    { \"name\": " << JSONString(p.Name)
+         << ", \"wall_s\": " << p.Wall
+         << ", \"delta_rss_kb\": " << p.DeltaRSS
+         << ", \"rss_kb\": " << p.RSS
+         << ", \"at_s\": " << p.Since << " }";
+  }
+  json << "\n  ]\n}\n";
+  return json.str();
+}
+//____________________________________________________________________________
+bool GReWeightStartupTimer::WriteJSON(const string & filename) const
+{
+  std::ofstream out(filename.c_str());
+  if(!out) {
+    LOG("ReW", pERROR) << "Can not write startup timing to " << filename;
+    return false;
+  }
+  out << this->AsJSON();
+  return true;
+}
+//____________________________________________________________________________
+void GReWeightStartupTimer::Report(const string & json_filename) const
+{
+  if(fPhases.size() == 0) return;
+  LOG("ReW", pNOTICE) << "Startup timing:\n" << this->AsTable();
+  if(json_filename.size() > 0) this->WriteJSON(json_filename);
+}
+//____________________________________________________________________________
+string GReWeightStartupTimer::JSONString(const string & text)
+{
+  std::ostringstream out;
+  out << '"';
+  for(unsigned int i = 0; i < text.size(); i++) {
+    unsigned char c = text[i];
+    if     (c == '"' || c == '\\') out << '\\' << c;
+    else if(c == '\n')             out << "\\n";
+    else if(c == '\t')             out << "\\t";
+    else if(c < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c
+          << std::dec << std::setfill(' ');
+    }
+    else out << c;
+  }
+  out << '"';
+  return out.str();
+}
+//____________________________________________________________________________
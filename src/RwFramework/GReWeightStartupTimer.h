@@ -0,0 +1,103 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightStartupTimer
+
+\brief    Records where a reweighting job spends its time before the event
+          loop gets going: wall time and resident memory (RSS) changes for
+          each startup phase (tune building, input file opening, each
+          weight calculator's construction, first Reconfigure() and first
+          CalcWeight(), ...).
+
+          Phases are recorded either as laps (Lap(): everything since the
+          previous lap) or as explicit intervals (Begin() / End()).
+          GReWeight adds a lap for the construction of each calculator it
+          adopts and intervals for each calculator's first Reconfigure()
+          and first CalcWeight(); apps add laps for their own phases.
+          The timer is off by default, costing a flag check per hook.
+          The results can be printed as a table or written as JSON.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_STARTUP_TIMER_H_
+#define _G_REWEIGHT_STARTUP_TIMER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace genie {
+namespace rew   {
+
+class GReWeightStartupTimer {
+
+public:
+  static GReWeightStartupTimer * Instance (void);
+
+  void   Enable    (void);                       ///< start timing (laps are measured from here on)
+  void   Disable   (void) { fEnabled = false; }  ///< stop timing (recorded phases are kept)
+  bool   IsEnabled (void) const { return fEnabled; }
+
+  void   Lap       (const std::string & phase);  ///< record a phase ending now & starting at the previous lap
+  void   Begin     (const std::string & phase);  ///< start an explicit interval
+  void   End       (const std::string & phase);  ///< record an explicit interval started with Begin()
+
+  std::string AsTable   (void) const;
+  std::string AsJSON    (void) const;
+  bool        WriteJSON (const std::string & filename) const;
+  void        Report    (const std::string & json_filename) const; ///< log the table & write the JSON file (if a name is given)
+
+  static std::string JSONString (const std::string & text); ///< text as a quoted & escaped JSON string (also used by GReWeightTracer)
+
+private:
+  GReWeightStartupTimer();
+ ~GReWeightStartupTimer() {}
+
+  // a point in time: wall clock [s] & resident set size [kB]
+  struct Point {
+    double Wall;
+    long   RSS;
+  };
+  // a recorded phase
+  struct Phase {
+    std::string Name;
+    double      Wall;     ///< elapsed wall time [s]
+    long        DeltaRSS; ///< RSS change [kB]
+    long        RSS;      ///< RSS at the end of the phase [kB]
+    double      Since;    ///< end of the phase, since Enable() [s]
+  };
+
+  Point Now    (void) const;
+  void  Record (const std::string & phase, const Point & begin, const Point & end);
+
+  bool                          fEnabled;
+  Point                         fStart;    ///< when the timer was enabled
+  Point                         fLastLap;  ///< end of the previous lap
+  std::map<std::string, Point>  fOpen;     ///< intervals started with Begin()
+  std::vector<Phase>            fPhases;   ///< recorded phases, in order of completion
+
+  static GReWeightStartupTimer * fInstance;
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (GReWeightStartupTimer::fInstance !=0) {
+            delete GReWeightStartupTimer::fInstance;
+            GReWeightStartupTimer::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
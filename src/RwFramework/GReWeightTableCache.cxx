@@ -0,0 +1,204 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <sstream>
+
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TMD5.h>
+#include <TNamed.h>
+#include <TSystem.h>
+
+// GENIE/Generator includes
+#include "Framework/Conventions/GVersion.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/RunOpt.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightTableCache.h"
+
+using std::string;
+
+using namespace genie;
+using namespace genie::rew;
+
+GReWeightTableCache * GReWeightTableCache::fInstance = 0;
+
+namespace {
+  const char * kKeyName = "table_cache_key";
+}
+//____________________________________________________________________________
+GReWeightTableCache::GReWeightTableCache() :
+fModified (false),
+fNHits    (0),
+fNMisses  (0)
+{
+
+}
+//____________________________________________________________________________
+GReWeightTableCache::~GReWeightTableCache()
+{
+  this->Clear();
+}
+//____________________________________________________________________________
+GReWeightTableCache * GReWeightTableCache::Instance()
+{
+  if(fInstance == 0) {
+    static GReWeightTableCache::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new GReWeightTableCache;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+bool GReWeightTableCache::Open(const string & filename)
+{
+  this->Clear();
+  fFilename = filename;
+
+  std::ostringstream key;
+  key << "format " << kFormatVersion
+      << "; GENIE " << __GENIE_RELEASE__
+      << "; tune " << (RunOpt::Instance()->Tune() ? RunOpt::Instance()->Tune()->Name() : "none");
+  fKey = key.str();
+
+  if(gSystem->AccessPathName(filename.c_str())) {
+    LOG("ReW", pNOTICE)
+      << "No table cache at " << filename << " - It will be created";
+    return true;
+  }
+
+  TFile file(filename.c_str(), "READ");
+  TNamed * stored_key = (file.IsZombie()) ? 0 : dynamic_cast<TNamed *> (file.Get(kKeyName));
+  if(!stored_key || fKey != stored_key->GetTitle()) {
+    LOG("ReW", pWARN)
+      << "Ignoring the table cache at " << filename << ", written for ["
+      << (stored_key ? stored_key->GetTitle() : "unknown") << "] rather than ["
+      << fKey << "] - It will be rebuilt";
+    delete stored_key;
+    return false;
+  }
+  delete stored_key;
+
+  TIter next(file.GetListOfKeys());
+  TKey * tkey = 0;
+  while((tkey = (TKey *) next())) {
+    string name = tkey->GetName();
+    if(name == kKeyName || fTables.count(name)) continue;
+    TObject * obj = tkey->ReadObj();
+    TH1 * h = dynamic_cast<TH1 *> (obj);
+    if(h) h->SetDirectory(0);
+    fTables[name] = obj;
+  }
+  file.Close();
+
+  LOG("ReW", pNOTICE)
+    << "Loaded " << fTables.size() << " tables from the table cache at "
+    << filename << " [" << fKey << "]";
+  return true;
+}
+//____________________________________________________________________________
+bool GReWeightTableCache::Save(void)
+{
+  if(!this->IsOpen()) return true;
+
+  LOG("ReW", pNOTICE)
+    << "Table cache: " << fNHits << " tables loaded, " << fNMisses << " built";
+  if(!fModified) return true;
+
+  // Write to a temporary file & rename, so that concurrent jobs sharing
+  // a cache file never read a partially written one
+  std::ostringstream tmpname;
+  tmpname << fFilename << ".tmp." << gSystem->GetPid();
+  TFile file(tmpname.str().c_str(), "RECREATE");
+  if(file.IsZombie()) {
+    LOG("ReW", pERROR) << "Can not write the table cache at " << tmpname.str();
+    return false;
+  }
+  TNamed key(kKeyName, fKey.c_str());
+  key.Write();
+  std::map<string, TObject *>::const_iterator it = fTables.begin();
+  for( ; it != fTables.end(); ++it) {
+    file.WriteTObject(it->second, it->first.c_str());
+  }
+  file.Close();
+
+  if(gSystem->Rename(tmpname.str().c_str(), fFilename.c_str()) != 0) {
+    LOG("ReW", pERROR) << "Can not move the table cache to " << fFilename;
+    gSystem->Unlink(tmpname.str().c_str());
+    return false;
+  }
+  fModified = false;
+
+  LOG("ReW", pNOTICE)
+    << "Saved " << fTables.size() << " tables in the table cache at " << fFilename;
+  return true;
+}
+//____________________________________________________________________________
+TObject * GReWeightTableCache::Get(
+   const string & calc, const string & config, const string & table) const
+{
+  if(!this->IsOpen()) return 0;
+
+  std::map<string, TObject *>::const_iterator it =
+     fTables.find(this->TableName(calc, config, table));
+  if(it == fTables.end()) {
+    fNMisses++;
+    return 0;
+  }
+  fNHits++;
+
+  TObject * obj = it->second->Clone();
+  TH1 * h = dynamic_cast<TH1 *> (obj);
+  if(h) h->SetDirectory(0);
+  return obj;
+}
+//____________________________________________________________________________
+void GReWeightTableCache::Put(
+   const string & calc, const string & config, const string & table,
+   const TObject & obj)
+{
+  if(!this->IsOpen()) return;
+
+  string name = this->TableName(calc, config, table);
+  std::map<string, TObject *>::iterator it = fTables.find(name);
+  if(it != fTables.end()) delete it->second;
+
+  TObject * copy = obj.Clone();
+  TH1 * h = dynamic_cast<TH1 *> (copy);
+  if(h) h->SetDirectory(0);
+  fTables[name] = copy;
+  fModified = true;
+}
+//____________________________________________________________________________
+string GReWeightTableCache::TableName(
+   const string & calc, const string & config, const string & table) const
+{
+// calc_<config hash>_table, usable as a ROOT key name
+//
+  TMD5 md5;
+  md5.Update((const UChar_t *) config.c_str(), config.size());
+  md5.Final();
+  return calc + "_" + string(md5.AsString()).substr(0,12) + "_" + table;
+}
+//____________________________________________________________________________
+void GReWeightTableCache::Clear(void)
+{
+  std::map<string, TObject *>::iterator it = fTables.begin();
+  for( ; it != fTables.end(); ++it) {
+    delete it->second;
+  }
+  fTables.clear();
+  fModified = false;
+  fNHits    = 0;
+  fNMisses  = 0;
+}
+//____________________________________________________________________________
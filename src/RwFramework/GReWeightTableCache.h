@@ -0,0 +1,91 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightTableCache
+
+\brief    Opt-in, versioned cache of the derived tables that weight
+          calculators build at construction time or on first use (eg
+          default branching ratios as a function of W, or nucleon momentum
+          distributions sampled from nuclear models).
+
+          When a cache file is opened, calculators look their tables up
+          before building them and add newly built ones, which are written
+          back by Save(). Tables are keyed by calculator, by a description
+          of the calculator configuration they depend on, and by name.
+          The whole file is keyed by the cache format version, the GENIE
+          version and the tune: a file written with a different key is
+          ignored and rebuilt.
+          With no cache file opened, all lookups fail and calculators build
+          their tables as usual.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_TABLE_CACHE_H_
+#define _G_REWEIGHT_TABLE_CACHE_H_
+
+#include <string>
+#include <map>
+
+class TObject;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightTableCache {
+
+public:
+  static GReWeightTableCache * Instance (void);
+
+  bool      Open   (const std::string & filename);  ///< enable the cache & load the tables in filename (if it exists and its key matches)
+  bool      IsOpen (void) const { return fFilename.size() > 0; }
+  bool      Save   (void);                          ///< write the cache back, if any table was added
+
+  TObject * Get    (const std::string & calc, const std::string & config,
+                    const std::string & table) const;               ///< copy of a cached table (caller owns it) or 0
+  void      Put    (const std::string & calc, const std::string & config,
+                    const std::string & table, const TObject & obj); ///< add a table (a copy is stored)
+
+  const std::string & Key (void) const { return fKey; }
+
+  static const int kFormatVersion = 1;
+
+private:
+  GReWeightTableCache();
+ ~GReWeightTableCache();
+
+  std::string TableName (const std::string & calc, const std::string & config,
+                         const std::string & table) const;
+  void        Clear     (void);
+
+  std::string                       fFilename; ///< cache file, empty if the cache is not enabled
+  std::string                       fKey;      ///< format version, GENIE version & tune
+  std::map<std::string, TObject *>  fTables;   ///< table name -> table
+  bool                              fModified; ///< tables added since loading?
+  mutable int                       fNHits;    ///< # of successful lookups
+  mutable int                       fNMisses;  ///< # of failed lookups
+
+  static GReWeightTableCache * fInstance;
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (GReWeightTableCache::fInstance !=0) {
+            delete GReWeightTableCache::fInstance;
+            GReWeightTableCache::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
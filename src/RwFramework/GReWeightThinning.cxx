@@ -0,0 +1,201 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <sstream>
+
+#include <TMath.h>
+#include <TRandom.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightThinning.h"
+#include "RwFramework/GReWeightEventSummary.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+//____________________________________________________________________________
+GReWeightThinning::GReWeightThinning() :
+fFraction      (0.1),
+fMinPerStratum (10),
+fNSelected     (0)
+{
+  const double ev_bins[] = { 0., 0.5, 1., 1.5, 2., 3., 4., 6., 10., 20. };
+  const double q2_bins[] = { 0., 0.1, 0.2, 0.5, 1., 2., 5. };
+  fEvBins.assign(ev_bins, ev_bins + sizeof(ev_bins)/sizeof(double));
+  fQ2Bins.assign(q2_bins, q2_bins + sizeof(q2_bins)/sizeof(double));
+}
+//____________________________________________________________________________
+string GReWeightThinning::StratumName(const GReWeightEventSummary & summary) const
+{
+  typedef GReWeightEventSummary S;
+
+  std::ostringstream name;
+  if      (summary.Value(S::kCC) > 0) name << "CC";
+  else if (summary.Value(S::kNC) > 0) name << "NC";
+  else if (summary.Value(S::kEM) > 0) name << "EM";
+  else                                name << "other";
+
+  if      (summary.Value(S::kQEL) > 0) name << " QEL";
+  else if (summary.Value(S::kRES) > 0) name << " RES";
+  else if (summary.Value(S::kDIS) > 0) name << " DIS";
+  else if (summary.Value(S::kCOH) > 0) name << " COH";
+  else if (summary.Value(S::kMEC) > 0) name << " MEC";
+  else if (summary.Value(S::kDFR) > 0) name << " DFR";
+  else                                 name << " other";
+
+  name << " " << (int) summary.Value(S::kTarget)
+       << " " << this->BinName(fEvBins, this->BinIndex(fEvBins, summary.Value(S::kEv)), "Ev")
+       << " " << this->BinName(fQ2Bins, this->BinIndex(fQ2Bins, summary.Value(S::kQ2)), "Q2");
+  return name.str();
+}
+//____________________________________________________________________________
+int GReWeightThinning::AddEvent(const string & stratum, double importance)
+{
+  std::map<string, int>::const_iterator it = fStrata.find(stratum);
+  int istratum = 0;
+  if(it == fStrata.end()) {
+    istratum = fStrataNames.size();
+    fStrata[stratum] = istratum;
+    fStrataNames.push_back(stratum);
+  } else {
+    istratum = it->second;
+  }
+
+  // a vanishing importance would never be kept, nor compensated for
+  fStratum   .push_back(istratum);
+  fImportance.push_back(TMath::Max(importance, 1E-6));
+  return fImportance.size() - 1;
+}
+//____________________________________________________________________________
+void GReWeightThinning::Select(TRandom & rnd)
+{
+  int nev     = fImportance.size();
+  int nstrata = fStrataNames.size();
+
+  vector< vector<int> > members(nstrata);
+  for(int iev = 0; iev < nev; iev++) {
+    members[fStratum[iev]].push_back(iev);
+  }
+
+  fProbability.assign(nev, 1.);
+  fSelected   .assign(nev, false);
+  fNSelected = 0;
+
+  for(int is = 0; is < nstrata; is++) {
+    const vector<int> & events = members[is];
+    int    n      = events.size();
+    double target = TMath::Min((double) n,
+                    TMath::Max(fFraction * n, (double) fMinPerStratum));
+
+    // p = min(1, c * importance), with c such that the p's add up to the
+    // target: events capped at p=1 are taken out and c is recomputed
+    // until no more events get capped
+    vector<bool> capped(n, false);
+    int    ncapped = 0;
+    double c       = 0.;
+    bool   changed = true;
+    while(changed) {
+      changed = false;
+      double sum = 0.;
+      for(int i = 0; i < n; i++) {
+        if(!capped[i]) sum += fImportance[events[i]];
+      }
+      if(sum <= 0.) break;
+      c = (target - ncapped) / sum;
+      for(int i = 0; i < n; i++) {
+        if(!capped[i] && c * fImportance[events[i]] >= 1.) {
+          capped[i] = true;
+          ncapped++;
+          changed = true;
+        }
+      }
+    }
+    for(int i = 0; i < n; i++) {
+      int iev = events[i];
+      fProbability[iev] = capped[i] ? 1. : c * fImportance[iev];
+      fSelected   [iev] = (rnd.Rndm() < fProbability[iev]);
+      if(fSelected[iev]) fNSelected++;
+    }
+  }
+
+  LOG("ReW", pNOTICE)
+    << "Thinning kept " << fNSelected << " of " << nev << " events in "
+    << nstrata << " strata (effective size: " << this->EffectiveSize() << ")";
+}
+//____________________________________________________________________________
+double GReWeightThinning::EffectiveSize(void) const
+{
+  double sumw = 0., sumw2 = 0.;
+  for(unsigned int iev = 0; iev < fSelected.size(); iev++) {
+    double w = this->Weight(iev);
+    sumw  += w;
+    sumw2 += w*w;
+  }
+  return (sumw2 > 0.) ? sumw*sumw/sumw2 : 0.;
+}
+//____________________________________________________________________________
+GReWeightThinning::Sum GReWeightThinning::Total(
+   const float * x, int stride, double offset) const
+{
+// The sampling (Horvitz-Thompson) variance of the thinned sum, given the
+// full sample, is sum (1-p)/p (x-offset)^2 over all events
+//
+  Sum s;
+  s.Full    = 0.;
+  s.Thinned = 0.;
+  s.Sigma   = 0.;
+
+  double var = 0.;
+  int nev = fSelected.size();
+  for(int iev = 0; iev < nev; iev++) {
+    double xi = (x ? x[(size_t)iev * stride] : 1.) - offset;
+    double p  = fProbability[iev];
+    s.Full += xi;
+    if(fSelected[iev]) s.Thinned += xi / p;
+    var += (1. - p) / p * xi * xi;
+  }
+  s.Sigma = TMath::Sqrt(var);
+  return s;
+}
+//____________________________________________________________________________
+double GReWeightThinning::Importance(const float * weights, int n)
+{
+  double sumw2 = 1.; // nominal
+  for(int i = 0; i < n; i++) {
+    sumw2 += weights[i] * weights[i];
+  }
+  return TMath::Sqrt(sumw2 / (n + 1));
+}
+//____________________________________________________________________________
+int GReWeightThinning::BinIndex(const vector<double> & edges, double x) const
+{
+// 0: below the first edge, edges.size(): above the last one
+//
+  int bin = 0;
+  while(bin < (int) edges.size() && x >= edges[bin]) bin++;
+  return bin;
+}
+//____________________________________________________________________________
+string GReWeightThinning::BinName(
+   const vector<double> & edges, int bin, const char * var) const
+{
+  std::ostringstream name;
+  if      (edges.size() == 0)         name << var;
+  else if (bin == 0)                  name << var << "<"  << edges[0];
+  else if (bin >= (int) edges.size()) name << var << ">=" << edges.back();
+  else    name << var << "[" << edges[bin-1] << "," << edges[bin] << ")";
+  return name.str();
+}
+//____________________________________________________________________________
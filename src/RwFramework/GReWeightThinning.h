@@ -0,0 +1,113 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightThinning
+
+\brief    Builds a reduced (`thinned') event sample by stratified, importance
+          weighted subsampling, so that approximate fits can run on a
+          fraction of the events without losing the rare events that
+          reweighting gives large weights to.
+
+          Events are grouped in strata (interaction type, scattering mode,
+          target, Ev bin and Q2 bin). Within a stratum, an event is kept
+          with a probability p proportional to its importance (capped at 1),
+          chosen so that the expected number of kept events is the
+          requested fraction of the stratum (but at least a minimum number
+          of events, so that small strata are never emptied). Kept events
+          carry the compensating weight 1/p, so that any weighted sum over
+          the thinned sample is an unbiased estimate of the same sum over
+          the full sample.
+
+          The importance of an event is the RMS of its weights over a set of
+          universes (parameter throws or dial scans) and the nominal
+          universe, sqrt(mean^2 + variance), which is the choice minimizing
+          the average sampling variance of the universe totals.
+
+          Total() compares a weighted sum over the thinned sample with the
+          same sum over the full sample and gives the expected sampling
+          error of the thinned estimate.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_THINNING_H_
+#define _G_REWEIGHT_THINNING_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+class TRandom;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightEventSummary;
+
+class GReWeightThinning {
+
+public:
+  GReWeightThinning();
+ ~GReWeightThinning() {}
+
+  // a sum over the full sample, its thinned sample estimate & sampling error
+  struct Sum {
+    double Full;
+    double Thinned;
+    double Sigma;
+  };
+
+  void  SetFraction       (double fraction) { fFraction     = fraction; }
+  void  SetMinPerStratum  (int nmin)        { fMinPerStratum = nmin;    }
+  void  SetEvBins         (const std::vector<double> & edges) { fEvBins = edges; }
+  void  SetQ2Bins         (const std::vector<double> & edges) { fQ2Bins = edges; }
+
+  std::string StratumName (const GReWeightEventSummary & summary) const;
+
+  int   AddEvent          (const std::string & stratum, double importance); ///< returns the event index
+  void  Select            (TRandom & rnd);                                  ///< choose the events to keep
+
+  int   NEvents           (void) const { return fImportance.size(); }
+  int   NStrata           (void) const { return fStrataNames.size(); }
+  int   NSelected         (void) const { return fNSelected; }
+
+  bool   Selected         (int iev) const { return fSelected[iev]; }
+  double Probability      (int iev) const { return fProbability[iev]; }
+  double Weight           (int iev) const { return fSelected[iev] ? 1./fProbability[iev] : 0.; } ///< compensating weight
+  int    Stratum          (int iev) const { return fStratum[iev]; }
+  const std::string & StratumName (int istratum) const { return fStrataNames[istratum]; }
+
+  double EffectiveSize    (void) const;                           ///< Kish effective # of kept events
+  Sum    Total            (const float * x, int stride, double offset = 0.) const; ///< sum of x[iev*stride] - offset (x=0: unit values)
+
+  static double Importance (const float * weights, int n);        ///< RMS of the weights & the nominal (unit) weight
+
+private:
+
+  int    BinIndex (const std::vector<double> & edges, double x) const;
+  std::string BinName (const std::vector<double> & edges, int bin, const char * var) const;
+
+  double                      fFraction;      ///< fraction of events to keep
+  int                         fMinPerStratum; ///< min # of events to keep per stratum
+  std::vector<double>         fEvBins;        ///< Ev bin edges (GeV)
+  std::vector<double>         fQ2Bins;        ///< Q2 bin edges (GeV^2)
+
+  std::map<std::string, int>  fStrata;        ///< stratum name -> index
+  std::vector<std::string>    fStrataNames;   ///< index -> stratum name
+  std::vector<int>            fStratum;       ///< per event: stratum index
+  std::vector<double>         fImportance;    ///< per event: importance
+  std::vector<double>         fProbability;   ///< per event: probability of being kept
+  std::vector<bool>           fSelected;      ///< per event: kept?
+  int                         fNSelected;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,288 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightTracer.h"
+#include "RwFramework/GReWeightStartupTimer.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+GReWeightTracer * GReWeightTracer::fInstance = 0;
+
+// a recorded span
+struct GReWeightTracer::Buffer {
+  struct Span {
+    string       Name;
+    const char * Category;
+    double       Begin;    ///< [us] since Enable()
+    double       Duration; ///< [us]
+    long         Event;    ///< -1 outside events
+  };
+  int          Thread;     ///< thread number, in order of registration
+  vector<Span> Spans;
+  long         Dropped;
+};
+
+namespace {
+  std::atomic<bool> gEnabled (false);
+  std::atomic<long> gSampling(100);
+  std::atomic<long> gCapacity(1000000);
+  double            gStart = 0.;  ///< [us], set by Enable() before any traced thread runs
+  std::mutex        gRegisterMutex;
+
+  // per-thread state
+  thread_local bool   tInEvent    = false;
+  thread_local bool   tSampled    = false;
+  thread_local long   tEvent      = -1;
+  thread_local double tEventBegin = 0.;
+
+  double Clock(void)
+  {
+    return std::chrono::duration<double, std::micro>(
+       std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+//____________________________________________________________________________
+GReWeightTracer::GReWeightTracer()
+{
+
+}
+//____________________________________________________________________________
+GReWeightTracer::~GReWeightTracer()
+{
+  for(unsigned int i = 0; i < fBuffers.size(); i++) delete fBuffers[i];
+  fBuffers.clear();
+}
+//____________________________________________________________________________
+GReWeightTracer * GReWeightTracer::Instance()
+{
+  if(fInstance == 0) {
+    static GReWeightTracer::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new GReWeightTracer;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+void GReWeightTracer::Enable(void)
+{
+  gStart = Clock();
+  gEnabled.store(true);
+}
+//____________________________________________________________________________
+void GReWeightTracer::Disable(void)
+{
+  gEnabled.store(false);
+}
+//____________________________________________________________________________
+bool GReWeightTracer::IsEnabled(void) const
+{
+  return gEnabled.load(std::memory_order_relaxed);
+}
+//____________________________________________________________________________
+void GReWeightTracer::SetSampling(long every)
+{
+  gSampling.store((every > 0) ? every : 1);
+}
+//____________________________________________________________________________
+void GReWeightTracer::SetCapacity(long spans)
+{
+  gCapacity.store(spans);
+}
+//____________________________________________________________________________
+void GReWeightTracer::BeginEvent(long id)
+{
+  // an event left open (eg by a `continue' in the event loop) ends here
+  if(tInEvent) EndEvent();
+
+  tInEvent = true;
+  tEvent   = id;
+  tSampled = gEnabled.load(std::memory_order_relaxed) &&
+             (id % gSampling.load(std::memory_order_relaxed) == 0);
+  if(tSampled) tEventBegin = Now();
+}
+//____________________________________________________________________________
+void GReWeightTracer::EndEvent(void)
+{
+  if(tSampled) {
+    std::ostringstream name;
+    name << "event " << tEvent;
+    string sname = name.str();
+    Record(0, &sname, "event", tEventBegin, Now());
+  }
+  tInEvent = false;
+  tSampled = false;
+  tEvent   = -1;
+}
+//____________________________________________________________________________
+bool GReWeightTracer::Tracing(void)
+{
+  return gEnabled.load(std::memory_order_relaxed) && (!tInEvent || tSampled);
+}
+//____________________________________________________________________________
+double GReWeightTracer::Now(void)
+{
+  return Clock() - gStart;
+}
+//____________________________________________________________________________
+GReWeightTracer::Buffer * GReWeightTracer::ThisThread(void)
+{
+  static thread_local Buffer * buffer = 0;
+  if(buffer) return buffer;
+
+  // buffers are owned by the tracer, so that they outlive their threads
+  std::lock_guard<std::mutex> lock(gRegisterMutex);
+  GReWeightTracer * tracer = GReWeightTracer::Instance();
+  buffer = new Buffer;
+  buffer->Thread  = tracer->fBuffers.size();
+  buffer->Dropped = 0;
+  tracer->fBuffers.push_back(buffer);
+  return buffer;
+}
+//____________________________________________________________________________
+void GReWeightTracer::Record(
+   const char * name, const string * sname, const char * category,
+   double begin, double end)
+{
+  Buffer * buffer = ThisThread();
+  if((long) buffer->Spans.size() >= gCapacity.load(std::memory_order_relaxed)) {
+    buffer->Dropped++;
+    return;
+  }
+  Buffer::Span span;
+  span.Name     = (sname) ? *sname : string(name);
+  span.Category = category;
+  span.Begin    = begin;
+  span.Duration = end - begin;
+  span.Event    = (tInEvent) ? tEvent : -1;
+  buffer->Spans.push_back(span);
+}
+//____________________________________________________________________________
+long GReWeightTracer::NSpans(void) const
+{
+  long n = 0;
+  for(unsigned int i = 0; i < fBuffers.size(); i++) n += fBuffers[i]->Spans.size();
+  return n;
+}
+//____________________________________________________________________________
+long GReWeightTracer::NDropped(void) const
+{
+  long n = 0;
+  for(unsigned int i = 0; i < fBuffers.size(); i++) n += fBuffers[i]->Dropped;
+  return n;
+}
+//____________________________________________________________________________
+string GReWeightTracer::AsJSON(void) const
+{
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3);
+  json << "{\n  \"displayTimeUnit\": \"ms\",\n"
+       << "  \"otherData\": { \"dropped_spans\": " << this->NDropped() << " },\n"
+       << "  \"traceEvents\": [";
+  bool first = true;
+  for(unsigned int ib = 0; ib < fBuffers.size(); ib++) {
+    const Buffer * buffer = fBuffers[ib];
+    json << (first ? "\n" : ",\n")
+         << "    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+         << buffer->Thread << ", \"args\": { \"name\": \"thread " << buffer->Thread << "\" } }";
+    first = false;
+    for(unsigned int is = 0; is < buffer->Spans.size(); is++) {
+      const Buffer::Span & span = buffer->Spans[is];
+      json << ",\n    { \"name\": " << GReWeightStartupTimer::JSONString(span.Name)
+           << ", \"cat\": " << GReWeightStartupTimer::JSONString(span.Category)
+           << ", \"ph\": \"X\", \"ts\": " << span.Begin
+           << ", \"dur\": " << span.Duration
+           << ", \"pid\": 1, \"tid\": " << buffer->Thread;
+      if(span.Event >= 0) json << ", \"args\": { \"event\": " << span.Event << " }";
+      json << " }";
+    }
+  }
+  json << "\n  ]\n}\n";
+  return json.str();
+}
+//____________________________________________________________________________
+bool GReWeightTracer::WriteJSON(const string & filename) const
+{
+  std::ofstream out(filename.c_str());
+  if(!out) {
+    LOG("ReW", pERROR) << "Can not write the trace to " << filename;
+    return false;
+  }
+  out << this->AsJSON();
+  return true;
+}
+//____________________________________________________________________________
+void GReWeightTracer::Report(const string & json_filename) const
+{
+  // the slowest traced events, to look up first in the trace viewer
+  vector< std::pair<double, string> > events;
+  for(unsigned int ib = 0; ib < fBuffers.size(); ib++) {
+    const vector<Buffer::Span> & spans = fBuffers[ib]->Spans;
+    for(unsigned int is = 0; is < spans.size(); is++) {
+      if(string(spans[is].Category) != "event") continue;
+      events.push_back(std::make_pair(spans[is].Duration, spans[is].Name));
+    }
+  }
+  std::sort(events.rbegin(), events.rend());
+
+  std::ostringstream summary;
+  summary << this->NSpans() << " spans recorded in " << fBuffers.size()
+          << " thread(s), " << this->NDropped() << " dropped, "
+          << events.size() << " events traced";
+  summary << std::fixed << std::setprecision(3);
+  for(unsigned int i = 0; i < events.size() && i < 10; i++) {
+    summary << "\n  " << std::left << std::setw(20) << events[i].second
+            << std::right << std::setw(12) << events[i].first / 1000. << " ms";
+  }
+  LOG("ReW", pNOTICE) << "Trace: " << summary.str();
+
+  if(json_filename.size() > 0) this->WriteJSON(json_filename);
+}
+//____________________________________________________________________________
+GReWeightTraceSpan::GReWeightTraceSpan(const char * name, const char * category) :
+fActive   (GReWeightTracer::Tracing()),
+fName     (name),
+fSName    (0),
+fCategory (category),
+fBegin    (0.)
+{
+  if(fActive) fBegin = GReWeightTracer::Now();
+}
+//____________________________________________________________________________
+GReWeightTraceSpan::GReWeightTraceSpan(const string & name, const char * category) :
+fActive   (GReWeightTracer::Tracing()),
+fName     (0),
+fSName    (&name),
+fCategory (category),
+fBegin    (0.)
+{
+  if(fActive) fBegin = GReWeightTracer::Now();
+}
+//____________________________________________________________________________
+GReWeightTraceSpan::~GReWeightTraceSpan()
+{
+  if(!fActive) return;
+  GReWeightTracer::Record(fName, fSName, fCategory, fBegin, GReWeightTracer::Now());
+}
+//____________________________________________________________________________
@@ -0,0 +1,120 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightTracer
+
+\brief    Records timed spans (GReWeight::CalcWeight(), each calculator's
+          CalcWeight() and Reconfigure(), cross section evaluations and
+          integrals, event I/O, ...) for a sampled subset of events and
+          exports them as Chrome trace JSON, which chrome://tracing and
+          ui.perfetto.dev display as a timeline per thread, so that the
+          events which are slow can be inspected one by one.
+
+          Event loops bracket each event with BeginEvent() / EndEvent()
+          (BeginEvent() also ends the previous event, if still open): the
+          event is traced if its id is a multiple of the sampling interval
+          (SetSampling()). Spans opened outside any event (eg the
+          Reconfigure() between universes) are traced whenever tracing is
+          on. Spans are opened with a GReWeightTraceSpan on the stack:
+
+            { GReWeightTraceSpan span("XSec", "xsec"); ... }
+
+          which, when its thread is not tracing, costs a flag check.
+
+          Each thread records into its own buffer, with no locking; a
+          buffer that reaches the capacity (SetCapacity()) drops further
+          spans, and counts them. WriteJSON() reads all buffers, so it
+          must be called once the traced threads are done.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_TRACER_H_
+#define _G_REWEIGHT_TRACER_H_
+
+#include <string>
+#include <vector>
+
+namespace genie {
+namespace rew   {
+
+class GReWeightTracer {
+
+public:
+  static GReWeightTracer * Instance (void);
+
+  void   Enable      (void);                          ///< start tracing (timestamps are measured from here on)
+  void   Disable     (void);                          ///< stop tracing (recorded spans are kept)
+  bool   IsEnabled   (void) const;
+  void   SetSampling (long every);                    ///< trace every n-th event (default: 100)
+  void   SetCapacity (long spans);                    ///< max spans per thread (default: 1000000)
+
+  static void BeginEvent (long id); ///< start an event on this thread; it is traced if sampled
+  static void EndEvent   (void);
+  static bool Tracing    (void);    ///< is this thread recording spans?
+
+  long        NSpans     (void) const;                  ///< spans recorded, all threads
+  long        NDropped   (void) const;                  ///< spans dropped at full buffers, all threads
+  std::string AsJSON     (void) const;                  ///< Chrome trace JSON
+  bool        WriteJSON  (const std::string & filename) const;
+  void        Report     (const std::string & json_filename) const; ///< log a summary & write the JSON file
+
+private:
+  friend class GReWeightTraceSpan;
+
+  GReWeightTracer();
+ ~GReWeightTracer();
+
+  struct Buffer; // a thread's spans, defined in the implementation
+
+  static double   Now       (void); ///< [us] since Enable()
+  static Buffer * ThisThread(void); ///< this thread's buffer, registered on first use
+  static void     Record    (const char * name, const std::string * sname,
+                             const char * category, double begin, double end);
+
+  std::vector<Buffer *> fBuffers;  ///< all threads' buffers, in order of registration
+
+  static GReWeightTracer * fInstance;
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (GReWeightTracer::fInstance !=0) {
+            delete GReWeightTracer::fInstance;
+            GReWeightTracer::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+// A traced span, from construction to destruction. The name must outlive
+// the span (string literals, calculator names held by GReWeight, ...).
+class GReWeightTraceSpan {
+
+public:
+  GReWeightTraceSpan(const char *        name, const char * category);
+  GReWeightTraceSpan(const std::string & name, const char * category);
+ ~GReWeightTraceSpan();
+
+private:
+  GReWeightTraceSpan(const GReWeightTraceSpan &);
+  GReWeightTraceSpan & operator = (const GReWeightTraceSpan &);
+
+  bool                fActive;
+  const char *        fName;
+  const std::string * fSName;
+  const char *        fCategory;
+  double              fBegin;   ///< [us] since GReWeightTracer::Enable()
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -21,19 +21,34 @@ using namespace genie;
 using namespace genie::rew;
 
 GSystUncertainty * GSystUncertainty::fInstance = 0;
+
+namespace {
+  // table overriding the shared one for the calling thread (see MakeCurrent)
+  thread_local GSystUncertainty * gCurrentUncertainty = 0;
+}
 //____________________________________________________________________________
 GSystUncertainty::GSystUncertainty()
 {
 //  fInstance = 0;
+}
+//____________________________________________________________________________
+GSystUncertainty::GSystUncertainty(const GSystUncertainty & err) :
+fOneSigPlusErrMap(err.fOneSigPlusErrMap),
+fOneSigMnusErrMap(err.fOneSigMnusErrMap)
+{
+
 }
 //____________________________________________________________________________
 GSystUncertainty::~GSystUncertainty()
 {
-  fInstance = 0;
+  if(gCurrentUncertainty == this) gCurrentUncertainty = 0;
+  if(fInstance           == this) fInstance           = 0;
 }
 //____________________________________________________________________________
 GSystUncertainty * GSystUncertainty::Instance()
 {
+  if(gCurrentUncertainty) return gCurrentUncertainty;
+
   if(fInstance == 0) {
     LOG("ReW", pINFO) << "GSystUncertainty late initialization";
     static GSystUncertainty::Cleaner cleaner;
@@ -44,6 +59,18 @@ GSystUncertainty * GSystUncertainty::Instance()
   return fInstance;
 }
 //____________________________________________________________________________
+GSystUncertainty * GSystUncertainty::Clone()
+{
+  return new GSystUncertainty(*GSystUncertainty::Instance());
+}
+//____________________________________________________________________________
+GSystUncertainty * GSystUncertainty::MakeCurrent(GSystUncertainty * unc)
+{
+  GSystUncertainty * prev = gCurrentUncertainty;
+  gCurrentUncertainty = unc;
+  return prev;
+}
+//____________________________________________________________________________
 double GSystUncertainty::OneSigmaErr(GSyst_t s, int sign) const
 {
   if(sign > 0) {
@@ -3,7 +3,12 @@
 
 \class    genie::rew::GSystUncertainty
 
-\brief    
+\brief    Table of one-sigma fractional errors for each systematic parameter.
+
+          A single table is shared by default. Independent tables can be
+          created with Clone() and made current for the calling thread
+          with MakeCurrent(), so that several GReWeight instances running
+          side-by-side can each use their own uncertainties.
 
 \author   Costas Andreopoulos <costas.andreopoulos \at stfc.ac.uk>
           University of Liverpool & STFC Rutherford Appleton Lab
@@ -34,7 +39,12 @@ namespace rew   {
 class GSystUncertainty {
 
 public:  
-  static GSystUncertainty * Instance (void);
+  static GSystUncertainty * Instance    (void);                    ///< current table (the shared one unless overriden)
+  static GSystUncertainty * Clone       (void);                    ///< new independent copy of the current table, caller owns
+  static GSystUncertainty * MakeCurrent (GSystUncertainty * unc);  ///< route Instance() to unc for this thread (0 restores the shared table), returns previous
+
+  GSystUncertainty(const GSystUncertainty & err);
+ ~GSystUncertainty();
 
   double OneSigmaErr    (GSyst_t syst, int sign=0) const;
   void   SetUncertainty (GSyst_t syst, double plus_err, double minus_err);
@@ -47,8 +57,6 @@ private:
   map<GSyst_t, double> fOneSigMnusErrMap; // - err
 
   GSystUncertainty();
-  GSystUncertainty(const GSystUncertainty & err);
- ~GSystUncertainty();
   
   static GSystUncertainty * fInstance;
 
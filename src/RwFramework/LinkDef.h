@@ -12,6 +12,18 @@
 #pragma link C++ class genie::rew::GSystInfo;
 #pragma link C++ class genie::rew::GSystUncertainty;
 #pragma link C++ class genie::rew::GReWeight;
+#pragma link C++ class genie::rew::GReWeightEventSummary;
+#pragma link C++ class genie::rew::GReWeightEventView;
+#pragma link C++ class genie::rew::GReWeightBlockPlan;
+#pragma link C++ class genie::rew::GReWeightMath;
+#pragma link C++ class genie::rew::GReWeightResponseSurface;
+#pragma link C++ class genie::rew::GReWeightSelection;
+#pragma link C++ class genie::rew::GReWeightServices;
+#pragma link C++ class genie::rew::GReWeightTableCache;
+#pragma link C++ class genie::rew::GReWeightStartupTimer;
+#pragma link C++ class genie::rew::GReWeightThinning;
+#pragma link C++ class genie::rew::GReWeightTracer;
+#pragma link C++ class genie::rew::GReWeightTraceSpan;
 
 #pragma link C++ ioctortype TRootIOCtor;
 
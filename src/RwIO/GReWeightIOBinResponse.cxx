@@ -0,0 +1,228 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+
+#include <TRootIOCtor.h>
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOBinResponse.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+ClassImp(GReWeightIOBinResponse)
+
+//____________________________________________________________________________
+GReWeightIOBinResponse::GReWeightIOBinResponse() :
+TObject(),
+fNBins(0)
+{
+  fKnotOffset.push_back(0);
+}
+//____________________________________________________________________________
+GReWeightIOBinResponse::GReWeightIOBinResponse(TRootIOCtor *) :
+TObject(),
+fNBins(0)
+{
+
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::SetBinning(const string & spec, int nbins)
+{
+  assert(fDials.size() == 0);
+  fBinning = spec;
+  fNBins   = nbins;
+  fNominal.assign(nbins, 0.);
+}
+//____________________________________________________________________________
+int GReWeightIOBinResponse::AddDial(const string & name, const vector<double> & knots)
+{
+  assert(knots.size() >= 2);
+  for(unsigned int k = 1; k < knots.size(); k++) assert(knots[k] > knots[k-1]);
+
+  fDials.push_back(name);
+  fKnots.insert(fKnots.end(), knots.begin(), knots.end());
+  fKnotOffset.push_back(fKnots.size());
+
+  // flat (unit) response until set
+  fSplineOffset.push_back(fSpline.size());
+  int nint = knots.size() - 1;
+  for(int i = 0; i < fNBins * nint; i++) {
+    fSpline.push_back(1.);
+    fSpline.push_back(0.);
+    fSpline.push_back(0.);
+    fSpline.push_back(0.);
+  }
+  return fDials.size() - 1;
+}
+//____________________________________________________________________________
+int GReWeightIOBinResponse::AddCross(int dial1, int dial2)
+{
+  assert(dial1 >= 0 && dial1 < this->NDials() && dial2 >= 0 && dial2 < this->NDials() && dial1 != dial2);
+
+  int nk1 = fKnotOffset[dial1+1] - fKnotOffset[dial1];
+  int nk2 = fKnotOffset[dial2+1] - fKnotOffset[dial2];
+  fCross1.push_back(dial1);
+  fCross2.push_back(dial2);
+  fCrossOffset.push_back(fCross.size());
+  fCross.resize(fCross.size() + (size_t)fNBins * nk1 * nk2, 1.);
+  return fCross1.size() - 1;
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::SetNominal(int bin, double count)
+{
+  fNominal[bin] = count;
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::SetDialResponse(int dial, int bin, const double * ratios)
+{
+  //
+  // Natural cubic spline through (knot, ratio): second derivatives m from
+  // the tridiagonal system, then, on each interval,
+  // y = a + b t + c t^2 + d t^3 with t the offset from the first knot
+  //
+  const double * x = &fKnots[fKnotOffset[dial]];
+  int n = fKnotOffset[dial+1] - fKnotOffset[dial];
+
+  vector<double> m(n, 0.);
+  if(n > 2) {
+    vector<double> diag(n, 0.), rhs(n, 0.);
+    for(int i = 1; i < n-1; i++) {
+      double h0 = x[i]   - x[i-1];
+      double h1 = x[i+1] - x[i];
+      diag[i] = 2. * (h0 + h1);
+      rhs [i] = 6. * ((ratios[i+1] - ratios[i]) / h1 - (ratios[i] - ratios[i-1]) / h0);
+    }
+    // forward elimination & back substitution (m[0] = m[n-1] = 0)
+    for(int i = 2; i < n-1; i++) {
+      double h0 = x[i] - x[i-1];
+      double f  = h0 / diag[i-1];
+      diag[i] -= f * h0;
+      rhs [i] -= f * rhs[i-1];
+    }
+    for(int i = n-2; i >= 1; i--) {
+      double h1 = x[i+1] - x[i];
+      m[i] = (rhs[i] - ((i < n-2) ? h1 * m[i+1] : 0.)) / diag[i];
+    }
+  }
+
+  double * coef = &fSpline[fSplineOffset[dial] + (size_t)bin * (n-1) * 4];
+  for(int i = 0; i < n-1; i++) {
+    double h = x[i+1] - x[i];
+    coef[4*i    ] = ratios[i];
+    coef[4*i + 1] = (ratios[i+1] - ratios[i]) / h - h * (2.*m[i] + m[i+1]) / 6.;
+    coef[4*i + 2] = m[i] / 2.;
+    coef[4*i + 3] = (m[i+1] - m[i]) / (6.*h);
+  }
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::SetCrossResponse(int pair, int bin, const double * ratios)
+{
+  // the part of the joint response not described by the two dials' own
+  // responses (which must be set first)
+  int d1  = fCross1[pair];
+  int d2  = fCross2[pair];
+  int nk1 = fKnotOffset[d1+1] - fKnotOffset[d1];
+  int nk2 = fKnotOffset[d2+1] - fKnotOffset[d2];
+  double * cross = &fCross[fCrossOffset[pair] + (size_t)bin * nk1 * nk2];
+
+  Locator loc1, loc2;
+  for(int k1 = 0; k1 < nk1; k1++) {
+    this->Locate(d1, fKnots[fKnotOffset[d1] + k1], loc1);
+    double r1 = this->DialValue(d1, bin, loc1);
+    for(int k2 = 0; k2 < nk2; k2++) {
+      this->Locate(d2, fKnots[fKnotOffset[d2] + k2], loc2);
+      double r12 = r1 * this->DialValue(d2, bin, loc2);
+      cross[k1*nk2 + k2] = (r12 != 0.) ? ratios[k1*nk2 + k2] / r12 : 1.;
+    }
+  }
+}
+//____________________________________________________________________________
+int GReWeightIOBinResponse::DialIndex(const string & name) const
+{
+  for(unsigned int i = 0; i < fDials.size(); i++) {
+    if(fDials[i] == name) return i;
+  }
+  return -1;
+}
+//____________________________________________________________________________
+vector<double> GReWeightIOBinResponse::Knots(int dial) const
+{
+  return vector<double>(fKnots.begin() + fKnotOffset[dial], fKnots.begin() + fKnotOffset[dial+1]);
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::Locate(int dial, double x, Locator & loc) const
+{
+  const double * k = &fKnots[fKnotOffset[dial]];
+  int n = fKnotOffset[dial+1] - fKnotOffset[dial];
+
+  if(x < k[0])   x = k[0];
+  if(x > k[n-1]) x = k[n-1];
+  int i = 0;
+  while(i < n-2 && x > k[i+1]) i++;
+  loc.Interval = i;
+  loc.T        = x - k[i];
+  loc.F        = loc.T / (k[i+1] - k[i]);
+}
+//____________________________________________________________________________
+double GReWeightIOBinResponse::DialValue(int dial, int bin, const Locator & loc) const
+{
+  int nint = fKnotOffset[dial+1] - fKnotOffset[dial] - 1;
+  const double * c = &fSpline[fSplineOffset[dial] + ((size_t)bin * nint + loc.Interval) * 4];
+  double t = loc.T;
+  return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+//____________________________________________________________________________
+double GReWeightIOBinResponse::CrossValue(
+   int pair, int bin, const Locator & loc1, const Locator & loc2) const
+{
+  int nk1 = fKnotOffset[fCross1[pair]+1] - fKnotOffset[fCross1[pair]];
+  int nk2 = fKnotOffset[fCross2[pair]+1] - fKnotOffset[fCross2[pair]];
+  const double * g = &fCross[fCrossOffset[pair] + (size_t)bin * nk1 * nk2];
+  int i = loc1.Interval;
+  int j = loc2.Interval;
+  double f = loc1.F;
+  double e = loc2.F;
+  return (1.-f) * ((1.-e) * g[ i   *nk2 + j] + e * g[ i   *nk2 + j+1])
+       +     f  * ((1.-e) * g[(i+1)*nk2 + j] + e * g[(i+1)*nk2 + j+1]);
+}
+//____________________________________________________________________________
+void GReWeightIOBinResponse::Evaluate(const double * dials, double * expected) const
+{
+  int ndials = this->NDials();
+  vector<Locator> loc(ndials);
+  for(int d = 0; d < ndials; d++) this->Locate(d, dials[d], loc[d]);
+
+  int ncross = this->NCross();
+  for(int b = 0; b < fNBins; b++) {
+    double r = 1.;
+    for(int d = 0; d < ndials; d++) r *= this->DialValue(d, b, loc[d]);
+    for(int p = 0; p < ncross; p++) r *= this->CrossValue(p, b, loc[fCross1[p]], loc[fCross2[p]]);
+    expected[b] = fNominal[b] * r;
+  }
+}
+//____________________________________________________________________________
+double GReWeightIOBinResponse::Response(int bin, const double * dials) const
+{
+  int ndials = this->NDials();
+  vector<Locator> loc(ndials);
+  for(int d = 0; d < ndials; d++) this->Locate(d, dials[d], loc[d]);
+
+  double r = 1.;
+  for(int d = 0; d < ndials; d++) r *= this->DialValue(d, bin, loc[d]);
+  for(int p = 0; p < this->NCross(); p++) {
+    r *= this->CrossValue(p, bin, loc[fCross1[p]], loc[fCross2[p]]);
+  }
+  return r;
+}
+//____________________________________________________________________________
@@ -0,0 +1,105 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOBinResponse
+
+\brief    Response functions of the expected counts of a set of analysis bins
+          to a set of tweak dials, for template fits that need each bin's
+          prediction as a function of the dials rather than event weights
+          (see grwghtbinresp).
+
+          Each bin's prediction is its nominal count times, for each dial,
+          a natural cubic spline through the ratios (to nominal) of the
+          counts at the dial's knots, and, for each pair of dials declared
+          correlated, a bilinear interpolation over the knot grid of the
+          part of the joint response the two splines do not describe:
+
+            N_b(x) = N0_b * prod_d S_bd(x_d) * prod_(d,e) C_bde(x_d, x_e)
+
+          Dial values outside their knot range are clamped to it.
+          Evaluate() locates the dial values among the knots once and then
+          costs a few multiplications per bin, so fits scale with the
+          number of bins rather than the number of events.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_BIN_RESPONSE_H_
+#define _G_REWEIGHT_IO_BIN_RESPONSE_H_
+
+#include <string>
+#include <vector>
+
+#include <TObject.h>
+
+class TRootIOCtor;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightIOBinResponse : public TObject {
+
+public:
+  GReWeightIOBinResponse();
+  GReWeightIOBinResponse(TRootIOCtor *);
+ ~GReWeightIOBinResponse() {}
+
+  // building
+  void SetBinning       (const std::string & spec, int nbins);              ///< binning description & # of bins (call first)
+  int  AddDial          (const std::string & name, const std::vector<double> & knots); ///< returns the dial index
+  int  AddCross         (int dial1, int dial2);                             ///< returns the pair index
+  void SetNominal       (int bin, double count);
+  void SetDialResponse  (int dial, int bin, const double * ratios);         ///< count ratio to nominal at each knot
+  void SetCrossResponse (int pair, int bin, const double * ratios);         ///< joint count ratio to nominal, [knot1 * nknots2 + knot2]
+
+  // reading
+  const std::string &   Binning   (void)  const { return fBinning;       }
+  int                   NBins     (void)  const { return fNBins;         }
+  int                   NDials    (void)  const { return fDials.size();  }
+  int                   NCross    (void)  const { return fCross1.size(); }
+  const std::string &   Dial      (int i) const { return fDials[i];      }
+  int                   DialIndex (const std::string & name) const;       ///< -1 if unknown
+  std::vector<double>   Knots     (int dial) const;
+  double                Nominal   (int bin)  const { return fNominal[bin]; }
+
+  void   Evaluate (const double * dials, double * expected) const; ///< expected counts of all bins, at dial values dials[NDials()]
+  double Response (int bin, const double * dials) const;           ///< ratio to nominal of a single bin
+
+private:
+
+  // where a dial value falls among the knots
+  struct Locator {
+    int    Interval;  ///< knot interval
+    double T;         ///< offset from the interval's first knot
+    double F;         ///< fraction of the interval
+  };
+  void   Locate     (int dial, double x, Locator & loc) const;
+  double DialValue  (int dial, int bin, const Locator & loc) const;
+  double CrossValue (int pair, int bin, const Locator & loc1, const Locator & loc2) const;
+
+  std::string              fBinning;      ///< binning specification
+  int                      fNBins;
+  std::vector<double>      fNominal;      ///< [bin]
+  std::vector<std::string> fDials;        ///< dial names
+  std::vector<double>      fKnots;        ///< all dials' knots
+  std::vector<int>         fKnotOffset;   ///< [dial] first knot in fKnots, plus an end marker
+  std::vector<double>      fSpline;       ///< [dial][bin][interval][4] cubic coefficients, in the offset from the interval's first knot
+  std::vector<int>         fSplineOffset; ///< [dial] first coefficient in fSpline
+  std::vector<int>         fCross1;       ///< [pair] first dial
+  std::vector<int>         fCross2;       ///< [pair] second dial
+  std::vector<double>      fCross;        ///< [pair][bin][knot1][knot2] residual joint response
+  std::vector<int>         fCrossOffset;  ///< [pair] first value in fCross
+
+ClassDef(GReWeightIOBinResponse,1)
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
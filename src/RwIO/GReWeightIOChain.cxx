@@ -0,0 +1,164 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOChain.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  vector<string> Tokens(const string & line)
+  {
+    vector<string> tokens;
+    string token;
+    for(size_t i = 0; i <= line.size(); i++) {
+      char c = (i < line.size()) ? line[i] : ' ';
+      if(c == ' ' || c == '\t' || c == ',' || c == '\r') {
+        if(token.size() > 0) tokens.push_back(token);
+        token = "";
+      } else {
+        token += c;
+      }
+    }
+    return tokens;
+  }
+  bool IsNumber(const string & token, double & value)
+  {
+    char * end = 0;
+    value = strtod(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0';
+  }
+}
+//____________________________________________________________________________
+GReWeightIOChain::GReWeightIOChain() :
+fNDials(0)
+{
+
+}
+//____________________________________________________________________________
+bool GReWeightIOChain::Read(
+  const string & filename, const vector<GSyst_t> & systs, string & error)
+{
+  fNDials = systs.size();
+  fStates      .clear();
+  fMultiplicity.clear();
+  fStateOf     .clear();
+
+  std::ifstream in(filename.c_str());
+  if(!in.good()) {
+    error = "can not open chain file " + filename;
+    return false;
+  }
+
+  // column of each dial (in the given order, unless named by a header)
+  vector<int> column(fNDials);
+  for(int i = 0; i < fNDials; i++) column[i] = i;
+  int ncolumns = fNDials;
+
+  std::map<vector<double>, int> index;  // state -> # in the order of appearance
+  vector<double> state(fNDials);
+  string line;
+  int    iline  = 0;
+  bool   header = true;
+  while(std::getline(in, line)) {
+    iline++;
+    vector<string> tokens = Tokens(line);
+    if(tokens.size() == 0 || tokens[0][0] == '#') continue;
+
+    std::ostringstream where;
+    where << filename << ":" << iline << ": ";
+
+    // the first line may name the columns
+    double value = 0.;
+    if(header && !IsNumber(tokens[0], value)) {
+      ncolumns = tokens.size();
+      for(int i = 0; i < fNDials; i++) {
+        column[i] = -1;
+        for(unsigned int j = 0; j < tokens.size(); j++) {
+          if(GSyst::FromString(tokens[j]) == systs[i]) column[i] = j;
+        }
+        if(column[i] < 0) {
+          error = where.str() + "no column for " + GSyst::AsString(systs[i]);
+          return false;
+        }
+      }
+      header = false;
+      continue;
+    }
+    header = false;
+
+    if((int)tokens.size() != ncolumns) {
+      std::ostringstream msg;
+      msg << where.str() << tokens.size() << " values instead of " << ncolumns;
+      error = msg.str();
+      return false;
+    }
+    for(int i = 0; i < fNDials; i++) {
+      if(!IsNumber(tokens[column[i]], state[i])) {
+        error = where.str() + "not a number: " + tokens[column[i]];
+        return false;
+      }
+    }
+
+    std::map<vector<double>, int>::const_iterator it = index.find(state);
+    int istate = 0;
+    if(it != index.end()) {
+      istate = it->second;
+      fMultiplicity[istate]++;
+    } else {
+      istate = fMultiplicity.size();
+      index[state] = istate;
+      fStates.insert(fStates.end(), state.begin(), state.end());
+      fMultiplicity.push_back(1);
+    }
+    fStateOf.push_back(istate);
+  }
+
+  if(fStateOf.size() == 0) {
+    error = "no samples in chain file " + filename;
+    return false;
+  }
+
+  LOG("ReW", pNOTICE)
+    << "Chain " << filename << ": " << this->NSamples() << " samples in "
+    << this->NStates() << " distinct states (repeat factor "
+    << this->RepeatFactor() << ")";
+  return true;
+}
+//____________________________________________________________________________
+double GReWeightIOChain::RepeatFactor(void) const
+{
+  return (this->NStates() > 0) ? double(this->NSamples()) / this->NStates() : 0.;
+}
+//____________________________________________________________________________
+string GReWeightIOChain::Digest(void) const
+{
+  std::ostringstream digest;
+  digest.precision(17);
+  for(int is = 0; is < this->NStates(); is++) {
+    for(int id = 0; id < fNDials; id++) digest << this->Dial(is, id) << " ";
+    digest << "x" << fMultiplicity[is] << "\n";
+  }
+  digest << "samples:";
+  for(unsigned int i = 0; i < fStateOf.size(); i++) digest << " " << fStateOf[i];
+  return digest.str();
+}
+//____________________________________________________________________________
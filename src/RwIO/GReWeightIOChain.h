@@ -0,0 +1,72 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOChain
+
+\brief    Reads a table of tweak dial vectors (eg the samples of a Markov
+          chain exploring a fit posterior) from a text file and reduces it
+          to its distinct states, each with its multiplicity, so that each
+          state is reweighted once however often the chain repeats it.
+
+          One sample per line, the dial values separated by spaces, tabs or
+          commas; empty lines and lines starting with `#' are skipped. An
+          optional first line of systematic names (as GSyst::AsString())
+          gives the column of each dial, in which case further columns
+          (eg the chain's log-likelihood) are ignored; otherwise the columns
+          are the dials in the order given to Read().
+
+          States keep the order of their first appearance in the chain.
+          StateOf() maps each sample back to its state, to expand per-state
+          results to the full chain.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_CHAIN_H_
+#define _G_REWEIGHT_IO_CHAIN_H_
+
+#include <string>
+#include <vector>
+
+#include "RwFramework/GSyst.h"
+
+namespace genie {
+namespace rew   {
+
+class GReWeightIOChain {
+
+public:
+  GReWeightIOChain();
+ ~GReWeightIOChain() {}
+
+  bool Read (const std::string & filename, const std::vector<GSyst_t> & systs,
+             std::string & error);                                    ///< read & deduplicate a chain
+
+  int  NSamples     (void)  const { return fStateOf.size();      }   ///< # of chain samples
+  int  NStates      (void)  const { return fMultiplicity.size(); }   ///< # of distinct states
+  int  NDials       (void)  const { return fNDials;              }
+  double Dial       (int istate, int idial) const { return fStates[(size_t)istate * fNDials + idial]; }
+  int  Multiplicity (int istate) const { return fMultiplicity[istate]; } ///< # of samples in a state
+  int  StateOf      (int isample) const { return fStateOf[isample]; }    ///< state of a sample
+
+  double      RepeatFactor (void) const;   ///< samples per state
+  std::string Digest       (void) const;   ///< canonical text of the states, multiplicities & sample order
+
+private:
+
+  int                 fNDials;
+  std::vector<double> fStates;         ///< [state][dial]
+  std::vector<int>    fMultiplicity;   ///< [state]
+  std::vector<int>    fStateOf;        ///< [sample]
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
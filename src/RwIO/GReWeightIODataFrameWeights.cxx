@@ -0,0 +1,205 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+#include <mutex>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Ntuple/NtpMCEventRecord.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIODataFrameWeights.h"
+#include "RwFramework/GReWeight.h"
+#include "RwFramework/GSystSet.h"
+
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  // building calculators goes through GENIE's shared algorithm factory
+  // and configuration pool
+  std::mutex gBuildMutex;
+  // taken around weight calculations when serialized
+  std::mutex gCalcMutex;
+}
+//____________________________________________________________________________
+GReWeightIODataFrameWeights::GReWeightIODataFrameWeights(
+   Setup_t setup, unsigned int nslots) :
+fSetup      (setup),
+fSerialized (true)
+{
+  assert(fSetup);
+  Slot empty;
+  empty.Central = 0;
+  fSlots.assign(nslots > 0 ? nslots : 1, empty);
+}
+//____________________________________________________________________________
+GReWeightIODataFrameWeights::~GReWeightIODataFrameWeights()
+{
+  for(unsigned int is = 0; is < fSlots.size(); is++) {
+    delete fSlots[is].Central;
+    for(unsigned int iu = 0; iu < fSlots[is].Universes.size(); iu++) {
+      delete fSlots[is].Universes[iu];
+    }
+  }
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::SetDial(GSyst_t syst, double twk)
+{
+  for(unsigned int is = 0; is < fSlots.size(); is++) {
+    if(fSlots[is].Central || fSlots[is].Universes.size() > 0) {
+      LOG("ReW", pERROR)
+        << "Dial values must be set before the weights are first calculated";
+      return;
+    }
+  }
+  for(unsigned int i = 0; i < fCentral.size(); i++) {
+    if(fCentral[i].first == syst) {
+      fCentral[i].second = twk;
+      return;
+    }
+  }
+  fCentral.push_back(std::make_pair(syst, twk));
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::AddUniverse(const Dials_t & dials)
+{
+  for(unsigned int is = 0; is < fSlots.size(); is++) {
+    if(fSlots[is].Universes.size() > 0) {
+      LOG("ReW", pERROR)
+        << "Universes must be added before the weights are first calculated";
+      return;
+    }
+  }
+  fUniverses.push_back(dials);
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::AddUniverse(GSyst_t syst, double twk)
+{
+  this->AddUniverse(Dials_t(1, std::make_pair(syst, twk)));
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::Build(void)
+{
+  for(unsigned int is = 0; is < fSlots.size(); is++) {
+    this->BuildSlot(is, true);
+  }
+}
+//____________________________________________________________________________
+GReWeight * GReWeightIODataFrameWeights::Create(const Dials_t & dials)
+{
+  GReWeight * rw = new GReWeight;
+  fSetup(*rw);
+
+  // central values first, then the universe's own
+  GSystSet & syst = rw->Systematics();
+  for(unsigned int i = 0; i < fCentral.size(); i++) {
+    syst.Set(fCentral[i].first, fCentral[i].second);
+  }
+  for(unsigned int i = 0; i < dials.size(); i++) {
+    syst.Set(dials[i].first, dials[i].second);
+  }
+  rw->Reconfigure();
+  return rw;
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::BuildSlot(unsigned int slot, bool universes)
+{
+  assert(slot < fSlots.size());
+  Slot & s = fSlots[slot];
+  if(s.Central && (!universes || s.Universes.size() == fUniverses.size())) return;
+
+  std::lock_guard<std::mutex> lock(gBuildMutex);
+  if(!s.Central) {
+    LOG("ReW", pNOTICE) << "Building the weight calculators of slot " << slot;
+    s.Central = this->Create(Dials_t());
+  }
+  if(universes) {
+    while(s.Universes.size() < fUniverses.size()) {
+      s.Universes.push_back(this->Create(fUniverses[s.Universes.size()]));
+    }
+  }
+}
+//____________________________________________________________________________
+double GReWeightIODataFrameWeights::Calc(GReWeight & rw, const EventRecord & event)
+{
+  if(!fSerialized) return rw.CalcWeight(event);
+
+  std::lock_guard<std::mutex> lock(gCalcMutex);
+  return rw.CalcWeight(event);
+}
+//____________________________________________________________________________
+double GReWeightIODataFrameWeights::Weight(
+   unsigned int slot, const EventRecord & event)
+{
+  this->BuildSlot(slot, false);
+  return this->Calc(*fSlots[slot].Central, event);
+}
+//____________________________________________________________________________
+double GReWeightIODataFrameWeights::Weight(
+   unsigned int slot, const NtpMCEventRecord & rec)
+{
+  if(!rec.event) return 1.;
+  return this->Weight(slot, *rec.event);
+}
+//____________________________________________________________________________
+void GReWeightIODataFrameWeights::Weights(
+   unsigned int slot, const EventRecord & event, vector<double> & w)
+{
+  this->BuildSlot(slot, true);
+  Slot & s = fSlots[slot];
+  w.resize(s.Universes.size());
+  for(unsigned int iu = 0; iu < s.Universes.size(); iu++) {
+    w[iu] = this->Calc(*s.Universes[iu], event);
+  }
+}
+//____________________________________________________________________________
+vector<double> GReWeightIODataFrameWeights::Weights(
+   unsigned int slot, const NtpMCEventRecord & rec)
+{
+  vector<double> w;
+  if(!rec.event) {
+    w.assign(fUniverses.size(), 1.);
+    return w;
+  }
+  this->Weights(slot, *rec.event, w);
+  return w;
+}
+//____________________________________________________________________________
+std::function<double (unsigned int, const NtpMCEventRecord &)>
+   GReWeightIODataFrameWeights::WeightFunctor(void)
+{
+  GReWeightIODataFrameWeights * self = this;
+  return [self](unsigned int slot, const NtpMCEventRecord & rec) {
+    return self->Weight(slot, rec);
+  };
+}
+//____________________________________________________________________________
+#ifdef __GENIE_REWEIGHT_RVEC_ENABLED__
+ROOT::VecOps::RVec<double> GReWeightIODataFrameWeights::UniverseWeights(
+   unsigned int slot, const NtpMCEventRecord & rec)
+{
+  vector<double> w = this->Weights(slot, rec);
+  return ROOT::VecOps::RVec<double>(w.begin(), w.end());
+}
+//____________________________________________________________________________
+std::function<ROOT::VecOps::RVec<double> (unsigned int, const NtpMCEventRecord &)>
+   GReWeightIODataFrameWeights::UniversesFunctor(void)
+{
+  GReWeightIODataFrameWeights * self = this;
+  return [self](unsigned int slot, const NtpMCEventRecord & rec) {
+    return self->UniverseWeights(slot, rec);
+  };
+}
+//____________________________________________________________________________
+#endif
@@ -0,0 +1,124 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIODataFrameWeights
+
+\brief    Computes GENIE weights inline in a ROOT RDataFrame analysis of a
+          GHEP event tree, so that no intermediate weights file is needed:
+
+            ROOT::EnableImplicitMT();
+            ROOT::RDataFrame df("gtree", "events.ghep.root");
+            GReWeightIODataFrameWeights rw(setup, df.GetNSlots());
+            rw.SetDial(kXSecTwkDial_MaCCQE, 0.5);          // central values
+            rw.AddUniverse(kXSecTwkDial_MaCCQE, -1.);       // universes
+            rw.AddUniverse(kXSecTwkDial_MaCCQE, +1.);
+            auto d = df.DefineSlot("w",  rw.WeightFunctor(),    {"gmcrec"})
+                       .DefineSlot("wu", rw.UniversesFunctor(), {"gmcrec"});
+
+          where setup is a function adopting the weight calculators into a
+          GReWeight (and setting their modes or uncertainties, if needed).
+
+          Each RDataFrame slot gets its own, independent, GReWeight for the
+          central dial values and one for each universe, configured once,
+          so no reconfiguration happens in the event loop and slots never
+          share a calculator. They are built on first use by each slot
+          (one at a time, as building calculators goes through GENIE's
+          shared algorithm factory) or up-front with Build().
+          Building costs one set of calculators per slot and universe.
+
+          Some calculators still use shared GENIE objects when computing
+          weights (eg the nuclear models of nuclear_qe, the cross section
+          models of the event generation threads), so by default the weight
+          calculations of all slots take turns (the event reading, decoding
+          and the rest of the analysis still run in parallel).
+          SetSerialized(false) opts out, letting the slots weight events
+          concurrently: only for calculators known to use no shared GENIE
+          object when computing weights (see GReWeightServices).
+
+          The object must outlive the event loops using its functors.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_DATA_FRAME_WEIGHTS_H_
+#define _G_REWEIGHT_IO_DATA_FRAME_WEIGHTS_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,14,0)
+#include <ROOT/RVec.hxx>
+#define __GENIE_REWEIGHT_RVEC_ENABLED__
+#endif
+
+// GENIE/Reweight includes
+#include "RwFramework/GSyst.h"
+
+namespace genie {
+
+class EventRecord;
+class NtpMCEventRecord;
+
+namespace rew   {
+
+class GReWeight;
+
+class GReWeightIODataFrameWeights {
+
+public:
+  typedef std::function<void (GReWeight &)> Setup_t;
+  typedef std::vector< std::pair<GSyst_t, double> > Dials_t;
+
+  GReWeightIODataFrameWeights(Setup_t setup, unsigned int nslots);
+ ~GReWeightIODataFrameWeights();
+
+  void SetDial       (GSyst_t syst, double twk);         ///< central dial value (default: 0)
+  void AddUniverse   (const Dials_t & dials);             ///< a universe: dial values on top of the central ones
+  void AddUniverse   (GSyst_t syst, double twk);          ///< a universe differing in a single dial
+  void SetSerialized (bool serialized) { fSerialized = serialized; } ///< let weight calculations take turns? (default: true)
+  void Build         (void);                              ///< build the calculators of all slots now
+
+  unsigned int NSlots     (void) const { return fSlots.size();     }
+  unsigned int NUniverses (void) const { return fUniverses.size(); }
+
+  double              Weight  (unsigned int slot, const EventRecord & event);                        ///< weight at the central dial values
+  double              Weight  (unsigned int slot, const NtpMCEventRecord & rec);
+  void                Weights (unsigned int slot, const EventRecord & event, std::vector<double> & w); ///< weight in each universe
+  std::vector<double> Weights (unsigned int slot, const NtpMCEventRecord & rec);
+
+  std::function<double (unsigned int, const NtpMCEventRecord &)> WeightFunctor (void);
+#ifdef __GENIE_REWEIGHT_RVEC_ENABLED__
+  ROOT::VecOps::RVec<double> UniverseWeights (unsigned int slot, const NtpMCEventRecord & rec);
+  std::function<ROOT::VecOps::RVec<double> (unsigned int, const NtpMCEventRecord &)> UniversesFunctor (void);
+#endif
+
+private:
+
+  struct Slot {
+    GReWeight *              Central;   ///< calculators at the central dial values
+    std::vector<GReWeight *> Universes; ///< calculators of each universe
+  };
+
+  GReWeight * Create    (const Dials_t & dials);
+  void        BuildSlot (unsigned int slot, bool universes);
+  double      Calc      (GReWeight & rw, const EventRecord & event);
+
+  Setup_t              fSetup;       ///< adopts the weight calculators into a GReWeight
+  Dials_t              fCentral;     ///< central dial values
+  std::vector<Dials_t> fUniverses;   ///< dial values of each universe (on top of the central ones)
+  std::vector<Slot>    fSlots;       ///< per RDataFrame slot
+  bool                 fSerialized;  ///< let weight calculations take turns?
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,151 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+
+#include <TTree.h>
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/Ntuple/NtpMCEventRecord.h"
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOEventBuffer.h"
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwFramework/GReWeightEventView.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+//____________________________________________________________________________
+GReWeightIOEventBuffer::GReWeightIOEventBuffer(
+   TTree * tree, unsigned int capacity) :
+fTree     (tree),
+fMCRec    (0),
+fGst      (0),
+fCapacity (TMath::Max(capacity, 1u)),
+fViews    (false),
+fRecords  (true)
+{
+  assert(fTree);
+  if(GReWeightIOGstReader::IsGstTree(fTree)) {
+    fGst = new GReWeightIOGstReader(fTree);
+  } else {
+    fTree->SetBranchAddress("gmcrec", &fMCRec);
+  }
+
+  fEvents .reserve(fCapacity);
+  fEntries.reserve(fCapacity);
+}
+//____________________________________________________________________________
+GReWeightIOEventBuffer::~GReWeightIOEventBuffer()
+{
+  this->Clear();
+  for(unsigned int i = 0; i < fViewList.size(); i++) {
+    delete fViewList[i];
+  }
+  if(fGst) {
+    delete fGst;
+    return;
+  }
+  if(fTree) fTree->ResetBranchAddresses();
+  delete fMCRec;
+}
+//____________________________________________________________________________
+unsigned int GReWeightIOEventBuffer::Fill(Long64_t first, Long64_t last)
+{
+  return this->Read(first, last, 0, 0);
+}
+//____________________________________________________________________________
+unsigned int GReWeightIOEventBuffer::Fill(
+   Long64_t first, Long64_t last, const std::vector<bool> & keep, Long64_t offset)
+{
+  return this->Read(first, last, &keep, offset);
+}
+//____________________________________________________________________________
+unsigned int GReWeightIOEventBuffer::Read(
+   Long64_t first, Long64_t last, const std::vector<bool> * keep, Long64_t offset)
+{
+  this->Clear();
+
+  Long64_t nentries = fTree->GetEntries();
+  Long64_t stop = TMath::Min(last, first + (Long64_t)fCapacity - 1);
+  stop = TMath::Min(stop, nentries - 1);
+
+  for(Long64_t ientry = first; ientry <= stop; ientry++) {
+    if(keep && !(*keep)[ientry - offset]) continue;
+    if(fGst && fViews && !fRecords) {
+      // decoded straight from the gst branch buffers, with no event record
+      if(!fGst->ReadEventView(ientry, *this->NextView())) continue;
+      fEntries.push_back(ientry);
+      continue;
+    }
+    if(fGst) {
+      EventRecord * event = fGst->ReadEvent(ientry);
+      if(!event) continue;
+      if(fViews) *this->NextView() = fGst->LastView();
+      fEvents .push_back(new EventRecord(*event));
+      fEntries.push_back(ientry);
+      continue;
+    }
+    if(fTree->GetEntry(ientry) <= 0) {
+      LOG("ReW", pWARN) << "Could not read entry " << ientry;
+      continue;
+    }
+    if(fViews) this->NextView()->Fill(*(fMCRec->event));
+    fEvents .push_back(new EventRecord(*(fMCRec->event)));
+    fEntries.push_back(ientry);
+    fMCRec->Clear();
+  }
+
+  LOG("ReW", pINFO)
+    << "Buffered " << fEntries.size() << " events in [" << first << ", " << stop << "]";
+
+  return fEntries.size();
+}
+//____________________________________________________________________________
+void GReWeightIOEventBuffer::Clear(void)
+{
+  std::vector<EventRecord *>::iterator it = fEvents.begin();
+  for( ; it != fEvents.end(); ++it) {
+    delete *it;
+  }
+  fEvents .clear();
+  fEntries.clear();
+}
+//____________________________________________________________________________
+const EventRecord & GReWeightIOEventBuffer::Event(unsigned int i) const
+{
+  assert(this->HasRecords() && i < fEvents.size());
+  return *(fEvents[i]);
+}
+//____________________________________________________________________________
+Long64_t GReWeightIOEventBuffer::Entry(unsigned int i) const
+{
+  assert(i < fEntries.size());
+  return fEntries[i];
+}
+//____________________________________________________________________________
+const GReWeightEventView & GReWeightIOEventBuffer::View(unsigned int i) const
+{
+  assert(fViews && i < fEntries.size());
+  return *(fViewList[i]);
+}
+//____________________________________________________________________________
+GReWeightEventView * GReWeightIOEventBuffer::NextView(void)
+{
+// view of the event about to be buffered (views are reused from fill to fill)
+//
+  unsigned int i = fEntries.size();
+  if(i == fViewList.size()) fViewList.push_back(new GReWeightEventView);
+  return fViewList[i];
+}
+//____________________________________________________________________________
@@ -0,0 +1,94 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOEventBuffer
+
+\brief    Holds a contiguous chunk of decoded events from a GHEP event tree,
+          so that the same events can be reweighted several times (for
+          different tweak dial values or different reweighting setups)
+          while being read from the input file only once.
+          Reads GHEP event trees and, through GReWeightIOGstReader, flat
+          gst summary trees.
+          With SetViews(true) each buffered event is also decoded, once,
+          into a compact GReWeightEventView, so that calculators handling
+          views reweight it again and again without walking the event
+          record. Views of gst events are decoded straight from the branch
+          buffers; with SetRecords(false) as well, no event record is built
+          at all (Event() is then unavailable). GHEP files store each event
+          as a single streamed object, with no branch per particle array to
+          decode views from: the gmcrec branch is always deserialized into
+          a full event record, which the view is filled from, so for GHEP
+          input views save the per-reweighting, not the per-read, cost.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_EVENT_BUFFER_H_
+#define _G_REWEIGHT_IO_EVENT_BUFFER_H_
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class TTree;
+
+namespace genie {
+
+class EventRecord;
+class NtpMCEventRecord;
+
+namespace rew   {
+
+class GReWeightIOGstReader;
+class GReWeightEventView;
+
+class GReWeightIOEventBuffer {
+
+public:
+  GReWeightIOEventBuffer(TTree * tree, unsigned int capacity);
+ ~GReWeightIOEventBuffer();
+
+  unsigned int Fill     (Long64_t first, Long64_t last); ///< read events [first, min(last, first+capacity-1)], returns # of events read
+  unsigned int Fill     (Long64_t first, Long64_t last,
+                         const std::vector<bool> & keep, Long64_t offset); ///< same, skipping entries i with !keep[i-offset]
+  void         Clear    (void);                          ///< drop all buffered events
+  void         SetViews (bool views) { fViews = views; } ///< also decode the events read into event views?
+  bool         HasViews (void) const { return fViews;    }
+  void         SetRecords (bool records) { fRecords = records; } ///< with views, also build the records of gst events? (default: true)
+  bool         HasRecords (void) const { return fRecords || !fViews || !fGst; } ///< is Event() available?
+
+  unsigned int Capacity (void) const { return fCapacity;       }
+  unsigned int NEvents  (void) const { return fEntries.size(); }
+
+  const EventRecord & Event (unsigned int i) const;      ///< i-th buffered event (if HasRecords())
+  Long64_t            Entry (unsigned int i) const;      ///< tree entry of the i-th buffered event
+  const GReWeightEventView & View (unsigned int i) const; ///< view of the i-th buffered event (if HasViews())
+
+  GReWeightIOGstReader * GstReader (void) const { return fGst; } ///< null unless reading a gst tree
+
+private:
+
+  unsigned int         Read     (Long64_t first, Long64_t last, const std::vector<bool> * keep, Long64_t offset);
+  GReWeightEventView * NextView (void);
+
+  TTree *                    fTree;      ///< input GHEP event tree
+  NtpMCEventRecord *         fMCRec;     ///< branch address for the gmcrec branch
+  GReWeightIOGstReader *     fGst;       ///< gst tree reader, if the input is a gst tree
+  unsigned int               fCapacity;  ///< max # of events held in memory
+  std::vector<EventRecord *> fEvents;    ///< owned copies of the buffered events
+  std::vector<Long64_t>      fEntries;   ///< corresponding tree entries
+  bool                       fViews;     ///< decode event views?
+  bool                       fRecords;   ///< build event records (of gst events) along with views?
+  std::vector<GReWeightEventView *> fViewList; ///< views of the buffered events (reused from fill to fill)
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,434 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+
+#include <TMath.h>
+#include <TTree.h>
+#include <TLorentzVector.h>
+#include <TParticlePDG.h>
+
+// GENIE/Generator includes
+#include "Framework/Conventions/Constants.h"
+#include "Framework/Conventions/Units.h"
+#include "Framework/Conventions/KinePhaseSpace.h"
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/GHEP/GHepStatus.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/ParticleData/PDGLibrary.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOGstReader.h"
+#include "RwFramework/GReWeightTracer.h"
+
+using namespace genie;
+using namespace genie::rew;
+using namespace genie::constants;
+
+namespace {
+  // the non-resonance background dials, which need the primary hadronic
+  // system
+  bool IsNonResBkgDial(GSyst_t syst)
+  {
+    switch(syst) {
+      case kXSecTwkDial_RvpCC1pi    :
+      case kXSecTwkDial_RvpCC2pi    :
+      case kXSecTwkDial_RvpNC1pi    :
+      case kXSecTwkDial_RvpNC2pi    :
+      case kXSecTwkDial_RvnCC1pi    :
+      case kXSecTwkDial_RvnCC2pi    :
+      case kXSecTwkDial_RvnNC1pi    :
+      case kXSecTwkDial_RvnNC2pi    :
+      case kXSecTwkDial_RvbarpCC1pi :
+      case kXSecTwkDial_RvbarpCC2pi :
+      case kXSecTwkDial_RvbarpNC1pi :
+      case kXSecTwkDial_RvbarpNC2pi :
+      case kXSecTwkDial_RvbarnCC1pi :
+      case kXSecTwkDial_RvbarnCC2pi :
+      case kXSecTwkDial_RvbarnNC1pi :
+      case kXSecTwkDial_RvbarnNC2pi :
+        return true;
+      default:
+        return false;
+    }
+  }
+}
+//____________________________________________________________________________
+GReWeightIOGstReader::GReWeightIOGstReader(TTree * gst) :
+fTree        (gst),
+fHasXSec     (true),
+fHasHitNucP4 (true),
+fHasPrimHad  (true),
+fHasFinal    (true),
+fEvent       (0)
+{
+  assert(fTree);
+
+  bool required  = true;
+  bool kinematics= true;
+  bool xsec_wght = true;
+
+  // read only what is used
+  fTree->SetBranchStatus("*", 0);
+
+  this->SetAddress("neu",       &fNeu,       required);
+  this->SetAddress("fspl",      &fFspl,      required);
+  this->SetAddress("tgt",       &fTgt,       required);
+  this->SetAddress("Z",         &fZ,         required);
+  this->SetAddress("A",         &fA,         required);
+  this->SetAddress("hitnuc",    &fHitNuc,    required);
+  this->SetAddress("hitqrk",    &fHitQrk,    required);
+  this->SetAddress("resid",     &fResId,     required);
+  this->SetAddress("sea",       &fSea,       required);
+  this->SetAddress("qel",       &fQel,       required);
+  this->SetAddress("mec",       &fMec,       required);
+  this->SetAddress("res",       &fRes,       required);
+  this->SetAddress("dis",       &fDis,       required);
+  this->SetAddress("coh",       &fCoh,       required);
+  this->SetAddress("dfr",       &fDfr,       required);
+  this->SetAddress("imd",       &fImd,       required);
+  this->SetAddress("imdanh",    &fImdAnh,    required);
+  this->SetAddress("nuel",      &fNuEl,      required);
+  this->SetAddress("em",        &fEm,        required);
+  this->SetAddress("cc",        &fCc,        required);
+  this->SetAddress("nc",        &fNc,        required);
+  this->SetAddress("charm",     &fCharm,     required);
+  bool optional = true;
+  fSingleK = fAmNuGamma = false;
+  this->SetAddress("singlek",   &fSingleK,   optional);
+  this->SetAddress("amnugamma", &fAmNuGamma, optional);
+
+  this->SetAddress("xs",   &fXs,   kinematics);
+  this->SetAddress("ys",   &fYs,   kinematics);
+  this->SetAddress("ts",   &fTs,   kinematics);
+  this->SetAddress("Q2s",  &fQ2s,  kinematics);
+  this->SetAddress("Ws",   &fWs,   kinematics);
+  this->SetAddress("Ev",   &fEv,   kinematics);
+  this->SetAddress("pxv",  &fPxv,  kinematics);
+  this->SetAddress("pyv",  &fPyv,  kinematics);
+  this->SetAddress("pzv",  &fPzv,  kinematics);
+  this->SetAddress("El",   &fEl,   kinematics);
+  this->SetAddress("pxl",  &fPxl,  kinematics);
+  this->SetAddress("pyl",  &fPyl,  kinematics);
+  this->SetAddress("pzl",  &fPzl,  kinematics);
+  this->SetAddress("vtxx", &fVtxX, kinematics);
+  this->SetAddress("vtxy", &fVtxY, kinematics);
+  this->SetAddress("vtxz", &fVtxZ, kinematics);
+  this->SetAddress("vtxt", &fVtxT, kinematics);
+
+  this->SetAddress("En",   &fEn,   fHasHitNucP4);
+  this->SetAddress("pxn",  &fPxn,  fHasHitNucP4);
+  this->SetAddress("pyn",  &fPyn,  fHasHitNucP4);
+  this->SetAddress("pzn",  &fPzn,  fHasHitNucP4);
+
+  this->SetAddress("wght",  &fWght,  xsec_wght);
+  this->SetAddress("XSec",  &fXSec,  fHasXSec);
+  this->SetAddress("DXSec", &fDXSec, fHasXSec);
+  this->SetAddress("KPS",   &fKPS,   fHasXSec);
+  fHasXSec = fHasXSec && xsec_wght;
+
+  this->SetAddress("ni",   &fNi,  fHasPrimHad);
+  this->SetAddress("pdgi", fPdgi, fHasPrimHad);
+  this->SetAddress("resc", fResc, fHasPrimHad);
+  this->SetAddress("Ei",   fEi,   fHasPrimHad);
+  this->SetAddress("pxi",  fPxi,  fHasPrimHad);
+  this->SetAddress("pyi",  fPyi,  fHasPrimHad);
+  this->SetAddress("pzi",  fPzi,  fHasPrimHad);
+
+  this->SetAddress("nf",   &fNf,  fHasFinal);
+  this->SetAddress("pdgf", fPdgf, fHasFinal);
+  this->SetAddress("Ef",   fEf,   fHasFinal);
+  this->SetAddress("pxf",  fPxf,  fHasFinal);
+  this->SetAddress("pyf",  fPyf,  fHasFinal);
+  this->SetAddress("pzf",  fPzf,  fHasFinal);
+
+  if(!required || !kinematics) {
+    fError = "The input tree lacks basic gst branches - Is it a gst tree?";
+    LOG("ReW", pERROR) << fError;
+    return;
+  }
+
+  LOG("ReW", pNOTICE)
+    << "Reading flat gst tree with:"
+    << "\n - stored cross sections & weights : " << (fHasXSec    ? "yes" : "no")
+    << "\n - hit nucleon 4-momentum          : " << (fHasHitNucP4 ? "yes" : "no")
+    << "\n - hadrons produced in the nucleus : " << (fHasPrimHad  ? "yes" : "no")
+    << "\n - final state particles           : " << (fHasFinal    ? "yes" : "no");
+}
+//____________________________________________________________________________
+GReWeightIOGstReader::~GReWeightIOGstReader()
+{
+  delete fEvent;
+  if(fTree) {
+    fTree->ResetBranchAddresses();
+    fTree->SetBranchStatus("*", 1);
+  }
+}
+//____________________________________________________________________________
+void GReWeightIOGstReader::SetAddress(
+   const char * name, void * address, bool & found)
+{
+  if(!fTree->GetBranch(name)) {
+    LOG("ReW", pINFO) << "No `" << name << "' branch in the gst tree";
+    found = false;
+    return;
+  }
+  fTree->SetBranchStatus  (name, 1);
+  fTree->SetBranchAddress (name, address);
+}
+//____________________________________________________________________________
+Long64_t GReWeightIOGstReader::GetEntries(void) const
+{
+  return fTree->GetEntries();
+}
+//____________________________________________________________________________
+EventRecord * GReWeightIOGstReader::ReadEvent(Long64_t ientry)
+{
+  GReWeightTraceSpan span("gst ReadEvent", "io");
+
+  delete fEvent;
+  fEvent = 0;
+
+  if(!this->ReadEventView(ientry, fView)) return 0;
+
+  //
+  // Interaction summary
+  //
+
+  int ihitnuc = fView.HitNucleonPosition();
+
+  TLorentzVector p4v (fPxv, fPyv, fPzv, fEv);
+  TLorentzVector p4l (fPxl, fPyl, fPzl, fEl);
+  TLorentzVector x4  (fVtxX, fVtxY, fVtxZ, fVtxT);
+  TLorentzVector p4n (0., 0., 0., 0.);
+  if(ihitnuc >= 0) {
+    p4n.SetPxPyPzE(fView.Px(ihitnuc), fView.Py(ihitnuc), fView.Pz(ihitnuc), fView.E(ihitnuc));
+  }
+
+  InitialState init_state(fTgt, fNeu);
+  ProcessInfo  proc_info (fView.ScatteringTypeId(), fView.InteractionTypeId());
+  Interaction * interaction = new Interaction(init_state, proc_info);
+
+  InitialState * init = interaction->InitStatePtr();
+  init->SetProbeP4(p4v);
+  if(fHitNuc != 0) {
+    init->TgtPtr()->SetHitNucPdg (fHitNuc);
+    init->TgtPtr()->SetHitNucP4  (p4n);
+  }
+  if(fHitQrk != 0) {
+    init->TgtPtr()->SetHitQrkPdg (fHitQrk);
+    init->TgtPtr()->SetHitSeaQrk (fSea);
+  }
+
+  Kinematics * kine = interaction->KinePtr();
+  kine->Setx  (fXs,  true);
+  kine->Sety  (fYs,  true);
+  kine->Sett  (fTs,  true);
+  kine->SetQ2 (fQ2s, true);
+  kine->SetW  (fWs,  true);
+  kine->SetFSLeptonP4 (p4l);
+  kine->SetHadSystP4  (p4n + p4v - p4l);
+
+  XclsTag * xcls = interaction->ExclTagPtr();
+  if(fCharm)                 xcls->SetCharm();
+  if(fRes && fResId >= 0)    xcls->SetResonance((Resonance_t)fResId);
+
+  //
+  // Particle list, as decoded in the view (the record sets the daughters)
+  //
+
+  EventRecord * event = new EventRecord;
+  event->AttachSummary(interaction);
+  event->SetVertex(x4);
+
+  int np = fView.NParticles();
+  for(int i = 0; i < np; i++) {
+    TLorentzVector p4 (fView.Px(i), fView.Py(i), fView.Pz(i), fView.E(i));
+    TLorentzVector v4 (fView.Vx(i), fView.Vy(i), fView.Vz(i), fView.Vt(i));
+    event->AddParticle(fView.Pdg(i), (GHepStatus_t) fView.Status(i),
+       fView.FirstMother(i), fView.LastMother(i), -1, -1, p4, v4);
+    if(fView.RescatterCode(i) != -1) {
+      event->Particle(i)->SetRescatterCode(fView.RescatterCode(i));
+    }
+  }
+
+  //
+  // Stored cross sections & weight
+  //
+
+  if(fHasXSec) {
+    event->SetWeight   (fView.Weight());
+    event->SetXSec     (fView.XSec());
+    event->SetDiffXSec (fView.DiffXSec(), (KinePhaseSpace_t) fKPS);
+  }
+
+  fEvent = event;
+  return fEvent;
+}
+//____________________________________________________________________________
+bool GReWeightIOGstReader::ReadEventView(Long64_t ientry, GReWeightEventView & view)
+{
+  GReWeightTraceSpan span("gst ReadEventView", "io");
+
+  view.Clear();
+
+  if(!this->IsValid()) return false;
+  if(fTree->GetEntry(ientry) <= 0) {
+    LOG("ReW", pWARN) << "Could not read gst entry " << ientry;
+    return false;
+  }
+
+  //
+  // Process & target
+  //
+
+  InteractionType_t itype = kIntNull;
+  if      (fCc) itype = kIntWeakCC;
+  else if (fNc) itype = kIntWeakNC;
+  else if (fEm) itype = kIntEM;
+  else if (fNuEl || fImd || fImdAnh) itype = kIntWeakMix;
+
+  ScatteringType_t stype = kScNull;
+  if      (fQel)       stype = kScQuasiElastic;
+  else if (fRes)       stype = kScResonant;
+  else if (fDis)       stype = kScDeepInelastic;
+  else if (fCoh)       stype = kScCoherentProduction;
+  else if (fMec)       stype = kScMEC;
+  else if (fDfr)       stype = kScDiffractive;
+  else if (fImd)       stype = kScInverseMuDecay;
+  else if (fImdAnh)    stype = kScIMDAnnihilation;
+  else if (fNuEl)      stype = kScNuElectronElastic;
+  else if (fSingleK)   stype = kScSingleKaon;
+  else if (fAmNuGamma) stype = kScAMNuGamma;
+  if(fImd) itype = kIntWeakCC;
+
+  view.SetProcess(itype, stype, fCharm);
+  view.SetTarget (fTgt, fA, fZ, fHitNuc);
+  view.SetKinematics(fXs, fYs, fTs, fQ2s, fWs);
+
+  // hit nucleon 4-momentum (at rest, unless stored)
+  double pxn = 0., pyn = 0., pzn = 0., En = 0.;
+  if(fHitNuc != 0) {
+    TParticlePDG * nucleon = PDGLibrary::Instance()->Find(fHitNuc);
+    En = (nucleon) ? nucleon->Mass() : kNucleonMass;
+    if(fHasHitNucP4) { pxn = fPxn; pyn = fPyn; pzn = fPzn; En = fEn; }
+  }
+
+  //
+  // Particle list
+  //
+
+  bool nuclear = (fA > 1);
+
+  // probe
+  view.AddParticle(fNeu, kIStInitialState, -1, -1, -1, -1,
+     fPxv, fPyv, fPzv, fEv, fVtxX, fVtxY, fVtxZ, fVtxT);
+
+  // target nucleus & hit nucleon
+  int itgt    = -1;
+  int ihitnuc = -1;
+  if(nuclear) {
+    TParticlePDG * nucleus = PDGLibrary::Instance()->Find(fTgt);
+    double M = (nucleus) ? nucleus->Mass() : fA * kNucleonMass;
+    itgt = view.AddParticle(fTgt, kIStInitialState, -1, -1, -1, -1,
+       0., 0., 0., M, fVtxX, fVtxY, fVtxZ, fVtxT);
+    if(fHitNuc != 0) {
+      ihitnuc = view.AddParticle(fHitNuc, kIStNucleonTarget, itgt, -1, -1, -1,
+         pxn, pyn, pzn, En, 0., 0., 0., 0.);
+    }
+  } else {
+    ihitnuc = view.AddParticle(fTgt, kIStInitialState, -1, -1, -1, -1,
+       pxn, pyn, pzn, En, fVtxX, fVtxY, fVtxZ, fVtxT);
+  }
+
+  // primary lepton
+  int ifsl = view.AddParticle(fFspl, kIStStableFinalState, 0, -1, -1, -1,
+     fPxl, fPyl, fPzl, fEl, fVtxX, fVtxY, fVtxZ, fVtxT);
+
+  // hadronic system, as the mother of the primary hadrons in DIS
+  int imom = ihitnuc;
+  if(fDis && ihitnuc >= 0) {
+    imom = view.AddParticle(kPdgHadronicSyst, kIStDISPreFragmHadronicState,
+       ihitnuc, -1, -1, -1,
+       pxn + fPxv - fPxl, pyn + fPyv - fPyl, pzn + fPzv - fPzl, En + fEv - fEl,
+       0., 0., 0., 0.);
+  }
+
+  // hadrons produced in the nucleus (the final state, for free nucleons)
+  if(fHasPrimHad) {
+    int ist = (nuclear) ? kIStHadronInTheNucleus : kIStStableFinalState;
+    int n = TMath::Min(fNi, kNPmax);
+    for(int i = 0; i < n; i++) {
+      view.AddParticle(fPdgi[i], ist, imom, -1, -1, -1,
+         fPxi[i], fPyi[i], fPzi[i], fEi[i], 0., 0., 0., 0., fResc[i]);
+    }
+  }
+
+  // final state particles, after intranuclear rescattering
+  if(fHasFinal && nuclear) {
+    int n = TMath::Min(fNf, kNPmax);
+    for(int i = 0; i < n; i++) {
+      view.AddParticle(fPdgf[i], kIStStableFinalState, 1, -1, -1, -1,
+         fPxf[i], fPyf[i], fPzf[i], fEf[i], 0., 0., 0., 0.);
+    }
+  }
+
+  view.SetPositions(0, itgt, ihitnuc, ifsl);
+
+  //
+  // Stored cross sections & weight
+  //
+
+  if(fHasXSec) {
+    double xsec_units = 1E-38 * units::cm2;
+    view.SetXSec(fWght, fXSec * xsec_units, fDXSec * xsec_units);
+  }
+
+  return true;
+}
+//____________________________________________________________________________
+bool GReWeightIOGstReader::CanReweight(GSyst_t syst, std::string & why) const
+{
+  why = "";
+
+  if(syst == kHadrAGKYTwkDial_xF1pi || syst == kHadrAGKYTwkDial_pT1pi) {
+    why = "needs the hadronization record, which is not stored in gst trees";
+  }
+  else if(syst == kHadrNuclTwkDial_FormZone || GSyst::IsINukeMeanFreePathSystematic(syst)) {
+    why = "needs the positions of hadrons in the nucleus, which are not stored in gst trees";
+  }
+  else if(GSyst::IsINukeFateSystematic(syst)) {
+    if(!fHasPrimHad) why = "needs the hadrons produced in the nucleus (pdgi, resc, Ei, ...)";
+  }
+  else if(syst == kRDcyTwkDial_BR1gamma || syst == kRDcyTwkDial_BR1eta ||
+          syst == kRDcyTwkDial_Theta_Delta2Npi) {
+    why = "needs the resonance decay products, which are not stored in gst trees";
+  }
+  else if(syst == kSystNucl_CCQEPauliSupViaKF || syst == kSystNucl_CCQEMomDistroFGtoSF) {
+    if(!fHasHitNucP4) why = "needs the hit nucleon 4-momentum (En, pxn, ...)";
+  }
+  else if(IsNonResBkgDial(syst)) {
+    if(!fHasPrimHad) why = "needs the primary hadronic system (pdgi, Ei, ...)";
+  }
+  else {
+    // cross section dials
+    if(!fHasXSec) why = "needs the stored cross sections and weight (XSec, DXSec, KPS, wght)";
+  }
+  return (why.size() == 0);
+}
+//____________________________________________________________________________
+bool GReWeightIOGstReader::IsGstTree(TTree * tree)
+{
+  if(!tree) return false;
+  return (tree->GetBranch("neu") && tree->GetBranch("Q2s") && !tree->GetBranch("gmcrec"));
+}
+//____________________________________________________________________________
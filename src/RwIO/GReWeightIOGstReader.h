@@ -0,0 +1,117 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOGstReader
+
+\brief    Reads events from a flat `gst' summary tree (as written by
+          gntpc -f gst) and rebuilds, for each one, the minimal GHEP event
+          record the weight calculators need: the interaction summary
+          (process, probe, target, hit nucleon & quark, selected kinematics,
+          resonance & charm tags), the stored cross sections and weight,
+          and a particle list with the probe, target, hit nucleon, primary
+          lepton, the hadrons produced in the nucleus (with their
+          rescattering codes) and the final state particles.
+          Only the branches it uses are read, which is several times faster
+          than deserializing full NtpMCEventRecord objects.
+          ReadEventView() decodes the same particle list (mothers only, no
+          daughter links) straight from the branch buffers into a reusable
+          GReWeightEventView, with no event record, interaction or particle
+          objects built at all, for weight calculators that handle views.
+          If the tree lacks the basic gst branches, IsValid() is false,
+          Error() says why and no event can be read.
+          The flat format lacks some information (hadron positions in the
+          nucleus, the hadronization and resonance decay history, and, for
+          older files, the stored cross sections). Use CanReweight() to find
+          out, before processing, which systematics can not be reweighted.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_GST_READER_H_
+#define _G_REWEIGHT_IO_GST_READER_H_
+
+#include <string>
+
+#include <Rtypes.h>
+
+// GENIE/Reweight includes
+#include "RwFramework/GSyst.h"
+#include "RwFramework/GReWeightEventView.h"
+
+class TTree;
+
+namespace genie {
+
+class EventRecord;
+
+namespace rew   {
+
+class GReWeightIOGstReader {
+
+public:
+  GReWeightIOGstReader(TTree * gst);
+ ~GReWeightIOGstReader();
+
+  EventRecord * ReadEvent   (Long64_t ientry);        ///< owned by the reader, valid until the next call
+  bool          ReadEventView (Long64_t ientry, GReWeightEventView & view); ///< false if the entry can not be read
+  const GReWeightEventView & LastView (void) const { return fView; } ///< view the last ReadEvent() event was built from
+  bool          CanReweight (GSyst_t syst, std::string & why) const;
+  Long64_t      GetEntries  (void) const;
+  bool          IsValid     (void) const { return fError.size() == 0; } ///< does the tree have the basic gst branches?
+  const std::string & Error (void) const { return fError; }
+
+  static bool   IsGstTree   (TTree * tree);           ///< does it look like a gst tree?
+
+  static const int kNPmax = 250; ///< max # of particles in the gst particle arrays
+
+private:
+
+  void SetAddress (const char * name, void * address, bool & found);
+
+  TTree *     fTree;
+  std::string fError;  ///< why the tree can not be read (empty if it can)
+
+  // what the input provides
+  bool fHasXSec;      ///< XSec, DXSec, KPS & wght
+  bool fHasHitNucP4;  ///< hit nucleon 4-momentum
+  bool fHasPrimHad;   ///< hadrons produced in the nucleus, with rescattering codes
+  bool fHasFinal;     ///< final state particles
+
+  // branch buffers
+  Int_t    fNeu, fFspl, fTgt, fZ, fA, fHitNuc, fHitQrk, fResId;
+  Bool_t   fSea, fQel, fMec, fRes, fDis, fCoh, fDfr, fImd, fImdAnh, fSingleK, fNuEl, fEm, fCc, fNc, fCharm, fAmNuGamma;
+  Double_t fWght, fXs, fYs, fTs, fQ2s, fWs;
+  Double_t fEv, fPxv, fPyv, fPzv;
+  Double_t fEn, fPxn, fPyn, fPzn;
+  Double_t fEl, fPxl, fPyl, fPzl;
+  Double_t fVtxX, fVtxY, fVtxZ, fVtxT;
+  Double_t fXSec, fDXSec;
+  UInt_t   fKPS;
+  Int_t    fNi;
+  Int_t    fPdgi [kNPmax];
+  Int_t    fResc [kNPmax];
+  Double_t fEi   [kNPmax];
+  Double_t fPxi  [kNPmax];
+  Double_t fPyi  [kNPmax];
+  Double_t fPzi  [kNPmax];
+  Int_t    fNf;
+  Int_t    fPdgf [kNPmax];
+  Double_t fEf   [kNPmax];
+  Double_t fPxf  [kNPmax];
+  Double_t fPyf  [kNPmax];
+  Double_t fPzf  [kNPmax];
+
+  EventRecord *      fEvent; ///< the last rebuilt event
+  GReWeightEventView fView;  ///< the last decoded event, from which fEvent is built
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,148 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <sstream>
+
+#include <TRootIOCtor.h>
+#include <TFile.h>
+#include <TUUID.h>
+#include <TMD5.h>
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOShardManifest.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+ClassImp(GReWeightIOShardManifest)
+
+//____________________________________________________________________________
+namespace genie {
+namespace rew   {
+  std::ostream & operator << (
+     std::ostream & stream, const GReWeightIOShardManifest & manifest)
+  {
+    manifest.Print(stream);
+    return stream;
+  }
+}
+}
+//____________________________________________________________________________
+GReWeightIOShardManifest::GReWeightIOShardManifest() :
+TObject(),
+fInputEntries(0),
+fFirstEvent(0),
+fLastEvent(-1),
+fSeed(-1),
+fRunKey(0),
+fSparse(false)
+{
+
+}
+//____________________________________________________________________________
+GReWeightIOShardManifest::GReWeightIOShardManifest(
+   const GReWeightIOShardManifest & m) :
+TObject(),
+fApp(m.fApp),
+fInputFile(m.fInputFile),
+fInputUUID(m.fInputUUID),
+fInputEntries(m.fInputEntries),
+fFirstEvent(m.fFirstEvent),
+fLastEvent(m.fLastEvent),
+fConfig(m.fConfig),
+fConfigHash(m.fConfigHash),
+fSeed(m.fSeed),
+fRunKey(m.fRunKey),
+fTreeNames(m.fTreeNames),
+fSparse(m.fSparse)
+{
+
+}
+//____________________________________________________________________________
+GReWeightIOShardManifest::GReWeightIOShardManifest(TRootIOCtor *) :
+TObject(),
+fInputEntries(0),
+fFirstEvent(0),
+fLastEvent(-1),
+fSeed(-1),
+fRunKey(0),
+fSparse(false)
+{
+
+}
+//____________________________________________________________________________
+void GReWeightIOShardManifest::SetInput(const TFile * input_file, Long64_t nentries)
+{
+  fInputFile    = input_file->GetName();
+  fInputUUID    = input_file->GetUUID().AsString();
+  fInputEntries = nentries;
+}
+//____________________________________________________________________________
+void GReWeightIOShardManifest::SetEventRange(Long64_t first, Long64_t last)
+{
+  fFirstEvent = first;
+  fLastEvent  = last;
+}
+//____________________________________________________________________________
+void GReWeightIOShardManifest::SetConfig(std::string config)
+{
+  fConfig     = config;
+  fConfigHash = GReWeightIOShardManifest::Hash(config);
+}
+//____________________________________________________________________________
+bool GReWeightIOShardManifest::Compatible(
+   const GReWeightIOShardManifest & other, std::string & why) const
+{
+  std::ostringstream msg;
+  if(fApp != other.fApp) {
+    msg << "written by different apps (" << fApp << ", " << other.fApp << ")";
+  }
+  else if(fInputUUID != other.fInputUUID || fInputEntries != other.fInputEntries) {
+    msg << "different input event files (" << fInputFile << " [" << fInputUUID
+        << "], " << other.fInputFile << " [" << other.fInputUUID << "])";
+  }
+  else if(fConfigHash != other.fConfigHash) {
+    msg << "different configurations (" << fConfigHash << ", " << other.fConfigHash << ")";
+  }
+  else if(fSeed != other.fSeed) {
+    msg << "different random number seeds (" << fSeed << ", " << other.fSeed << ")";
+  }
+  else if(fTreeNames != other.fTreeNames || fSparse != other.fSparse) {
+    msg << "different weight trees";
+  }
+  why = msg.str();
+  return (why.size() == 0);
+}
+//____________________________________________________________________________
+void GReWeightIOShardManifest::Print(std::ostream & stream) const
+{
+  stream << "\n [-] Shard written by " << fApp
+         << "\n  |-> Input file     : " << fInputFile
+         << "\n  |-> Input UUID     : " << fInputUUID
+         << "\n  |-> Input entries  : " << fInputEntries
+         << "\n  |-> Event range    : [" << fFirstEvent << ", " << fLastEvent << "]"
+         << "\n  |-> Config hash    : " << fConfigHash
+         << "\n  |-> Random seed    : " << fSeed
+         << "\n  |-> Run key        : " << fRunKey
+         << "\n  |-> Sparse trees   : " << (fSparse ? "yes" : "no")
+         << "\n  |-> Weight trees   : ";
+  for(unsigned int i = 0; i < fTreeNames.size(); i++) {
+    stream << fTreeNames[i] << " ";
+  }
+  stream << "\n";
+}
+//____________________________________________________________________________
+std::string GReWeightIOShardManifest::Hash(const std::string & text)
+{
+  TMD5 md5;
+  md5.Update((const UChar_t *) text.c_str(), text.size());
+  md5.Final();
+  return std::string(md5.AsString());
+}
+//____________________________________________________________________________
@@ -0,0 +1,104 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOShardManifest
+
+\brief    Identifies the piece of work held in a weights file (a `shard') so
+          that the outputs of jobs split over event ranges can be validated
+          and merged (see grwghtmerge).
+          It records the input event file identity (name, UUID and number
+          of entries), the processed event range, a hash of the reweighting
+          configuration, the random number seed used for throws and the
+          names of the weight trees in the shard, and whether these trees
+          hold an entry for every event in the range or only for the events
+          passing a selection (`sparse' trees).
+          Shards can be merged only if they share the same input identity,
+          configuration hash, seed and trees.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_SHARD_MANIFEST_H_
+#define _G_REWEIGHT_IO_SHARD_MANIFEST_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include <TObject.h>
+
+class TFile;
+class TRootIOCtor;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightIOShardManifest;
+std::ostream & operator << (std::ostream & stream, const GReWeightIOShardManifest & manifest);
+
+class GReWeightIOShardManifest : public TObject {
+
+public:
+  GReWeightIOShardManifest();
+  GReWeightIOShardManifest(const GReWeightIOShardManifest & manifest);
+  GReWeightIOShardManifest(TRootIOCtor *);
+ ~GReWeightIOShardManifest() {}
+
+  void SetApp          (std::string app)             { fApp = app;        }
+  void SetInput        (const TFile * input_file, Long64_t nentries);
+  void SetEventRange   (Long64_t first, Long64_t last);
+  void SetConfig       (std::string config);                      ///< canonical configuration text, hashed
+  void SetSeed         (Long64_t seed)               { fSeed = seed;      }
+  void SetRunKey       (int run_key)                 { fRunKey = run_key; }
+  void AddTree         (std::string tree_name)       { fTreeNames.push_back(tree_name); }
+  void SetSparse       (bool sparse)                 { fSparse = sparse;  }
+
+  const std::string &              App          (void) const { return fApp;           }
+  const std::string &              InputFile    (void) const { return fInputFile;     }
+  const std::string &              InputUUID    (void) const { return fInputUUID;     }
+  Long64_t                         InputEntries (void) const { return fInputEntries;  }
+  Long64_t                         FirstEvent   (void) const { return fFirstEvent;    }
+  Long64_t                         LastEvent    (void) const { return fLastEvent;     }
+  Long64_t                         NEvents      (void) const { return fLastEvent - fFirstEvent + 1; }
+  const std::string &              Config       (void) const { return fConfig;        }
+  const std::string &              ConfigHash   (void) const { return fConfigHash;    }
+  Long64_t                         Seed         (void) const { return fSeed;          }
+  int                              RunKey       (void) const { return fRunKey;        }
+  const std::vector<std::string> & TreeNames    (void) const { return fTreeNames;     }
+  bool                             Sparse       (void) const { return fSparse;        }
+
+  bool Compatible (const GReWeightIOShardManifest & other, std::string & why) const; ///< can the two shards be merged?
+  void Print      (std::ostream & stream) const;
+
+  static std::string Hash (const std::string & text); ///< MD5 digest, as a hex string
+
+  friend std::ostream & operator << (std::ostream & stream, const GReWeightIOShardManifest & manifest);
+
+private:
+
+  std::string              fApp;           ///< app that wrote the shard
+  std::string              fInputFile;     ///< input event file name
+  std::string              fInputUUID;     ///< input event file UUID
+  Long64_t                 fInputEntries;  ///< # of entries in the input event tree
+  Long64_t                 fFirstEvent;    ///< first processed event (included)
+  Long64_t                 fLastEvent;     ///< last processed event (included)
+  std::string              fConfig;        ///< canonical configuration text
+  std::string              fConfigHash;    ///< its hash
+  Long64_t                 fSeed;          ///< random number seed used for throws (-1: default)
+  int                      fRunKey;        ///< run key, if any
+  std::vector<std::string> fTreeNames;     ///< weight trees in the shard
+  bool                     fSparse;        ///< trees hold entries for selected events only
+
+ClassDef(GReWeightIOShardManifest,2)
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,305 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+#include <cstdlib>
+#include <sstream>
+
+#include <TDirectory.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TMath.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOUniverseHists.h"
+#include "RwFramework/GReWeightEventSummary.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::rew;
+
+namespace {
+  string Trim(const string & text)
+  {
+    size_t begin = text.find_first_not_of(" \t");
+    if(begin == string::npos) return "";
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+  }
+}
+//____________________________________________________________________________
+GReWeightIOUniverseHists::GReWeightIOUniverseHists(int nuniverses, int nslots) :
+fNUniverses (TMath::Max(nuniverses, 1)),
+fNSlots     (TMath::Max(nslots,     1)),
+fRowSize    (0),
+fSumW       (fNSlots),
+fSumW2      (fNSlots),
+fNominal    (fNSlots),
+fNormW      (fNSlots, vector<double>(fNUniverses, 0.)),
+fNormW2     (fNSlots, vector<double>(fNUniverses, 0.))
+{
+
+}
+//____________________________________________________________________________
+bool GReWeightIOUniverseHists::AddVariable(const string & spec, string & error)
+{
+  error = "";
+
+  // [name=]expression:nbins,min,max
+  size_t colon = spec.rfind(':');
+  if(colon == string::npos) {
+    error = "expected [name=]expression:nbins,min,max, got: " + spec;
+    return false;
+  }
+  string lhs     = spec.substr(0, colon);
+  string binning = spec.substr(colon+1);
+
+  Variable var;
+  size_t eq = lhs.find('=');
+  // `==' belongs to the expression
+  if(eq != string::npos && lhs.compare(eq, 2, "==") != 0 &&
+     (eq == 0 || (lhs[eq-1] != '!' && lhs[eq-1] != '<' && lhs[eq-1] != '>'))) {
+    var.Name       = Trim(lhs.substr(0, eq));
+    var.Expression = Trim(lhs.substr(eq+1));
+  } else {
+    var.Expression = Trim(lhs);
+  }
+  if(var.Name.size() == 0) {
+    std::ostringstream name;
+    name << "h" << fVars.size();
+    var.Name = name.str();
+  }
+  for(unsigned int i = 0; i < var.Name.size(); i++) {
+    char c = var.Name[i];
+    if(!isalnum(c) && c != '_') {
+      error = "invalid histogram name `" + var.Name + "' (use letters, digits & _)";
+      return false;
+    }
+  }
+  for(unsigned int i = 0; i < fVars.size(); i++) {
+    if(fVars[i].Name == var.Name) {
+      error = "duplicate histogram name `" + var.Name + "'";
+      return false;
+    }
+  }
+
+  string cerror;
+  if(!var.Compiled.Compile(var.Expression, cerror) || !var.Compiled.IsSet()) {
+    error = "invalid histogram expression: " + (cerror.size() ? cerror : spec);
+    return false;
+  }
+
+  std::istringstream bins(binning);
+  char comma1 = 0, comma2 = 0;
+  bins >> var.NBins >> comma1 >> var.Min >> comma2 >> var.Max;
+  if(bins.fail() || comma1 != ',' || comma2 != ',' ||
+     var.NBins <= 0 || var.Max <= var.Min) {
+    error = "invalid binning `" + binning + "' (expected nbins,min,max) in: " + spec;
+    return false;
+  }
+
+  var.Offset = fRowSize;
+  fRowSize  += var.NBins + 2;
+  fVars.push_back(var);
+
+  for(int islot = 0; islot < fNSlots; islot++) {
+    fSumW   [islot].assign((size_t)fNUniverses * fRowSize, 0.);
+    fSumW2  [islot].assign((size_t)fNUniverses * fRowSize, 0.);
+    fNominal[islot].assign(fRowSize, 0.);
+  }
+  return true;
+}
+//____________________________________________________________________________
+bool GReWeightIOUniverseHists::AddVariables(const string & specs, string & error)
+{
+  size_t begin = 0;
+  while(begin <= specs.size()) {
+    size_t end = specs.find(';', begin);
+    if(end == string::npos) end = specs.size();
+    string spec = specs.substr(begin, end - begin);
+    if(spec.find_first_not_of(" \t") != string::npos) {
+      if(!this->AddVariable(spec, error)) return false;
+    }
+    begin = end + 1;
+  }
+  if(fVars.size() == 0) {
+    error = "no histogram variables in: " + specs;
+    return false;
+  }
+  return true;
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::FindBins(
+   const GReWeightEventSummary & summary, int * bins) const
+{
+  unsigned int nvars = fVars.size();
+  for(unsigned int iv = 0; iv < nvars; iv++) {
+    const Variable & var = fVars[iv];
+    double x = var.Compiled.Evaluate(summary);
+    int bin = 0;                                   // underflow
+    if      (x >= var.Max) bin = var.NBins + 1;    // overflow
+    else if (x >= var.Min) {
+      bin = 1 + (int) ((x - var.Min) / (var.Max - var.Min) * var.NBins);
+      if(bin > var.NBins) bin = var.NBins;
+    }
+    bins[iv] = var.Offset + bin;
+  }
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::Fill(
+   int slot, int universe, const int * bins, double weight)
+{
+  assert(slot >= 0 && slot < fNSlots);
+  assert(universe >= 0 && universe < fNUniverses);
+
+  double w2 = weight * weight;
+  double * sumw  = &fSumW [slot][(size_t)universe * fRowSize];
+  double * sumw2 = &fSumW2[slot][(size_t)universe * fRowSize];
+  unsigned int nvars = fVars.size();
+  for(unsigned int iv = 0; iv < nvars; iv++) {
+    sumw [bins[iv]] += weight;
+    sumw2[bins[iv]] += w2;
+  }
+  fNormW [slot][universe] += weight;
+  fNormW2[slot][universe] += w2;
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::FillNominal(int slot, const int * bins)
+{
+  assert(slot >= 0 && slot < fNSlots);
+  unsigned int nvars = fVars.size();
+  for(unsigned int iv = 0; iv < nvars; iv++) {
+    fNominal[slot][bins[iv]] += 1.;
+  }
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::Merge(void)
+{
+  for(int islot = 1; islot < fNSlots; islot++) {
+    for(size_t i = 0; i < fSumW[0].size(); i++) {
+      fSumW [0][i] += fSumW [islot][i];
+      fSumW2[0][i] += fSumW2[islot][i];
+      fSumW [islot][i] = 0.;
+      fSumW2[islot][i] = 0.;
+    }
+    for(size_t i = 0; i < fNominal[0].size(); i++) {
+      fNominal[0][i] += fNominal[islot][i];
+      fNominal[islot][i] = 0.;
+    }
+    for(int iu = 0; iu < fNUniverses; iu++) {
+      fNormW [0][iu] += fNormW [islot][iu];
+      fNormW2[0][iu] += fNormW2[islot][iu];
+      fNormW [islot][iu] = 0.;
+      fNormW2[islot][iu] = 0.;
+    }
+  }
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::Truncate(int nuniverses)
+{
+  if(nuniverses < 1 || nuniverses >= fNUniverses) return;
+
+  // universes are stored one after the other
+  fNUniverses = nuniverses;
+  for(int islot = 0; islot < fNSlots; islot++) {
+    fSumW  [islot].resize((size_t)fNUniverses * fRowSize);
+    fSumW2 [islot].resize((size_t)fNUniverses * fRowSize);
+    fNormW [islot].resize(fNUniverses);
+    fNormW2[islot].resize(fNUniverses);
+  }
+}
+//____________________________________________________________________________
+double GReWeightIOUniverseHists::SumW(int universe, int bin) const
+{
+  assert(universe >= 0 && universe < fNUniverses && bin >= 0 && bin < fRowSize);
+  return fSumW[0][(size_t)universe * fRowSize + bin];
+}
+//____________________________________________________________________________
+double GReWeightIOUniverseHists::Nominal(int bin) const
+{
+  assert(bin >= 0 && bin < fRowSize);
+  return fNominal[0][bin];
+}
+//____________________________________________________________________________
+double GReWeightIOUniverseHists::NormW(int universe) const
+{
+  assert(universe >= 0 && universe < fNUniverses);
+  return fNormW[0][universe];
+}
+//____________________________________________________________________________
+void GReWeightIOUniverseHists::Write(TDirectory * dir) const
+{
+  assert(dir);
+  dir->cd();
+
+  for(unsigned int iv = 0; iv < fVars.size(); iv++) {
+    const Variable & var = fVars[iv];
+
+    TH2D h(var.Name.c_str(), (var.Expression + ";" + var.Expression + ";universe").c_str(),
+           var.NBins, var.Min, var.Max, fNUniverses, -0.5, fNUniverses - 0.5);
+    h.SetDirectory(0);
+    h.Sumw2();
+    for(int iu = 0; iu < fNUniverses; iu++) {
+      const double * sumw  = &fSumW [0][(size_t)iu * fRowSize + var.Offset];
+      const double * sumw2 = &fSumW2[0][(size_t)iu * fRowSize + var.Offset];
+      for(int ib = 0; ib <= var.NBins + 1; ib++) {
+        h.SetBinContent (ib, iu+1, sumw[ib]);
+        h.SetBinError   (ib, iu+1, TMath::Sqrt(sumw2[ib]));
+      }
+    }
+    h.SetEntries(0);
+    dir->WriteTObject(&h, var.Name.c_str());
+
+    string nominal_name = var.Name + "_nominal";
+    TH1D hn(nominal_name.c_str(), (var.Expression + ";" + var.Expression).c_str(),
+            var.NBins, var.Min, var.Max);
+    hn.SetDirectory(0);
+    hn.Sumw2();
+    double entries = 0.;
+    for(int ib = 0; ib <= var.NBins + 1; ib++) {
+      double n = fNominal[0][var.Offset + ib];
+      hn.SetBinContent (ib, n);
+      hn.SetBinError   (ib, TMath::Sqrt(n));
+      entries += n;
+    }
+    hn.SetEntries(entries);
+    dir->WriteTObject(&hn, nominal_name.c_str());
+  }
+
+  // normalization sums as a histogram (rather than a vector), so that
+  // outputs of jobs processing different events add up with hadd
+  TH1D hsumw("sumw", "sum of weights;universe", fNUniverses, -0.5, fNUniverses - 0.5);
+  hsumw.SetDirectory(0);
+  hsumw.Sumw2();
+  for(int iu = 0; iu < fNUniverses; iu++) {
+    hsumw.SetBinContent (iu+1, fNormW[0][iu]);
+    hsumw.SetBinError   (iu+1, TMath::Sqrt(fNormW2[0][iu]));
+  }
+  hsumw.SetEntries(0);
+  dir->WriteTObject(&hsumw, "sumw");
+}
+//____________________________________________________________________________
+string GReWeightIOUniverseHists::Specification(void) const
+{
+  std::ostringstream spec;
+  spec.precision(17);
+  for(unsigned int iv = 0; iv < fVars.size(); iv++) {
+    const Variable & var = fVars[iv];
+    if(iv > 0) spec << "; ";
+    spec << var.Name << "=" << var.Expression << ":"
+         << var.NBins << "," << var.Min << "," << var.Max;
+  }
+  return spec.str();
+}
+//____________________________________________________________________________
@@ -0,0 +1,117 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOUniverseHists
+
+\brief    Accumulates, in memory, weighted histograms of event summary
+          quantities for each of a number of universes (parameter throws or
+          tweak dial values), so that jobs which only need such histograms
+          do not have to write, and read back, a weight per event and
+          universe.
+
+          Each histogram variable is given as
+
+            [name=]expression:nbins,min,max
+
+          where expression is evaluated on a GReWeightEventSummary using the
+          GReWeightSelection expression syntax (eg `Ev', `Q2', `Ev-Elep').
+          For every variable the sum of weights and sum of squared weights
+          are kept per bin (including under/overflow) and per universe, and,
+          for every universe, the sum of weights and sum of squared weights
+          of all filled events (the normalization sums).
+          The unit-weight (nominal) histogram of each variable is kept too.
+
+          Accumulation uses independent slots: each filling thread should
+          use its own slot, and Merge() adds all slots up at the end.
+
+          Write() produces, for each variable, a TH2D `<name>' (x: the
+          variable, y: the universe index, with sum-of-squared-weight
+          errors) and a TH1D `<name>_nominal', plus a TH1D `sumw' holding,
+          for each universe, the sum of weights (errors: the square root
+          of the sum of squared weights).
+          All outputs are histograms, so that outputs of jobs processing
+          different events can be added up with hadd.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_UNIVERSE_HISTS_H_
+#define _G_REWEIGHT_IO_UNIVERSE_HISTS_H_
+
+#include <string>
+#include <vector>
+
+// GENIE/Reweight includes
+#include "RwFramework/GReWeightSelection.h"
+
+class TDirectory;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightEventSummary;
+
+class GReWeightIOUniverseHists {
+
+public:
+  GReWeightIOUniverseHists(int nuniverses, int nslots = 1);
+ ~GReWeightIOUniverseHists() {}
+
+  bool AddVariable  (const std::string & spec, std::string & error);  ///< [name=]expression:nbins,min,max
+  bool AddVariables (const std::string & specs, std::string & error); ///< several specs, separated by `;'
+
+  int  NVariables   (void) const { return fVars.size(); }
+  int  NUniverses   (void) const { return fNUniverses;  }
+  int  NSlots       (void) const { return fNSlots;      }
+
+  void FindBins     (const GReWeightEventSummary & summary, int * bins) const;  ///< bin of each variable (bins[NVariables()])
+  void Fill         (int slot, int universe, const int * bins, double weight);  ///< add a weighted event to a universe
+  void FillNominal  (int slot, const int * bins);                               ///< add an event to the unit-weight histograms
+  void Merge        (void);                                                     ///< add all slots into slot 0
+  void Truncate     (int nuniverses);                                          ///< keep only the first nuniverses universes
+  void Write        (TDirectory * dir) const;                                   ///< write the (merged) histograms & sums
+
+  int    NBins   (void) const { return fRowSize; }  ///< # of bins of all variables, incl. under/overflow
+  double SumW    (int universe, int bin) const;      ///< sum of weights in a bin (as given by FindBins), after Merge()
+  double Nominal (int bin) const;                    ///< # of events in a bin, after Merge()
+  double NormW   (int universe) const;               ///< sum of weights of all events, after Merge()
+
+  std::string Specification (void) const;   ///< canonical description of all variables
+
+private:
+
+  struct Variable {
+    std::string        Name;
+    std::string        Expression;
+    GReWeightSelection Compiled;
+    int                NBins;
+    double             Min;
+    double             Max;
+    int                Offset;   ///< of this variable's bins in a universe row
+  };
+
+  int                     fNUniverses;
+  int                     fNSlots;
+  int                     fRowSize;   ///< # of bins (incl. under/overflow) of all variables
+  std::vector<Variable>   fVars;
+
+  // per slot: [universe * fRowSize + bin]
+  std::vector< std::vector<double> > fSumW;
+  std::vector< std::vector<double> > fSumW2;
+  // per slot: [bin]
+  std::vector< std::vector<double> > fNominal;
+  // per slot: [universe]
+  std::vector< std::vector<double> > fNormW;
+  std::vector< std::vector<double> > fNormW2;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
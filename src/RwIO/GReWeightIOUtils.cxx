@@ -0,0 +1,157 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <vector>
+
+#include <TBranch.h>
+#include <TBranchElement.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+#include <TTree.h>
+#include <TMath.h>
+#include <RVersion.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/StringUtils.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOUtils.h"
+
+using namespace genie;
+
+//____________________________________________________________________________
+bool genie::utils::rew::CompressionSettings(std::string spec, int & settings)
+{
+  std::vector<std::string> tokens = utils::str::Split(spec, ":");
+  if(tokens.size() < 1 || tokens.size() > 2) {
+    LOG("ReW", pERROR) << "Invalid compression spec: " << spec;
+    return false;
+  }
+
+  // ROOT compression settings are encoded as 100 * algorithm + level
+  std::string alg = tokens[0];
+  int ialg  = 0;
+  int level = 0;
+  if      (alg == "zlib") { ialg = 1; level = 1; }
+  else if (alg == "lzma") { ialg = 2; level = 5; }
+  else if (alg == "lz4" ) { ialg = 4; level = 4; }
+  else if (alg == "zstd") { ialg = 5; level = 5; }
+  else {
+    LOG("ReW", pERROR) << "Unknown compression algorithm: " << alg;
+    return false;
+  }
+  if(tokens.size() == 2) {
+    level = atoi(tokens[1].c_str());
+  }
+  if(level < 0 || level > 9) {
+    LOG("ReW", pERROR) << "Invalid compression level: " << level;
+    return false;
+  }
+
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,20,0)
+  if(ialg == 5) {
+    LOG("ReW", pWARN)
+      << "ZSTD compression requires ROOT >= 6.20 - Using LZ4 instead";
+    ialg = 4;
+  }
+#endif
+
+  settings = 100*ialg + level;
+  return true;
+}
+//____________________________________________________________________________
+bool genie::utils::rew::SetCompression(TFile * file, std::string spec)
+{
+  if(!file) return false;
+
+  int settings = 0;
+  if(!CompressionSettings(spec, settings)) return false;
+
+  file->SetCompressionSettings(settings);
+
+  LOG("ReW", pNOTICE)
+    << "Output file " << file->GetName() << " compression: "
+    << spec << " (settings " << settings << ")";
+
+  return true;
+}
+//____________________________________________________________________________
+void genie::utils::rew::TuneWeightTree(
+  TTree * tree, Long64_t bytes_per_entry, Int_t basket_size, Long64_t auto_flush)
+{
+  if(!tree) return;
+
+  const Long64_t kMinBasket  = 32000;
+  const Long64_t kMaxBasket  = 16000000;
+  const Long64_t kClusterMem = 16000000;
+
+  bytes_per_entry = TMath::Max(bytes_per_entry, (Long64_t)1);
+
+  if(auto_flush <= 0) {
+    auto_flush = TMath::Max(kClusterMem / bytes_per_entry, (Long64_t)100);
+  }
+  tree->SetAutoFlush(auto_flush);
+
+  if(basket_size > 0) {
+    tree->SetBasketSize("*", basket_size);
+    LOG("ReW", pNOTICE)
+      << "Weights tree " << tree->GetName() << ": auto-flush every "
+      << auto_flush << " entries, basket size " << basket_size << " bytes";
+    return;
+  }
+
+  // Bytes per entry of each branch: from its leaves if of fixed length,
+  // otherwise (TArray objects, variable length arrays) a share of what the
+  // fixed length branches leave of bytes_per_entry, in proportion to the
+  // size of their elements
+  TObjArray * branches = tree->GetListOfBranches();
+  const int nbranches = branches->GetEntriesFast();
+  std::vector<Long64_t> bytes   (nbranches, 0);
+  std::vector<int>      elements(nbranches, 0); // element size of variable branches
+  Long64_t fixed_bytes = 0, variable_elements = 0;
+  for(int ib = 0; ib < nbranches; ib++) {
+    TBranch * branch = (TBranch *) branches->UncheckedAt(ib);
+    TBranchElement * element = dynamic_cast<TBranchElement *>(branch);
+    if(element) {
+      std::string cname = element->GetClassName();
+      elements[ib] = (cname == "TArrayF") ? 4 : (cname == "TArrayI") ? 4 : 8;
+    } else {
+      TObjArray * leaves = branch->GetListOfLeaves();
+      for(int il = 0; il < leaves->GetEntriesFast(); il++) {
+        TLeaf * leaf = (TLeaf *) leaves->UncheckedAt(il);
+        if(leaf->GetLeafCount()) elements[ib] = TMath::Max(elements[ib], leaf->GetLenType());
+        else bytes[ib] += (Long64_t) leaf->GetLenType() * leaf->GetLenStatic();
+      }
+      fixed_bytes += bytes[ib];
+    }
+    variable_elements += elements[ib];
+  }
+  Long64_t variable_bytes = TMath::Max(bytes_per_entry - fixed_bytes, (Long64_t)0);
+
+  Long64_t min_basket = kMaxBasket, max_basket = 0;
+  for(int ib = 0; ib < nbranches; ib++) {
+    TBranch * branch = (TBranch *) branches->UncheckedAt(ib);
+    if(elements[ib] > 0 && variable_elements > 0) {
+      bytes[ib] += variable_bytes * elements[ib] / variable_elements;
+    }
+    Long64_t bsz = TMath::Min(TMath::Max(bytes[ib] * auto_flush, kMinBasket), kMaxBasket);
+    tree->SetBasketSize(branch->GetName(), (Int_t) bsz);
+    min_basket = TMath::Min(min_basket, bsz);
+    max_basket = TMath::Max(max_basket, bsz);
+  }
+
+  LOG("ReW", pNOTICE)
+    << "Weights tree " << tree->GetName() << ": auto-flush every "
+    << auto_flush << " entries, basket sizes " << min_basket << " to "
+    << max_basket << " bytes (" << nbranches << " branches)";
+}
+//____________________________________________________________________________
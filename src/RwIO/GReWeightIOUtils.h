@@ -0,0 +1,57 @@
+//____________________________________________________________________________
+/*!
+
+\namespace  genie::utils::rew
+
+\brief      I/O utilities for the weight files written by the reweighting
+            apps: output compression and basket / auto-flush settings tuned
+            for weight columns.
+
+\author     The GENIE Collaboration
+
+\created    Oct 18, 2026
+
+\cpright    Copyright (c) 2003-2018, The GENIE Collaboration
+            For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_UTILS_H_
+#define _G_REWEIGHT_IO_UTILS_H_
+
+#include <string>
+
+#include <Rtypes.h>
+
+class TFile;
+class TTree;
+
+namespace genie {
+namespace utils {
+namespace rew   {
+
+  // Decode a compression spec of the form algorithm[:level], with algorithm
+  // one of zlib, lzma, lz4, zstd, into ROOT compression settings.
+  // Returns false if the spec is invalid (apps check --compression with it
+  // before any output is opened).
+  bool CompressionSettings (std::string spec, int & settings);
+
+  // Set the compression of an output file from a spec as above.
+  // Returns false (leaving the file untouched) if the spec is invalid.
+  bool SetCompression (TFile * file, std::string spec);
+
+  // Set the auto-flush cadence (entries per cluster) and the basket size of
+  // all branches of a weights tree (bytes_per_entry: all branches). For
+  // auto_flush <= 0 clusters of about 16 MB of uncompressed data are used.
+  // For basket_size <= 0 the basket of each branch is sized to hold a full
+  // cluster of its own entries (within [32 kB, 16 MB]), so that a cluster
+  // is read back with one read per branch and the baskets of the small
+  // branches stay small.
+  void TuneWeightTree (TTree * tree, Long64_t bytes_per_entry,
+                       Int_t basket_size = 0, Long64_t auto_flush = 0);
+
+} // rew   namespace
+} // utils namespace
+} // genie namespace
+
+#endif
@@ -0,0 +1,310 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <cassert>
+
+#include <TRootIOCtor.h>
+#include <TTree.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+
+// GENIE/Generator includes
+#include "Framework/Messenger/Messenger.h"
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOWeightCodec.h"
+
+using namespace genie;
+using namespace genie::rew;
+
+ClassImp(GReWeightIOWeightCodec)
+
+namespace {
+  const double   kLog16DefMin   = -8.;     // default ln(w) range for kStoreLog16
+  const double   kLog16DefMax   = +8.;
+  const UShort_t kLog16MaxCode  = 65535;
+}
+//____________________________________________________________________________
+GReWeightIOWeightCodec::GReWeightIOWeightCodec() :
+TObject(),
+fStorage(kStoreDouble),
+fOffset(0.),
+fScale(1.)
+{
+
+}
+//____________________________________________________________________________
+GReWeightIOWeightCodec::GReWeightIOWeightCodec(WeightStorage_t storage) :
+TObject(),
+fStorage(storage),
+fOffset(0.),
+fScale(1.)
+{
+  if(storage == kStoreLog16) {
+    this->SetLogRange(kLog16DefMin, kLog16DefMax);
+  }
+  else
+  if(storage == kStoreFloat16) {
+    this->SetLinearMap(1., 1.);
+  }
+}
+//____________________________________________________________________________
+GReWeightIOWeightCodec::GReWeightIOWeightCodec(
+   const GReWeightIOWeightCodec & codec) :
+TObject(),
+fStorage(codec.fStorage),
+fOffset(codec.fOffset),
+fScale(codec.fScale)
+{
+
+}
+//____________________________________________________________________________
+GReWeightIOWeightCodec::GReWeightIOWeightCodec(TRootIOCtor *) :
+TObject(),
+fStorage(kStoreDouble),
+fOffset(0.),
+fScale(1.)
+{
+
+}
+//____________________________________________________________________________
+void GReWeightIOWeightCodec::SetLogRange(double lnw_min, double lnw_max)
+{
+  assert(fStorage == kStoreLog16);
+  assert(lnw_max > lnw_min);
+
+  fOffset = lnw_min;
+  fScale  = (lnw_max - lnw_min) / (kLog16MaxCode - 1);
+}
+//____________________________________________________________________________
+void GReWeightIOWeightCodec::SetLinearMap(double offset, double scale)
+{
+  assert(fStorage == kStoreFloat16);
+  assert(scale > 0);
+
+  fOffset = offset;
+  fScale  = scale;
+}
+//____________________________________________________________________________
+bool GReWeightIOWeightCodec::IsQuantized(void) const
+{
+  return (fStorage == kStoreLog16 || fStorage == kStoreFloat16);
+}
+//____________________________________________________________________________
+int GReWeightIOWeightCodec::BytesPerWeight(void) const
+{
+  switch(fStorage) {
+    case kStoreDouble  : return sizeof(Double_t);
+    case kStoreFloat   : return sizeof(Float_t);
+    default            : break;
+  }
+  return sizeof(UShort_t);
+}
+//____________________________________________________________________________
+double GReWeightIOWeightCodec::PrecisionBound(void) const
+{
+  switch(fStorage) {
+    case kStoreDouble  : return 0.;
+    case kStoreFloat   : return std::ldexp(1., -24);
+    case kStoreLog16   : return std::exp(0.5*fScale) - 1.;
+    case kStoreFloat16 : return std::ldexp(1., -11);
+    default            : break;
+  }
+  return 0.;
+}
+//____________________________________________________________________________
+std::string GReWeightIOWeightCodec::AsString(void) const
+{
+  std::ostringstream str;
+  switch(fStorage) {
+    case kStoreDouble  : str << "double"; break;
+    case kStoreFloat   : str << "float";  break;
+    case kStoreLog16   :
+      str << "log16 (ln(w) in [" << fOffset << ", "
+          << fOffset + (kLog16MaxCode-1)*fScale << "], step " << fScale << ")";
+      break;
+    case kStoreFloat16 :
+      str << "float16 (of (w - " << fOffset << ")/" << fScale << ")";
+      break;
+    default : str << "unknown"; break;
+  }
+  str << ", precision bound: " << this->PrecisionBound();
+  return str.str();
+}
+//____________________________________________________________________________
+UShort_t GReWeightIOWeightCodec::Encode(double w) const
+{
+  if(fStorage == kStoreLog16) {
+    if( !(w > 0.) ) return 0;
+    double x = (std::log(w) - fOffset) / fScale;
+    if(x <= 0.                ) return 1;
+    if(x >= kLog16MaxCode - 1 ) return kLog16MaxCode;
+    return (UShort_t) (std::floor(x + 0.5) + 1);
+  }
+  else
+  if(fStorage == kStoreFloat16) {
+    return FloatToHalf( (float) ((w - fOffset) / fScale) );
+  }
+
+  LOG("ReW", pERROR) << "Weights are not quantized with storage: " << this->AsString();
+  return 0;
+}
+//____________________________________________________________________________
+double GReWeightIOWeightCodec::Decode(UShort_t c) const
+{
+  if(fStorage == kStoreLog16) {
+    if(c == 0) return 0.;
+    return std::exp(fOffset + (c-1) * fScale);
+  }
+  else
+  if(fStorage == kStoreFloat16) {
+    return fOffset + fScale * HalfToFloat(c);
+  }
+
+  LOG("ReW", pERROR) << "Weights are not quantized with storage: " << this->AsString();
+  return 0.;
+}
+//____________________________________________________________________________
+bool GReWeightIOWeightCodec::FromString(std::string name, WeightStorage_t & storage)
+{
+  if      (name == "double" ) storage = kStoreDouble;
+  else if (name == "float"  ) storage = kStoreFloat;
+  else if (name == "log16"  ) storage = kStoreLog16;
+  else if (name == "float16") storage = kStoreFloat16;
+  else return false;
+
+  return true;
+}
+//____________________________________________________________________________
+UShort_t GReWeightIOWeightCodec::FloatToHalf(float f)
+{
+// IEEE 754 single -> half precision, rounding to nearest even.
+// Finite values beyond the half range saturate at the largest finite value.
+//
+  UInt_t x;
+  std::memcpy(&x, &f, sizeof(x));
+
+  UInt_t sign = (x >> 16) & 0x8000;
+  Int_t  bexp = (x >> 23) & 0xff;
+  UInt_t mant =  x & 0x7fffff;
+
+  if(bexp == 0xff) {
+    return sign | 0x7c00 | (mant ? 0x200 : 0); // inf or nan
+  }
+
+  Int_t exp = bexp - 127 + 15;
+  if(exp >= 31) {
+    return sign | 0x7bff;
+  }
+  if(exp <= 0) {
+    // subnormal half (or zero)
+    if(exp < -10) return sign;
+    mant |= 0x800000;
+    Int_t  shift = 14 - exp;
+    UInt_t h     = mant >> shift;
+    UInt_t rem   = mant & ((1u << shift) - 1);
+    UInt_t halfw = 1u << (shift - 1);
+    if(rem > halfw || (rem == halfw && (h & 1))) h++;
+    return sign | h;
+  }
+
+  UInt_t h   = ((UInt_t)exp << 10) | (mant >> 13);
+  UInt_t rem = mant & 0x1fff;
+  if(rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++;
+  if((h & 0x7c00) == 0x7c00) h = 0x7bff;
+
+  return sign | h;
+}
+//____________________________________________________________________________
+float GReWeightIOWeightCodec::HalfToFloat(UShort_t h)
+{
+  UInt_t sign = h & 0x8000;
+  Int_t  exp  = (h >> 10) & 0x1f;
+  UInt_t mant = h & 0x3ff;
+
+  double v = 0.;
+  if(exp == 0) {
+    v = std::ldexp((double)mant, -24);
+  }
+  else
+  if(exp == 31) {
+    v = (mant == 0) ? HUGE_VAL : NAN;
+  }
+  else {
+    v = std::ldexp((double)(mant | 0x400), exp - 25);
+  }
+  return (float) (sign ? -v : v);
+}
+//____________________________________________________________________________
+GReWeightIOWeightBranch::GReWeightIOWeightBranch(
+  TTree * tree, std::string name, int n, const GReWeightIOWeightCodec & codec) :
+fCodec      (codec),
+fN          (n),
+fArrayD     (0),
+fArrayF     (0),
+fNSaturated (0)
+{
+  assert(tree && n > 0);
+
+  switch(fCodec.Storage()) {
+    case GReWeightIOWeightCodec::kStoreDouble :
+      fArrayD = new TArrayD(n);
+      tree->Branch(name.c_str(), fArrayD);
+      break;
+    case GReWeightIOWeightCodec::kStoreFloat :
+      fArrayF = new TArrayF(n);
+      tree->Branch(name.c_str(), fArrayF);
+      break;
+    default : {
+      fCodes.resize(n, 0);
+      std::ostringstream leaves;
+      leaves << name << "_q[" << n << "]/s";
+      tree->Branch((name + "_q").c_str(), &fCodes[0], leaves.str().c_str());
+      break;
+    }
+  }
+}
+//____________________________________________________________________________
+GReWeightIOWeightBranch::~GReWeightIOWeightBranch()
+{
+  if(fNSaturated > 0) {
+    LOG("ReW", pWARN)
+      << fNSaturated << " weights were outside the range of "
+      << fCodec.AsString() << " and were clipped";
+  }
+  delete fArrayD;
+  delete fArrayF;
+}
+//____________________________________________________________________________
+void GReWeightIOWeightBranch::Set(int i, double w)
+{
+  assert(i >= 0 && i < fN);
+
+  if(fArrayD) { fArrayD->AddAt(w, i); return; }
+  if(fArrayF) { fArrayF->AddAt(w, i); return; }
+
+  UShort_t c = fCodec.Encode(w);
+  if(fCodec.Storage() == GReWeightIOWeightCodec::kStoreLog16 &&
+     (c == 1 || c == kLog16MaxCode) && w > 0.) {
+    double lnw = std::log(w);
+    if(lnw < fCodec.Offset() || lnw > fCodec.Offset() + (kLog16MaxCode-1)*fCodec.Scale()) {
+      fNSaturated++;
+    }
+  }
+  fCodes[i] = c;
+}
+//____________________________________________________________________________
+void GReWeightIOWeightBranch::Set(const double * w)
+{
+  for(int i = 0; i < fN; i++) this->Set(i, w[i]);
+}
+//____________________________________________________________________________
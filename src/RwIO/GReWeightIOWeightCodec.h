@@ -0,0 +1,137 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOWeightCodec
+
+\brief    Describes how event weights are stored in a weights file and
+          converts between weights and their stored (possibly quantized)
+          representation. It is written in each weights file, next to the
+          weights tree, so that readers can decode the stored values.
+
+          Supported storage types:
+          - kStoreDouble  : 64-bit floating point (no loss)
+          - kStoreFloat   : 32-bit floating point (rel. error <= 2^-24)
+          - kStoreLog16   : 16-bit fixed-point log-weight. The code c in
+                            [1, 65535] stands for ln(w) = offset + (c-1)*scale,
+                            with offset and scale fixed per file from the
+                            ln(w) range [lnw_min, lnw_max]. Code 0 stands for
+                            w <= 0. Inside the range the relative error is
+                            bounded by exp(scale/2)-1 ~ scale/2 (1.2E-4 for
+                            the default range [-8,+8]), out-of-range weights
+                            saturate at the range edges.
+          - kStoreFloat16 : IEEE 754 half-precision value of (w-offset)/scale,
+                            with offset=1 and scale=1 by default, so that the
+                            abs. error is bounded by 2^-11 |w-1| (plus 2^-25
+                            for |w-1| < 6.1E-5). Values of |w-1| above 65504
+                            saturate. Unlike kStoreLog16, it preserves the
+                            sign of negative weights.
+
+          Quantized weights are stored as UShort_t arrays in a `<name>_q'
+          branch.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_WEIGHT_CODEC_H_
+#define _G_REWEIGHT_IO_WEIGHT_CODEC_H_
+
+#include <string>
+#include <vector>
+
+#include <TObject.h>
+
+class TTree;
+class TArrayD;
+class TArrayF;
+class TRootIOCtor;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightIOWeightCodec : public TObject {
+
+public:
+  typedef enum EWeightStorage {
+    kStoreDouble = 0,
+    kStoreFloat,
+    kStoreLog16,
+    kStoreFloat16
+  } WeightStorage_t;
+
+  GReWeightIOWeightCodec();
+  GReWeightIOWeightCodec(WeightStorage_t storage);
+  GReWeightIOWeightCodec(const GReWeightIOWeightCodec & codec);
+  GReWeightIOWeightCodec(TRootIOCtor *);
+ ~GReWeightIOWeightCodec() {}
+
+  void            SetLogRange    (double lnw_min, double lnw_max);  ///< kStoreLog16 only
+  void            SetLinearMap   (double offset, double scale);     ///< kStoreFloat16 only
+
+  WeightStorage_t Storage        (void) const { return (WeightStorage_t) fStorage; }
+  bool            IsQuantized    (void) const;
+  int             BytesPerWeight (void) const;                      ///< stored size of one weight
+  double          Offset         (void) const { return fOffset; }
+  double          Scale          (void) const { return fScale;  }
+  double          PrecisionBound (void) const;                      ///< max relative (log16, float) or |w-offset|-relative (float16) error
+  std::string     AsString       (void) const;
+
+  UShort_t        Encode         (double w)    const;               ///< quantized storage types only
+  double          Decode         (UShort_t c)  const;
+
+  static bool            FromString (std::string name, WeightStorage_t & storage);
+  static UShort_t        FloatToHalf (float f);
+  static float           HalfToFloat (UShort_t h);
+
+private:
+
+  int    fStorage;  ///< a WeightStorage_t value
+  double fOffset;   ///< log16: ln(w) for code 1, float16: subtracted from w before conversion
+  double fScale;    ///< log16: ln(w) step per code, float16: w-offset is divided by it before conversion
+
+ClassDef(GReWeightIOWeightCodec,1)
+};
+
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOWeightBranch
+
+\brief    Creates and fills a fixed-length weight array branch in a weights
+          tree, using the storage type of the given codec: a TArrayD or
+          TArrayF `<name>' branch, or a UShort_t[n] `<name>_q' branch for
+          quantized storage.
+*/
+//____________________________________________________________________________
+
+class GReWeightIOWeightBranch {
+
+public:
+  GReWeightIOWeightBranch(TTree * tree, std::string name, int n,
+                          const GReWeightIOWeightCodec & codec);
+ ~GReWeightIOWeightBranch();
+
+  void Set (int i, double w);        ///< set the i-th weight of the current entry
+  void Set (const double * w);       ///< set all n weights of the current entry
+
+  int  NSaturated (void) const { return fNSaturated; } ///< # of log16 weights clipped at the range edges so far
+
+private:
+
+  GReWeightIOWeightCodec  fCodec;
+  int                     fN;
+  TArrayD *               fArrayD;
+  TArrayF *               fArrayF;
+  std::vector<UShort_t>   fCodes;
+  int                     fNSaturated;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
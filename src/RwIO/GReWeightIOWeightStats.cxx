@@ -0,0 +1,67 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2018, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+
+ Authors: The GENIE Collaboration
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+#include <cmath>
+
+#include <TTree.h>
+
+// GENIE/Reweight includes
+#include "RwIO/GReWeightIOWeightStats.h"
+
+using std::string;
+
+using namespace genie;
+using namespace genie::rew;
+
+//____________________________________________________________________________
+GReWeightIOWeightStats::GReWeightIOWeightStats(TTree * tree, string name) :
+fMin     (1.),
+fMax     (1.),
+fMean    (1.),
+fRMS     (0.),
+fFNonPos (0.)
+{
+  assert(tree);
+
+  tree->Branch((name + "_min"    ).c_str(), &fMin,     (name + "_min/F"    ).c_str());
+  tree->Branch((name + "_max"    ).c_str(), &fMax,     (name + "_max/F"    ).c_str());
+  tree->Branch((name + "_mean"   ).c_str(), &fMean,    (name + "_mean/F"   ).c_str());
+  tree->Branch((name + "_rms"    ).c_str(), &fRMS,     (name + "_rms/F"    ).c_str());
+  tree->Branch((name + "_fnonpos").c_str(), &fFNonPos, (name + "_fnonpos/F").c_str());
+}
+//____________________________________________________________________________
+void GReWeightIOWeightStats::Set(const double * w, int n, const double * multiplicity)
+{
+  assert(n > 0);
+
+  // sums shifted by the first weight, for the variance of weights near 1
+  double shift = w[0];
+  double sumn = 0., sumd = 0., sumd2 = 0., nonpos = 0.;
+  double wmin = w[0], wmax = w[0];
+  for(int i = 0; i < n; i++) {
+    double m = (multiplicity) ? multiplicity[i] : 1.;
+    double d = w[i] - shift;
+    sumn  += m;
+    sumd  += m * d;
+    sumd2 += m * d * d;
+    if(w[i] <= 0.) nonpos += m;
+    if(w[i] < wmin) wmin = w[i];
+    if(w[i] > wmax) wmax = w[i];
+  }
+  double mean = (sumn > 0.) ? sumd / sumn : 0.;
+  double var  = (sumn > 0.) ? sumd2 / sumn - mean * mean : 0.;
+
+  fMin     = wmin;
+  fMax     = wmax;
+  fMean    = shift + mean;
+  fRMS     = (var > 0.) ? std::sqrt(var) : 0.;
+  fFNonPos = (sumn > 0.) ? nonpos / sumn : 0.;
+}
+//____________________________________________________________________________
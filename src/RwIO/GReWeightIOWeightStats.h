@@ -0,0 +1,69 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::rew::GReWeightIOWeightStats
+
+\brief    Creates and fills, next to a weight array branch `<name>' of a
+          weights tree, small per-entry summary columns of the weights over
+          the universes (or dial values):
+
+            <name>_min, <name>_max   smallest & largest weight
+            <name>_mean              mean weight
+            <name>_rms               standard deviation of the weights
+            <name>_fnonpos           fraction of universes with weight <= 0
+
+          so that outlier checks or importance sampling need not read the
+          whole weight arrays. The summaries are computed from the exact
+          (double) weights, before any lossy storage.
+
+          Universes may carry multiplicities (eg the number of chain samples
+          in each distinct state), counted as repeated universes.
+
+\author   The GENIE Collaboration
+
+\created  Oct 18, 2026
+
+\cpright  Copyright (c) 2003-2018, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _G_REWEIGHT_IO_WEIGHT_STATS_H_
+#define _G_REWEIGHT_IO_WEIGHT_STATS_H_
+
+#include <string>
+
+#include <Rtypes.h>
+
+class TTree;
+
+namespace genie {
+namespace rew   {
+
+class GReWeightIOWeightStats {
+
+public:
+  GReWeightIOWeightStats(TTree * tree, std::string name);
+ ~GReWeightIOWeightStats() {}
+
+  void Set (const double * w, int n, const double * multiplicity = 0); ///< summarize the current entry's weights
+
+  double Min     (void) const { return fMin;     }
+  double Max     (void) const { return fMax;     }
+  double Mean    (void) const { return fMean;    }
+  double RMS     (void) const { return fRMS;     }
+  double FNonPos (void) const { return fFNonPos; }
+
+private:
+
+  Float_t fMin;
+  Float_t fMax;
+  Float_t fMean;
+  Float_t fRMS;
+  Float_t fFNonPos;
+};
+
+} // rew   namespace
+} // genie namespace
+
+#endif
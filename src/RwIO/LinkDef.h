@@ -39,6 +39,9 @@
 #pragma link C++ class genie::rew::GReWeightInfo;
 #pragma link C++ class genie::rew::GReWeightIORecord;
 #pragma link C++ class genie::rew::GReWeightIOBranchDesc;
+#pragma link C++ class genie::rew::GReWeightIOWeightCodec;
+#pragma link C++ class genie::rew::GReWeightIOShardManifest;
+#pragma link C++ class genie::rew::GReWeightIOBinResponse;
 
 #pragma link C++ ioctortype TRootIOCtor;
 